@@ -502,9 +502,15 @@ pub fn build(b: *std.Build) void {
         "src/schema/serializer.c",
         "src/schema/callbacks.c",
         "src/schema/dynamic_schema.c",
+        "src/schema/interpolation.c",
+        "src/schema/snapshot.c",
+        // Messages
+        "src/msgpack/msgpack_cursor.c",
+        "src/msgpack/msgpack_writer.c",
         // Utils
         "src/utils/strUtil.c",
         "src/utils/sha1_c.c",
+        "src/utils/inflate.c",
         "src/utils/time.c",
         // Auth
         "src/auth/auth.c",
@@ -519,6 +525,10 @@ pub fn build(b: *std.Build) void {
     // Platform-specific network sources
     const native_network_sources = [_][]const u8{
         "src/network/websocket_transport.c",
+        "src/network/io_runtime.c",
+        "src/network/tls_config.c",
+        "src/network/resolver.c",
+        "src/utils/timers.c",
     };
 
     const web_network_sources = [_][]const u8{
@@ -604,6 +614,7 @@ pub fn build(b: *std.Build) void {
         "settings.h",
         "transport.h",
         "websocket_transport.h",
+        "io_runtime.h",
         "schema.h",
         "schema/types.h",
         "schema/decode.h",
@@ -611,6 +622,8 @@ pub fn build(b: *std.Build) void {
         "schema/collections.h",
         "schema/decoder.h",
         "schema/callbacks.h",
+        "schema/interpolation.h",
+        "schema/snapshot.h",
         "utils/sha1_c.h",
         "utils/strUtil.h",
         "auth/auth.h",
@@ -701,6 +714,29 @@ pub fn build(b: *std.Build) void {
             .run_step_name = "run-auth-example",
             .run_step_desc = "Run the auth example",
         }, target, optimize, colyseus, wslay_version_h, c_std);
+
+        buildExample(b, .{
+            .name = "ws_latency_bench",
+            .source_file = "examples/ws_latency_bench.c",
+            .run_step_name = "run-ws-latency-bench",
+            .run_step_desc = "Run the WebSocket transport latency benchmark (needs a local echo server)",
+        }, target, optimize, colyseus, wslay_version_h, c_std);
+
+        buildExample(b, .{
+            .name = "http_latency_bench",
+            .source_file = "examples/http_latency_bench.c",
+            .run_step_name = "run-http-latency-bench",
+            .run_step_desc = "Run the pooled HTTP client latency benchmark (needs a local echo server)",
+        }, target, optimize, colyseus, wslay_version_h, c_std);
+
+        if (os_tag == .linux) {
+            buildExample(b, .{
+                .name = "io_runtime_bench",
+                .source_file = "examples/io_runtime_bench.c",
+                .run_step_name = "run-io-runtime-bench",
+                .run_step_desc = "Benchmark the epoll and io_uring I/O runtime backends (needs a local echo server)",
+            }, target, optimize, colyseus, wslay_version_h, c_std);
+        }
     }
 
     // ========================================================================
@@ -721,6 +757,8 @@ pub fn build(b: *std.Build) void {
         .{ .name = "test_room", .file = "tests/test_room.zig", .description = "Run room tests" },
         .{ .name = "test_storage", .file = "tests/test_storage.zig", .description = "Run storage tests" },
         .{ .name = "test_schema", .file = "tests/test_schema.zig", .description = "Run schema tests" },
+        .{ .name = "test_websocket", .file = "tests/test_websocket.zig", .description = "Run WebSocket transport tests (loopback peer)" },
+        .{ .name = "test_timers", .file = "tests/test_timers.zig", .description = "Run shared timer wheel tests" },
         .{ .name = "test_suite", .file = "tests/test_suite.zig", .description = "Run unit test suite" },
         .{ .name = "test_integration", .file = "tests/test_integration.zig", .description = "Run integration tests (requires server)" },
         .{ .name = "test_schema_callbacks", .file = "tests/test_schema_callbacks.zig", .description = "Run schema callbacks tests (requires server)" },
@@ -0,0 +1,109 @@
+/*
+ * HTTP client latency benchmark.
+ *
+ * Sends `count` sequential GET requests through colyseus_http_t and
+ * measures per-request latency against a local HTTP server:
+ *
+ *   node tests/tls/wss-echo-server.mjs --plain --port 2569
+ *   ./zig-out/bin/http_latency_bench [host] [port] [count] [--fresh]
+ *
+ * Defaults: 127.0.0.1, 2569, 1000 requests. Requests reuse the client's
+ * kept-alive connection; --fresh creates a new colyseus_http_t for every
+ * request (a new connection each time) for comparison.
+ */
+#include <colyseus/http.h>
+#include <colyseus/settings.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static int succeeded;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* colyseus_http_get() is synchronous on native targets: the callback has
+ * run by the time it returns. */
+static void on_success(const colyseus_http_response_t* response, void* userdata) {
+    (void)response;
+    (void)userdata;
+    succeeded = 1;
+}
+
+static void on_error(const colyseus_http_error_t* error, void* userdata) {
+    (void)userdata;
+    fprintf(stderr, "Error (%d): %s\n", error->code, error->message ? error->message : "");
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const uint64_t* sorted, int n, double p) {
+    int idx = (int)(p * (n - 1) + 0.5);
+    return (double)sorted[idx] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* positional[3] = { "127.0.0.1", "2569", "1000" };
+    int npos = 0;
+    int fresh = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fresh") == 0) fresh = 1;
+        else if (npos < 3) positional[npos++] = argv[i];
+    }
+    int count = atoi(positional[2]);
+    if (count <= 0) count = 1000;
+
+    colyseus_settings_t* settings = colyseus_settings_create();
+    colyseus_settings_set_address(settings, positional[0]);
+    colyseus_settings_set_port(settings, positional[1]);
+
+    uint64_t* latency = malloc(sizeof(uint64_t) * (size_t)count);
+    colyseus_http_t* http = fresh ? NULL : colyseus_http_create(settings);
+    if (!latency || (!fresh && !http)) {
+        free(latency);
+        colyseus_http_free(http);
+        colyseus_settings_free(settings);
+        return 1;
+    }
+
+    int completed = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t started = now_ns();
+        colyseus_http_t* h = fresh ? colyseus_http_create(settings) : http;
+        succeeded = 0;
+        colyseus_http_get(h, "/bench", on_success, on_error, NULL);
+        if (fresh) colyseus_http_free(h);
+        if (!succeeded) break;
+        latency[completed++] = now_ns() - started;
+    }
+
+    if (completed > 0) {
+        uint64_t total = 0;
+        for (int i = 0; i < completed; i++) total += latency[i];
+        qsort(latency, (size_t)completed, sizeof(uint64_t), compare_u64);
+
+        printf("%d requests, %s (http://%s:%s)\n", completed,
+               fresh ? "new client per request" : "pooled client",
+               positional[0], positional[1]);
+        printf("  min  %8.1f us\n", (double)latency[0] / 1000.0);
+        printf("  avg  %8.1f us\n", (double)total / completed / 1000.0);
+        printf("  p50  %8.1f us\n", percentile_us(latency, completed, 0.50));
+        printf("  p90  %8.1f us\n", percentile_us(latency, completed, 0.90));
+        printf("  p99  %8.1f us\n", percentile_us(latency, completed, 0.99));
+        printf("  max  %8.1f us\n", (double)latency[completed - 1] / 1000.0);
+    }
+
+    free(latency);
+    colyseus_http_free(http);
+    colyseus_settings_free(settings);
+
+    return completed == count ? 0 : 1;
+}
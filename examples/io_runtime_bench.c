@@ -0,0 +1,160 @@
+/*
+ * Shared I/O runtime benchmark: epoll vs io_uring.
+ *
+ * Opens `connections` transports on one runtime thread and runs ping-pong
+ * rounds (every connection sends a frame, then waits for every echo)
+ * against a local echo server, once per backend:
+ *
+ *   node tests/tls/wss-echo-server.mjs --plain --port 2569
+ *   ./zig-out/bin/io_runtime_bench [url] [connections] [rounds]
+ *
+ * Defaults: ws://127.0.0.1:2569, 1000 connections, 200 rounds.
+ * Raise the fd limit (ulimit -n) for large connection counts.
+ */
+#include <colyseus/websocket_transport.h>
+#include <colyseus/io_runtime.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#define PAYLOAD_SIZE 64
+
+static atomic_int opened;
+static atomic_int failed;
+static atomic_int received;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static double cpu_seconds(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+static void on_open(void* userdata) {
+    (void)userdata;
+    atomic_fetch_add(&opened, 1);
+}
+
+static void on_message(const uint8_t* data, size_t length, void* userdata) {
+    (void)data;
+    (void)length;
+    (void)userdata;
+    atomic_fetch_add(&received, 1);
+}
+
+static void on_close(int code, const char* reason, void* userdata) {
+    (void)code;
+    (void)reason;
+    (void)userdata;
+}
+
+static void on_error(const char* message, void* userdata) {
+    (void)message;
+    (void)userdata;
+    atomic_fetch_add(&failed, 1);
+}
+
+static bool wait_for(atomic_int* counter, int target, uint64_t timeout_ns) {
+    uint64_t deadline = now_ns() + timeout_ns;
+    while (atomic_load(counter) < target && atomic_load(&failed) == 0) {
+        if (now_ns() > deadline) return false;
+        usleep(100);
+    }
+    return atomic_load(counter) >= target;
+}
+
+static int run(const char* url, int connections, int rounds, colyseus_io_backend_t backend) {
+    colyseus_io_runtime_t* runtime = colyseus_io_runtime_create_with_backend(1, backend);
+    if (!runtime) {
+        fprintf(stderr, "Failed to create I/O runtime\n");
+        return 1;
+    }
+    const char* name = colyseus_io_runtime_get_backend(runtime) == COLYSEUS_IO_BACKEND_IO_URING
+        ? "io_uring" : "epoll";
+    if (colyseus_io_runtime_get_backend(runtime) != backend) {
+        printf("%s: io_uring unavailable, skipping\n", name);
+        colyseus_io_runtime_free(runtime);
+        return 0;
+    }
+
+    colyseus_settings_t* settings = colyseus_settings_create();
+    colyseus_settings_set_io_runtime(settings, runtime);
+
+    colyseus_transport_events_t events = {
+        .on_open = on_open,
+        .on_message = on_message,
+        .on_close = on_close,
+        .on_error = on_error,
+        .userdata = NULL,
+    };
+
+    atomic_store(&opened, 0);
+    atomic_store(&failed, 0);
+    atomic_store(&received, 0);
+
+    colyseus_transport_t** transports = calloc((size_t)connections, sizeof(colyseus_transport_t*));
+    for (int i = 0; i < connections; i++) {
+        transports[i] = colyseus_websocket_transport_create(&events);
+        colyseus_websocket_connect_with_settings(transports[i], url, settings);
+    }
+
+    int status = 0;
+    if (!wait_for(&opened, connections, 10000000000ull)) {
+        fprintf(stderr, "%s: only %d/%d connections opened\n", name, atomic_load(&opened), connections);
+        status = 1;
+        goto done;
+    }
+
+    uint8_t payload[PAYLOAD_SIZE];
+    memset(payload, 0x42, sizeof(payload));
+
+    double cpu_start = cpu_seconds();
+    uint64_t start = now_ns();
+    for (int round = 1; round <= rounds; round++) {
+        for (int i = 0; i < connections; i++) {
+            transports[i]->send(transports[i], payload, sizeof(payload));
+        }
+        if (!wait_for(&received, round * connections, 5000000000ull)) {
+            fprintf(stderr, "%s: round %d timed out (%d echoes)\n", name, round, atomic_load(&received));
+            status = 1;
+            goto done;
+        }
+    }
+    double elapsed = (double)(now_ns() - start) / 1e9;
+    double cpu = cpu_seconds() - cpu_start;
+    int messages = rounds * connections;
+
+    printf("%-8s %d connections, %d rounds: %.0f msgs/s, %.2f s wall, %.2f s CPU (%.2f us CPU/msg)\n",
+           name, connections, rounds, messages / elapsed, elapsed, cpu, cpu * 1e6 / messages);
+
+done:
+    for (int i = 0; i < connections; i++) {
+        if (transports[i]) transports[i]->destroy(transports[i]);
+    }
+    free(transports);
+    colyseus_settings_free(settings);
+    colyseus_io_runtime_free(runtime);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    const char* url = argc > 1 ? argv[1] : "ws://127.0.0.1:2569";
+    int connections = argc > 2 ? atoi(argv[2]) : 1000;
+    int rounds = argc > 3 ? atoi(argv[3]) : 200;
+    if (connections <= 0) connections = 1000;
+    if (rounds <= 0) rounds = 200;
+
+    int status = run(url, connections, rounds, COLYSEUS_IO_BACKEND_EPOLL);
+    status |= run(url, connections, rounds, COLYSEUS_IO_BACKEND_IO_URING);
+    return status;
+}
@@ -0,0 +1,151 @@
+/*
+ * WebSocket transport latency benchmark.
+ *
+ * Sends `count` binary frames one at a time over the raw transport and
+ * measures send -> echo round-trip time against a local echo server:
+ *
+ *   node tests/tls/wss-echo-server.mjs --plain --port 2569
+ *   ./zig-out/bin/ws_latency_bench [url] [count] [payload_bytes]
+ *
+ * Defaults: ws://127.0.0.1:2569, 1000 frames, 32 bytes.
+ */
+#include <colyseus/websocket_transport.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+
+static atomic_bool opened;
+static atomic_bool closed;
+static atomic_uint received_seq;
+static atomic_uint_fast64_t received_at_ns;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void on_open(void* userdata) {
+    (void)userdata;
+    atomic_store(&opened, true);
+}
+
+static void on_message(const uint8_t* data, size_t length, void* userdata) {
+    (void)userdata;
+    uint64_t t = now_ns();
+    if (length < sizeof(uint32_t)) return;
+    uint32_t seq;
+    memcpy(&seq, data, sizeof(seq));
+    atomic_store(&received_at_ns, t);
+    atomic_store(&received_seq, seq);
+}
+
+static void on_close(int code, const char* reason, void* userdata) {
+    (void)userdata;
+    printf("Closed (%d): %s\n", code, reason ? reason : "");
+    atomic_store(&closed, true);
+}
+
+static void on_error(const char* message, void* userdata) {
+    (void)userdata;
+    fprintf(stderr, "Error: %s\n", message);
+    atomic_store(&closed, true);
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const uint64_t* sorted, int n, double p) {
+    int idx = (int)(p * (n - 1) + 0.5);
+    return (double)sorted[idx] / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* url = argc > 1 ? argv[1] : "ws://127.0.0.1:2569";
+    int count = argc > 2 ? atoi(argv[2]) : 1000;
+    size_t payload_size = argc > 3 ? (size_t)atoi(argv[3]) : 32;
+    if (count <= 0) count = 1000;
+    if (payload_size < sizeof(uint32_t)) payload_size = sizeof(uint32_t);
+
+    colyseus_transport_events_t events = {
+        .on_open = on_open,
+        .on_message = on_message,
+        .on_close = on_close,
+        .on_error = on_error,
+        .userdata = NULL,
+    };
+
+    colyseus_transport_t* transport = colyseus_websocket_transport_create(&events);
+    if (!transport) {
+        fprintf(stderr, "Failed to create transport\n");
+        return 1;
+    }
+
+    transport->connect(transport, url);
+
+    /* Wait up to 5s for the connection */
+    for (int i = 0; i < 5000 && !atomic_load(&opened) && !atomic_load(&closed); i++) {
+        usleep(1000);
+    }
+    if (!atomic_load(&opened)) {
+        fprintf(stderr, "Could not connect to %s\n", url);
+        transport->destroy(transport);
+        return 1;
+    }
+
+    uint8_t* payload = calloc(1, payload_size);
+    uint64_t* rtt = malloc(sizeof(uint64_t) * (size_t)count);
+    if (!payload || !rtt) {
+        free(payload);
+        free(rtt);
+        transport->destroy(transport);
+        return 1;
+    }
+
+    int completed = 0;
+    for (uint32_t seq = 1; seq <= (uint32_t)count; seq++) {
+        memcpy(payload, &seq, sizeof(seq));
+
+        uint64_t sent_at = now_ns();
+        transport->send(transport, payload, payload_size);
+
+        /* Spin (yielding) so the measurement isn't dominated by our own sleep */
+        uint64_t deadline = sent_at + 1000000000ull;
+        while (atomic_load(&received_seq) != seq && !atomic_load(&closed) && now_ns() < deadline) {
+            sched_yield();
+        }
+        if (atomic_load(&received_seq) != seq) {
+            fprintf(stderr, "Frame %u timed out\n", seq);
+            break;
+        }
+
+        rtt[completed++] = atomic_load(&received_at_ns) - sent_at;
+    }
+
+    if (completed > 0) {
+        uint64_t total = 0;
+        for (int i = 0; i < completed; i++) total += rtt[i];
+        qsort(rtt, (size_t)completed, sizeof(uint64_t), compare_u64);
+
+        printf("%d round trips, %zu byte payload (%s)\n", completed, payload_size, url);
+        printf("  min  %8.1f us\n", (double)rtt[0] / 1000.0);
+        printf("  avg  %8.1f us\n", (double)total / completed / 1000.0);
+        printf("  p50  %8.1f us\n", percentile_us(rtt, completed, 0.50));
+        printf("  p90  %8.1f us\n", percentile_us(rtt, completed, 0.90));
+        printf("  p99  %8.1f us\n", percentile_us(rtt, completed, 0.99));
+        printf("  max  %8.1f us\n", (double)rtt[completed - 1] / 1000.0);
+    }
+
+    free(payload);
+    free(rtt);
+    transport->destroy(transport);
+
+    return completed == count ? 0 : 1;
+}
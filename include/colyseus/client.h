@@ -7,6 +7,7 @@
 #include "colyseus/http.h"
 #include "colyseus/room.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "auth/auth.h"
 
@@ -20,7 +21,9 @@ typedef struct {
     colyseus_transport_factory_fn transport_factory;
     colyseus_http_t* http;
     colyseus_auth_t* auth;
-    void* http_worker;  /* Internal: background HTTP worker thread */
+    void* http_pool;    /* Internal: background HTTP request threads */
+    void* poll_state;   /* Internal: poll mode queue + room group */
+    bool prewarm;       /* Open the room connection during matchmaking (opt-in) */
 } colyseus_client_t;
 
 /* Matchmaking callbacks */
@@ -41,6 +44,75 @@ colyseus_http_t* colyseus_client_get_http(colyseus_client_t* client);
 /* Get Auth client */
 colyseus_auth_t* colyseus_client_get_auth(colyseus_client_t* client);
 
+/* Background HTTP requests
+ *
+ * Requests are queued on the client's request threads (up to 4 at once by
+ * default), highest priority first; matchmaking always runs at
+ * COLYSEUS_HTTP_PRIORITY_HIGH. Callbacks run on a request thread. On the
+ * web, requests go straight to fetch() and priorities, timeouts and
+ * cancellation do not apply. */
+typedef enum {
+    COLYSEUS_HTTP_GET,
+    COLYSEUS_HTTP_POST,
+    COLYSEUS_HTTP_PUT,
+    COLYSEUS_HTTP_DELETE,
+    COLYSEUS_HTTP_PATCH
+} colyseus_http_method_t;
+
+typedef enum {
+    COLYSEUS_HTTP_PRIORITY_HIGH,
+    COLYSEUS_HTTP_PRIORITY_NORMAL,
+    COLYSEUS_HTTP_PRIORITY_LOW
+} colyseus_http_priority_t;
+
+/* Error code passed to on_error when a request's timeout elapsed */
+#define COLYSEUS_HTTP_TIMEOUT 408
+
+/* Queue a request. `timeout_ms` (0 = none) counts from now, time spent
+ * queued included. Returns the request id, or 0 on failure. */
+uint64_t colyseus_client_http_request(
+    colyseus_client_t* client,
+    colyseus_http_method_t method,
+    const char* path,
+    const char* json_body,
+    colyseus_http_priority_t priority,
+    uint32_t timeout_ms,
+    colyseus_http_success_callback_t on_success,
+    colyseus_http_error_callback_t on_error,
+    void* userdata
+);
+
+/* Cancel a queued or running request: neither callback will run. Returns
+ * false if it already finished, or its callback is running. */
+bool colyseus_client_http_cancel(colyseus_client_t* client, uint64_t request_id);
+
+/* How many requests may run at once (default 4) */
+void colyseus_client_set_http_concurrency(colyseus_client_t* client, int max_requests);
+
+/* Fail matchmaking requests with COLYSEUS_HTTP_TIMEOUT after `timeout_ms`
+ * (default 0: no timeout) */
+void colyseus_client_set_matchmake_timeout(colyseus_client_t* client, uint32_t timeout_ms);
+
+/* Pre-warming (off by default, opt in here): while a matchmaking request
+ * is in flight, the WebSocket connection to the server is resolved,
+ * connected and, for wss://, TLS-handshaked, so joining only waits for the
+ * upgrade. It opens a connection before the server has a seat for it, and
+ * one that goes unused if matchmaking fails. Applies to the built-in
+ * WebSocket transport without an external event loop; see
+ * colyseus_room_get_join_timings() for the effect. */
+void colyseus_client_set_prewarm(colyseus_client_t* client, bool enabled);
+
+/* Poll mode: matchmaking results and room events are delivered by
+ * colyseus_client_poll() on the calling thread instead of the HTTP worker
+ * and network threads. Rooms created by the client afterwards are in poll
+ * mode (see colyseus_room_enable_poll_mode()). */
+void colyseus_client_enable_poll_mode(colyseus_client_t* client);
+
+/* Dispatch pending matchmaking results and events of the client's rooms
+ * until done or `budget_ms` elapsed (0 = no limit). Returns the number of
+ * events dispatched. */
+int colyseus_client_poll(colyseus_client_t* client, int budget_ms);
+
 /* Matchmaking methods */
 void colyseus_client_join_or_create(
     colyseus_client_t* client,
@@ -27,10 +27,12 @@ typedef struct {
 typedef void (*colyseus_http_success_callback_t)(const colyseus_http_response_t* response, void* userdata);
 typedef void (*colyseus_http_error_callback_t)(const colyseus_http_error_t* error, void* userdata);
 
-/* HTTP client structure */
+/* HTTP client structure. `session` is the native client's long-lived
+ * connection pool (NULL on the web); it is internal. */
 typedef struct {
     const colyseus_settings_t* settings;
     char* auth_token;
+    void* session;
 } colyseus_http_t;
 
 /* Create/destroy HTTP client */
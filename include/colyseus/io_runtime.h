@@ -0,0 +1,58 @@
+#ifndef COLYSEUS_IO_RUNTIME_H
+#define COLYSEUS_IO_RUNTIME_H
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Shared I/O runtime
+ *
+ * By default every native WebSocket transport runs its own tick thread.
+ * A runtime multiplexes the sockets of many transports (TCP connect, TLS
+ * handshake, HTTP upgrade, WebSocket frames) onto a small fixed set of
+ * epoll threads, so an extra connection only costs memory.
+ *
+ * Attach it with colyseus_settings_set_io_runtime(); every transport
+ * connected with those settings afterwards uses it. Transport callbacks
+ * (on_open, on_message, ...) then run on a runtime thread and must not
+ * block it.
+ *
+ * Available on Linux (epoll, or io_uring with
+ * colyseus_io_runtime_create_with_backend()). Elsewhere the create
+ * functions return NULL and transports keep their own thread.
+ */
+
+typedef struct colyseus_io_runtime colyseus_io_runtime_t;
+
+typedef enum {
+    COLYSEUS_IO_BACKEND_EPOLL,
+    /* io_uring (Linux 6.0+): multishot receive into a registered buffer
+     * ring, and all sends / receive re-arms of a loop iteration submitted
+     * with one io_uring_enter(). Falls back to epoll when unavailable. */
+    COLYSEUS_IO_BACKEND_IO_URING
+} colyseus_io_backend_t;
+
+/* Start a runtime with `thread_count` I/O threads (<= 0 means 1).
+ * Transports are spread across threads round-robin. */
+colyseus_io_runtime_t* colyseus_io_runtime_create(int thread_count);
+colyseus_io_runtime_t* colyseus_io_runtime_create_with_backend(int thread_count,
+                                                               colyseus_io_backend_t backend);
+
+/* Backend actually in use */
+colyseus_io_backend_t colyseus_io_runtime_get_backend(colyseus_io_runtime_t* runtime);
+
+/* Stop the threads and free the runtime. Every transport using it must
+ * have been destroyed first. */
+void colyseus_io_runtime_free(colyseus_io_runtime_t* runtime);
+
+/* Number of transports currently attached */
+int colyseus_io_runtime_get_connection_count(colyseus_io_runtime_t* runtime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_IO_RUNTIME_H */
@@ -50,6 +50,66 @@ uint8_t* colyseus_message_encode(colyseus_message_t* message, size_t* out_len);
 void colyseus_message_free(colyseus_message_t* message);
 void colyseus_message_encoded_free(uint8_t* data, size_t len);
 
+/* ============================================================================
+ * Message Writer API (streaming, for messages sent every frame)
+ * ============================================================================
+ *
+ * Encodes msgpack values in order straight into one buffer, with no tree
+ * and no per-value allocation. Containers are written as a header with the
+ * element count, then the elements (for maps: key, value, key, ...):
+ *
+ *   colyseus_msgwriter_t w;
+ *   colyseus_msgwriter_init(&w, NULL, 0);      // grows as needed
+ *   colyseus_msgwriter_map(&w, 2);
+ *   colyseus_msgwriter_str(&w, "x"); colyseus_msgwriter_float(&w, x);
+ *   colyseus_msgwriter_str(&w, "y"); colyseus_msgwriter_float(&w, y);
+ *   colyseus_room_send_writer(room, "move", &w);
+ *   colyseus_msgwriter_reset(&w);              // keep the buffer for the next one
+ *
+ * Pass a buffer to init to write into caller memory instead; it must be
+ * larger than COLYSEUS_MSGWRITER_HEADROOM, which is kept free in front of
+ * the payload for the room's protocol header. Running out of space (or
+ * memory) sets `error`: further writes are ignored and sending is skipped.
+ */
+
+#define COLYSEUS_MSGWRITER_HEADROOM 32
+
+typedef struct {
+    uint8_t* buf;       /* headroom, then the payload */
+    size_t capacity;
+    size_t length;      /* payload bytes written */
+    bool owned;         /* buf was allocated by the writer */
+    bool error;
+} colyseus_msgwriter_t;
+
+/* `buffer` NULL: the writer allocates and grows its own */
+void colyseus_msgwriter_init(colyseus_msgwriter_t* writer, uint8_t* buffer, size_t capacity);
+
+/* Start a new message, keeping the buffer */
+void colyseus_msgwriter_reset(colyseus_msgwriter_t* writer);
+
+/* Free the buffer if the writer allocated it */
+void colyseus_msgwriter_free(colyseus_msgwriter_t* writer);
+
+/* The encoded payload, or NULL after an error */
+const uint8_t* colyseus_msgwriter_data(const colyseus_msgwriter_t* writer, size_t* out_len);
+bool colyseus_msgwriter_ok(const colyseus_msgwriter_t* writer);
+
+void colyseus_msgwriter_nil(colyseus_msgwriter_t* writer);
+void colyseus_msgwriter_bool(colyseus_msgwriter_t* writer, bool value);
+void colyseus_msgwriter_int(colyseus_msgwriter_t* writer, int64_t value);
+void colyseus_msgwriter_uint(colyseus_msgwriter_t* writer, uint64_t value);
+void colyseus_msgwriter_float(colyseus_msgwriter_t* writer, double value);
+void colyseus_msgwriter_float32(colyseus_msgwriter_t* writer, float value);
+void colyseus_msgwriter_str(colyseus_msgwriter_t* writer, const char* value);
+void colyseus_msgwriter_str_len(colyseus_msgwriter_t* writer, const char* value, size_t length);
+void colyseus_msgwriter_bin(colyseus_msgwriter_t* writer, const uint8_t* data, size_t length);
+void colyseus_msgwriter_array(colyseus_msgwriter_t* writer, size_t count);
+void colyseus_msgwriter_map(colyseus_msgwriter_t* writer, size_t count);
+
+/* Append an already-encoded value as is */
+void colyseus_msgwriter_raw(colyseus_msgwriter_t* writer, const uint8_t* encoded, size_t length);
+
 /* ============================================================================
  * Message Reader API (for parsing incoming messages)
  * ============================================================================ */
@@ -125,6 +185,92 @@ typedef struct {
 colyseus_message_map_iterator_t colyseus_message_reader_map_iterator(colyseus_message_reader_t* reader);
 bool colyseus_message_map_iterator_next(colyseus_message_map_iterator_t* iter, colyseus_message_reader_t** out_key, colyseus_message_reader_t** out_value);
 
+/* ============================================================================
+ * Message Cursor API (zero-allocation reads)
+ * ============================================================================
+ *
+ * A cursor is a plain value pointing into the encoded bytes a message
+ * handler receives: nothing is decoded up front and nothing is allocated.
+ * Reads decode the value at the cursor and move past it; copy the struct
+ * to remember a position. Strings and binaries point into the original
+ * bytes, so they are valid as long as those bytes are (for the duration of
+ * the handler). Malformed input sets `error`, after which every read fails.
+ *
+ *   colyseus_message_cursor_t msg;
+ *   colyseus_message_cursor_init(&msg, data, length);
+ *   int64_t x;
+ *   if (colyseus_message_cursor_map_get_int(&msg, "x", &x)) { ... }
+ *
+ * Integers keep their wire type: unsigned encodings (including positive
+ * fixints) report UINT, signed ones INT; the int/uint/float reads accept
+ * either. Ext values report as BIN (the type byte is skipped).
+ */
+
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    size_t pos;
+    bool error;
+} colyseus_message_cursor_t;
+
+void colyseus_message_cursor_init(colyseus_message_cursor_t* cur, const uint8_t* data, size_t length);
+
+/* True once every value has been read, or on error */
+bool colyseus_message_cursor_at_end(const colyseus_message_cursor_t* cur);
+
+/* Type of the value at the cursor (NIL at end or on error) */
+colyseus_message_type_t colyseus_message_cursor_type(const colyseus_message_cursor_t* cur);
+
+/* Move past the value at the cursor, containers included */
+bool colyseus_message_cursor_skip(colyseus_message_cursor_t* cur);
+
+/* Typed reads: false (cursor unmoved) if the value has another type.
+ * Integers convert between signed and unsigned only when the value fits:
+ * read_uint() fails on a negative, read_int() on one above INT64_MAX. */
+bool colyseus_message_cursor_read_nil(colyseus_message_cursor_t* cur);
+bool colyseus_message_cursor_read_bool(colyseus_message_cursor_t* cur, bool* out);
+bool colyseus_message_cursor_read_int(colyseus_message_cursor_t* cur, int64_t* out);
+bool colyseus_message_cursor_read_uint(colyseus_message_cursor_t* cur, uint64_t* out);
+bool colyseus_message_cursor_read_float(colyseus_message_cursor_t* cur, double* out);
+bool colyseus_message_cursor_read_str(colyseus_message_cursor_t* cur, const char** out, size_t* out_len);
+bool colyseus_message_cursor_read_bin(colyseus_message_cursor_t* cur, const uint8_t** out, size_t* out_len);
+
+/* Step into a container: the cursor moves to its first element (for maps,
+ * the first key; keys and values then alternate). */
+bool colyseus_message_cursor_enter_array(colyseus_message_cursor_t* cur, size_t* out_count);
+bool colyseus_message_cursor_enter_map(colyseus_message_cursor_t* cur, size_t* out_count);
+
+/* Element `index` of the array at `array` (linear: skips the ones before) */
+bool colyseus_message_cursor_array_at(const colyseus_message_cursor_t* array, size_t index,
+                                      colyseus_message_cursor_t* out);
+
+/* Move from the map at the cursor to the value of string key `key`. Linear
+ * scan; non-string keys are skipped. The cursor is unmoved if not found. */
+bool colyseus_message_cursor_map_find(colyseus_message_cursor_t* cur, const char* key);
+
+/* Convenience lookups on the map at `map` (which is not moved) */
+bool colyseus_message_cursor_map_get_str(const colyseus_message_cursor_t* map, const char* key, const char** out_value, size_t* out_len);
+bool colyseus_message_cursor_map_get_int(const colyseus_message_cursor_t* map, const char* key, int64_t* out_value);
+bool colyseus_message_cursor_map_get_uint(const colyseus_message_cursor_t* map, const char* key, uint64_t* out_value);
+bool colyseus_message_cursor_map_get_float(const colyseus_message_cursor_t* map, const char* key, double* out_value);
+bool colyseus_message_cursor_map_get_bool(const colyseus_message_cursor_t* map, const char* key, bool* out_value);
+
+/* Optional index for maps read by many keys: one pass fills caller-owned
+ * entries (at most `capacity`, string keys only) and sorts them, after
+ * which lookups are a binary search. */
+typedef struct {
+    const char* key;
+    size_t key_len;
+    colyseus_message_cursor_t value;
+} colyseus_message_map_entry_t;
+
+size_t colyseus_message_cursor_map_index(const colyseus_message_cursor_t* map,
+                                         colyseus_message_map_entry_t* entries, size_t capacity);
+
+/* The value cursor for `key` (copy it before reading), or NULL */
+const colyseus_message_cursor_t* colyseus_message_map_index_find(const colyseus_message_map_entry_t* entries,
+                                                                 size_t count, const char* key);
+
 #ifdef __cplusplus
 }
 #endif
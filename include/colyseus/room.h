@@ -18,6 +18,8 @@ extern "C" {
 typedef struct colyseus_room colyseus_room_t;
 typedef struct colyseus_schema_serializer colyseus_schema_serializer_t;
 typedef struct colyseus_schema_vtable colyseus_schema_vtable_t;
+typedef struct colyseus_state_snapshot colyseus_state_snapshot_t;
+typedef struct colyseus_room_poll_group colyseus_room_poll_group_t;
 
 /* Room event callbacks */
 typedef void (*colyseus_room_on_join_fn)(void* userdata);
@@ -27,6 +29,15 @@ typedef void (*colyseus_room_on_leave_fn)(int code, const char* reason, void* us
 typedef void (*colyseus_room_on_drop_fn)(int code, const char* reason, void* userdata);
 typedef void (*colyseus_room_on_reconnect_fn)(void* userdata);
 
+/* What goes when the reconnection queue is over budget */
+typedef enum {
+    COLYSEUS_QUEUE_DROP_OLDEST,   /* oldest messages first (TS SDK behaviour) */
+    COLYSEUS_QUEUE_DROP_NEWEST,   /* refuse the message being sent */
+    COLYSEUS_QUEUE_DROP_BY_TYPE   /* oldest droppable-typed messages first (see
+                                   * colyseus_room_set_message_droppable), then
+                                   * the oldest of any type */
+} colyseus_queue_drop_policy_t;
+
 /* Reconnection configuration.
  *
  * Defaults match the @colyseus/sdk TypeScript SDK:
@@ -37,9 +48,20 @@ typedef void (*colyseus_room_on_reconnect_fn)(void* userdata);
  *   min_uptime_ms        5000
  *   delay_ms             100   (base delay for backoff)
  *   max_enqueued_messages 10
+ *   jitter               true
+ *   max_enqueued_bytes   65536
+ *   drop_policy          COLYSEUS_QUEUE_DROP_OLDEST
  *
  * Delay for attempt N is computed as:
  *   clamp(min_delay_ms, max_delay_ms, (1 << N) * delay_ms)
+ * With `jitter`, the lower half of that delay is randomized (never below
+ * min_delay_ms), so rooms dropped together don't retry together.
+ *
+ * Messages sent while reconnecting are copied into one buffer of
+ * max_enqueued_bytes (allocated when the first reconnection starts) and
+ * sent as one batch once the room is back. Both limits apply;
+ * max_enqueued_messages 0 means no count limit. Messages sent while that
+ * batch goes out queue behind it with no limit, and none are dropped.
  */
 typedef struct {
     bool enabled;
@@ -49,6 +71,9 @@ typedef struct {
     int min_uptime_ms;
     int delay_ms;
     int max_enqueued_messages;
+    bool jitter;
+    size_t max_enqueued_bytes;
+    colyseus_queue_drop_policy_t drop_policy;
 } colyseus_reconnection_options_t;
 
 void colyseus_reconnection_options_init_defaults(colyseus_reconnection_options_t* options);
@@ -84,13 +109,6 @@ typedef struct {
     UT_hash_handle hh;
 } colyseus_message_handler_t;
 
-/* Pending outbound message buffered while disconnected. */
-typedef struct colyseus_pending_msg {
-    uint8_t* data;
-    size_t length;
-    struct colyseus_pending_msg* next;
-} colyseus_pending_msg_t;
-
 /* Reconnection runtime state. Internal — do not modify directly. */
 typedef struct {
     colyseus_reconnection_options_t options;
@@ -98,16 +116,41 @@ typedef struct {
     bool is_reconnecting;
     bool cancelled;
 
-    /* FIFO queue of messages buffered while disconnected. */
-    colyseus_pending_msg_t* queue_head;
-    colyseus_pending_msg_t* queue_tail;
-    int queue_count;
+    /* Messages buffered while disconnected (room_msg_queue_t*) */
+    void* queue;
 
-    /* Worker thread + condvar. Defined opaquely to keep platform headers out
+    /* Retry timer + lock. Defined opaquely to keep platform headers out
      * of this public header. Implementation file allocates and casts. */
     void* worker;
 } colyseus_reconnection_state_t;
 
+/* Where the time of the last join went, in milliseconds. Phases that
+ * didn't happen are 0: resolve on a cache hit, tls for ws://, and
+ * matchmake for a direct connect or reconnect. With a pre-warmed
+ * connection, resolve / connect / tls ran during matchmaking and `total_ms`
+ * doesn't include them. */
+typedef struct {
+    uint32_t matchmake_ms;  /* seat reservation request */
+    uint32_t resolve_ms;
+    uint32_t connect_ms;    /* TCP */
+    uint32_t tls_ms;
+    uint32_t upgrade_ms;    /* WebSocket upgrade round trip */
+    uint32_t join_ms;       /* upgrade done to JOIN_ROOM */
+    uint32_t total_ms;      /* matchmaking start (or connect) to JOIN_ROOM */
+    bool prewarmed;         /* the connection was opened during matchmaking */
+} colyseus_join_timings_t;
+
+/* Connection liveness, from WebSocket pings (see
+ * colyseus_settings_set_keepalive). RTT fields stay 0 until the first pong. */
+typedef struct {
+    uint32_t rtt_us;            /* latest round trip */
+    uint32_t smoothed_rtt_us;   /* RFC 6298 smoothed round trip */
+    uint32_t jitter_us;         /* smoothed deviation from smoothed_rtt_us */
+    uint32_t last_seen_ms_ago;  /* since the server last sent anything */
+    uint64_t pings_sent;
+    uint64_t pongs_received;
+} colyseus_room_latency_t;
+
 /* Room structure */
 struct colyseus_room {
     char* name;
@@ -126,10 +169,25 @@ struct colyseus_room {
     uint64_t joined_at_ms;
     colyseus_reconnection_state_t reconnection;
 
+    /* Join timings (see colyseus_room_get_join_timings): the last
+     * completed join, and the one in progress */
+    uint64_t join_started_ms;
+    uint64_t opened_at_ms;
+    colyseus_join_timings_t join_timings;
+    colyseus_join_timings_t join_progress;
+
     /* Schema serializer */
     colyseus_schema_serializer_t* serializer;
     const colyseus_schema_vtable_t* state_vtable;
 
+    /* Opt-in state snapshots (colyseus_snapshot_publisher_t*, see schema/snapshot.h).
+     * Set once on the decode thread; read with acquire from any thread. */
+    bool state_snapshots_enabled;
+    void* state_snapshots;
+
+    /* Poll mode: transport events queued for colyseus_room_poll() (internal) */
+    void* poll_queue;
+
     /* Connection callbacks (stored for async response) */
     void (*connect_on_success)(void* userdata);
     void (*connect_on_error)(int code, const char* message, void* userdata);
@@ -154,8 +212,11 @@ struct colyseus_room {
     colyseus_room_on_reconnect_fn on_reconnect;
     void* on_reconnect_userdata;
 
-    /* Message handlers hash map */
+    /* Message handlers hash map, keyed by type (owns the handlers) */
     colyseus_message_handler_t* message_handlers;
+    /* Numeric types 0..count-1 indexed directly (entries of the hash map) */
+    colyseus_message_handler_t** int_handlers;
+    size_t int_handlers_count;
 
     /* Wildcard message handlers - default (msgpack reader) */
     colyseus_room_on_message_fn on_message_any;
@@ -186,6 +247,42 @@ void colyseus_room_set_state_type(colyseus_room_t* room, const colyseus_schema_v
 /* Get current state (returns pointer to schema state, or NULL if not available) */
 void* colyseus_room_get_state(colyseus_room_t* room);
 
+/* Publish an immutable copy-on-write snapshot of the state after every
+ * patch. Must be called before connect. */
+void colyseus_room_enable_state_snapshots(colyseus_room_t* room);
+
+/* Acquire the latest state snapshot. Safe to call from any thread; release
+ * with colyseus_state_snapshot_release(). NULL if snapshots are disabled or
+ * no patch was applied yet. */
+colyseus_state_snapshot_t* colyseus_room_acquire_state_snapshot(colyseus_room_t* room);
+
+/* Poll mode.
+ *
+ * By default, transport events are handled on the transport's network
+ * thread: schema decoding and every room callback run there. In poll mode
+ * the network thread only queues raw frames (lock-free SPSC ring per room),
+ * and colyseus_room_poll() decodes and dispatches them on the calling
+ * thread. Enable before connect; poll from a single thread (e.g. once per
+ * frame on the game thread), and don't free the room from inside its own
+ * callbacks.
+ */
+void colyseus_room_enable_poll_mode(colyseus_room_t* room);
+bool colyseus_room_is_poll_mode(const colyseus_room_t* room);
+
+/* Dispatch queued events until the queue is empty or `budget_ms` elapsed
+ * (0 = no limit). Returns the number of events dispatched. */
+int colyseus_room_poll(colyseus_room_t* room, int budget_ms);
+
+/* Poll groups: poll several poll-mode rooms with one call and a shared
+ * budget (used by colyseus_client_poll()). Rooms leave the group when
+ * freed; freeing the group leaves its rooms untouched. Callbacks run by
+ * colyseus_room_poll_group_poll() may free other rooms of the group (not
+ * the one being polled, as with colyseus_room_poll()). */
+colyseus_room_poll_group_t* colyseus_room_poll_group_create(void);
+void colyseus_room_poll_group_free(colyseus_room_poll_group_t* group);
+void colyseus_room_poll_group_add(colyseus_room_poll_group_t* group, colyseus_room_t* room);
+int colyseus_room_poll_group_poll(colyseus_room_poll_group_t* group, int budget_ms);
+
 /* Connection */
 void colyseus_room_connect(
     colyseus_room_t* room,
@@ -196,6 +293,23 @@ void colyseus_room_connect(
     void* userdata
 );
 
+/* Connect on a transport pre-warmed with colyseus_websocket_prewarm()
+ * (taking ownership of it). Falls back to a fresh connection when it can't
+ * be upgraded to `endpoint`. `started_ms` is when the join began on the
+ * colyseus_monotonic_ms() clock and `matchmake_ms` the matchmaking part of
+ * it, for the join timings. */
+void colyseus_room_connect_prewarmed(
+    colyseus_room_t* room,
+    const char* endpoint,
+    const colyseus_settings_t* settings,
+    colyseus_transport_t* prewarmed,
+    uint64_t started_ms,
+    uint32_t matchmake_ms,
+    void (*on_success)(void* userdata),
+    void (*on_error)(int code, const char* message, void* userdata),
+    void* userdata
+);
+
 void colyseus_room_leave(colyseus_room_t* room, bool consented);
 
 /* Getters/Setters */
@@ -211,6 +325,13 @@ bool colyseus_room_is_connected(const colyseus_room_t* room);
 /* "roomId:token", ready for colyseus_client_reconnect(). NULL until joined. */
 const char* colyseus_room_get_reconnection_token(const colyseus_room_t* room);
 
+/* Timings of the last join (or reconnect). False while not joined. */
+bool colyseus_room_get_join_timings(const colyseus_room_t* room, colyseus_join_timings_t* out);
+
+/* Round-trip time and last activity of the current connection. False while
+ * not connected, or on transports without pings (web). */
+bool colyseus_room_get_latency(const colyseus_room_t* room, colyseus_room_latency_t* out);
+
 /* Event handlers */
 void colyseus_room_on_join(colyseus_room_t* room, colyseus_room_on_join_fn callback, void* userdata);
 void colyseus_room_on_state_change(colyseus_room_t* room, colyseus_room_on_state_change_fn callback, void* userdata);
@@ -225,6 +346,12 @@ void colyseus_room_set_reconnection_options(colyseus_room_t* room, const colyseu
 void colyseus_room_get_reconnection_options(const colyseus_room_t* room, colyseus_reconnection_options_t* out_options);
 bool colyseus_room_is_reconnecting(const colyseus_room_t* room);
 
+/* Under COLYSEUS_QUEUE_DROP_BY_TYPE, messages of these types are the first
+ * to go when the reconnection queue is full (e.g. position updates a later
+ * one supersedes) */
+void colyseus_room_set_message_droppable(colyseus_room_t* room, const char* type, bool droppable);
+void colyseus_room_set_message_droppable_int(colyseus_room_t* room, int type, bool droppable);
+
 /* Message handlers - default (msgpack reader, auto-decoded) */
 void colyseus_room_on_message(colyseus_room_t* room, const char* type, colyseus_room_on_message_fn callback, void* userdata);
 void colyseus_room_on_message_int(colyseus_room_t* room, int type, colyseus_room_on_message_fn callback, void* userdata);
@@ -251,6 +378,14 @@ void colyseus_room_send_int(colyseus_room_t* room, int type, colyseus_message_t*
 void colyseus_room_send_encoded(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length);
 void colyseus_room_send_int_encoded(colyseus_room_t* room, int type, const uint8_t* message, size_t length);
 
+/* Send the payload of a message writer. The protocol header goes into the
+ * writer's headroom, so the transport gets one buffer and nothing is copied
+ * (types longer than the headroom fall back to a gathered send). Nothing is
+ * sent if the writer has an error. The writer is left as is: reset it to
+ * reuse the buffer. */
+void colyseus_room_send_writer(colyseus_room_t* room, const char* type, colyseus_msgwriter_t* writer);
+void colyseus_room_send_int_writer(colyseus_room_t* room, int type, colyseus_msgwriter_t* writer);
+
 /* Send raw bytes (ROOM_DATA_BYTES protocol) */
 void colyseus_room_send_bytes(colyseus_room_t* room, const char* type, const uint8_t* data, size_t length);
 void colyseus_room_send_int_bytes(colyseus_room_t* room, int type, const uint8_t* data, size_t length);
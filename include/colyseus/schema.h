@@ -130,6 +130,18 @@ void colyseus_schema_serializer_patch(colyseus_schema_serializer_t* serializer,
 void colyseus_schema_serializer_teardown(colyseus_schema_serializer_t* serializer);
 void colyseus_schema_serializer_handshake(colyseus_schema_serializer_t* serializer, const uint8_t* bytes, size_t length, int offset);
 
+/* Catch-up: apply queued patches in sequence, then trigger callbacks and GC
+ * once (see colyseus_decoder_begin_batch()) */
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+    int offset;
+} colyseus_patch_frame_t;
+
+void colyseus_schema_serializer_patch_batch(colyseus_schema_serializer_t* serializer, const colyseus_patch_frame_t* patches, int count);
+void colyseus_schema_serializer_begin_batch(colyseus_schema_serializer_t* serializer);
+void colyseus_schema_serializer_end_batch(colyseus_schema_serializer_t* serializer);
+
 /* ============================================================================
  * Vtable Registry (for complex schema hierarchies)
  * ============================================================================ */
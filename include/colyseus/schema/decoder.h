@@ -31,6 +31,16 @@ typedef struct colyseus_type_context {
 /* Callback for triggering changes after decode */
 typedef void (*colyseus_trigger_changes_fn)(colyseus_changes_t* changes, void* userdata);
 
+/* Callback invoked after a patch is fully applied (after triggers and GC),
+ * while the dirty state of the patch is still available */
+typedef void (*colyseus_decode_end_fn)(colyseus_decoder_t* decoder, void* userdata);
+
+typedef struct colyseus_decode_listener {
+    colyseus_decode_end_fn callback;
+    void* userdata;
+    struct colyseus_decode_listener* next;
+} colyseus_decode_listener_t;
+
 /* Decoder structure */
 struct colyseus_decoder {
     colyseus_ref_tracker_t* refs;
@@ -44,6 +54,12 @@ struct colyseus_decoder {
     /* Callback for triggering changes */
     colyseus_trigger_changes_fn trigger_changes;
     void* trigger_userdata;
+
+    /* Post-decode listeners (interpolation, snapshots, ...) */
+    colyseus_decode_listener_t* decode_listeners;
+
+    /* Nesting depth of colyseus_decoder_begin_batch() */
+    int batch_depth;
 };
 
 /* Type context functions */
@@ -60,9 +76,25 @@ void colyseus_decoder_free(colyseus_decoder_t* decoder);
 void colyseus_decoder_set_trigger_callback(colyseus_decoder_t* decoder, 
     colyseus_trigger_changes_fn callback, void* userdata);
 
+/* Add/remove a post-decode listener */
+void colyseus_decoder_add_decode_listener(colyseus_decoder_t* decoder,
+    colyseus_decode_end_fn callback, void* userdata);
+void colyseus_decoder_remove_decode_listener(colyseus_decoder_t* decoder,
+    colyseus_decode_end_fn callback, void* userdata);
+
 /* Decode state update */
 void colyseus_decoder_decode(colyseus_decoder_t* decoder, const uint8_t* bytes, size_t length, colyseus_iterator_t* it);
 
+/* Batched decode (catch-up after a stall).
+ *
+ * Patches decoded between begin_batch() and end_batch() only mutate the
+ * state. end_batch() then triggers callbacks, runs GC and notifies decode
+ * listeners once, with the changes merged into one net change per field /
+ * map key. Refs created and released within the batch never reach
+ * callbacks. Batches nest; only the outermost end_batch() flushes. */
+void colyseus_decoder_begin_batch(colyseus_decoder_t* decoder);
+void colyseus_decoder_end_batch(colyseus_decoder_t* decoder);
+
 /* Get current state */
 colyseus_schema_t* colyseus_decoder_get_state(colyseus_decoder_t* decoder);
 
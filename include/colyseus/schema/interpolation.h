@@ -0,0 +1,64 @@
+#ifndef COLYSEUS_SCHEMA_INTERPOLATION_H
+#define COLYSEUS_SCHEMA_INTERPOLATION_H
+
+#include "types.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Snapshot Interpolation Buffer
+ *
+ * Records selected numeric fields of every instance of one schema type
+ * (e.g. "x"/"y" of MapSchema<Player> children) into a fixed-size ring of
+ * timestamped samples, one sample per decoded patch.
+ *
+ * Storage is SoA: each channel (field) holds one contiguous float row per
+ * sample, indexed by entity slot. Sampling a channel for all entities is a
+ * single lerp loop over two rows.
+ *
+ * Samples are captured automatically after each patch, timestamped with
+ * colyseus_monotonic_ms(). Sample from the same thread that decodes patches.
+ */
+
+typedef struct colyseus_interp_buffer colyseus_interp_buffer_t;
+
+/* Create a buffer tracking `channel_count` numeric fields (by name) of all
+ * instances of `vtable`. `history` is the number of samples kept per entity
+ * (rounded up to a power of two, minimum 2). Instances already decoded are
+ * tracked from the start. Returns NULL if a field is missing or not
+ * numeric. */
+colyseus_interp_buffer_t* colyseus_interp_buffer_create(colyseus_decoder_t* decoder,
+    const colyseus_schema_vtable_t* vtable, const char* const* field_names,
+    int channel_count, int history);
+void colyseus_interp_buffer_free(colyseus_interp_buffer_t* buf);
+
+/* Record one sample at `time_ms` (done automatically after each patch) */
+void colyseus_interp_buffer_capture(colyseus_interp_buffer_t* buf, double time_ms);
+
+/* Maximum time past the newest sample to extrapolate (default: 100ms).
+ * Beyond it, values hold at the extrapolated limit. 0 disables extrapolation. */
+void colyseus_interp_buffer_set_max_extrapolation(colyseus_interp_buffer_t* buf, double ms);
+
+/* Tracked entities. Slot order is stable until an entity is removed
+ * (the last slot is moved into the freed one). */
+int colyseus_interp_buffer_get_count(colyseus_interp_buffer_t* buf);
+const int* colyseus_interp_buffer_get_ref_ids(colyseus_interp_buffer_t* buf);
+int colyseus_interp_buffer_find_slot(colyseus_interp_buffer_t* buf, int ref_id);
+
+/* Sample one channel for all entities at `render_time_ms`.
+ * `out` must hold colyseus_interp_buffer_get_count() floats. */
+void colyseus_interp_buffer_sample_channel(colyseus_interp_buffer_t* buf, int channel,
+    double render_time_ms, float* out);
+
+/* Sample all channels of a single entity. `out` must hold channel_count floats. */
+bool colyseus_interp_buffer_sample_entity(colyseus_interp_buffer_t* buf, int ref_id,
+    double render_time_ms, float* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_SCHEMA_INTERPOLATION_H */
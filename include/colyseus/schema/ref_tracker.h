@@ -30,6 +30,9 @@ typedef struct {
     int ref_count;
     colyseus_ref_type_t ref_type;
     const colyseus_schema_vtable_t* vtable;  /* For schemas, to enumerate children */
+    uint64_t dirty_fields;      /* Bit per field index (collections: per item index, see below) */
+    unsigned int dirty_gen;     /* Dirty list generation this ref was appended in */
+    unsigned int created_epoch; /* Epoch the ref was first added in */
     UT_hash_handle hh;
 } colyseus_ref_entry_t;
 
@@ -43,8 +46,43 @@ typedef struct colyseus_deleted_ref {
 struct colyseus_ref_tracker {
     colyseus_ref_entry_t* refs;         /* Hash table of refs */
     colyseus_deleted_ref_t* deleted;    /* List of refs pending deletion */
+
+    /* Dirty tracking */
+    int* dirty_refs;                    /* refIds with a non-zero dirty mask */
+    int dirty_count;
+    int dirty_capacity;
+    bool dirty_overflow;                /* A ref couldn't be listed (out of memory) */
+    unsigned int dirty_gen;             /* Bumped on every clear, invalidates entry->dirty_gen */
+    unsigned int dirty_epoch;           /* Incremented on every decoded patch */
+    bool dirty_auto_clear;              /* Clear dirty state at the start of each patch */
 };
 
+/*
+ * Dirty field tracking
+ *
+ * The decoder sets one bit per changed field on every ref it touches, and
+ * records the refId once per epoch in a flat list. Game code can mirror the
+ * state into its own structures by walking the dirty list and scanning the
+ * bits, instead of registering a callback per field.
+ *
+ * Schemas: bit N is field index N (schemas have at most 64 fields).
+ * Arrays/maps: bit N is item index N; indexes >= 63 all map to bit 63.
+ * CLEAR and REVERSE operations mark every bit.
+ *
+ * With auto-clear enabled (default), dirty state is reset when the next
+ * patch starts decoding. Disable it to accumulate across patches and call
+ * colyseus_ref_tracker_clear_dirty() yourself once consumed.
+ *
+ * The dirty list may contain refIds that were garbage-collected by the same
+ * patch; colyseus_ref_tracker_get_entry() returns NULL for those.
+ *
+ * If the list can't grow (out of memory), the masks are still set and
+ * colyseus_ref_tracker_dirty_overflowed() returns true until the next clear:
+ * the list is then incomplete and consumers must scan every entry instead.
+ */
+#define COLYSEUS_DIRTY_ALL ((uint64_t)~0ULL)
+#define COLYSEUS_DIRTY_BIT(index) ((uint64_t)1 << ((index) < 63 ? (index) : 63))
+
 /* Create/destroy tracker */
 colyseus_ref_tracker_t* colyseus_ref_tracker_create(void);
 void colyseus_ref_tracker_free(colyseus_ref_tracker_t* tracker);
@@ -71,6 +109,35 @@ void colyseus_ref_tracker_gc(colyseus_ref_tracker_t* tracker);
 /* Clear all references */
 void colyseus_ref_tracker_clear(colyseus_ref_tracker_t* tracker);
 
+/* Mark a field (schema) or item index (collection) as changed. Pass a
+ * negative index to mark every bit. */
+void colyseus_ref_tracker_mark_dirty(colyseus_ref_tracker_t* tracker, int ref_id, int index);
+
+/* Get the dirty mask of a ref (0 if clean or unknown) */
+uint64_t colyseus_ref_tracker_get_dirty_fields(colyseus_ref_tracker_t* tracker, int ref_id);
+
+/* Get refIds changed since the last clear (pointer valid until next decode/clear) */
+const int* colyseus_ref_tracker_get_dirty_refs(colyseus_ref_tracker_t* tracker, int* out_count);
+
+/* True if a changed ref is missing from the dirty list (see above) */
+bool colyseus_ref_tracker_dirty_overflowed(colyseus_ref_tracker_t* tracker);
+
+/* Reset all dirty masks and the dirty list */
+void colyseus_ref_tracker_clear_dirty(colyseus_ref_tracker_t* tracker);
+
+/* Reset the dirty mask of a single ref (stays in the dirty list until the next clear) */
+void colyseus_ref_tracker_clear_dirty_ref(colyseus_ref_tracker_t* tracker, int ref_id);
+
+/* Enable/disable clearing dirty state at the start of each patch (default: enabled) */
+void colyseus_ref_tracker_set_dirty_auto_clear(colyseus_ref_tracker_t* tracker, bool enabled);
+
+/* Called by the decoder before decoding a patch: bumps the epoch and
+ * clears dirty state if auto-clear is enabled */
+void colyseus_ref_tracker_begin_epoch(colyseus_ref_tracker_t* tracker);
+
+/* Current patch epoch (number of patches decoded) */
+unsigned int colyseus_ref_tracker_get_epoch(colyseus_ref_tracker_t* tracker);
+
 #ifdef __cplusplus
 }
 #endif
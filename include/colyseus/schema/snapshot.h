@@ -0,0 +1,64 @@
+#ifndef COLYSEUS_SCHEMA_SNAPSHOT_H
+#define COLYSEUS_SCHEMA_SNAPSHOT_H
+
+#include "types.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * State Snapshots
+ *
+ * Opt-in copy-on-write views of the decoded state, safe to read from
+ * another thread (e.g. the render thread) while the network thread keeps
+ * decoding patches.
+ *
+ * After every patch the publisher builds a new immutable version of the
+ * state tree. Refs that weren't touched by the patch (see dirty tracking in
+ * ref_tracker.h) and whose children are unchanged are shared with the
+ * previous version, so only changed paths are copied.
+ *
+ * A snapshot has the same layout as the live state: schema nodes are copies
+ * of the generated structs, ARRAY/MAP fields point to colyseus_array_schema_t
+ * / colyseus_map_schema_t copies, and REF fields point to child copies. The
+ * regular read accessors (colyseus_map_schema_get, ...) work on it. Never
+ * write to a snapshot.
+ *
+ * Readers acquire the latest version and release it when done. Acquiring
+ * is wait-free; the publisher waits for readers only while they are
+ * between loading the pointer and retaining it.
+ *
+ * Only static (code-generated) vtables are supported. Schemas using dynamic
+ * vtables are not captured (colyseus_state_snapshot_get_state() returns NULL).
+ */
+
+typedef struct colyseus_snapshot_publisher colyseus_snapshot_publisher_t;
+typedef struct colyseus_state_snapshot colyseus_state_snapshot_t;
+
+/* Attach a publisher to a decoder. A snapshot is published after each patch. */
+colyseus_snapshot_publisher_t* colyseus_snapshot_publisher_create(colyseus_decoder_t* decoder);
+void colyseus_snapshot_publisher_free(colyseus_snapshot_publisher_t* publisher);
+
+/* Build and publish a snapshot now (done automatically after each patch) */
+void colyseus_snapshot_publisher_publish(colyseus_snapshot_publisher_t* publisher);
+
+/* Acquire the latest snapshot (NULL if none published yet). Thread-safe.
+ * Must be released with colyseus_state_snapshot_release(). */
+colyseus_state_snapshot_t* colyseus_snapshot_publisher_acquire(colyseus_snapshot_publisher_t* publisher);
+
+/* Release a snapshot. May be called from any thread. */
+void colyseus_state_snapshot_release(colyseus_state_snapshot_t* snapshot);
+
+/* Root state of the snapshot (cast to your generated state type) */
+const colyseus_schema_t* colyseus_state_snapshot_get_state(const colyseus_state_snapshot_t* snapshot);
+
+/* Patch epoch the snapshot was taken at (see colyseus_ref_tracker_get_epoch) */
+unsigned int colyseus_state_snapshot_get_epoch(const colyseus_state_snapshot_t* snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_SCHEMA_SNAPSHOT_H */
@@ -3,12 +3,15 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "uthash.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+    struct colyseus_io_runtime;
+
     /* Header entry for hash map */
     typedef struct {
         char* key;
@@ -27,6 +30,25 @@ extern "C" {
         /* CA certificate chain for TLS verification (PEM format, null-terminated) */
         const unsigned char* ca_pem_data;  /* Points to certificate data (not owned) */
         size_t ca_pem_len;                  /* Length including null terminator */
+
+        /* Shared I/O threads for native transports (see io_runtime.h; not owned) */
+        struct colyseus_io_runtime* io_runtime;
+
+        /* Native transports are driven by the host's event loop (see
+         * websocket_transport.h); takes precedence over io_runtime */
+        bool external_event_loop;
+
+        /* Offer permessage-deflate (RFC 7692) in the WebSocket upgrade
+         * (native transports). Inflating one connection's messages uses at
+         * most ws_compression_max_memory bytes: window + largest message. */
+        bool ws_compression;
+        size_t ws_compression_max_memory;
+
+        /* WebSocket ping every ws_ping_interval_ms (0 = off); a connection
+         * that sends nothing back within ws_pong_timeout_ms of a ping is
+         * closed with 1006 (native transports) */
+        uint32_t ws_ping_interval_ms;
+        uint32_t ws_pong_timeout_ms;
     } colyseus_settings_t;
 
     /* Create and destroy settings */
@@ -46,6 +68,27 @@ extern "C" {
                                                const unsigned char* pem_data,
                                                size_t pem_len);
 
+    /* Run transports on a shared I/O runtime instead of one thread each
+     * (NULL restores the default). The runtime must outlive the transports. */
+    void colyseus_settings_set_io_runtime(colyseus_settings_t* settings,
+                                          struct colyseus_io_runtime* runtime);
+
+    /* Drive native transports from the host's own event loop: no transport
+     * thread, see colyseus_transport_get_fd() / colyseus_transport_on_readable() */
+    void colyseus_settings_set_external_event_loop(colyseus_settings_t* settings, bool enabled);
+
+    /* Negotiate permessage-deflate (on by default). `max_memory` caps the
+     * inflater of each connection (0 keeps the default, 16 MB); messages that
+     * would inflate past it close the connection with 1009. */
+    void colyseus_settings_set_compression(colyseus_settings_t* settings, bool enabled, size_t max_memory);
+
+    /* Ping interval and pong deadline (defaults 1000 / 2000 ms). A dead
+     * connection is noticed within about interval + timeout, instead of
+     * whenever TCP keepalive gives up. `ping_interval_ms` 0 disables pings;
+     * `pong_timeout_ms` 0 keeps the default. */
+    void colyseus_settings_set_keepalive(colyseus_settings_t* settings,
+                                         uint32_t ping_interval_ms, uint32_t pong_timeout_ms);
+
     /* Add/remove headers */
     void colyseus_settings_add_header(colyseus_settings_t* settings, const char* key, const char* value);
     void colyseus_settings_remove_header(colyseus_settings_t* settings, const char* key);
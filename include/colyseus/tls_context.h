@@ -1,6 +1,8 @@
 #ifndef COLYSEUS_TLS_CONTEXT_H
 #define COLYSEUS_TLS_CONTEXT_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <mbedtls/net_sockets.h>
 #include <mbedtls/ssl.h>
 #include <mbedtls/entropy.h>
@@ -8,14 +10,60 @@
 #include <mbedtls/x509_crt.h>
 #include <mbedtls/error.h>
 
+/*
+ * Shared client TLS configuration
+ *
+ * Parsing the CA sources (bundled Mozilla roots, system store, settings
+ * override) and seeding a DRBG used to be most of the CPU cost of a wss://
+ * connect. A configuration holds the parsed chain, the mbedtls_ssl_config
+ * and the DRBG. It is built lazily, once per (verification, override CA)
+ * combination, never modified afterwards, and reference counted; each
+ * connection only adds its own mbedtls_ssl_context. The one mutable part is
+ * the session cache below, which has its own lock.
+ */
+typedef struct colyseus_tls_config colyseus_tls_config_t;
+
+/* Take a reference on the matching configuration, building it on first
+ * use. NULL with `*out_err` set on failure. Any thread. */
+colyseus_tls_config_t* colyseus_tls_config_acquire(bool skip_verify,
+                                                   const unsigned char* ca_pem,
+                                                   size_t ca_pem_len,
+                                                   const char** out_err);
+void colyseus_tls_config_release(colyseus_tls_config_t* config);
+
+const mbedtls_ssl_config* colyseus_tls_config_get_ssl_config(const colyseus_tls_config_t* config);
+
+/* Configurations built so far (each one parsed the CA sources) */
+int colyseus_tls_config_get_build_count(void);
+
+/*
+ * Session resumption
+ *
+ * The last session negotiated with each host:port (a TLS 1.2 session ID or
+ * ticket, or a TLS 1.3 ticket) is kept in the configuration it was made
+ * with and offered on the next connect, which then skips the certificate
+ * exchange and, for TLS 1.2, the key exchange. A resumed session is not
+ * re-verified, so sessions never cross verification settings. Configurations
+ * that skip verification cache nothing.
+ */
+
+/* Offer the cached session for host:port on a fresh `ssl`. Returns true if
+ * one was set. */
+bool colyseus_tls_config_offer_session(colyseus_tls_config_t* config, const char* host,
+                                       int port, mbedtls_ssl_context* ssl);
+
+/* Remember the session of `ssl` for host:port. Call once the handshake is
+ * done (TLS 1.2) and whenever a TLS 1.3 ticket arrives. */
+void colyseus_tls_config_save_session(colyseus_tls_config_t* config, const char* host,
+                                      int port, mbedtls_ssl_context* ssl);
+
+/* Per-connection TLS state */
 typedef struct {
     mbedtls_ssl_context ssl;
-    mbedtls_ssl_config conf;
-    mbedtls_entropy_context entropy;
-    mbedtls_ctr_drbg_context ctr_drbg;
-    mbedtls_x509_crt ca_chain;  /* CA certificate chain for verification */
-    int ca_chain_initialized;   /* Whether ca_chain was initialized */
+    colyseus_tls_config_t* config;  /* one reference */
     int handshake_done;
+    int session_offered;  /* a cached session went into the ClientHello */
+    int peer_verified;    /* the server sent a certificate chain */
 } colyseus_tls_context_t;
 
-#endif /* COLYSEUS_TLS_CONTEXT_H */
\ No newline at end of file
+#endif /* COLYSEUS_TLS_CONTEXT_H */
@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,6 +16,8 @@ typedef struct colyseus_transport colyseus_transport_t;
 
 /* Transport event callbacks */
 typedef void (*colyseus_transport_on_open_fn)(void* userdata);
+/* `data` may point into the transport's receive buffer: valid only until
+ * the callback returns. */
 typedef void (*colyseus_transport_on_message_fn)(const uint8_t* data, size_t length, void* userdata);
 typedef void (*colyseus_transport_on_close_fn)(int code, const char* reason, void* userdata);
 typedef void (*colyseus_transport_on_error_fn)(const char* error, void* userdata);
@@ -27,6 +31,12 @@ typedef struct {
     void* userdata;  /* User data passed to all callbacks */
 } colyseus_transport_events_t;
 
+/* One piece of a message sent with colyseus_transport_send_parts() */
+typedef struct {
+    const uint8_t* data;
+    size_t length;
+} colyseus_transport_buf_t;
+
 /* Transport interface (vtable pattern) */
 struct colyseus_transport {
     /* Function pointers (vtable) */
@@ -36,6 +46,12 @@ struct colyseus_transport {
     void (*close)(colyseus_transport_t* transport, int code, const char* reason);
     bool (*is_open)(const colyseus_transport_t* transport);
     void (*destroy)(colyseus_transport_t* transport);
+    /* Optional: send one message given as `count` consecutive parts, without
+     * joining them first. May be NULL. */
+    void (*send_parts)(colyseus_transport_t* transport, const colyseus_transport_buf_t* parts, size_t count);
+    /* Optional: send `count` messages, one per buffer, in one go (a single
+     * vectored write where possible). May be NULL. */
+    void (*send_batch)(colyseus_transport_t* transport, const colyseus_transport_buf_t* messages, size_t count);
 
     /* Events */
     colyseus_transport_events_t events;
@@ -57,6 +73,50 @@ static inline void colyseus_transport_send(colyseus_transport_t* transport, cons
     }
 }
 
+/* Send the concatenation of `parts` as one message. Transports without
+ * send_parts get a joined copy (unless there is only one part). */
+static inline void colyseus_transport_send_parts(colyseus_transport_t* transport,
+                                                 const colyseus_transport_buf_t* parts, size_t count) {
+    if (!transport) return;
+    if (transport->send_parts) {
+        transport->send_parts(transport, parts, count);
+        return;
+    }
+    if (!transport->send) return;
+    if (count == 1) {
+        transport->send(transport, parts[0].data, parts[0].length);
+        return;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) total += parts[i].length;
+    uint8_t* joined = (uint8_t*)malloc(total ? total : 1);
+    if (!joined) return;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (parts[i].length > 0) {
+            memcpy(joined + offset, parts[i].data, parts[i].length);
+            offset += parts[i].length;
+        }
+    }
+    transport->send(transport, joined, total);
+    free(joined);
+}
+
+/* Send each of `messages` as its own message, in order. Transports
+ * without send_batch get one send() per message. */
+static inline void colyseus_transport_send_batch(colyseus_transport_t* transport,
+                                                 const colyseus_transport_buf_t* messages, size_t count) {
+    if (!transport) return;
+    if (transport->send_batch) {
+        transport->send_batch(transport, messages, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        colyseus_transport_send(transport, messages[i].data, messages[i].length);
+    }
+}
+
 static inline void colyseus_transport_send_unreliable(colyseus_transport_t* transport, const uint8_t* data, size_t length) {
     if (transport && transport->send_unreliable) {
         transport->send_unreliable(transport, data, length);
@@ -0,0 +1,42 @@
+#ifndef COLYSEUS_INFLATE_H
+#define COLYSEUS_INFLATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Raw DEFLATE (RFC 1951) decoder for permessage-deflate (RFC 7692).
+     *
+     * Each call inflates one whole message. With context takeover the last
+     * window of output is kept, so a message may reference bytes of the
+     * previous ones. Memory is the window plus the largest message and
+     * never grows past window + max_output.
+     */
+    #define COLYSEUS_INFLATE_OK          0
+    #define COLYSEUS_INFLATE_DATA_ERROR -1   /* corrupt stream */
+    #define COLYSEUS_INFLATE_TOO_BIG    -2   /* output over max_output */
+    #define COLYSEUS_INFLATE_NO_MEMORY  -3
+
+    typedef struct colyseus_inflate colyseus_inflate_t;
+
+    /* `window_bits` 8..15; `context_takeover` false drops the window after
+     * every message. */
+    colyseus_inflate_t* colyseus_inflate_create(int window_bits, bool context_takeover, size_t max_output);
+    void colyseus_inflate_free(colyseus_inflate_t* inflater);
+
+    /* Inflate one message (compressed payload without the 00 00 ff ff
+     * tail). `*out` points into the inflater and is valid until the next
+     * call. */
+    int colyseus_inflate_message(colyseus_inflate_t* inflater, const uint8_t* in, size_t in_len,
+                                 const uint8_t** out, size_t* out_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_INFLATE_H */
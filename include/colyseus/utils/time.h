@@ -11,6 +11,9 @@ extern "C" {
  * intervals; the absolute value has no defined epoch. */
 uint64_t colyseus_monotonic_ms(void);
 
+/* Same clock in microseconds, for short intervals (round-trip times) */
+uint64_t colyseus_monotonic_us(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -24,7 +24,8 @@ extern "C" {
         COLYSEUS_WS_HANDSHAKE_SENDING,
         COLYSEUS_WS_HANDSHAKE_RECEIVING,
         COLYSEUS_WS_CONNECTED,
-        COLYSEUS_WS_REMOTE_DISCONNECT
+        COLYSEUS_WS_REMOTE_DISCONNECT,
+        COLYSEUS_WS_WARM              /* pre-warmed: connected, waiting for the upgrade URL */
     } colyseus_ws_state_t;
 
     /* WebSocket transport implementation data */
@@ -39,17 +40,36 @@ extern "C" {
         void* tick_thread;  /* Thread handle (platform specific) */
         void* tls_ctx;  /* colyseus_tls_context_t* */
         const unsigned char* ca_pem_data;  /* CA certificates in PEM format */
+        void* send_queue;  /* Outbound frames from any thread (ws_send_queue_t*) */
+        void* frame_reader;  /* Inbound frame parser and receive buffer (ws_frame_reader_t*) */
+        void* io_runtime;  /* colyseus_io_runtime_t* shared I/O threads, or NULL */
+        void* io_handle;   /* colyseus_io_handle_t* while attached to io_runtime */
+        void* connector;   /* Resolution + connect attempts (ws_connector_t*) while connecting */
+        void* prewarm;     /* Upgrade handoff (ws_prewarm_t*) of a pre-warmed connection */
+        void* keepalive;   /* Pings, pong deadline and RTT (ws_keepalive_t*) */
+        void* wakeup_event; /* Windows: tick thread wakeup (WSAEVENT), also selected on the socket */
 
         /* size_t fields (8 bytes on 64-bit) */
         size_t buffer_size;
         size_t buffer_offset;
         size_t handshake_len;
         size_t ca_pem_len;           /* Length of CA PEM data */
+        size_t compression_max_memory;  /* Inflater cap per connection */
+
+        /* 8-byte fields */
+        uint64_t phase_started_ms;   /* Start of the TLS handshake / upgrade in progress */
 
         /* 4-byte fields */
         colyseus_ws_state_t state;
         int url_port;
         int socket_fd;
+        int wakeup_fds[2];           /* Tick thread wakeup: eventfd (both ends) or pipe [read, write] */
+        int wakeup_socket;           /* Windows: socket currently selected on wakeup_event */
+        uint32_t resolve_ms;         /* Last connect: host lookup (0 when cached) */
+        uint32_t connect_ms;         /* Last connect: TCP, from the first attempt */
+        uint32_t connect_attempts;   /* Last connect: addresses tried */
+        uint32_t tls_ms;             /* Last connect: TLS handshake */
+        uint32_t upgrade_ms;         /* Last connect: upgrade request to response */
 
         /* 1-byte fields */
         bool running;
@@ -59,6 +79,12 @@ extern "C" {
         char* pending_close_reason;  /* Close reason for deferred close (must free) */
         bool use_tls;                /* True for wss:// */
         bool tls_skip_verify;        /* Skip certificate verification */
+        bool io_want_write;          /* TLS handshake is blocked on a writable socket */
+        bool external_loop;          /* Driven by the host's event loop (no tick thread) */
+        bool compression;            /* Offer permessage-deflate */
+        bool tls_full_handshake;     /* TLS handshake completed with a certificate exchange */
+        bool tls_resumed;            /* TLS handshake resumed a cached session */
+        bool warm_only;              /* Pre-warming: stop before the upgrade */
     } colyseus_ws_transport_data_t;
 #endif /* !__EMSCRIPTEN__ */
 
@@ -70,6 +96,84 @@ extern "C" {
                                                    const char* url,
                                                    const colyseus_settings_t* settings);
 
+#ifndef __EMSCRIPTEN__
+    /*
+     * External event loop mode
+     *
+     * With colyseus_settings_set_external_event_loop(settings, true) the
+     * transport starts no thread. The host registers the socket in its own
+     * loop and calls the entry points below; the connect / TLS / upgrade
+     * state machine, wslay and all transport callbacks run inside them, on
+     * the host's thread. Re-query fd, interest and timeout after every entry
+     * point call and after sending (a send adds write interest).
+     */
+    #define COLYSEUS_TRANSPORT_WANT_READ  0x1
+    #define COLYSEUS_TRANSPORT_WANT_WRITE 0x2
+
+    /* Socket to watch (-1 when not connected) */
+    int colyseus_transport_get_fd(const colyseus_transport_t* transport);
+
+    /* COLYSEUS_TRANSPORT_WANT_* flags the transport is waiting for */
+    int colyseus_transport_get_interest(const colyseus_transport_t* transport);
+
+    /* Milliseconds until colyseus_transport_on_timeout() is due: -1 for no
+     * deadline, 0 when buffered data is ready without socket activity. */
+    int colyseus_transport_get_timeout_ms(const colyseus_transport_t* transport);
+
+    /* Entry points for the host loop */
+    void colyseus_transport_on_readable(colyseus_transport_t* transport);
+    void colyseus_transport_on_writable(colyseus_transport_t* transport);
+    void colyseus_transport_on_timeout(colyseus_transport_t* transport);
+
+    /* Cumulative transport counters (sample twice for rates, e.g. send
+     * syscalls per second) and timings of the last connect. Any thread. */
+    typedef struct {
+        uint64_t frames_sent;        /* data frames handed to the socket */
+        uint64_t bytes_sent;         /* data frame bytes, headers included */
+        uint64_t send_calls;         /* send() / writev() calls on the socket */
+        uint64_t messages_received;
+        uint64_t bytes_received;     /* after TLS decryption */
+        uint64_t resolve_ms;         /* last connect: host name lookup, 0 from cache */
+        uint64_t connect_ms;         /* last connect: TCP connect across all attempts */
+        uint64_t connect_attempts;   /* last connect: addresses tried */
+        uint64_t tls_full_handshakes;
+        uint64_t tls_resumed_handshakes;  /* cached session accepted by the server */
+        uint64_t tls_ms;             /* last connect: TLS handshake */
+        uint64_t upgrade_ms;         /* last connect: WebSocket upgrade round trip */
+        uint64_t pings_sent;
+        uint64_t pongs_received;
+        uint64_t rtt_us;             /* latest ping round trip, 0 before the first pong */
+        uint64_t srtt_us;            /* smoothed round trip (RFC 6298) */
+        uint64_t rtt_jitter_us;      /* smoothed deviation from srtt */
+        uint64_t last_seen_ms;       /* colyseus_monotonic_ms() of the last bytes received */
+    } colyseus_transport_stats_t;
+
+    void colyseus_transport_get_stats(const colyseus_transport_t* transport,
+                                      colyseus_transport_stats_t* out);
+
+    /*
+     * Pre-warming
+     *
+     * Resolve, connect and (for wss://) complete the TLS handshake with the
+     * host of `url` ahead of time, then wait. colyseus_websocket_upgrade()
+     * later sends the upgrade for the real URL on that connection, so only
+     * one round trip is left. The transport's events are replaced at the
+     * upgrade; until then it reports nothing. Not available with an
+     * external event loop. Returns false if the connect couldn't start.
+     */
+    bool colyseus_websocket_prewarm(colyseus_transport_t* transport,
+                                    const char* url,
+                                    const colyseus_settings_t* settings);
+
+    /* Upgrade a pre-warmed transport to `url` and deliver `events` from now
+     * on. Returns false, leaving the transport unused, if `url` is on
+     * another scheme / host / port or the warm connection was lost: destroy
+     * it and connect a new one. Any thread, once. */
+    bool colyseus_websocket_upgrade(colyseus_transport_t* transport,
+                                    const char* url,
+                                    const colyseus_transport_events_t* events);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -347,6 +347,8 @@ void gdext_colyseus_room_is_reconnecting(void* p_method_userdata, GDExtensionCla
  *   min_uptime_ms: int
  *   delay_ms: int
  *   max_enqueued_messages: int
+ *   jitter: bool
+ *   max_enqueued_bytes: int
  */
 void gdext_colyseus_room_set_reconnection_options(void* p_method_userdata, GDExtensionClassInstancePtr p_instance,
     const GDExtensionConstVariantPtr* p_args, GDExtensionInt p_argument_count,
@@ -408,6 +410,10 @@ void gdext_colyseus_room_set_reconnection_options(void* p_method_userdata, GDExt
     READ_INT_FIELD("min_uptime_ms", opts.min_uptime_ms);
     READ_INT_FIELD("delay_ms", opts.delay_ms);
     READ_INT_FIELD("max_enqueued_messages", opts.max_enqueued_messages);
+    READ_BOOL_FIELD("jitter", opts.jitter);
+    int max_enqueued_bytes = (int)opts.max_enqueued_bytes;
+    READ_INT_FIELD("max_enqueued_bytes", max_enqueued_bytes);
+    if (max_enqueued_bytes >= 0) opts.max_enqueued_bytes = (size_t)max_enqueued_bytes;
 
     #undef READ_INT_FIELD
     #undef READ_BOOL_FIELD
@@ -1,9 +1,14 @@
 #include "colyseus/client.h"
+#include "colyseus/websocket_transport.h"
+#include "colyseus/utils/time.h"
+#include "utils/spinlock.h"
+#include "utils/timers.h"
 #include "sds.h"
 #include "cJSON.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
 /* Platform-specific threading */
 #ifdef __EMSCRIPTEN__
@@ -18,222 +23,469 @@
     #define THREAD_CALL
 #endif
 
-/* ── HTTP worker (threaded on native, inline on Emscripten) ────── */
+/* ── HTTP request pool (threaded on native, inline on Emscripten) ── */
 
 /* Task node in the queue */
 typedef struct http_task {
+    uint64_t id;
     colyseus_http_t* http;
+    colyseus_http_method_t method;
     char* path;
     char* body;
+    colyseus_http_priority_t priority;
+    uint64_t deadline_ms;  /* 0 = no timeout */
     void (*on_success)(const colyseus_http_response_t*, void*);
     void (*on_error)(const colyseus_http_error_t*, void*);
+    void (*on_discard)(void*);  /* dropped unanswered (cancelled, or the client is freed) */
     void* userdata;
+    struct http_pool* pool;
+    bool delivering;  /* its callback is running */
+    bool abandoned;   /* timed out or cancelled while running */
     struct http_task* next;
 } http_task_t;
 
+static void http_task_free(http_task_t* task) {
+    free(task->path);
+    free(task->body);
+    free(task);
+}
+
+/* Execute the request (blocking on native) */
+static void http_task_run(http_task_t* task,
+                          void (*on_success)(const colyseus_http_response_t*, void*),
+                          void (*on_error)(const colyseus_http_error_t*, void*),
+                          void* userdata) {
+    switch (task->method) {
+        case COLYSEUS_HTTP_GET:
+            colyseus_http_get(task->http, task->path, on_success, on_error, userdata);
+            break;
+        case COLYSEUS_HTTP_POST:
+            colyseus_http_post(task->http, task->path, task->body, on_success, on_error, userdata);
+            break;
+        case COLYSEUS_HTTP_PUT:
+            colyseus_http_put(task->http, task->path, task->body, on_success, on_error, userdata);
+            break;
+        case COLYSEUS_HTTP_DELETE:
+            colyseus_http_delete(task->http, task->path, on_success, on_error, userdata);
+            break;
+        case COLYSEUS_HTTP_PATCH:
+            colyseus_http_patch(task->http, task->path, task->body, on_success, on_error, userdata);
+            break;
+    }
+}
+
+#define HTTP_POOL_DEFAULT_WORKERS 4
+#define HTTP_POOL_IDLE_MS 5000  /* idle workers exit after this long */
+#define HTTP_PRIORITY_COUNT 3
+
 #ifdef __EMSCRIPTEN__
 /*
  * Emscripten: no worker thread needed. emscripten_fetch() is async –
  * calling colyseus_http_post() fires the request and returns immediately.
- * The browser event loop delivers the response callback later.
+ * The browser event loop delivers the response callback later, so there
+ * is nothing to prioritize, cancel or time out here.
  */
-typedef struct {
-    bool running;
-} http_worker_t;
+typedef struct http_pool {
+    uint64_t next_id;
+    uint32_t matchmake_timeout_ms;
+} http_pool_t;
 
-static http_worker_t* http_worker_create(void) {
-    http_worker_t* w = malloc(sizeof(http_worker_t));
-    if (!w) return NULL;
-    w->running = true;
-    return w;
+static http_pool_t* http_pool_create(void) {
+    return calloc(1, sizeof(http_pool_t));
 }
 
-static void http_worker_enqueue(http_worker_t* w, http_task_t* task) {
-    (void)w;
-    colyseus_http_post(task->http, task->path, task->body,
-                       task->on_success, task->on_error, task->userdata);
-    free(task->path);
-    free(task->body);
-    free(task);
+static uint64_t http_pool_enqueue(http_pool_t* p, http_task_t* task) {
+    task->id = ++p->next_id;
+    http_task_run(task, task->on_success, task->on_error, task->userdata);
+    uint64_t id = task->id;
+    http_task_free(task);
+    return id;
 }
 
-static void http_worker_free(http_worker_t* w) {
-    free(w);
+static bool http_pool_cancel(http_pool_t* p, uint64_t id) {
+    (void)p;
+    (void)id;
+    return false;
 }
 
-#else /* Native platforms – threaded worker */
+static void http_pool_set_max_workers(http_pool_t* p, int max_workers) {
+    (void)p;
+    (void)max_workers;
+}
 
-/* Worker state – one per client */
-typedef struct {
+static void http_pool_free(http_pool_t* p) {
+    free(p);
+}
+
+#else /* Native platforms – bounded pool of worker threads */
+
+/*
+ * Up to `max_workers` threads run requests at once, highest priority
+ * first (FIFO within a priority), so a matchmaking request never waits
+ * behind a queue of slow API calls. Workers start on demand and exit after
+ * HTTP_POOL_IDLE_MS without work.
+ *
+ * A blocking request can't be interrupted: when one times out or is
+ * cancelled while running, its callbacks are suppressed and the worker is
+ * written off as stalled (another may start in its place) until the
+ * request returns. Deadlines are enforced by a blocking timer on the
+ * shared wheel (utils/timers.h), armed for the earliest one.
+ */
+typedef struct http_pool {
 #ifdef _WIN32
-    HANDLE thread;
     CRITICAL_SECTION mutex;
-    CONDITION_VARIABLE cond;
+    CONDITION_VARIABLE work_cond;   /* workers: a task was queued */
+    CONDITION_VARIABLE done_cond;   /* free: a thread exited */
 #else
-    pthread_t thread;
     pthread_mutex_t mutex;
-    pthread_cond_t cond;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
 #endif
-    http_task_t* head;  /* queue head */
-    http_task_t* tail;  /* queue tail */
-    bool running;
-    bool started;
-} http_worker_t;
-
-static thread_return_t THREAD_CALL http_worker_func(void* arg);
-
-static http_worker_t* http_worker_create(void) {
-    http_worker_t* w = malloc(sizeof(http_worker_t));
-    if (!w) return NULL;
-    memset(w, 0, sizeof(http_worker_t));
-
+    http_task_t* head[HTTP_PRIORITY_COUNT];  /* queues, by priority */
+    http_task_t* tail[HTTP_PRIORITY_COUNT];
+    http_task_t* running;
+    uint64_t next_id;
+    uint32_t matchmake_timeout_ms;
+    int queued;
+    int max_workers;
+    int workers;  /* threads alive */
+    int idle;     /* waiting for work */
+    int starting; /* started, not yet looking for work */
+    int stalled;  /* blocked in an abandoned request */
+    colyseus_timer_t* timer;  /* deadlines; created with the first one */
+    uint64_t timer_due_ms;    /* deadline it is armed for, 0 if none */
+    bool running_flag;  /* false once the pool is being freed */
+} http_pool_t;
+
+static thread_return_t THREAD_CALL http_pool_worker_func(void* arg);
+static void http_pool_timer_fn(void* arg);
+
+static void http_pool_lock(http_pool_t* p) {
 #ifdef _WIN32
-    InitializeCriticalSection(&w->mutex);
-    InitializeConditionVariable(&w->cond);
+    EnterCriticalSection(&p->mutex);
 #else
-    pthread_mutex_init(&w->mutex, NULL);
-    pthread_cond_init(&w->cond, NULL);
+    pthread_mutex_lock(&p->mutex);
 #endif
-
-    w->head = NULL;
-    w->tail = NULL;
-    w->running = true;
-    w->started = false;
-    return w;
 }
 
-static void http_worker_ensure_started(http_worker_t* w) {
-    if (w->started) return;
-    w->started = true;
-
+static void http_pool_unlock(http_pool_t* p) {
 #ifdef _WIN32
-    w->thread = CreateThread(NULL, 0, http_worker_func, w, 0, NULL);
+    LeaveCriticalSection(&p->mutex);
 #else
-    pthread_create(&w->thread, NULL, http_worker_func, w);
+    pthread_mutex_unlock(&p->mutex);
 #endif
 }
 
-static void http_worker_enqueue(http_worker_t* w, http_task_t* task) {
-    task->next = NULL;
-
 #ifdef _WIN32
-    EnterCriticalSection(&w->mutex);
+typedef CONDITION_VARIABLE http_cond_t;
 #else
-    pthread_mutex_lock(&w->mutex);
+typedef pthread_cond_t http_cond_t;
 #endif
 
-    if (w->tail) {
-        w->tail->next = task;
-    } else {
-        w->head = task;
-    }
-    w->tail = task;
-
-    http_worker_ensure_started(w);
-
+static void http_pool_signal(http_cond_t* cond) {
 #ifdef _WIN32
-    WakeConditionVariable(&w->cond);
-    LeaveCriticalSection(&w->mutex);
+    WakeConditionVariable(cond);
 #else
-    pthread_cond_signal(&w->cond);
-    pthread_mutex_unlock(&w->mutex);
+    pthread_cond_signal(cond);
 #endif
 }
 
-static void http_worker_free(http_worker_t* w) {
-    if (!w) return;
+static void http_pool_broadcast(http_cond_t* cond) {
+#ifdef _WIN32
+    WakeAllConditionVariable(cond);
+#else
+    pthread_cond_broadcast(cond);
+#endif
+}
 
-    /* Signal shutdown */
+/* Wait on `cond` (lock held) for at most `timeout_ms`; negative = no limit */
+static void http_pool_wait(http_pool_t* p, http_cond_t* cond, int64_t timeout_ms) {
 #ifdef _WIN32
-    EnterCriticalSection(&w->mutex);
-    w->running = false;
-    WakeConditionVariable(&w->cond);
-    LeaveCriticalSection(&w->mutex);
+    SleepConditionVariableCS(cond, &p->mutex, timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms);
 #else
-    pthread_mutex_lock(&w->mutex);
-    w->running = false;
-    pthread_cond_signal(&w->cond);
-    pthread_mutex_unlock(&w->mutex);
+    if (timeout_ms < 0) {
+        pthread_cond_wait(cond, &p->mutex);
+        return;
+    }
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += (time_t)(timeout_ms / 1000);
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait(cond, &p->mutex, &ts);
 #endif
+}
 
-    /* Wait for thread to finish */
-    if (w->started) {
+static bool http_pool_start_thread(http_pool_t* p, thread_return_t (THREAD_CALL *func)(void*)) {
 #ifdef _WIN32
-        WaitForSingleObject(w->thread, INFINITE);
-        CloseHandle(w->thread);
+    HANDLE thread = CreateThread(NULL, 0, func, p, 0, NULL);
+    if (!thread) return false;
+    CloseHandle(thread);
 #else
-        pthread_join(w->thread, NULL);
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, func, p) != 0) return false;
+    pthread_detach(thread);
 #endif
-    }
+    return true;
+}
 
-    /* Drain remaining tasks */
-    http_task_t* t = w->head;
-    while (t) {
-        http_task_t* next = t->next;
-        free(t->path);
-        free(t->body);
-        free(t);
-        t = next;
-    }
+static http_pool_t* http_pool_create(void) {
+    http_pool_t* p = calloc(1, sizeof(http_pool_t));
+    if (!p) return NULL;
 
 #ifdef _WIN32
-    DeleteCriticalSection(&w->mutex);
+    InitializeCriticalSection(&p->mutex);
+    InitializeConditionVariable(&p->work_cond);
+    InitializeConditionVariable(&p->done_cond);
 #else
-    pthread_mutex_destroy(&w->mutex);
-    pthread_cond_destroy(&w->cond);
+    pthread_mutex_init(&p->mutex, NULL);
+    pthread_cond_init(&p->work_cond, NULL);
+    pthread_cond_init(&p->done_cond, NULL);
 #endif
 
-    free(w);
+    p->max_workers = HTTP_POOL_DEFAULT_WORKERS;
+    p->running_flag = true;
+    return p;
+}
+
+static bool http_pool_has_queued(const http_pool_t* p) {
+    for (int i = 0; i < HTTP_PRIORITY_COUNT; i++) {
+        if (p->head[i]) return true;
+    }
+    return false;
 }
 
-static thread_return_t THREAD_CALL http_worker_func(void* arg) {
-    http_worker_t* w = (http_worker_t*)arg;
+/* Lock held. Wake idle workers, and start more while there are more
+ * queued tasks than idle workers and the limit allows. */
+static void http_pool_dispatch(http_pool_t* p) {
+    if (p->queued == 0) return;
+    if (p->idle > 0) http_pool_signal(&p->work_cond);
+    while (p->queued > p->idle + p->starting && p->workers - p->stalled < p->max_workers) {
+        if (!http_pool_start_thread(p, http_pool_worker_func)) break;
+        p->workers++;
+        p->starting++;
+    }
+}
 
-    while (1) {
-        http_task_t* task = NULL;
+/* Lock held. Unlink the highest priority task. */
+static http_task_t* http_pool_take(http_pool_t* p) {
+    for (int i = 0; i < HTTP_PRIORITY_COUNT; i++) {
+        http_task_t* task = p->head[i];
+        if (!task) continue;
+        p->head[i] = task->next;
+        if (!p->head[i]) p->tail[i] = NULL;
+        task->next = NULL;
+        p->queued--;
+        return task;
+    }
+    return NULL;
+}
 
-#ifdef _WIN32
-        EnterCriticalSection(&w->mutex);
-        while (!w->head && w->running) {
-            SleepConditionVariableCS(&w->cond, &w->mutex, INFINITE);
+/* Lock held. Unlink a queued task, by id, or the first one past its
+ * deadline (id 0, `now_ms`). */
+static http_task_t* http_pool_unqueue(http_pool_t* p, uint64_t id, uint64_t now_ms) {
+    for (int i = 0; i < HTTP_PRIORITY_COUNT; i++) {
+        http_task_t* prev = NULL;
+        for (http_task_t* t = p->head[i]; t; prev = t, t = t->next) {
+            bool match = id ? t->id == id : (t->deadline_ms && t->deadline_ms <= now_ms);
+            if (!match) continue;
+            if (prev) prev->next = t->next;
+            else p->head[i] = t->next;
+            if (p->tail[i] == t) p->tail[i] = prev;
+            t->next = NULL;
+            p->queued--;
+            return t;
         }
-        if (!w->running && !w->head) {
-            LeaveCriticalSection(&w->mutex);
+    }
+    return NULL;
+}
+
+/* Lock held. Arm the deadline timer for `deadline_ms` unless it is already
+ * due sooner. */
+static void http_pool_arm_timer(http_pool_t* p, uint64_t deadline_ms) {
+    if (p->timer_due_ms && p->timer_due_ms <= deadline_ms) return;
+    if (!p->timer) {
+        p->timer = colyseus_timer_create_blocking(http_pool_timer_fn, p);
+        if (!p->timer) return;
+    }
+    uint64_t now = colyseus_monotonic_ms();
+    uint64_t delay = deadline_ms > now ? deadline_ms - now : 0;
+    if (delay > UINT32_MAX) delay = UINT32_MAX;
+    if (colyseus_timer_arm(p->timer, (uint32_t)delay)) {
+        p->timer_due_ms = deadline_ms;
+    }
+}
+
+/* Lock held. Suppress a running task's callbacks; its worker no longer
+ * counts against the limit. */
+static void http_pool_abandon(http_pool_t* p, http_task_t* task) {
+    task->abandoned = true;
+    p->stalled++;
+    http_pool_dispatch(p);
+}
+
+static uint64_t http_pool_enqueue(http_pool_t* p, http_task_t* task) {
+    task->pool = p;
+    task->next = NULL;
+    int lane = (int)task->priority;
+    if (lane < 0 || lane >= HTTP_PRIORITY_COUNT) lane = COLYSEUS_HTTP_PRIORITY_NORMAL;
+
+    http_pool_lock(p);
+    uint64_t id = task->id = ++p->next_id;
+
+    if (p->tail[lane]) {
+        p->tail[lane]->next = task;
+    } else {
+        p->head[lane] = task;
+    }
+    p->tail[lane] = task;
+    p->queued++;
+
+    if (task->deadline_ms) {
+        http_pool_arm_timer(p, task->deadline_ms);
+    }
+    http_pool_dispatch(p);
+    http_pool_unlock(p);
+    return id;
+}
+
+/* Neither callback runs for a cancelled task, so its userdata goes to
+ * on_discard (a running task's late result only ever sees the task) */
+static bool http_pool_cancel(http_pool_t* p, uint64_t id) {
+    if (id == 0) return false;
+
+    http_pool_lock(p);
+    http_task_t* task = http_pool_unqueue(p, id, 0);
+    bool cancelled = task != NULL;
+    void (*on_discard)(void*) = task ? task->on_discard : NULL;
+    void* userdata = task ? task->userdata : NULL;
+    if (!task) {
+        for (http_task_t* t = p->running; t; t = t->next) {
+            if (t->id != id) continue;
+            if (!t->delivering && !t->abandoned) {
+                http_pool_abandon(p, t);
+                cancelled = true;
+                on_discard = t->on_discard;
+                userdata = t->userdata;
+            }
             break;
         }
-        task = w->head;
-        w->head = task->next;
-        if (!w->head) w->tail = NULL;
-        LeaveCriticalSection(&w->mutex);
+    }
+    http_pool_unlock(p);
+
+    if (task) http_task_free(task);
+    if (on_discard) on_discard(userdata);
+    return cancelled;
+}
+
+static void http_pool_set_max_workers(http_pool_t* p, int max_workers) {
+    http_pool_lock(p);
+    p->max_workers = max_workers > 0 ? max_workers : 1;
+    http_pool_dispatch(p);
+    http_pool_unlock(p);
+}
+
+static void http_pool_free(http_pool_t* p) {
+    if (!p) return;
+
+    /* Drop what's queued; requests already running finish first */
+    http_pool_lock(p);
+    p->running_flag = false;
+    http_task_t* dropped = NULL;
+    http_task_t* task;
+    while ((task = http_pool_take(p))) {
+        task->next = dropped;
+        dropped = task;
+    }
+    http_pool_broadcast(&p->work_cond);
+    while (p->workers > 0) {
+        http_pool_wait(p, &p->done_cond, -1);
+    }
+    http_pool_unlock(p);
+
+    /* Waits for a running deadline callback (it sees running_flag and stops) */
+    colyseus_timer_free(p->timer);
+
+    while (dropped) {
+        task = dropped;
+        dropped = task->next;
+        if (task->on_discard) task->on_discard(task->userdata);
+        http_task_free(task);
+    }
+
+#ifdef _WIN32
+    DeleteCriticalSection(&p->mutex);
 #else
-        pthread_mutex_lock(&w->mutex);
-        while (!w->head && w->running) {
-            pthread_cond_wait(&w->cond, &w->mutex);
-        }
-        if (!w->running && !w->head) {
-            pthread_mutex_unlock(&w->mutex);
-            break;
-        }
-        task = w->head;
-        w->head = task->next;
-        if (!w->head) w->tail = NULL;
-        pthread_mutex_unlock(&w->mutex);
+    pthread_mutex_destroy(&p->mutex);
+    pthread_cond_destroy(&p->work_cond);
+    pthread_cond_destroy(&p->done_cond);
 #endif
 
-        /* Execute the HTTP request (blocking, but on this worker thread) */
-        colyseus_http_post(
-            task->http,
-            task->path,
-            task->body,
-            task->on_success,
-            task->on_error,
-            task->userdata
-        );
+    free(p);
+}
+
+/* A running task's callback may fire only if it wasn't abandoned; after
+ * this, cancellation and the timer leave it alone. */
+static bool http_pool_claim(http_task_t* task) {
+    http_pool_t* p = task->pool;
+    http_pool_lock(p);
+    bool claimed = !task->abandoned;
+    if (claimed) task->delivering = true;
+    http_pool_unlock(p);
+    return claimed;
+}
+
+static void http_pool_on_success(const colyseus_http_response_t* response, void* userdata) {
+    http_task_t* task = (http_task_t*)userdata;
+    if (http_pool_claim(task) && task->on_success) task->on_success(response, task->userdata);
+}
+
+static void http_pool_on_error(const colyseus_http_error_t* error, void* userdata) {
+    http_task_t* task = (http_task_t*)userdata;
+    if (http_pool_claim(task) && task->on_error) task->on_error(error, task->userdata);
+}
+
+static thread_return_t THREAD_CALL http_pool_worker_func(void* arg) {
+    http_pool_t* p = (http_pool_t*)arg;
+
+    http_pool_lock(p);
+    p->starting--;
+    while (p->running_flag) {
+        /* Over the limit (it was lowered, or a stalled worker came back) */
+        if (p->workers - p->stalled > p->max_workers) break;
+
+        http_task_t* task = http_pool_take(p);
+        if (!task) {
+            p->idle++;
+            http_pool_wait(p, &p->work_cond, HTTP_POOL_IDLE_MS);
+            p->idle--;
+            if (p->queued == 0) break;
+            continue;
+        }
 
-        free(task->path);
-        free(task->body);
-        free(task);
+        task->next = p->running;
+        p->running = task;
+        http_pool_unlock(p);
+
+        http_task_run(task, http_pool_on_success, http_pool_on_error, task);
+
+        http_pool_lock(p);
+        for (http_task_t** link = &p->running; *link; link = &(*link)->next) {
+            if (*link == task) {
+                *link = task->next;
+                break;
+            }
+        }
+        if (task->abandoned) p->stalled--;
+        http_task_free(task);
     }
+    p->workers--;
+    if (p->running_flag) http_pool_dispatch(p);  /* a wakeup may have been ours */
+    http_pool_signal(&p->done_cond);
+    http_pool_unlock(p);
 
 #ifdef _WIN32
     return 0;
@@ -242,8 +494,81 @@ static thread_return_t THREAD_CALL http_worker_func(void* arg) {
 #endif
 }
 
+/* Timer worker: answer requests past their deadline, then re-arm for the
+ * next one */
+static void http_pool_timer_fn(void* arg) {
+    http_pool_t* p = (http_pool_t*)arg;
+    colyseus_http_error_t timeout = { COLYSEUS_HTTP_TIMEOUT, "Request timed out" };
+
+    http_pool_lock(p);
+    p->timer_due_ms = 0;
+    while (p->running_flag) {
+        uint64_t now = colyseus_monotonic_ms();
+
+        /* Queued past its deadline: it never runs */
+        http_task_t* expired = http_pool_unqueue(p, 0, now);
+        if (expired) {
+            http_pool_unlock(p);
+            if (expired->on_error) expired->on_error(&timeout, expired->userdata);
+            http_task_free(expired);
+            http_pool_lock(p);
+            continue;
+        }
+
+        /* Running past its deadline: answer now, drop the late result */
+        http_task_t* late = NULL;
+        uint64_t next = 0;
+        for (http_task_t* t = p->running; t; t = t->next) {
+            if (!t->deadline_ms || t->delivering || t->abandoned) continue;
+            if (t->deadline_ms <= now) {
+                late = t;
+                break;
+            }
+            if (!next || t->deadline_ms < next) next = t->deadline_ms;
+        }
+        if (late) {
+            void (*on_error)(const colyseus_http_error_t*, void*) = late->on_error;
+            void* userdata = late->userdata;
+            http_pool_abandon(p, late);
+            http_pool_unlock(p);
+            if (on_error) on_error(&timeout, userdata);
+            http_pool_lock(p);
+            continue;
+        }
+
+        for (int i = 0; i < HTTP_PRIORITY_COUNT; i++) {
+            for (http_task_t* t = p->head[i]; t; t = t->next) {
+                if (t->deadline_ms && (!next || t->deadline_ms < next)) next = t->deadline_ms;
+            }
+        }
+        if (next) http_pool_arm_timer(p, next);
+        break;
+    }
+    http_pool_unlock(p);
+}
+
 #endif /* __EMSCRIPTEN__ */
 
+static http_task_t* http_task_create(colyseus_client_t* client,
+                                     colyseus_http_method_t method,
+                                     const char* path, const char* body,
+                                     colyseus_http_priority_t priority,
+                                     uint32_t timeout_ms) {
+    http_task_t* task = calloc(1, sizeof(http_task_t));
+    if (!task) return NULL;
+    task->http = client->http;
+    task->method = method;
+    task->path = strdup(path);
+    task->body = body ? strdup(body) : NULL;
+    task->priority = priority;
+    task->deadline_ms = timeout_ms ? colyseus_monotonic_ms() + timeout_ms : 0;
+    if (!task->path || (body && !task->body)) {
+        http_task_free(task);
+        return NULL;
+    }
+    return task;
+}
+
 /* ── Matchmaking ──────────────────────────────────────────────── */
 
 /* Internal context for async operations */
@@ -253,14 +578,51 @@ typedef struct {
     colyseus_client_error_callback_t on_error;
     void* userdata;
     char* reconnection_token; /* "reconnect" only; the server doesn't echo it */
+    uint64_t started_ms;
+    colyseus_transport_t* prewarmed;  /* connecting while the request runs */
 } colyseus_matchmake_context_t;
 
 static void matchmake_context_free(colyseus_matchmake_context_t* ctx) {
     if (!ctx) return;
     free(ctx->reconnection_token);
+    if (ctx->prewarmed) {
+        colyseus_transport_destroy(ctx->prewarmed);
+    }
     free(ctx);
 }
 
+/* Start the room connection while matchmaking runs. The room is on the
+ * server's WebSocket endpoint (see client_build_room_endpoint), so the
+ * host is known before the seat reservation. */
+static colyseus_transport_t* matchmake_prewarm(colyseus_client_t* client) {
+#ifndef __EMSCRIPTEN__
+    if (!client->prewarm || client->transport_factory != colyseus_websocket_transport_create ||
+        (client->settings && client->settings->external_event_loop)) {
+        return NULL;
+    }
+
+    colyseus_transport_events_t events = {0};
+    colyseus_transport_t* transport = colyseus_websocket_transport_create(&events);
+    if (!transport) return NULL;
+
+    char* base = colyseus_settings_get_websocket_endpoint(client->settings);
+    bool started = base && colyseus_websocket_prewarm(transport, base, client->settings);
+    free(base);
+    if (!started) {
+        colyseus_transport_destroy(transport);
+        return NULL;
+    }
+    return transport;
+#else
+    (void)client;
+    return NULL;
+#endif
+}
+
+static void matchmake_context_discard(void* ctx) {
+    matchmake_context_free((colyseus_matchmake_context_t*)ctx);
+}
+
 /* Internal functions */
 static void client_create_matchmake_request(
     colyseus_client_t* client,
@@ -275,10 +637,13 @@ static void client_create_matchmake_request(
 
 static void client_on_matchmake_success(const colyseus_http_response_t* response, void* userdata);
 static void client_on_matchmake_error(const colyseus_http_error_t* error, void* userdata);
+static void client_handle_matchmake_success(const colyseus_http_response_t* response, colyseus_matchmake_context_t* ctx);
+static void client_handle_matchmake_error(const colyseus_http_error_t* error, colyseus_matchmake_context_t* ctx);
 
 static void client_consume_seat_reservation(
     colyseus_client_t* client,
     const colyseus_seat_reservation_t* reservation,
+    colyseus_matchmake_context_t* ctx,
     colyseus_client_room_callback_t on_success,
     colyseus_client_error_callback_t on_error,
     void* userdata
@@ -291,6 +656,123 @@ static char* client_build_room_endpoint(
     const char* reconnection_token
 );
 
+/* ── Poll mode ────────────────────────────────────────────────── */
+
+/* Matchmaking result copied off the HTTP worker thread */
+typedef struct client_completion {
+    bool success;
+    int code;    /* HTTP status code / error code */
+    char* body;  /* response body / error message */
+    colyseus_matchmake_context_t* ctx;
+    struct client_completion* next;
+} client_completion_t;
+
+typedef struct {
+    colyseus_spinlock_t lock;
+    client_completion_t* head;
+    client_completion_t* tail;
+    colyseus_room_poll_group_t* rooms;
+} client_poll_state_t;
+
+static void client_poll_enqueue(client_poll_state_t* state, bool success,
+                                int code, const char* body,
+                                colyseus_matchmake_context_t* ctx) {
+    client_completion_t* c = malloc(sizeof(client_completion_t));
+    if (!c) {
+        if (ctx->on_error) {
+            ctx->on_error(-1, "Out of memory", ctx->userdata);
+        }
+        matchmake_context_free(ctx);
+        return;
+    }
+    c->success = success;
+    c->code = code;
+    c->body = body ? strdup(body) : NULL;
+    c->ctx = ctx;
+    c->next = NULL;
+
+    colyseus_spinlock_lock(&state->lock);
+    if (state->tail) {
+        state->tail->next = c;
+    } else {
+        state->head = c;
+    }
+    state->tail = c;
+    colyseus_spinlock_unlock(&state->lock);
+}
+
+static client_completion_t* client_poll_take_all(client_poll_state_t* state) {
+    colyseus_spinlock_lock(&state->lock);
+    client_completion_t* list = state->head;
+    state->head = NULL;
+    state->tail = NULL;
+    colyseus_spinlock_unlock(&state->lock);
+    return list;
+}
+
+static void client_poll_state_free(client_poll_state_t* state) {
+    if (!state) return;
+    client_completion_t* c = client_poll_take_all(state);
+    while (c) {
+        client_completion_t* next = c->next;
+        matchmake_context_free(c->ctx);
+        free(c->body);
+        free(c);
+        c = next;
+    }
+    colyseus_room_poll_group_free(state->rooms);
+    free(state);
+}
+
+void colyseus_client_enable_poll_mode(colyseus_client_t* client) {
+    if (!client || client->poll_state) return;
+
+    client_poll_state_t* state = calloc(1, sizeof(client_poll_state_t));
+    if (!state) return;
+    colyseus_spinlock_init(&state->lock);
+    state->rooms = colyseus_room_poll_group_create();
+    if (!state->rooms) {
+        free(state);
+        return;
+    }
+    client->poll_state = state;
+}
+
+int colyseus_client_poll(colyseus_client_t* client, int budget_ms) {
+    if (!client || !client->poll_state) return 0;
+    client_poll_state_t* state = (client_poll_state_t*)client->poll_state;
+    uint64_t start = colyseus_monotonic_ms();
+
+    /* Matchmaking results first: they create the rooms polled below. A
+     * batch is always fully dispatched so no result is left behind. */
+    int count = 0;
+    client_completion_t* c = client_poll_take_all(state);
+    while (c) {
+        client_completion_t* next = c->next;
+        if (c->success) {
+            colyseus_http_response_t response = { c->code, c->body, true };
+            client_handle_matchmake_success(&response, c->ctx);
+        } else {
+            colyseus_http_error_t error = { c->code, c->body };
+            client_handle_matchmake_error(&error, c->ctx);
+        }
+        free(c->body);
+        free(c);
+        count++;
+        c = next;
+    }
+
+    int remaining = 0;
+    if (budget_ms > 0) {
+        uint64_t elapsed = colyseus_monotonic_ms() - start;
+        if (elapsed >= (uint64_t)budget_ms) return count;
+        remaining = budget_ms - (int)elapsed;
+    }
+    return count + colyseus_room_poll_group_poll(state->rooms, remaining);
+}
+
+/* ── Client lifecycle ─────────────────────────────────────────── */
+
 /* Create client */
 colyseus_client_t* colyseus_client_create(colyseus_settings_t* settings) {
     return colyseus_client_create_with_transport(settings, colyseus_websocket_transport_create);
@@ -307,7 +789,9 @@ colyseus_client_t* colyseus_client_create_with_transport(
     client->transport_factory = transport_factory;
     client->http = colyseus_http_create(settings);
     client->auth = colyseus_auth_create(client->http);
-    client->http_worker = http_worker_create();
+    client->http_pool = http_pool_create();
+    client->poll_state = NULL;
+    client->prewarm = false;  /* opt-in: colyseus_client_set_prewarm() */
 
     return client;
 }
@@ -315,7 +799,8 @@ colyseus_client_t* colyseus_client_create_with_transport(
 void colyseus_client_free(colyseus_client_t* client) {
     if (!client) return;
 
-    http_worker_free((http_worker_t*)client->http_worker);
+    http_pool_free((http_pool_t*)client->http_pool);
+    client_poll_state_free((client_poll_state_t*)client->poll_state);
     colyseus_http_free(client->http);
     colyseus_auth_free(client->auth);
     free(client);
@@ -329,6 +814,49 @@ colyseus_auth_t* colyseus_client_get_auth(colyseus_client_t* client) {
     return client ? client->auth : NULL;
 }
 
+/* Background HTTP requests */
+uint64_t colyseus_client_http_request(
+    colyseus_client_t* client,
+    colyseus_http_method_t method,
+    const char* path,
+    const char* json_body,
+    colyseus_http_priority_t priority,
+    uint32_t timeout_ms,
+    colyseus_http_success_callback_t on_success,
+    colyseus_http_error_callback_t on_error,
+    void* userdata
+) {
+    if (!client || !client->http_pool || !path) return 0;
+
+    http_task_t* task = http_task_create(client, method, path, json_body, priority, timeout_ms);
+    if (!task) return 0;
+    task->on_success = on_success;
+    task->on_error = on_error;
+    task->userdata = userdata;
+
+    return http_pool_enqueue((http_pool_t*)client->http_pool, task);
+}
+
+bool colyseus_client_http_cancel(colyseus_client_t* client, uint64_t request_id) {
+    if (!client || !client->http_pool) return false;
+    return http_pool_cancel((http_pool_t*)client->http_pool, request_id);
+}
+
+void colyseus_client_set_http_concurrency(colyseus_client_t* client, int max_requests) {
+    if (!client || !client->http_pool) return;
+    http_pool_set_max_workers((http_pool_t*)client->http_pool, max_requests);
+}
+
+void colyseus_client_set_matchmake_timeout(colyseus_client_t* client, uint32_t timeout_ms) {
+    if (!client || !client->http_pool) return;
+    ((http_pool_t*)client->http_pool)->matchmake_timeout_ms = timeout_ms;
+}
+
+void colyseus_client_set_prewarm(colyseus_client_t* client, bool enabled) {
+    if (!client) return;
+    client->prewarm = enabled;
+}
+
 /* Matchmaking methods */
 void colyseus_client_join_or_create(
     colyseus_client_t* client,
@@ -431,25 +959,57 @@ static void client_create_matchmake_request(
     ctx->on_error = on_error;
     ctx->userdata = userdata;
     ctx->reconnection_token = reconnection_token ? strdup(reconnection_token) : NULL;
-
-    /* Enqueue on the worker thread */
-    http_task_t* task = malloc(sizeof(http_task_t));
-    task->http = client->http;
-    task->path = strdup(path);
-    task->body = strdup(options_json ? options_json : "{}");
+    ctx->started_ms = colyseus_monotonic_ms();
+    ctx->prewarmed = NULL;
+
+    /* Matchmaking goes ahead of any other queued request */
+    http_pool_t* pool = (http_pool_t*)client->http_pool;
+    http_task_t* task = http_task_create(client, COLYSEUS_HTTP_POST, path,
+                                         options_json ? options_json : "{}",
+                                         COLYSEUS_HTTP_PRIORITY_HIGH,
+                                         pool->matchmake_timeout_ms);
+    if (!task) {
+        if (on_error) {
+            on_error(-1, "Out of memory", userdata);
+        }
+        matchmake_context_free(ctx);
+        sdsfree(path);
+        return;
+    }
     task->on_success = client_on_matchmake_success;
     task->on_error = client_on_matchmake_error;
+    task->on_discard = matchmake_context_discard;
     task->userdata = ctx;
-    task->next = NULL;
 
-    http_worker_enqueue((http_worker_t*)client->http_worker, task);
+    ctx->prewarmed = matchmake_prewarm(client);
+    http_pool_enqueue(pool, task);
 
     sdsfree(path);
 }
 
 static void client_on_matchmake_success(const colyseus_http_response_t* response, void* userdata) {
     colyseus_matchmake_context_t* ctx = (colyseus_matchmake_context_t*)userdata;
+    client_poll_state_t* poll = (client_poll_state_t*)ctx->client->poll_state;
+
+    if (poll) {
+        client_poll_enqueue(poll, true, response->status_code, response->body, ctx);
+    } else {
+        client_handle_matchmake_success(response, ctx);
+    }
+}
 
+static void client_on_matchmake_error(const colyseus_http_error_t* error, void* userdata) {
+    colyseus_matchmake_context_t* ctx = (colyseus_matchmake_context_t*)userdata;
+    client_poll_state_t* poll = (client_poll_state_t*)ctx->client->poll_state;
+
+    if (poll) {
+        client_poll_enqueue(poll, false, error->code, error->message, ctx);
+    } else {
+        client_handle_matchmake_error(error, ctx);
+    }
+}
+
+static void client_handle_matchmake_success(const colyseus_http_response_t* response, colyseus_matchmake_context_t* ctx) {
     /* Parse JSON response */
     cJSON* json = cJSON_Parse(response->body);
     if (!json) {
@@ -510,16 +1070,14 @@ static void client_on_matchmake_success(const colyseus_http_response_t* response
     cJSON_Delete(json);
 
     /* Consume seat reservation */
-    client_consume_seat_reservation(ctx->client, &reservation, ctx->on_success, ctx->on_error, ctx->userdata);
+    client_consume_seat_reservation(ctx->client, &reservation, ctx, ctx->on_success, ctx->on_error, ctx->userdata);
 
     /* Cleanup */
     colyseus_seat_reservation_free(&reservation);
     matchmake_context_free(ctx);
 }
 
-static void client_on_matchmake_error(const colyseus_http_error_t* error, void* userdata) {
-    colyseus_matchmake_context_t* ctx = (colyseus_matchmake_context_t*)userdata;
-
+static void client_handle_matchmake_error(const colyseus_http_error_t* error, colyseus_matchmake_context_t* ctx) {
     if (ctx->on_error) {
         ctx->on_error(error->code, error->message, ctx->userdata);
     }
@@ -530,6 +1088,7 @@ static void client_on_matchmake_error(const colyseus_http_error_t* error, void*
 static void client_consume_seat_reservation(
     colyseus_client_t* client,
     const colyseus_seat_reservation_t* reservation,
+    colyseus_matchmake_context_t* ctx,
     colyseus_client_room_callback_t on_success,
     colyseus_client_error_callback_t on_error,
     void* userdata
@@ -546,6 +1105,11 @@ static void client_consume_seat_reservation(
     colyseus_room_set_id(room, reservation->room.room_id);
     colyseus_room_set_session_id(room, reservation->session_id);
 
+    /* Poll mode: the room's events are dispatched by colyseus_client_poll() */
+    if (client->poll_state) {
+        colyseus_room_poll_group_add(((client_poll_state_t*)client->poll_state)->rooms, room);
+    }
+
     /* Build WebSocket endpoint */
     char* endpoint = client_build_room_endpoint(
         client,
@@ -554,11 +1118,17 @@ static void client_consume_seat_reservation(
         reservation->reconnection_token
     );
 
-    /* Connect room (pass settings for TLS configuration) */
-    colyseus_room_connect(
+    /* Connect room (pass settings for TLS configuration), upgrading the
+     * connection opened during matchmaking if there is one */
+    colyseus_transport_t* prewarmed = ctx->prewarmed;
+    ctx->prewarmed = NULL;
+    colyseus_room_connect_prewarmed(
         room,
         endpoint,
         client->settings,
+        prewarmed,
+        ctx->started_ms,
+        (uint32_t)(colyseus_monotonic_ms() - ctx->started_ms),
         NULL,  /* on_success handled via room.on_join */
         on_error,
         userdata
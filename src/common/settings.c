@@ -4,6 +4,10 @@
 #include <string.h>
 #include <stdio.h>
 
+#define COLYSEUS_WS_COMPRESSION_MAX_MEMORY_DEFAULT (16 * 1024 * 1024)
+#define COLYSEUS_WS_PING_INTERVAL_DEFAULT_MS 1000
+#define COLYSEUS_WS_PONG_TIMEOUT_DEFAULT_MS  2000
+
 colyseus_settings_t* colyseus_settings_create(void) {
     colyseus_settings_t* settings = malloc(sizeof(colyseus_settings_t));
     if (!settings) return NULL;
@@ -20,6 +24,12 @@ void colyseus_settings_init(colyseus_settings_t* settings) {
     settings->headers = NULL;  /* Empty hash map */
     settings->ca_pem_data = NULL;
     settings->ca_pem_len = 0;
+    settings->io_runtime = NULL;
+    settings->external_event_loop = false;
+    settings->ws_compression = true;
+    settings->ws_compression_max_memory = COLYSEUS_WS_COMPRESSION_MAX_MEMORY_DEFAULT;
+    settings->ws_ping_interval_ms = COLYSEUS_WS_PING_INTERVAL_DEFAULT_MS;
+    settings->ws_pong_timeout_ms = COLYSEUS_WS_PONG_TIMEOUT_DEFAULT_MS;
 }
 
 void colyseus_settings_free(colyseus_settings_t* settings) {
@@ -61,6 +71,26 @@ void colyseus_settings_set_ca_certificates(colyseus_settings_t* settings,
     settings->ca_pem_len = pem_len;
 }
 
+void colyseus_settings_set_io_runtime(colyseus_settings_t* settings,
+                                      struct colyseus_io_runtime* runtime) {
+    settings->io_runtime = runtime;
+}
+
+void colyseus_settings_set_external_event_loop(colyseus_settings_t* settings, bool enabled) {
+    settings->external_event_loop = enabled;
+}
+
+void colyseus_settings_set_compression(colyseus_settings_t* settings, bool enabled, size_t max_memory) {
+    settings->ws_compression = enabled;
+    settings->ws_compression_max_memory = max_memory ? max_memory : COLYSEUS_WS_COMPRESSION_MAX_MEMORY_DEFAULT;
+}
+
+void colyseus_settings_set_keepalive(colyseus_settings_t* settings,
+                                     uint32_t ping_interval_ms, uint32_t pong_timeout_ms) {
+    settings->ws_ping_interval_ms = ping_interval_ms;
+    settings->ws_pong_timeout_ms = pong_timeout_ms ? pong_timeout_ms : COLYSEUS_WS_PONG_TIMEOUT_DEFAULT_MS;
+}
+
 void colyseus_settings_add_header(colyseus_settings_t* settings, const char* key, const char* value) {
     colyseus_header_t* header = NULL;
     HASH_FIND_STR(settings->headers, key, header);
@@ -0,0 +1,397 @@
+#include "colyseus/messages.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Cursor over msgpack bytes
+ *
+ * Nothing is parsed ahead: each call decodes the header at the cursor and
+ * moves past it. Containers are skipped by counting the values still to
+ * pass (no recursion, so deep nesting can't exhaust the stack). A cursor
+ * that hits malformed or truncated input sets `error` and stays put; every
+ * read after that fails.
+ */
+
+typedef struct {
+    colyseus_message_type_t type;
+    size_t header;      /* bytes before the payload */
+    size_t payload;     /* str / bin / ext bytes */
+    size_t count;       /* array elements / map pairs */
+    uint64_t bits;      /* int / uint / float / bool value, raw */
+} cursor_head_t;
+
+static uint64_t read_be(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+/* Decode the header at `pos` (big-endian, per the msgpack spec) */
+static bool cursor_head(const colyseus_message_cursor_t* cur, size_t pos, cursor_head_t* h) {
+    if (cur->error || pos >= cur->length) return false;
+    const uint8_t* p = cur->data + pos;
+    size_t avail = cur->length - pos;
+    uint8_t b = p[0];
+    size_t width = 0;   /* size of the length / value field after the prefix */
+
+    memset(h, 0, sizeof(*h));
+    h->header = 1;
+
+    if (b <= 0x7f) { h->type = COLYSEUS_MESSAGE_TYPE_UINT; h->bits = b; return true; }
+    if (b >= 0xe0) { h->type = COLYSEUS_MESSAGE_TYPE_INT; h->bits = (uint64_t)(int64_t)(int8_t)b; return true; }
+    if (b <= 0x8f) { h->type = COLYSEUS_MESSAGE_TYPE_MAP; h->count = b & 0x0f; return true; }
+    if (b <= 0x9f) { h->type = COLYSEUS_MESSAGE_TYPE_ARRAY; h->count = b & 0x0f; return true; }
+    if (b <= 0xbf) {
+        h->type = COLYSEUS_MESSAGE_TYPE_STR;
+        h->payload = b & 0x1f;
+        return h->payload <= avail - 1;
+    }
+
+    switch (b) {
+        case 0xc0: h->type = COLYSEUS_MESSAGE_TYPE_NIL; return true;
+        case 0xc2: case 0xc3: h->type = COLYSEUS_MESSAGE_TYPE_BOOL; h->bits = b & 1; return true;
+        case 0xc4: case 0xc5: case 0xc6: h->type = COLYSEUS_MESSAGE_TYPE_BIN; width = (size_t)1 << (b - 0xc4); break;
+        case 0xc7: case 0xc8: case 0xc9: h->type = COLYSEUS_MESSAGE_TYPE_BIN; width = (size_t)1 << (b - 0xc7); break;
+        case 0xca: h->type = COLYSEUS_MESSAGE_TYPE_FLOAT; width = 4; break;
+        case 0xcb: h->type = COLYSEUS_MESSAGE_TYPE_FLOAT; width = 8; break;
+        case 0xcc: case 0xcd: case 0xce: case 0xcf: h->type = COLYSEUS_MESSAGE_TYPE_UINT; width = (size_t)1 << (b - 0xcc); break;
+        case 0xd0: case 0xd1: case 0xd2: case 0xd3: h->type = COLYSEUS_MESSAGE_TYPE_INT; width = (size_t)1 << (b - 0xd0); break;
+        case 0xd4: case 0xd5: case 0xd6: case 0xd7: case 0xd8:
+            /* fixext: type byte + 1..16 data bytes */
+            h->type = COLYSEUS_MESSAGE_TYPE_BIN;
+            h->header = 2;
+            h->payload = (size_t)1 << (b - 0xd4);
+            return avail >= 2 && h->payload <= avail - 2;
+        case 0xd9: case 0xda: case 0xdb: h->type = COLYSEUS_MESSAGE_TYPE_STR; width = (size_t)1 << (b - 0xd9); break;
+        case 0xdc: case 0xdd: h->type = COLYSEUS_MESSAGE_TYPE_ARRAY; width = b == 0xdc ? 2 : 4; break;
+        case 0xde: case 0xdf: h->type = COLYSEUS_MESSAGE_TYPE_MAP; width = b == 0xde ? 2 : 4; break;
+        default: return false;  /* 0xc1: never used */
+    }
+
+    if (width > avail - 1) return false;
+    uint64_t v = read_be(p + 1, width);
+    h->header = 1 + width;
+
+    switch (h->type) {
+        case COLYSEUS_MESSAGE_TYPE_UINT:
+        case COLYSEUS_MESSAGE_TYPE_FLOAT:
+            h->bits = v;
+            return true;
+        case COLYSEUS_MESSAGE_TYPE_INT:
+            /* sign-extend from `width` bytes */
+            h->bits = width == 8 ? v : (uint64_t)(((int64_t)(v << (64 - 8 * width))) >> (64 - 8 * width));
+            return true;
+        case COLYSEUS_MESSAGE_TYPE_ARRAY:
+        case COLYSEUS_MESSAGE_TYPE_MAP:
+            /* every element takes at least a byte: rejects absurd counts */
+            if (v > avail - h->header) return false;
+            h->count = (size_t)v;
+            return true;
+        default:
+            break;
+    }
+
+    /* str / bin / ext */
+    if (b >= 0xc7 && b <= 0xc9) h->header++;  /* ext type byte */
+    if (h->header > avail || v > avail - h->header) return false;
+    h->payload = (size_t)v;
+    return true;
+}
+
+static bool cursor_fail(colyseus_message_cursor_t* cur) {
+    cur->error = true;
+    return false;
+}
+
+/* Header of the current value, flagging malformed input */
+static bool cursor_peek(colyseus_message_cursor_t* cur, cursor_head_t* h) {
+    if (cur->error) return false;
+    if (!cursor_head(cur, cur->pos, h)) return cursor_fail(cur);
+    return true;
+}
+
+static double cursor_float_value(const cursor_head_t* h) {
+    switch (h->type) {
+        case COLYSEUS_MESSAGE_TYPE_FLOAT:
+            if (h->header == 5) {
+                union { uint32_t i; float f; } u = { (uint32_t)h->bits };
+                return (double)u.f;
+            } else {
+                union { uint64_t i; double d; } u = { h->bits };
+                return u.d;
+            }
+        case COLYSEUS_MESSAGE_TYPE_INT: return (double)(int64_t)h->bits;
+        case COLYSEUS_MESSAGE_TYPE_UINT: return (double)h->bits;
+        default: return 0;
+    }
+}
+
+/* ── Navigation ────────────────────────────────────────────────── */
+
+void colyseus_message_cursor_init(colyseus_message_cursor_t* cur, const uint8_t* data, size_t length) {
+    if (!cur) return;
+    cur->data = data;
+    cur->length = data ? length : 0;
+    cur->pos = 0;
+    cur->error = false;
+}
+
+bool colyseus_message_cursor_at_end(const colyseus_message_cursor_t* cur) {
+    return !cur || cur->error || cur->pos >= cur->length;
+}
+
+colyseus_message_type_t colyseus_message_cursor_type(const colyseus_message_cursor_t* cur) {
+    cursor_head_t h;
+    if (!cur || !cursor_head(cur, cur->pos, &h)) return COLYSEUS_MESSAGE_TYPE_NIL;
+    return h.type;
+}
+
+bool colyseus_message_cursor_skip(colyseus_message_cursor_t* cur) {
+    if (!cur || cur->error) return false;
+    size_t pos = cur->pos;
+    size_t pending = 1;
+    while (pending > 0) {
+        cursor_head_t h;
+        if (!cursor_head(cur, pos, &h)) return cursor_fail(cur);
+        pos += h.header + h.payload;
+        pending--;
+        if (h.type == COLYSEUS_MESSAGE_TYPE_ARRAY) {
+            pending += h.count;
+        } else if (h.type == COLYSEUS_MESSAGE_TYPE_MAP) {
+            if (h.count > SIZE_MAX / 2 - pending) return cursor_fail(cur);
+            pending += 2 * h.count;
+        }
+    }
+    cur->pos = pos;
+    return true;
+}
+
+bool colyseus_message_cursor_enter_array(colyseus_message_cursor_t* cur, size_t* out_count) {
+    cursor_head_t h;
+    if (out_count) *out_count = 0;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_ARRAY) return false;
+    cur->pos += h.header;
+    if (out_count) *out_count = h.count;
+    return true;
+}
+
+bool colyseus_message_cursor_enter_map(colyseus_message_cursor_t* cur, size_t* out_count) {
+    cursor_head_t h;
+    if (out_count) *out_count = 0;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_MAP) return false;
+    cur->pos += h.header;
+    if (out_count) *out_count = h.count;
+    return true;
+}
+
+bool colyseus_message_cursor_array_at(const colyseus_message_cursor_t* array, size_t index,
+                                      colyseus_message_cursor_t* out) {
+    if (!array || !out) return false;
+    *out = *array;
+    size_t count = 0;
+    if (!colyseus_message_cursor_enter_array(out, &count) || index >= count) return false;
+    for (size_t i = 0; i < index; i++) {
+        if (!colyseus_message_cursor_skip(out)) return false;
+    }
+    return true;
+}
+
+/* Is the value at `pos` the string `key`? */
+static bool cursor_key_equals(const colyseus_message_cursor_t* cur, const cursor_head_t* h, size_t pos,
+                              const char* key, size_t key_len) {
+    return h->type == COLYSEUS_MESSAGE_TYPE_STR && h->payload == key_len &&
+           memcmp(cur->data + pos + h->header, key, key_len) == 0;
+}
+
+bool colyseus_message_cursor_map_find(colyseus_message_cursor_t* cur, const char* key) {
+    if (!cur || !key) return false;
+    colyseus_message_cursor_t it = *cur;
+    size_t count = 0;
+    if (!colyseus_message_cursor_enter_map(&it, &count)) {
+        cur->error = it.error;
+        return false;
+    }
+    size_t key_len = strlen(key);
+    for (size_t i = 0; i < count; i++) {
+        cursor_head_t h;
+        if (!cursor_peek(&it, &h)) break;
+        bool match = cursor_key_equals(&it, &h, it.pos, key, key_len);
+        if (!colyseus_message_cursor_skip(&it)) break;  /* the key */
+        if (match) {
+            *cur = it;
+            return true;
+        }
+        if (!colyseus_message_cursor_skip(&it)) break;  /* its value */
+    }
+    cur->error = it.error;
+    return false;
+}
+
+/* ── Typed reads ───────────────────────────────────────────────── */
+
+bool colyseus_message_cursor_read_nil(colyseus_message_cursor_t* cur) {
+    cursor_head_t h;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_NIL) return false;
+    cur->pos += h.header;
+    return true;
+}
+
+bool colyseus_message_cursor_read_bool(colyseus_message_cursor_t* cur, bool* out) {
+    cursor_head_t h;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_BOOL) return false;
+    if (out) *out = h.bits != 0;
+    cur->pos += h.header;
+    return true;
+}
+
+bool colyseus_message_cursor_read_int(colyseus_message_cursor_t* cur, int64_t* out) {
+    cursor_head_t h;
+    if (!cur || !cursor_peek(cur, &h)) return false;
+    if (h.type == COLYSEUS_MESSAGE_TYPE_INT) {
+        if (out) *out = (int64_t)h.bits;
+    } else if (h.type == COLYSEUS_MESSAGE_TYPE_UINT && h.bits <= INT64_MAX) {
+        if (out) *out = (int64_t)h.bits;
+    } else {
+        return false;
+    }
+    cur->pos += h.header;
+    return true;
+}
+
+bool colyseus_message_cursor_read_uint(colyseus_message_cursor_t* cur, uint64_t* out) {
+    cursor_head_t h;
+    if (!cur || !cursor_peek(cur, &h)) return false;
+    if (h.type == COLYSEUS_MESSAGE_TYPE_UINT) {
+        if (out) *out = h.bits;
+    } else if (h.type == COLYSEUS_MESSAGE_TYPE_INT && (int64_t)h.bits >= 0) {
+        if (out) *out = h.bits;
+    } else {
+        return false;
+    }
+    cur->pos += h.header;
+    return true;
+}
+
+bool colyseus_message_cursor_read_float(colyseus_message_cursor_t* cur, double* out) {
+    cursor_head_t h;
+    if (!cur || !cursor_peek(cur, &h)) return false;
+    if (h.type != COLYSEUS_MESSAGE_TYPE_FLOAT && h.type != COLYSEUS_MESSAGE_TYPE_INT &&
+        h.type != COLYSEUS_MESSAGE_TYPE_UINT) {
+        return false;
+    }
+    if (out) *out = cursor_float_value(&h);
+    cur->pos += h.header;
+    return true;
+}
+
+bool colyseus_message_cursor_read_str(colyseus_message_cursor_t* cur, const char** out, size_t* out_len) {
+    cursor_head_t h;
+    if (out) *out = NULL;
+    if (out_len) *out_len = 0;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_STR) return false;
+    if (out) *out = (const char*)cur->data + cur->pos + h.header;
+    if (out_len) *out_len = h.payload;
+    cur->pos += h.header + h.payload;
+    return true;
+}
+
+bool colyseus_message_cursor_read_bin(colyseus_message_cursor_t* cur, const uint8_t** out, size_t* out_len) {
+    cursor_head_t h;
+    if (out) *out = NULL;
+    if (out_len) *out_len = 0;
+    if (!cur || !cursor_peek(cur, &h) || h.type != COLYSEUS_MESSAGE_TYPE_BIN) return false;
+    if (out) *out = cur->data + cur->pos + h.header;
+    if (out_len) *out_len = h.payload;
+    cur->pos += h.header + h.payload;
+    return true;
+}
+
+/* ── Map shortcuts ─────────────────────────────────────────────── */
+
+bool colyseus_message_cursor_map_get_int(const colyseus_message_cursor_t* map, const char* key, int64_t* out) {
+    if (!map) return false;
+    colyseus_message_cursor_t v = *map;
+    return colyseus_message_cursor_map_find(&v, key) && colyseus_message_cursor_read_int(&v, out);
+}
+
+bool colyseus_message_cursor_map_get_uint(const colyseus_message_cursor_t* map, const char* key, uint64_t* out) {
+    if (!map) return false;
+    colyseus_message_cursor_t v = *map;
+    return colyseus_message_cursor_map_find(&v, key) && colyseus_message_cursor_read_uint(&v, out);
+}
+
+bool colyseus_message_cursor_map_get_float(const colyseus_message_cursor_t* map, const char* key, double* out) {
+    if (!map) return false;
+    colyseus_message_cursor_t v = *map;
+    return colyseus_message_cursor_map_find(&v, key) && colyseus_message_cursor_read_float(&v, out);
+}
+
+bool colyseus_message_cursor_map_get_bool(const colyseus_message_cursor_t* map, const char* key, bool* out) {
+    if (!map) return false;
+    colyseus_message_cursor_t v = *map;
+    return colyseus_message_cursor_map_find(&v, key) && colyseus_message_cursor_read_bool(&v, out);
+}
+
+bool colyseus_message_cursor_map_get_str(const colyseus_message_cursor_t* map, const char* key,
+                                         const char** out, size_t* out_len) {
+    if (!map) return false;
+    colyseus_message_cursor_t v = *map;
+    return colyseus_message_cursor_map_find(&v, key) && colyseus_message_cursor_read_str(&v, out, out_len);
+}
+
+/* ── Map index ─────────────────────────────────────────────────── */
+
+static int index_entry_cmp(const char* a, size_t a_len, const char* b, size_t b_len) {
+    if (a_len != b_len) return a_len < b_len ? -1 : 1;
+    return memcmp(a, b, a_len);
+}
+
+static int index_entry_qsort_cmp(const void* a, const void* b) {
+    const colyseus_message_map_entry_t* x = (const colyseus_message_map_entry_t*)a;
+    const colyseus_message_map_entry_t* y = (const colyseus_message_map_entry_t*)b;
+    return index_entry_cmp(x->key, x->key_len, y->key, y->key_len);
+}
+
+size_t colyseus_message_cursor_map_index(const colyseus_message_cursor_t* map,
+                                         colyseus_message_map_entry_t* entries, size_t capacity) {
+    if (!map || !entries) return 0;
+    colyseus_message_cursor_t it = *map;
+    size_t count = 0;
+    if (!colyseus_message_cursor_enter_map(&it, &count)) return 0;
+
+    size_t n = 0;
+    for (size_t i = 0; i < count && n < capacity; i++) {
+        cursor_head_t h;
+        if (!cursor_peek(&it, &h)) break;
+        if (h.type == COLYSEUS_MESSAGE_TYPE_STR) {
+            entries[n].key = (const char*)it.data + it.pos + h.header;
+            entries[n].key_len = h.payload;
+        }
+        if (!colyseus_message_cursor_skip(&it)) break;
+        if (h.type == COLYSEUS_MESSAGE_TYPE_STR) {
+            entries[n].value = it;
+            n++;
+        }
+        if (!colyseus_message_cursor_skip(&it)) {
+            if (h.type == COLYSEUS_MESSAGE_TYPE_STR) n--;
+            break;
+        }
+    }
+    qsort(entries, n, sizeof(*entries), index_entry_qsort_cmp);
+    return n;
+}
+
+const colyseus_message_cursor_t* colyseus_message_map_index_find(const colyseus_message_map_entry_t* entries,
+                                                                 size_t count, const char* key) {
+    if (!entries || !key) return NULL;
+    size_t key_len = strlen(key);
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int c = index_entry_cmp(entries[mid].key, entries[mid].key_len, key, key_len);
+        if (c == 0) return &entries[mid].value;
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
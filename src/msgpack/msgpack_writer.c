@@ -0,0 +1,208 @@
+#include "colyseus/messages.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Streaming msgpack writer
+ *
+ * Values are encoded straight into the buffer, in the smallest msgpack form
+ * (non-negative integers as unsigned, like the JavaScript encoders do).
+ * The first COLYSEUS_MSGWRITER_HEADROOM bytes are left free so the room can
+ * put the protocol byte and message type in front of the payload and send
+ * it as one buffer.
+ */
+
+#define MSGWRITER_INITIAL_CAPACITY 256
+
+void colyseus_msgwriter_init(colyseus_msgwriter_t* w, uint8_t* buffer, size_t capacity) {
+    if (!w) return;
+    w->buf = buffer;
+    w->capacity = buffer ? capacity : 0;
+    w->length = 0;
+    w->owned = false;
+    w->error = buffer != NULL && capacity < COLYSEUS_MSGWRITER_HEADROOM;
+}
+
+void colyseus_msgwriter_reset(colyseus_msgwriter_t* w) {
+    if (!w) return;
+    w->length = 0;
+    w->error = w->buf != NULL && w->capacity < COLYSEUS_MSGWRITER_HEADROOM;
+}
+
+void colyseus_msgwriter_free(colyseus_msgwriter_t* w) {
+    if (!w) return;
+    if (w->owned) free(w->buf);
+    w->buf = NULL;
+    w->capacity = 0;
+    w->length = 0;
+    w->owned = false;
+    w->error = false;
+}
+
+const uint8_t* colyseus_msgwriter_data(const colyseus_msgwriter_t* w, size_t* out_len) {
+    if (out_len) *out_len = 0;
+    if (!w || w->error || !w->buf) return NULL;
+    if (out_len) *out_len = w->length;
+    return w->buf + COLYSEUS_MSGWRITER_HEADROOM;
+}
+
+bool colyseus_msgwriter_ok(const colyseus_msgwriter_t* w) {
+    return w && !w->error;
+}
+
+/* Room for `n` more payload bytes; NULL (and the error flag) if a caller
+ * buffer is full or growing fails */
+static uint8_t* msgwriter_reserve(colyseus_msgwriter_t* w, size_t n) {
+    if (w->error) return NULL;
+    size_t used = COLYSEUS_MSGWRITER_HEADROOM + w->length;
+    if (w->buf && n <= w->capacity - used) return w->buf + used;
+
+    if (w->buf && !w->owned) {
+        w->error = true;
+        return NULL;
+    }
+    size_t capacity = w->capacity ? w->capacity : MSGWRITER_INITIAL_CAPACITY;
+    while (n > capacity - used) {
+        if (capacity > SIZE_MAX / 2) {
+            w->error = true;
+            return NULL;
+        }
+        capacity *= 2;
+    }
+    uint8_t* buf = realloc(w->buf, capacity);
+    if (!buf) {
+        w->error = true;
+        return NULL;
+    }
+    w->buf = buf;
+    w->capacity = capacity;
+    w->owned = true;
+    return w->buf + used;
+}
+
+/* Prefix byte followed by `width` big-endian bytes of `value` */
+static void msgwriter_put_be(colyseus_msgwriter_t* w, uint8_t prefix, uint64_t value, size_t width) {
+    uint8_t* p = msgwriter_reserve(w, 1 + width);
+    if (!p) return;
+    p[0] = prefix;
+    for (size_t i = 0; i < width; i++) {
+        p[width - i] = (uint8_t)(value >> (8 * i));
+    }
+    w->length += 1 + width;
+}
+
+/* Header for a str / bin of `n` bytes: `fix` is the fix-form base (0 if
+ * none) and `base` the 8-bit form, followed by the 16 and 32-bit ones */
+static void msgwriter_put_length(colyseus_msgwriter_t* w, uint8_t fix, uint8_t base, size_t n) {
+    if (fix && n <= 31) msgwriter_put_be(w, (uint8_t)(fix | n), 0, 0);
+    else if (n <= UINT8_MAX) msgwriter_put_be(w, base, n, 1);
+    else if (n <= UINT16_MAX) msgwriter_put_be(w, (uint8_t)(base + 1), n, 2);
+    else if ((uint64_t)n <= UINT32_MAX) msgwriter_put_be(w, (uint8_t)(base + 2), n, 4);
+    else w->error = true;
+}
+
+static void msgwriter_put_bytes(colyseus_msgwriter_t* w, const void* data, size_t n) {
+    if (n == 0) return;
+    uint8_t* p = msgwriter_reserve(w, n);
+    if (!p) return;
+    memcpy(p, data, n);
+    w->length += n;
+}
+
+/* ── Values ────────────────────────────────────────────────────── */
+
+void colyseus_msgwriter_nil(colyseus_msgwriter_t* w) {
+    if (w) msgwriter_put_be(w, 0xc0, 0, 0);
+}
+
+void colyseus_msgwriter_bool(colyseus_msgwriter_t* w, bool value) {
+    if (w) msgwriter_put_be(w, value ? 0xc3 : 0xc2, 0, 0);
+}
+
+void colyseus_msgwriter_uint(colyseus_msgwriter_t* w, uint64_t value) {
+    if (!w) return;
+    if (value <= 0x7f) msgwriter_put_be(w, (uint8_t)value, 0, 0);
+    else if (value <= UINT8_MAX) msgwriter_put_be(w, 0xcc, value, 1);
+    else if (value <= UINT16_MAX) msgwriter_put_be(w, 0xcd, value, 2);
+    else if (value <= UINT32_MAX) msgwriter_put_be(w, 0xce, value, 4);
+    else msgwriter_put_be(w, 0xcf, value, 8);
+}
+
+void colyseus_msgwriter_int(colyseus_msgwriter_t* w, int64_t value) {
+    if (!w) return;
+    if (value >= 0) {
+        colyseus_msgwriter_uint(w, (uint64_t)value);
+    } else if (value >= -32) {
+        msgwriter_put_be(w, (uint8_t)value, 0, 0);
+    } else if (value >= INT8_MIN) {
+        msgwriter_put_be(w, 0xd0, (uint64_t)value, 1);
+    } else if (value >= INT16_MIN) {
+        msgwriter_put_be(w, 0xd1, (uint64_t)value, 2);
+    } else if (value >= INT32_MIN) {
+        msgwriter_put_be(w, 0xd2, (uint64_t)value, 4);
+    } else {
+        msgwriter_put_be(w, 0xd3, (uint64_t)value, 8);
+    }
+}
+
+void colyseus_msgwriter_float(colyseus_msgwriter_t* w, double value) {
+    if (!w) return;
+    union { double d; uint64_t i; } u = { value };
+    msgwriter_put_be(w, 0xcb, u.i, 8);
+}
+
+void colyseus_msgwriter_float32(colyseus_msgwriter_t* w, float value) {
+    if (!w) return;
+    union { float f; uint32_t i; } u = { value };
+    msgwriter_put_be(w, 0xca, u.i, 4);
+}
+
+void colyseus_msgwriter_str_len(colyseus_msgwriter_t* w, const char* value, size_t length) {
+    if (!w) return;
+    if (!value) {
+        colyseus_msgwriter_nil(w);
+        return;
+    }
+    msgwriter_put_length(w, 0xa0, 0xd9, length);
+    msgwriter_put_bytes(w, value, length);
+}
+
+void colyseus_msgwriter_str(colyseus_msgwriter_t* w, const char* value) {
+    colyseus_msgwriter_str_len(w, value, value ? strlen(value) : 0);
+}
+
+void colyseus_msgwriter_bin(colyseus_msgwriter_t* w, const uint8_t* data, size_t length) {
+    if (!w) return;
+    if (!data && length > 0) {
+        w->error = true;
+        return;
+    }
+    msgwriter_put_length(w, 0, 0xc4, length);
+    msgwriter_put_bytes(w, data, length);
+}
+
+/* Arrays and maps have no 8-bit form: dc/dd and de/df */
+void colyseus_msgwriter_array(colyseus_msgwriter_t* w, size_t count) {
+    if (!w) return;
+    if (count <= 15) msgwriter_put_be(w, (uint8_t)(0x90 | count), 0, 0);
+    else if (count <= UINT16_MAX) msgwriter_put_be(w, 0xdc, count, 2);
+    else if ((uint64_t)count <= UINT32_MAX) msgwriter_put_be(w, 0xdd, count, 4);
+    else w->error = true;
+}
+
+void colyseus_msgwriter_map(colyseus_msgwriter_t* w, size_t count) {
+    if (!w) return;
+    if (count <= 15) msgwriter_put_be(w, (uint8_t)(0x80 | count), 0, 0);
+    else if (count <= UINT16_MAX) msgwriter_put_be(w, 0xde, count, 2);
+    else if ((uint64_t)count <= UINT32_MAX) msgwriter_put_be(w, 0xdf, count, 4);
+    else w->error = true;
+}
+
+void colyseus_msgwriter_raw(colyseus_msgwriter_t* w, const uint8_t* encoded, size_t length) {
+    if (!w) return;
+    if (!encoded && length > 0) {
+        w->error = true;
+        return;
+    }
+    msgwriter_put_bytes(w, encoded, length);
+}
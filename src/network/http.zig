@@ -56,11 +56,18 @@ const colyseus_settings_t = extern struct {
     headers: ?*colyseus_header_t,
     ca_pem_data: [*c]const u8,
     ca_pem_len: usize,
+    io_runtime: ?*anyopaque,
+    external_event_loop: bool,
+    ws_compression: bool,
+    ws_compression_max_memory: usize,
 };
 
 // External C function declarations
 extern fn colyseus_settings_get_webrequest_endpoint(settings: *const colyseus_settings_t) [*c]u8;
 
+// Shared resolver cache (src/network/resolver.c, native only)
+extern fn colyseus_resolver_prefetch(host: [*c]const u8) void;
+
 // Bundled Mozilla CA roots (src/certs/ca_bundle.c). These are C array symbols, so
 // the symbol address is the data itself — take &symbol rather than reading it as a
 // value. Used to give HTTPS matchmaking the same device-independent trust baseline
@@ -93,6 +100,7 @@ pub const colyseus_http_error_t = extern struct {
 pub const colyseus_http_t = extern struct {
     settings: *const colyseus_settings_t,
     auth_token: [*c]u8,
+    session: ?*anyopaque, // *HttpSession
 };
 
 pub const colyseus_http_success_callback_t = ?*const fn (*const colyseus_http_response_t, ?*anyopaque) callconv(.c) void;
@@ -124,9 +132,15 @@ fn freeString(alloc: Allocator, ptr: [*c]u8) void {
 
 export fn colyseus_http_create(settings: *const colyseus_settings_t) ?*colyseus_http_t {
     const http_client = allocator.create(colyseus_http_t) catch return null;
+    const session = allocator.create(HttpSession) catch {
+        allocator.destroy(http_client);
+        return null;
+    };
+    session.* = .{ .client = .{ .allocator = allocator } };
     http_client.* = .{
         .settings = settings,
         .auth_token = null,
+        .session = session,
     };
     return http_client;
 }
@@ -134,6 +148,11 @@ export fn colyseus_http_create(settings: *const colyseus_settings_t) ?*colyseus_
 export fn colyseus_http_free(http_client: ?*colyseus_http_t) void {
     if (http_client == null) return;
     const h = http_client.?;
+    if (h.session) |ptr| {
+        const session: *HttpSession = @ptrCast(@alignCast(ptr));
+        session.deinit();
+        allocator.destroy(session);
+    }
     freeString(allocator, h.auth_token);
     allocator.destroy(h);
 }
@@ -266,31 +285,215 @@ fn addCertsFromPem(cb: *std.crypto.Certificate.Bundle, gpa: Allocator, pem: []co
     }
 }
 
-// Populate the std.http.Client trust store to mirror the WSS transport: OS system
-// store (best-effort) + bundled Mozilla roots + any settings-provided override.
+// Populate a trust store to mirror the WSS transport: OS system store
+// (best-effort) + bundled Mozilla roots + any settings-provided override.
 // Without this, std.http only trusts the OS store, which is unreliable on Android
 // and can't honor certificate_bundle_override — so matchmaking HTTPS would fail
 // where the WSS connection (post-#24) succeeds.
-fn setupCaBundle(client: *http.Client, settings: *const colyseus_settings_t) void {
+fn buildCaBundle(cb: *std.crypto.Certificate.Bundle, override_pem: []const u8) void {
     // System store first (rescan clears the bundle, so it must run before we add).
     // Best-effort: on Android/missing-store this fails and we fall back to bundled.
-    client.ca_bundle.rescan(allocator) catch {};
+    cb.rescan(allocator) catch {};
 
     const bundled_ptr: [*]const u8 = @ptrCast(&colyseus_ca_bundle_pem);
     // Length includes the trailing NUL; drop it so the PEM scanner sees clean text.
     const bundled_len = if (colyseus_ca_bundle_pem_len > 0) colyseus_ca_bundle_pem_len - 1 else 0;
-    addCertsFromPem(&client.ca_bundle, allocator, bundled_ptr[0..bundled_len]) catch |err|
+    addCertsFromPem(cb, allocator, bundled_ptr[0..bundled_len]) catch |err|
         std.log.warn("Failed to add bundled CA roots for HTTPS: {}", .{err});
 
-    if (settings.ca_pem_data != null and settings.ca_pem_len > 0) {
-        const override_len = if (settings.ca_pem_len > 0) settings.ca_pem_len - 1 else 0;
-        const override_pem = settings.ca_pem_data[0..override_len];
-        addCertsFromPem(&client.ca_bundle, allocator, override_pem) catch |err|
+    if (override_pem.len > 0) {
+        addCertsFromPem(cb, allocator, override_pem) catch |err|
             std.log.warn("Failed to add override CA for HTTPS: {}", .{err});
     }
+}
+
+// Trust stores shared by every HTTPS request, like the transport's TLS
+// configurations (src/network/tls_config.c): built once per settings override
+// instead of re-parsing the system store and bundled roots on each request.
+// Requests only read them (rescans are disabled), so clients borrow the bundle
+// without copying. Reference counted; idle ones past max_idle_ca_bundles are freed.
+const SharedCaBundle = struct {
+    bundle: std.crypto.Certificate.Bundle,
+    override: []u8, // copy of the settings PEM it was built with
+    refs: usize,
+    next: ?*SharedCaBundle,
+};
+
+const max_idle_ca_bundles = 4;
+var g_ca_bundles: ?*SharedCaBundle = null; // most recently used first
+var g_ca_bundles_mutex: std.Thread.Mutex = .{};
 
-    // We populated the bundle ourselves; stop fetch() from rescanning (which clears it).
-    client.next_https_rescan_certs = false;
+fn settingsOverridePem(settings: *const colyseus_settings_t) []const u8 {
+    if (settings.ca_pem_data == null or settings.ca_pem_len == 0) return &.{};
+    return settings.ca_pem_data[0 .. settings.ca_pem_len - 1];
+}
+
+// Built under the lock: concurrent requests wait for one parse.
+fn acquireCaBundle(settings: *const colyseus_settings_t) !*SharedCaBundle {
+    const override = settingsOverridePem(settings);
+
+    g_ca_bundles_mutex.lock();
+    defer g_ca_bundles_mutex.unlock();
+
+    var link: *?*SharedCaBundle = &g_ca_bundles;
+    while (link.*) |entry| : (link = &entry.next) {
+        if (std.mem.eql(u8, entry.override, override)) {
+            link.* = entry.next;
+            entry.refs += 1;
+            entry.next = g_ca_bundles;
+            g_ca_bundles = entry;
+            return entry;
+        }
+    }
+
+    const entry = try allocator.create(SharedCaBundle);
+    errdefer allocator.destroy(entry);
+    entry.* = .{
+        .bundle = .{},
+        .override = try allocator.dupe(u8, override),
+        .refs = 1,
+        .next = g_ca_bundles,
+    };
+    buildCaBundle(&entry.bundle, override);
+    g_ca_bundles = entry;
+    return entry;
+}
+
+fn releaseCaBundle(shared: *SharedCaBundle) void {
+    var evicted: ?*SharedCaBundle = null;
+    {
+        g_ca_bundles_mutex.lock();
+        defer g_ca_bundles_mutex.unlock();
+
+        shared.refs -= 1;
+        var idle: usize = 0;
+        var link: *?*SharedCaBundle = &g_ca_bundles;
+        while (link.*) |entry| {
+            if (entry.refs == 0) {
+                idle += 1;
+                if (idle > max_idle_ca_bundles) {
+                    link.* = entry.next;
+                    entry.next = evicted;
+                    evicted = entry;
+                    continue;
+                }
+            }
+            link = &entry.next;
+        }
+    }
+
+    while (evicted) |entry| {
+        evicted = entry.next;
+        entry.bundle.deinit(allocator);
+        allocator.free(entry.override);
+        allocator.destroy(entry);
+    }
+}
+
+// One std.http.Client per colyseus_http_t, kept for its lifetime: keep-alive
+// connections go back to the client's pool and the next request to the same
+// host reuses them (no TCP or TLS handshake), and the CA bundle is attached
+// once. std.http.Client is safe to share between threads, so matchmaking on
+// the client's worker and auth calls on the caller's thread use the same pool.
+const HttpSession = struct {
+    client: http.Client,
+    ca: ?*SharedCaBundle = null, // attached on the first HTTPS request
+    mutex: std.Thread.Mutex = .{},
+
+    // Make the pooled client ready for a request with these settings. The
+    // client keeps the trust store it was first given (in-flight requests
+    // read it); false if the settings now want another one.
+    fn prepare(self: *HttpSession, settings: *const colyseus_settings_t) !bool {
+        if (comptime is_emscripten) return true;
+        if (!settings.use_secure_protocol) return true;
+
+        self.mutex.lock();
+        defer self.mutex.unlock();
+
+        if (self.ca) |shared| return std.mem.eql(u8, shared.override, settingsOverridePem(settings));
+
+        const shared = try acquireCaBundle(settings);
+        self.ca = shared;
+        self.client.ca_bundle = shared.bundle;
+        // We populated the bundle ourselves; stop fetch() from rescanning (which clears it).
+        self.client.next_https_rescan_certs = false;
+        return true;
+    }
+
+    // True if a request now would likely go out on a kept-alive connection
+    fn hasIdleConnection(self: *HttpSession) bool {
+        if (comptime is_emscripten) return false;
+        const pool = &self.client.connection_pool;
+        pool.mutex.lock();
+        defer pool.mutex.unlock();
+        return pool.free_len > 0;
+    }
+
+    fn deinit(self: *HttpSession) void {
+        if (comptime !is_emscripten) {
+            if (self.ca) |shared| {
+                // Borrowed: return it instead of letting client.deinit() free it.
+                self.client.ca_bundle = .{};
+                releaseCaBundle(shared);
+                self.ca = null;
+            }
+        }
+        self.client.deinit();
+    }
+};
+
+// A client for a single request, for when the session's can't be used
+// (the CA override changed after the first HTTPS request).
+const OneOffClient = struct {
+    client: http.Client,
+    ca: ?*SharedCaBundle = null,
+
+    fn init(self: *OneOffClient, settings: *const colyseus_settings_t) !void {
+        self.* = .{ .client = .{ .allocator = allocator } };
+        if (comptime !is_emscripten) {
+            if (settings.use_secure_protocol) {
+                const shared = try acquireCaBundle(settings);
+                self.ca = shared;
+                self.client.ca_bundle = shared.bundle;
+                self.client.next_https_rescan_certs = false;
+            }
+        }
+    }
+
+    fn deinit(self: *OneOffClient) void {
+        if (comptime !is_emscripten) {
+            if (self.ca) |shared| {
+                self.client.ca_bundle = .{};
+                releaseCaBundle(shared);
+            }
+        }
+        self.client.deinit();
+    }
+};
+
+// Errors meaning the server had already closed a kept-alive connection when
+// the request went out on it (its idle timeout raced the request).
+fn isStaleConnectionError(err: anyerror) bool {
+    return switch (err) {
+        error.ReadFailed,
+        error.WriteFailed,
+        error.EndOfStream,
+        error.ConnectionResetByPeer,
+        error.BrokenPipe,
+        error.HttpConnectionClosing,
+        => true,
+        else => false,
+    };
+}
+
+// Safe to send twice (RFC 9110 §9.2.2). fetch() doesn't tell whether a
+// failure came before or after the server read the request, so a POST
+// (e.g. matchmaking, which reserves a seat) is never retried.
+fn isIdempotent(method: http.Method) bool {
+    return switch (method) {
+        .GET, .HEAD, .PUT, .DELETE, .OPTIONS, .TRACE => true,
+        else => false,
+    };
 }
 
 fn httpRequestImpl(
@@ -313,17 +516,25 @@ fn httpRequestImpl(
 
     const base_slice = cStrToSlice(base_url) orelse return error.InvalidBaseUrl;
 
+    // A matchmaking request is followed by a WebSocket connect to the same
+    // server: have the transport's resolver look the name up meanwhile.
+    if (comptime !is_emscripten) {
+        if (h.settings.server_address != null) colyseus_resolver_prefetch(h.settings.server_address);
+    }
+
     const url = try buildUrl(allocator, base_slice, path_slice);
     defer allocator.free(url);
 
-    var client: http.Client = .{ .allocator = allocator };
-    defer client.deinit();
+    const session: *HttpSession = @ptrCast(@alignCast(h.session orelse return error.NullHttpHandle));
+    var one_off: OneOffClient = undefined;
+    var use_one_off = false;
+    defer if (use_one_off) one_off.deinit();
 
-    // Give HTTPS matchmaking the same trust roots as the WSS transport.
-    // Plain http:// never touches the CA bundle, so skip the setup cost there.
-    if (comptime !is_emscripten) {
-        if (h.settings.use_secure_protocol) setupCaBundle(&client, h.settings);
-    }
+    const client: *http.Client = if (try session.prepare(h.settings)) &session.client else blk: {
+        try one_off.init(h.settings);
+        use_one_off = true;
+        break :blk &one_off.client;
+    };
 
     var response_writer: std.Io.Writer.Allocating = .init(allocator);
     defer response_writer.deinit();
@@ -333,13 +544,23 @@ fn httpRequestImpl(
     var owned_headers = try buildHeaders(h, body_slice != null);
     defer owned_headers.deinit(allocator);
 
-    const result = try client.fetch(.{
+    const options: http.Client.FetchOptions = .{
         .location = .{ .url = url },
         .method = method,
         .payload = body_slice,
         .extra_headers = owned_headers.headers,
         .response_writer = &response_writer.writer,
-    });
+    };
+
+    // A pooled connection the server has since closed fails on first use;
+    // std.http drops it from the pool, so one retry of an idempotent
+    // request goes out on a new one.
+    const reused = !use_one_off and session.hasIdleConnection();
+    const result = client.fetch(options) catch |err| retry: {
+        if (!reused or !isIdempotent(method) or !isStaleConnectionError(err)) return err;
+        response_writer.clearRetainingCapacity();
+        break :retry try client.fetch(options);
+    };
 
     const status_code: c_int = @intFromEnum(result.status);
     const response_body = response_writer.written();
@@ -350,6 +350,7 @@ colyseus_http_t* colyseus_http_create(const colyseus_settings_t* settings) {
     
     http->settings = settings;
     http->auth_token = NULL;
+    http->session = NULL;
     
     return http;
 }
@@ -0,0 +1,67 @@
+#ifndef COLYSEUS_IO_LOOP_H
+#define COLYSEUS_IO_LOOP_H
+
+#include "colyseus/io_runtime.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Transport side of the shared I/O runtime (internal).
+ *
+ * A handle is one source of work on a runtime thread. `on_ready` runs on
+ * that thread whenever the handle's fd matches its interest, or after
+ * colyseus_io_handle_wake(). Callbacks of one handle never run
+ * concurrently.
+ */
+
+#define COLYSEUS_IO_READ  0x1
+#define COLYSEUS_IO_WRITE 0x2
+
+typedef struct colyseus_io_handle colyseus_io_handle_t;
+typedef void (*colyseus_io_ready_fn)(void* ctx);
+
+/* Attach a new handle (no fd yet). Any thread. */
+colyseus_io_handle_t* colyseus_io_handle_attach(colyseus_io_runtime_t* runtime,
+                                                colyseus_io_ready_fn on_ready, void* ctx);
+
+/* Set the fd and COLYSEUS_IO_* interest (fd < 0 or events == 0 removes it).
+ * Runtime thread only (from on_ready). */
+void colyseus_io_handle_set_interest(colyseus_io_handle_t* handle, int fd, int events);
+
+/* Run on_ready soon, regardless of fd readiness. Any thread. */
+void colyseus_io_handle_wake(colyseus_io_handle_t* handle);
+
+/* Run on_ready once colyseus_monotonic_ms() reaches `deadline_ms`, whether
+ * or not the fd is ready (0 clears it). One-shot. Any thread (from another
+ * one it waits for a running on_ready, like detach()). */
+void colyseus_io_handle_set_deadline(colyseus_io_handle_t* handle, uint64_t deadline_ms);
+
+/* Stop dispatching: removes the fd, and from another thread waits for a
+ * running on_ready to return. on_ready is never called afterwards and
+ * wake() becomes a no-op. Any thread. */
+void colyseus_io_handle_detach(colyseus_io_handle_t* handle);
+
+/* Detach (if needed) and free the handle. Any thread, including from its
+ * own on_ready (freed once it returns). */
+void colyseus_io_handle_release(colyseus_io_handle_t* handle);
+
+/* Buffered backends (io_uring): the runtime owns the socket's data path and
+ * the transport must read / write through the handle instead of recv() /
+ * send(). Both follow recv()/send() semantics (-1 with errno EAGAIN when
+ * nothing is buffered / the send buffer is full). Runtime thread only,
+ * except colyseus_io_handle_is_buffered(). */
+bool colyseus_io_handle_is_buffered(const colyseus_io_handle_t* handle);
+ssize_t colyseus_io_handle_recv(colyseus_io_handle_t* handle, void* buf, size_t len);
+ssize_t colyseus_io_handle_send(colyseus_io_handle_t* handle, const void* buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_IO_LOOP_H */
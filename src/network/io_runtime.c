@@ -0,0 +1,1210 @@
+#include "colyseus/io_runtime.h"
+#include "io_loop.h"
+#include "colyseus/utils/time.h"
+#include "utils/spinlock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef __linux__
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#if defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+#if defined(IORING_RECV_MULTISHOT) && defined(__NR_io_uring_setup)
+    #define COLYSEUS_HAVE_IO_URING 1
+#endif
+
+/*
+ * Each loop thread owns a wakeup eventfd and either an epoll set or an
+ * io_uring instance.
+ *
+ * Handles are dispatched with the loop's mutex held; the wait for events
+ * runs without it. Detaching from another thread takes the mutex, so it
+ * waits for a dispatch in progress and never races a callback. Released
+ * handles go to a per-loop dead list and are freed after the current batch
+ * (the epoll event array may still point at them) and, with io_uring, once
+ * none of their requests are in flight.
+ *
+ * wake() pushes the handle onto a spinlock-guarded wake list (once, until
+ * the loop takes it) and signals the eventfd.
+ *
+ * Handles with a deadline sit on an unsorted per-loop timer list (a few
+ * connecting transports at most); the wait is bounded by the earliest one.
+ */
+
+#define IO_LOOP_MAX_EVENTS 64
+
+typedef struct io_loop io_loop_t;
+
+struct colyseus_io_handle {
+    io_loop_t* loop;
+    colyseus_io_ready_fn on_ready;
+    void* ctx;
+
+    /* Loop thread (or under loop->lock) */
+    int fd;
+    int events;
+    bool released;
+    bool ready;                     /* on the ready list */
+    colyseus_io_handle_t* ready_next;
+    colyseus_io_handle_t* dead_next;
+
+    atomic_bool detached;
+    atomic_bool woken;              /* on the wake list */
+    colyseus_io_handle_t* wake_next;
+
+    uint64_t deadline_ms;           /* 0: none (under loop->lock) */
+    bool timer_queued;              /* on the loop's timer list */
+    colyseus_io_handle_t* timer_next;
+
+    /* io_uring backend: buffered data path (loop thread) */
+    int ops;                        /* requests in flight */
+    bool recv_armed;
+    bool recv_started;              /* READ interest seen since the fd was set */
+    bool poll_armed;
+    bool eof;
+    int error;
+    uint8_t* in_buf;
+    size_t in_off, in_len, in_cap;
+    uint8_t* out_buf;               /* accumulating */
+    size_t out_len, out_cap;
+    uint8_t* send_buf;              /* owned by the kernel while a send is in flight */
+    size_t send_off, send_len, send_cap;
+    bool flush_queued;
+    colyseus_io_handle_t* flush_next;
+    bool cancel_queued;
+    colyseus_io_handle_t* cancel_next;
+};
+
+#ifdef COLYSEUS_HAVE_IO_URING
+
+/* Provided buffers for multishot receive (per loop) */
+#define IO_URING_ENTRIES   2048
+#define IO_URING_BUF_COUNT 512      /* power of two */
+#define IO_URING_BUF_SIZE  16384
+#define IO_URING_BGID      0
+/* Stop accepting sends above this many buffered bytes (EAGAIN) */
+#define IO_URING_SEND_HIGH_WATER (256 * 1024)
+
+/* user_data: handle pointer | op tag (handles are malloc-aligned) */
+#define IO_OP_WAKE   0u
+#define IO_OP_RECV   1u
+#define IO_OP_SEND   2u
+#define IO_OP_POLL   3u
+#define IO_OP_CANCEL 4u
+#define IO_OP_MASK   7u
+
+typedef struct {
+    int fd;
+    unsigned sq_entries;
+    unsigned* sq_head;
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned sq_local_tail;
+    unsigned sq_submitted;
+    struct io_uring_sqe* sqes;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    struct io_uring_cqe* cqes;
+    void* sq_ptr;
+    size_t sq_len;
+    void* cq_ptr;
+    size_t cq_len;
+    size_t sqes_len;
+
+    struct io_uring_buf_ring* buf_ring;
+    size_t buf_ring_len;
+    uint8_t* buf_base;
+    unsigned short buf_tail;
+
+    uint64_t wake_value;            /* eventfd read target */
+} io_uring_state_t;
+
+#endif /* COLYSEUS_HAVE_IO_URING */
+
+struct io_loop {
+    colyseus_io_runtime_t* runtime;
+    colyseus_io_backend_t backend;
+    pthread_t thread;
+    int epoll_fd;
+    int event_fd;
+    atomic_bool running;
+
+    pthread_mutex_t lock;           /* held while dispatching */
+    colyseus_io_handle_t* dead;     /* released, freed after the batch */
+    colyseus_io_handle_t* ready_head;  /* io_uring: dispatch on this iteration */
+    colyseus_io_handle_t* ready_tail;
+    colyseus_io_handle_t* flush;    /* io_uring: outbound data to submit */
+    colyseus_io_handle_t* cancel;   /* io_uring: detached, requests to cancel */
+
+    colyseus_spinlock_t wake_lock;
+    colyseus_io_handle_t* wake_head;
+
+    colyseus_io_handle_t* timers;   /* handles with a deadline (under lock) */
+
+#ifdef COLYSEUS_HAVE_IO_URING
+    io_uring_state_t uring;
+#endif
+};
+
+struct colyseus_io_runtime {
+    io_loop_t* loops;
+    int loop_count;
+    colyseus_io_backend_t backend;
+    atomic_uint next_loop;
+    atomic_int connection_count;
+};
+
+static bool io_loop_is_current(io_loop_t* loop) {
+    return pthread_equal(loop->thread, pthread_self());
+}
+
+static void io_loop_signal(io_loop_t* loop) {
+    uint64_t one = 1;
+    ssize_t ret = write(loop->event_fd, &one, sizeof(one));
+    (void)ret;  /* EAGAIN: counter saturated, a wakeup is pending anyway */
+}
+
+static colyseus_io_handle_t* io_loop_take_woken(io_loop_t* loop) {
+    colyseus_spinlock_lock(&loop->wake_lock);
+    colyseus_io_handle_t* woken = loop->wake_head;
+    loop->wake_head = NULL;
+    colyseus_spinlock_unlock(&loop->wake_lock);
+    return woken;
+}
+
+static void io_handle_free(colyseus_io_handle_t* h) {
+    free(h->in_buf);
+    free(h->out_buf);
+    free(h->send_buf);
+    free(h);
+}
+
+/* Free released handles that the kernel no longer references */
+static void io_loop_free_dead(io_loop_t* loop, bool force) {
+    colyseus_io_handle_t** link = &loop->dead;
+    while (*link) {
+        colyseus_io_handle_t* h = *link;
+        /* io_uring: still referenced by a request or one of the loop's lists */
+        bool busy = h->ops > 0 || h->ready || h->flush_queued || h->cancel_queued ||
+                    h->timer_queued;
+        if (force || !busy) {
+            *link = h->dead_next;
+            io_handle_free(h);
+        } else {
+            link = &h->dead_next;
+        }
+    }
+}
+
+static void io_loop_dispatch(colyseus_io_handle_t* h) {
+    if (!atomic_load_explicit(&h->detached, memory_order_acquire)) {
+        h->on_ready(h->ctx);
+    }
+}
+
+/* Unlink the handles whose deadline has passed (and detached / cleared
+ * ones) and return the expired ones, linked through timer_next. */
+static colyseus_io_handle_t* io_loop_take_expired(io_loop_t* loop) {
+    if (!loop->timers) return NULL;
+
+    uint64_t now = colyseus_monotonic_ms();
+    colyseus_io_handle_t* expired = NULL;
+    for (colyseus_io_handle_t** link = &loop->timers; *link; ) {
+        colyseus_io_handle_t* h = *link;
+        bool detached = atomic_load_explicit(&h->detached, memory_order_acquire);
+        if (detached || h->deadline_ms == 0 || h->deadline_ms <= now) {
+            *link = h->timer_next;
+            h->timer_queued = false;
+            h->timer_next = NULL;
+            if (!detached && h->deadline_ms != 0) {
+                h->deadline_ms = 0;
+                h->timer_next = expired;
+                expired = h;
+            }
+            continue;
+        }
+        link = &h->timer_next;
+    }
+    return expired;
+}
+
+/* Milliseconds until the earliest deadline, -1 for none */
+static int io_loop_next_timeout(io_loop_t* loop) {
+    uint64_t earliest = 0;
+    for (colyseus_io_handle_t* h = loop->timers; h; h = h->timer_next) {
+        if (h->deadline_ms && (earliest == 0 || h->deadline_ms < earliest)) earliest = h->deadline_ms;
+    }
+    if (earliest == 0) return -1;
+
+    uint64_t now = colyseus_monotonic_ms();
+    if (earliest <= now) return 0;
+    uint64_t wait = earliest - now;
+    return wait > INT_MAX ? INT_MAX : (int)wait;
+}
+
+/* ── epoll backend ───────────────────────────────────────────────── */
+
+static void io_loop_run_epoll(io_loop_t* loop) {
+    struct epoll_event events[IO_LOOP_MAX_EVENTS];
+    int timeout = -1;
+
+    while (atomic_load_explicit(&loop->running, memory_order_acquire)) {
+        int n = epoll_wait(loop->epoll_fd, events, IO_LOOP_MAX_EVENTS, timeout);
+        if (n < 0 && errno != EINTR) {
+            fprintf(stderr, "I/O runtime: epoll_wait failed (%d)\n", errno);
+            break;
+        }
+
+        pthread_mutex_lock(&loop->lock);
+        for (int i = 0; i < n; i++) {
+            colyseus_io_handle_t* h = (colyseus_io_handle_t*)events[i].data.ptr;
+            if (h) {
+                io_loop_dispatch(h);
+                continue;
+            }
+
+            /* Wakeup: drain the counter and run every woken handle */
+            uint64_t count;
+            ssize_t ret = read(loop->event_fd, &count, sizeof(count));
+            (void)ret;
+
+            colyseus_io_handle_t* woken = io_loop_take_woken(loop);
+            while (woken) {
+                colyseus_io_handle_t* next = woken->wake_next;
+                woken->wake_next = NULL;
+                atomic_store_explicit(&woken->woken, false, memory_order_release);
+                io_loop_dispatch(woken);
+                woken = next;
+            }
+        }
+
+        colyseus_io_handle_t* expired = io_loop_take_expired(loop);
+        while (expired) {
+            colyseus_io_handle_t* next = expired->timer_next;
+            expired->timer_next = NULL;
+            io_loop_dispatch(expired);
+            expired = next;
+        }
+
+        io_loop_free_dead(loop, false);
+        timeout = io_loop_next_timeout(loop);
+        pthread_mutex_unlock(&loop->lock);
+    }
+}
+
+static void io_epoll_set_interest(colyseus_io_handle_t* h, int fd, int events) {
+    int epoll_fd = h->loop->epoll_fd;
+
+    if (fd != h->fd) {
+        if (h->fd >= 0 && h->events) {
+            /* May already be gone if the fd was closed */
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, h->fd, NULL);
+        }
+        h->fd = fd;
+        h->events = 0;
+    }
+
+    if (fd < 0 || events == 0) {
+        if (h->fd >= 0 && h->events) {
+            epoll_ctl(epoll_fd, EPOLL_CTL_DEL, h->fd, NULL);
+        }
+        h->events = 0;
+        return;
+    }
+
+    if (events == h->events) return;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = ((events & COLYSEUS_IO_READ) ? EPOLLIN : 0) |
+                ((events & COLYSEUS_IO_WRITE) ? EPOLLOUT : 0);
+    ev.data.ptr = h;
+
+    int ret;
+    if (h->events) {
+        ret = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev);
+        /* The fd number was closed and reused since it was registered */
+        if (ret != 0 && errno == ENOENT) ret = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+    } else {
+        ret = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev);
+        if (ret != 0 && errno == EEXIST) ret = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev);
+    }
+    h->events = ret == 0 ? events : 0;
+}
+
+/* ── io_uring backend ────────────────────────────────────────────── */
+
+#ifdef COLYSEUS_HAVE_IO_URING
+
+/*
+ * The runtime owns the data path: one multishot recv per connection fills
+ * buffers from a registered provided-buffer ring, and the bytes are moved
+ * into the handle's inbound buffer for the transport to read. Transport
+ * writes are appended to the handle's outbound buffer and submitted as one
+ * send per connection at the end of the iteration. Everything queued during
+ * an iteration goes to the kernel with the next io_uring_enter(), which
+ * also waits for completions: one syscall per iteration, not per socket.
+ *
+ * The submission queue is only touched by the loop thread, under the loop
+ * mutex. Other threads hand work over through the wake / cancel lists.
+ */
+
+static bool io_uring_init(io_loop_t* loop) {
+    io_uring_state_t* u = &loop->uring;
+    memset(u, 0, sizeof(io_uring_state_t));
+    u->fd = -1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    u->fd = (int)syscall(__NR_io_uring_setup, IO_URING_ENTRIES, &params);
+    if (u->fd < 0) return false;
+
+    u->sq_len = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    u->cq_len = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        if (u->cq_len > u->sq_len) u->sq_len = u->cq_len;
+        u->cq_len = u->sq_len;
+    }
+
+    u->sq_ptr = mmap(NULL, u->sq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     u->fd, IORING_OFF_SQ_RING);
+    if (u->sq_ptr == MAP_FAILED) goto fail;
+    if (single_mmap) {
+        u->cq_ptr = u->sq_ptr;
+    } else {
+        u->cq_ptr = mmap(NULL, u->cq_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         u->fd, IORING_OFF_CQ_RING);
+        if (u->cq_ptr == MAP_FAILED) goto fail;
+    }
+    u->sqes_len = params.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   u->fd, IORING_OFF_SQES);
+    if (u->sqes == MAP_FAILED) goto fail;
+
+    uint8_t* sq = (uint8_t*)u->sq_ptr;
+    uint8_t* cq = (uint8_t*)u->cq_ptr;
+    u->sq_entries = params.sq_entries;
+    u->sq_head = (unsigned*)(sq + params.sq_off.head);
+    u->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    u->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    u->sq_array = (unsigned*)(sq + params.sq_off.array);
+    u->sq_local_tail = *u->sq_tail;
+    u->sq_submitted = u->sq_local_tail;
+    u->cq_head = (unsigned*)(cq + params.cq_off.head);
+    u->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    u->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    /* Register the provided buffer ring */
+    u->buf_ring_len = IO_URING_BUF_COUNT * sizeof(struct io_uring_buf);
+    u->buf_ring = mmap(NULL, u->buf_ring_len, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (u->buf_ring == MAP_FAILED) {
+        u->buf_ring = NULL;
+        goto fail;
+    }
+    u->buf_base = malloc((size_t)IO_URING_BUF_COUNT * IO_URING_BUF_SIZE);
+    if (!u->buf_base) goto fail;
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)u->buf_ring;
+    reg.ring_entries = IO_URING_BUF_COUNT;
+    reg.bgid = IO_URING_BGID;
+    if (syscall(__NR_io_uring_register, u->fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) goto fail;
+
+    for (unsigned i = 0; i < IO_URING_BUF_COUNT; i++) {
+        struct io_uring_buf* b = &u->buf_ring->bufs[i];
+        b->addr = (uint64_t)(uintptr_t)(u->buf_base + (size_t)i * IO_URING_BUF_SIZE);
+        b->len = IO_URING_BUF_SIZE;
+        b->bid = (unsigned short)i;
+    }
+    u->buf_tail = IO_URING_BUF_COUNT;
+    __atomic_store_n(&u->buf_ring->tail, u->buf_tail, __ATOMIC_RELEASE);
+    return true;
+
+fail:
+    if (u->sqes && u->sqes != MAP_FAILED) munmap(u->sqes, u->sqes_len);
+    if (u->cq_ptr && u->cq_ptr != MAP_FAILED && u->cq_ptr != u->sq_ptr) munmap(u->cq_ptr, u->cq_len);
+    if (u->sq_ptr && u->sq_ptr != MAP_FAILED) munmap(u->sq_ptr, u->sq_len);
+    if (u->buf_ring) munmap(u->buf_ring, u->buf_ring_len);
+    free(u->buf_base);
+    close(u->fd);
+    memset(u, 0, sizeof(io_uring_state_t));
+    u->fd = -1;
+    return false;
+}
+
+static void io_uring_shutdown(io_loop_t* loop) {
+    io_uring_state_t* u = &loop->uring;
+    if (u->fd < 0) return;
+    munmap(u->sqes, u->sqes_len);
+    if (u->cq_ptr != u->sq_ptr) munmap(u->cq_ptr, u->cq_len);
+    munmap(u->sq_ptr, u->sq_len);
+    close(u->fd);
+    munmap(u->buf_ring, u->buf_ring_len);
+    free(u->buf_base);
+    u->fd = -1;
+}
+
+static int io_uring_enter_ring(io_uring_state_t* u, unsigned to_submit, unsigned min_complete) {
+    return (int)syscall(__NR_io_uring_enter, u->fd, to_submit, min_complete,
+                        min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+}
+
+/* Same, waiting at most `timeout_ms` (< 0: no limit). Fails with ETIME
+ * when nothing completed in time. */
+static int io_uring_enter_ring_timeout(io_uring_state_t* u, unsigned to_submit,
+                                       unsigned min_complete, int timeout_ms) {
+#ifdef IORING_ENTER_EXT_ARG
+    if (min_complete && timeout_ms >= 0) {
+        struct __kernel_timespec ts;
+        ts.tv_sec = timeout_ms / 1000;
+        ts.tv_nsec = (long long)(timeout_ms % 1000) * 1000000LL;
+        struct io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (uint64_t)(uintptr_t)&ts;
+        return (int)syscall(__NR_io_uring_enter, u->fd, to_submit, min_complete,
+                            IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    }
+#else
+    /* Old headers: poll the timers every few milliseconds instead */
+    if (min_complete && timeout_ms >= 0) min_complete = 0;
+#endif
+    return io_uring_enter_ring(u, to_submit, min_complete);
+}
+
+static void io_uring_publish(io_uring_state_t* u) {
+    __atomic_store_n(u->sq_tail, u->sq_local_tail, __ATOMIC_RELEASE);
+}
+
+/* Next free SQE (zeroed). Submits early when the ring is full. */
+static struct io_uring_sqe* io_uring_get_sqe(io_uring_state_t* u) {
+    unsigned head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+    if (u->sq_local_tail - head >= u->sq_entries) {
+        io_uring_publish(u);
+        int ret = io_uring_enter_ring(u, u->sq_local_tail - u->sq_submitted, 0);
+        if (ret > 0) u->sq_submitted += (unsigned)ret;
+        head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+        if (u->sq_local_tail - head >= u->sq_entries) return NULL;
+    }
+    unsigned index = u->sq_local_tail & *u->sq_mask;
+    struct io_uring_sqe* sqe = &u->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    u->sq_array[index] = index;
+    u->sq_local_tail++;
+    return sqe;
+}
+
+static uint64_t io_uring_user_data(colyseus_io_handle_t* h, unsigned op) {
+    return (uint64_t)(uintptr_t)h | op;
+}
+
+static void io_uring_arm_wake(io_loop_t* loop) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&loop->uring);
+    if (!sqe) return;
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = loop->event_fd;
+    sqe->addr = (uint64_t)(uintptr_t)&loop->uring.wake_value;
+    sqe->len = sizeof(loop->uring.wake_value);
+    sqe->user_data = io_uring_user_data(NULL, IO_OP_WAKE);
+}
+
+static void io_uring_arm_recv(colyseus_io_handle_t* h) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&h->loop->uring);
+    if (!sqe) return;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = h->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = IO_URING_BGID;
+    sqe->user_data = io_uring_user_data(h, IO_OP_RECV);
+    h->recv_armed = true;
+    h->ops++;
+}
+
+static void io_uring_arm_poll_out(colyseus_io_handle_t* h) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&h->loop->uring);
+    if (!sqe) return;
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = h->fd;
+    sqe->poll32_events = POLLOUT;
+    sqe->user_data = io_uring_user_data(h, IO_OP_POLL);
+    h->poll_armed = true;
+    h->ops++;
+}
+
+static void io_uring_submit_send(colyseus_io_handle_t* h) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&h->loop->uring);
+    if (!sqe) return;
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = h->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(h->send_buf + h->send_off);
+    sqe->len = (unsigned)(h->send_len - h->send_off);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = io_uring_user_data(h, IO_OP_SEND);
+    h->ops++;
+}
+
+static void io_uring_cancel(colyseus_io_handle_t* h, unsigned op) {
+    struct io_uring_sqe* sqe = io_uring_get_sqe(&h->loop->uring);
+    if (!sqe) return;
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = io_uring_user_data(h, op);
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = io_uring_user_data(NULL, IO_OP_CANCEL);
+}
+
+static void io_uring_mark_ready(colyseus_io_handle_t* h) {
+    if (h->ready) return;
+    io_loop_t* loop = h->loop;
+    h->ready = true;
+    h->ready_next = NULL;
+    if (loop->ready_tail) {
+        loop->ready_tail->ready_next = h;
+    } else {
+        loop->ready_head = h;
+    }
+    loop->ready_tail = h;
+}
+
+static void io_uring_queue_flush(colyseus_io_handle_t* h) {
+    if (h->flush_queued) return;
+    h->flush_queued = true;
+    h->flush_next = h->loop->flush;
+    h->loop->flush = h;
+}
+
+/* Stop receiving on the current fd; the in-flight requests complete with
+ * -ECANCELED. The connection's buffered state is dropped. */
+static void io_uring_reset_handle(colyseus_io_handle_t* h) {
+    if (h->recv_armed) io_uring_cancel(h, IO_OP_RECV);
+    if (h->poll_armed) io_uring_cancel(h, IO_OP_POLL);
+    h->recv_started = false;
+    h->eof = false;
+    h->error = 0;
+    h->in_off = h->in_len = 0;
+    h->out_len = 0;
+}
+
+static void io_uring_recycle_buffer(io_uring_state_t* u, unsigned short bid) {
+    struct io_uring_buf* b = &u->buf_ring->bufs[u->buf_tail & (IO_URING_BUF_COUNT - 1)];
+    b->addr = (uint64_t)(uintptr_t)(u->buf_base + (size_t)bid * IO_URING_BUF_SIZE);
+    b->len = IO_URING_BUF_SIZE;
+    b->bid = bid;
+    u->buf_tail++;
+    __atomic_store_n(&u->buf_ring->tail, u->buf_tail, __ATOMIC_RELEASE);
+}
+
+static bool io_buffer_reserve(uint8_t** buf, size_t* cap, size_t needed) {
+    if (needed <= *cap) return true;
+    size_t new_cap = *cap ? *cap : 4096;
+    while (new_cap < needed) new_cap *= 2;
+    uint8_t* grown = realloc(*buf, new_cap);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = new_cap;
+    return true;
+}
+
+static void io_uring_on_recv(colyseus_io_handle_t* h, const struct io_uring_cqe* cqe) {
+    io_uring_state_t* u = &h->loop->uring;
+    bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+    if (!more) {
+        h->recv_armed = false;
+        h->ops--;
+    }
+
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+        unsigned short bid = (unsigned short)(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+        if (cqe->res > 0 && !atomic_load(&h->detached)) {
+            /* Compact, then append */
+            if (h->in_off > 0) {
+                memmove(h->in_buf, h->in_buf + h->in_off, h->in_len - h->in_off);
+                h->in_len -= h->in_off;
+                h->in_off = 0;
+            }
+            if (io_buffer_reserve(&h->in_buf, &h->in_cap, h->in_len + (size_t)cqe->res)) {
+                memcpy(h->in_buf + h->in_len, u->buf_base + (size_t)bid * IO_URING_BUF_SIZE, (size_t)cqe->res);
+                h->in_len += (size_t)cqe->res;
+            } else {
+                h->error = ENOMEM;
+            }
+        }
+        io_uring_recycle_buffer(u, bid);
+    }
+
+    if (cqe->res == 0) {
+        h->eof = true;
+    } else if (cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+        h->error = -cqe->res;
+    }
+
+    /* Out of provided buffers: re-arm once they're recycled */
+    if (!more && cqe->res == -ENOBUFS && !atomic_load(&h->detached) && h->fd >= 0) {
+        io_uring_arm_recv(h);
+    }
+
+    if (!atomic_load(&h->detached)) io_uring_mark_ready(h);
+}
+
+static void io_uring_on_send(colyseus_io_handle_t* h, const struct io_uring_cqe* cqe) {
+    h->ops--;
+    if (cqe->res < 0) {
+        if (cqe->res != -ECANCELED) h->error = -cqe->res;
+        h->send_off = h->send_len = 0;
+    } else {
+        h->send_off += (size_t)cqe->res;
+        if (h->send_off < h->send_len && !atomic_load(&h->detached)) {
+            io_uring_submit_send(h);  /* partial send: the rest of the buffer */
+            return;
+        }
+        h->send_off = h->send_len = 0;
+    }
+    if (atomic_load(&h->detached)) return;
+    if (h->out_len > 0) io_uring_queue_flush(h);
+    io_uring_mark_ready(h);
+}
+
+/* Submit each handle's accumulated outbound bytes as a single send */
+static void io_uring_flush_sends(io_loop_t* loop) {
+    colyseus_io_handle_t* h = loop->flush;
+    loop->flush = NULL;
+    while (h) {
+        colyseus_io_handle_t* next = h->flush_next;
+        h->flush_queued = false;
+        if (h->send_len == 0 && h->out_len > 0 && h->fd >= 0 && !atomic_load(&h->detached)) {
+            uint8_t* buf = h->send_buf;
+            size_t cap = h->send_cap;
+            h->send_buf = h->out_buf;
+            h->send_cap = h->out_cap;
+            h->send_len = h->out_len;
+            h->send_off = 0;
+            h->out_buf = buf;
+            h->out_cap = cap;
+            h->out_len = 0;
+            io_uring_submit_send(h);
+        }
+        h = next;
+    }
+}
+
+static void io_loop_run_uring(io_loop_t* loop) {
+    io_uring_state_t* u = &loop->uring;
+
+    pthread_mutex_lock(&loop->lock);
+    io_uring_arm_wake(loop);
+    pthread_mutex_unlock(&loop->lock);
+
+    while (atomic_load_explicit(&loop->running, memory_order_acquire)) {
+        /* Submit everything queued last iteration and wait for completions,
+         * unless handles are already ready to run. */
+        pthread_mutex_lock(&loop->lock);
+        io_uring_publish(u);
+        unsigned to_submit = u->sq_local_tail - u->sq_submitted;
+        unsigned min_complete = loop->ready_head ? 0 : 1;
+        int timeout = io_loop_next_timeout(loop);
+        pthread_mutex_unlock(&loop->lock);
+
+        int ret = io_uring_enter_ring_timeout(u, to_submit, min_complete, timeout);
+        if (ret < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN && errno != ETIME) {
+            fprintf(stderr, "I/O runtime: io_uring_enter failed (%d)\n", errno);
+            break;
+        }
+
+        pthread_mutex_lock(&loop->lock);
+        if (ret > 0) u->sq_submitted += (unsigned)ret;
+
+        /* Reap completions */
+        unsigned head = *u->cq_head;
+        unsigned tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const struct io_uring_cqe* cqe = &u->cqes[head & *u->cq_mask];
+            unsigned op = (unsigned)(cqe->user_data & IO_OP_MASK);
+            colyseus_io_handle_t* h = (colyseus_io_handle_t*)(uintptr_t)(cqe->user_data & ~(uint64_t)IO_OP_MASK);
+
+            if (op == IO_OP_WAKE) {
+                io_uring_arm_wake(loop);
+                colyseus_io_handle_t* woken = io_loop_take_woken(loop);
+                while (woken) {
+                    colyseus_io_handle_t* next = woken->wake_next;
+                    woken->wake_next = NULL;
+                    atomic_store_explicit(&woken->woken, false, memory_order_release);
+                    if (!atomic_load(&woken->detached)) io_uring_mark_ready(woken);
+                    woken = next;
+                }
+            } else if (op == IO_OP_RECV) {
+                io_uring_on_recv(h, cqe);
+            } else if (op == IO_OP_SEND) {
+                io_uring_on_send(h, cqe);
+            } else if (op == IO_OP_POLL) {
+                h->ops--;
+                h->poll_armed = false;
+                if (!atomic_load(&h->detached)) io_uring_mark_ready(h);
+            }
+            head++;
+        }
+        __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+
+        /* Detached handles: stop their requests */
+        colyseus_io_handle_t* cancel = loop->cancel;
+        loop->cancel = NULL;
+        while (cancel) {
+            colyseus_io_handle_t* next = cancel->cancel_next;
+            cancel->cancel_queued = false;
+            if (cancel->recv_armed) io_uring_cancel(cancel, IO_OP_RECV);
+            if (cancel->poll_armed) io_uring_cancel(cancel, IO_OP_POLL);
+            if (cancel->send_len > 0) io_uring_cancel(cancel, IO_OP_SEND);
+            cancel = next;
+        }
+
+        colyseus_io_handle_t* expired = io_loop_take_expired(loop);
+        while (expired) {
+            colyseus_io_handle_t* next = expired->timer_next;
+            expired->timer_next = NULL;
+            io_uring_mark_ready(expired);
+            expired = next;
+        }
+
+        /* Dispatch; handles made ready by on_ready run next iteration */
+        colyseus_io_handle_t* ready = loop->ready_head;
+        loop->ready_head = NULL;
+        loop->ready_tail = NULL;
+        while (ready) {
+            colyseus_io_handle_t* next = ready->ready_next;
+            ready->ready = false;
+            ready->ready_next = NULL;
+            io_loop_dispatch(ready);
+            ready = next;
+        }
+
+        io_uring_flush_sends(loop);
+        io_loop_free_dead(loop, false);
+        pthread_mutex_unlock(&loop->lock);
+    }
+}
+
+static void io_uring_set_interest(colyseus_io_handle_t* h, int fd, int events) {
+    if (fd != h->fd) {
+        if (h->fd >= 0) io_uring_reset_handle(h);
+        h->fd = fd;
+    }
+    h->events = fd >= 0 ? events : 0;
+    if (h->fd < 0 || events == 0) return;
+
+    if (events & COLYSEUS_IO_READ) {
+        h->recv_started = true;
+        if (!h->recv_armed && !h->eof && !h->error) io_uring_arm_recv(h);
+        /* Already buffered: the transport won't get another completion */
+        if (h->in_len > h->in_off || h->eof || h->error) io_uring_mark_ready(h);
+    }
+
+    if (events & COLYSEUS_IO_WRITE) {
+        if (!h->recv_started) {
+            /* Still connecting: wait for the socket itself */
+            if (!h->poll_armed) io_uring_arm_poll_out(h);
+        } else if (h->out_len < IO_URING_SEND_HIGH_WATER) {
+            io_uring_mark_ready(h);
+        }
+        /* Otherwise the send completion marks it ready */
+    }
+}
+
+#endif /* COLYSEUS_HAVE_IO_URING */
+
+/* ── Runtime ─────────────────────────────────────────────────────── */
+
+static void* io_loop_thread_func(void* arg) {
+    io_loop_t* loop = (io_loop_t*)arg;
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (loop->backend == COLYSEUS_IO_BACKEND_IO_URING) {
+        io_loop_run_uring(loop);
+        return NULL;
+    }
+#endif
+    io_loop_run_epoll(loop);
+    return NULL;
+}
+
+static bool io_loop_init(io_loop_t* loop, colyseus_io_runtime_t* runtime, colyseus_io_backend_t backend) {
+    memset(loop, 0, sizeof(io_loop_t));
+    loop->runtime = runtime;
+    loop->backend = backend;
+    loop->epoll_fd = -1;
+    loop->event_fd = -1;
+    colyseus_spinlock_init(&loop->wake_lock);
+
+    loop->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->event_fd < 0) goto fail;
+
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (backend == COLYSEUS_IO_BACKEND_IO_URING) {
+        if (!io_uring_init(loop)) goto fail;
+    } else
+#endif
+    {
+        loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (loop->epoll_fd < 0) goto fail;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL;  /* NULL marks the wakeup eventfd */
+        if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->event_fd, &ev) != 0) goto fail;
+    }
+
+    pthread_mutex_init(&loop->lock, NULL);
+    atomic_init(&loop->running, true);
+    if (pthread_create(&loop->thread, NULL, io_loop_thread_func, loop) != 0) {
+        pthread_mutex_destroy(&loop->lock);
+        goto fail;
+    }
+    return true;
+
+fail:
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (backend == COLYSEUS_IO_BACKEND_IO_URING) io_uring_shutdown(loop);
+#endif
+    if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+    if (loop->event_fd >= 0) close(loop->event_fd);
+    return false;
+}
+
+static void io_loop_shutdown(io_loop_t* loop) {
+    atomic_store_explicit(&loop->running, false, memory_order_release);
+    io_loop_signal(loop);
+    pthread_join(loop->thread, NULL);
+
+    io_loop_free_dead(loop, true);
+    pthread_mutex_destroy(&loop->lock);
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (loop->backend == COLYSEUS_IO_BACKEND_IO_URING) io_uring_shutdown(loop);
+#endif
+    if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+    close(loop->event_fd);
+}
+
+colyseus_io_runtime_t* colyseus_io_runtime_create_with_backend(int thread_count,
+                                                               colyseus_io_backend_t backend) {
+    if (thread_count <= 0) thread_count = 1;
+#ifndef COLYSEUS_HAVE_IO_URING
+    backend = COLYSEUS_IO_BACKEND_EPOLL;
+#endif
+
+    colyseus_io_runtime_t* runtime = malloc(sizeof(colyseus_io_runtime_t));
+    if (!runtime) return NULL;
+    runtime->loops = malloc(sizeof(io_loop_t) * (size_t)thread_count);
+    if (!runtime->loops) {
+        free(runtime);
+        return NULL;
+    }
+    runtime->loop_count = 0;
+    runtime->backend = backend;
+    atomic_init(&runtime->next_loop, 0);
+    atomic_init(&runtime->connection_count, 0);
+
+    for (int i = 0; i < thread_count; i++) {
+        if (!io_loop_init(&runtime->loops[i], runtime, runtime->backend)) {
+            if (i == 0 && runtime->backend == COLYSEUS_IO_BACKEND_IO_URING) {
+                /* io_uring unavailable (old kernel, seccomp): use epoll */
+                runtime->backend = COLYSEUS_IO_BACKEND_EPOLL;
+                i--;
+                continue;
+            }
+            colyseus_io_runtime_free(runtime);
+            return NULL;
+        }
+        runtime->loop_count++;
+    }
+    return runtime;
+}
+
+colyseus_io_runtime_t* colyseus_io_runtime_create(int thread_count) {
+    return colyseus_io_runtime_create_with_backend(thread_count, COLYSEUS_IO_BACKEND_EPOLL);
+}
+
+colyseus_io_backend_t colyseus_io_runtime_get_backend(colyseus_io_runtime_t* runtime) {
+    return runtime ? runtime->backend : COLYSEUS_IO_BACKEND_EPOLL;
+}
+
+void colyseus_io_runtime_free(colyseus_io_runtime_t* runtime) {
+    if (!runtime) return;
+    for (int i = 0; i < runtime->loop_count; i++) {
+        io_loop_shutdown(&runtime->loops[i]);
+    }
+    free(runtime->loops);
+    free(runtime);
+}
+
+int colyseus_io_runtime_get_connection_count(colyseus_io_runtime_t* runtime) {
+    return runtime ? atomic_load(&runtime->connection_count) : 0;
+}
+
+/* ── Handles ─────────────────────────────────────────────────────── */
+
+colyseus_io_handle_t* colyseus_io_handle_attach(colyseus_io_runtime_t* runtime,
+                                                colyseus_io_ready_fn on_ready, void* ctx) {
+    if (!runtime || !on_ready) return NULL;
+
+    colyseus_io_handle_t* h = calloc(1, sizeof(colyseus_io_handle_t));
+    if (!h) return NULL;
+
+    unsigned int index = atomic_fetch_add(&runtime->next_loop, 1) % (unsigned int)runtime->loop_count;
+    h->loop = &runtime->loops[index];
+    h->on_ready = on_ready;
+    h->ctx = ctx;
+    h->fd = -1;
+    atomic_init(&h->detached, false);
+    atomic_init(&h->woken, false);
+
+    atomic_fetch_add(&runtime->connection_count, 1);
+    return h;
+}
+
+void colyseus_io_handle_set_interest(colyseus_io_handle_t* h, int fd, int events) {
+    if (!h) return;
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (h->loop->backend == COLYSEUS_IO_BACKEND_IO_URING) {
+        io_uring_set_interest(h, fd, events);
+        return;
+    }
+#endif
+    io_epoll_set_interest(h, fd, events);
+}
+
+void colyseus_io_handle_wake(colyseus_io_handle_t* h) {
+    if (!h || atomic_load_explicit(&h->detached, memory_order_acquire)) return;
+    if (atomic_exchange_explicit(&h->woken, true, memory_order_acq_rel)) return;
+
+    io_loop_t* loop = h->loop;
+    colyseus_spinlock_lock(&loop->wake_lock);
+    h->wake_next = loop->wake_head;
+    loop->wake_head = h;
+    colyseus_spinlock_unlock(&loop->wake_lock);
+
+    io_loop_signal(loop);
+}
+
+void colyseus_io_handle_set_deadline(colyseus_io_handle_t* h, uint64_t deadline_ms) {
+    if (!h) return;
+
+    /* The timer list is the loop's: from another thread, wait out a
+     * dispatch and wake the loop so its wait honours the new deadline */
+    io_loop_t* loop = h->loop;
+    bool in_loop = io_loop_is_current(loop);
+    if (!in_loop) pthread_mutex_lock(&loop->lock);
+
+    h->deadline_ms = deadline_ms;
+    if (deadline_ms && !h->timer_queued) {
+        h->timer_queued = true;
+        h->timer_next = loop->timers;
+        loop->timers = h;
+    }
+
+    if (!in_loop) pthread_mutex_unlock(&loop->lock);
+    if (!in_loop && deadline_ms) io_loop_signal(loop);
+}
+
+void colyseus_io_handle_detach(colyseus_io_handle_t* h) {
+    if (!h || atomic_load_explicit(&h->detached, memory_order_acquire)) return;
+
+    io_loop_t* loop = h->loop;
+    bool in_loop = io_loop_is_current(loop);
+    if (!in_loop) pthread_mutex_lock(&loop->lock);
+
+    atomic_store_explicit(&h->detached, true, memory_order_release);
+    if (loop->backend == COLYSEUS_IO_BACKEND_IO_URING) {
+        /* Only the loop thread submits; it cancels the requests */
+        if (!h->cancel_queued) {
+            h->cancel_queued = true;
+            h->cancel_next = loop->cancel;
+            loop->cancel = h;
+        }
+    } else {
+        colyseus_io_handle_set_interest(h, -1, 0);
+    }
+    atomic_fetch_sub(&loop->runtime->connection_count, 1);
+
+    if (!in_loop) pthread_mutex_unlock(&loop->lock);
+    if (!in_loop && loop->backend == COLYSEUS_IO_BACKEND_IO_URING) io_loop_signal(loop);
+}
+
+void colyseus_io_handle_release(colyseus_io_handle_t* h) {
+    if (!h) return;
+    colyseus_io_handle_detach(h);
+
+    io_loop_t* loop = h->loop;
+    bool in_loop = io_loop_is_current(loop);
+    if (!in_loop) pthread_mutex_lock(&loop->lock);
+
+    /* Unlink from the wake list; the loop only reads it under wake_lock */
+    colyseus_spinlock_lock(&loop->wake_lock);
+    colyseus_io_handle_t** link = &loop->wake_head;
+    while (*link) {
+        if (*link == h) {
+            *link = h->wake_next;
+            break;
+        }
+        link = &(*link)->wake_next;
+    }
+    colyseus_spinlock_unlock(&loop->wake_lock);
+
+    h->released = true;
+    h->dead_next = loop->dead;
+    loop->dead = h;
+
+    if (!in_loop) pthread_mutex_unlock(&loop->lock);
+}
+
+bool colyseus_io_handle_is_buffered(const colyseus_io_handle_t* h) {
+    return h && h->loop->backend == COLYSEUS_IO_BACKEND_IO_URING;
+}
+
+ssize_t colyseus_io_handle_recv(colyseus_io_handle_t* h, void* buf, size_t len) {
+    if (h->in_len > h->in_off) {
+        size_t n = h->in_len - h->in_off;
+        if (n > len) n = len;
+        memcpy(buf, h->in_buf + h->in_off, n);
+        h->in_off += n;
+        if (h->in_off == h->in_len) h->in_off = h->in_len = 0;
+        return (ssize_t)n;
+    }
+    if (h->error) {
+        errno = h->error;
+        return -1;
+    }
+    if (h->eof) return 0;
+    errno = EAGAIN;
+    return -1;
+}
+
+ssize_t colyseus_io_handle_send(colyseus_io_handle_t* h, const void* buf, size_t len) {
+#ifdef COLYSEUS_HAVE_IO_URING
+    if (atomic_load(&h->detached) || h->error) {
+        /* Buffered data can't be written after detach without reordering */
+        errno = h->error ? h->error : EPIPE;
+        return -1;
+    }
+    if (h->out_len >= IO_URING_SEND_HIGH_WATER) {
+        errno = EAGAIN;
+        return -1;
+    }
+    if (!io_buffer_reserve(&h->out_buf, &h->out_cap, h->out_len + len)) {
+        errno = ENOMEM;
+        return -1;
+    }
+    memcpy(h->out_buf + h->out_len, buf, len);
+    h->out_len += len;
+    io_uring_queue_flush(h);
+    return (ssize_t)len;
+#else
+    (void)h;
+    (void)buf;
+    (void)len;
+    errno = ENOTSUP;
+    return -1;
+#endif
+}
+
+#else /* !__linux__ */
+
+/* No epoll: transports keep their own tick thread. */
+
+colyseus_io_runtime_t* colyseus_io_runtime_create(int thread_count) {
+    (void)thread_count;
+    return NULL;
+}
+
+colyseus_io_runtime_t* colyseus_io_runtime_create_with_backend(int thread_count,
+                                                               colyseus_io_backend_t backend) {
+    (void)thread_count;
+    (void)backend;
+    return NULL;
+}
+
+colyseus_io_backend_t colyseus_io_runtime_get_backend(colyseus_io_runtime_t* runtime) {
+    (void)runtime;
+    return COLYSEUS_IO_BACKEND_EPOLL;
+}
+
+void colyseus_io_runtime_free(colyseus_io_runtime_t* runtime) {
+    (void)runtime;
+}
+
+int colyseus_io_runtime_get_connection_count(colyseus_io_runtime_t* runtime) {
+    (void)runtime;
+    return 0;
+}
+
+colyseus_io_handle_t* colyseus_io_handle_attach(colyseus_io_runtime_t* runtime,
+                                                colyseus_io_ready_fn on_ready, void* ctx) {
+    (void)runtime;
+    (void)on_ready;
+    (void)ctx;
+    return NULL;
+}
+
+void colyseus_io_handle_set_interest(colyseus_io_handle_t* handle, int fd, int events) {
+    (void)handle;
+    (void)fd;
+    (void)events;
+}
+
+void colyseus_io_handle_wake(colyseus_io_handle_t* handle) {
+    (void)handle;
+}
+
+void colyseus_io_handle_set_deadline(colyseus_io_handle_t* handle, uint64_t deadline_ms) {
+    (void)handle;
+    (void)deadline_ms;
+}
+
+void colyseus_io_handle_detach(colyseus_io_handle_t* handle) {
+    (void)handle;
+}
+
+void colyseus_io_handle_release(colyseus_io_handle_t* handle) {
+    (void)handle;
+}
+
+bool colyseus_io_handle_is_buffered(const colyseus_io_handle_t* handle) {
+    (void)handle;
+    return false;
+}
+
+ssize_t colyseus_io_handle_recv(colyseus_io_handle_t* handle, void* buf, size_t len) {
+    (void)handle;
+    (void)buf;
+    (void)len;
+    return -1;
+}
+
+ssize_t colyseus_io_handle_send(colyseus_io_handle_t* handle, const void* buf, size_t len) {
+    (void)handle;
+    (void)buf;
+    (void)len;
+    return -1;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,392 @@
+#include "resolver.h"
+#include "colyseus/utils/time.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    typedef SRWLOCK resolver_lock_t;
+    #define RESOLVER_LOCK_INITIALIZER SRWLOCK_INIT
+    static void resolver_lock(resolver_lock_t* lock) { AcquireSRWLockExclusive(lock); }
+    static void resolver_unlock(resolver_lock_t* lock) { ReleaseSRWLockExclusive(lock); }
+#else
+    #include <pthread.h>
+    #include <netdb.h>
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    typedef pthread_mutex_t resolver_lock_t;
+    #define RESOLVER_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+    static void resolver_lock(resolver_lock_t* lock) { pthread_mutex_lock(lock); }
+    static void resolver_unlock(resolver_lock_t* lock) { pthread_mutex_unlock(lock); }
+#endif
+
+/* Same switch as the WebSocket transport's diagnostics */
+static int resolver_debug_enabled(void) {
+    static int cached = -1;
+    if (cached == -1) {
+        const char* v = getenv("COLYSEUS_WS_DEBUG");
+        cached = (v && v[0] && v[0] != '0') ? 1 : 0;
+    }
+    return cached;
+}
+
+#define RESOLVER_LOG(fmt, ...) do { \
+    if (resolver_debug_enabled()) { fprintf(stderr, "[DNS] " fmt "\n", ##__VA_ARGS__); fflush(stderr); } \
+} while (0)
+
+#define RESOLVER_THREADS_MAX  4    /* lookups running at once */
+#define RESOLVER_CACHE_MAX    64   /* hosts remembered */
+#define RESOLVER_ADDRS_MAX    16   /* addresses kept per host */
+
+typedef struct resolver_entry {
+    char* host;
+    colyseus_resolved_addr_t* addrs;  /* port 0 */
+    size_t count;
+    uint64_t expires_ms;
+    bool resolving;                   /* queued or running */
+    colyseus_resolve_t* waiters;
+    struct resolver_entry* next;      /* cache, most recently used first */
+    struct resolver_entry* job_next;  /* lookup queue */
+} resolver_entry_t;
+
+struct colyseus_resolve {
+    atomic_int status;
+    colyseus_resolved_addr_t* addrs;
+    size_t count;
+    int port;
+    bool cached;
+    colyseus_resolve_fn on_done;
+    void* ctx;
+    resolver_entry_t* entry;          /* while waiting, guarded by g_lock */
+    struct colyseus_resolve* next;
+};
+
+static resolver_lock_t g_lock = RESOLVER_LOCK_INITIALIZER;
+static resolver_entry_t* g_cache = NULL;
+static resolver_entry_t* g_jobs_head = NULL;
+static resolver_entry_t* g_jobs_tail = NULL;
+static int g_threads = 0;
+static atomic_uint g_ttl_ms = 60000;
+
+/* ── Addresses ── */
+
+static void resolver_set_port(colyseus_resolved_addr_t* a, int port) {
+    if (a->addr.ss_family == AF_INET) {
+        ((struct sockaddr_in*)&a->addr)->sin_port = htons((uint16_t)port);
+    } else if (a->addr.ss_family == AF_INET6) {
+        ((struct sockaddr_in6*)&a->addr)->sin6_port = htons((uint16_t)port);
+    }
+}
+
+/* Copy into `req` with its port. Caller holds g_lock (or owns `addrs`). */
+static bool resolver_fill(colyseus_resolve_t* req, const colyseus_resolved_addr_t* addrs, size_t count) {
+    if (count == 0) return false;
+    req->addrs = malloc(count * sizeof(colyseus_resolved_addr_t));
+    if (!req->addrs) return false;
+    memcpy(req->addrs, addrs, count * sizeof(colyseus_resolved_addr_t));
+    req->count = count;
+    for (size_t i = 0; i < count; i++) {
+        resolver_set_port(&req->addrs[i], req->port);
+    }
+    return true;
+}
+
+/* getaddrinfo() already sorts by RFC 6724 preference; interleave the
+ * families from there (RFC 8305 section 4) so a dead family costs one
+ * attempt delay, not one per address. */
+static size_t resolver_collect(const struct addrinfo* list, colyseus_resolved_addr_t* out) {
+    colyseus_resolved_addr_t v6[RESOLVER_ADDRS_MAX], v4[RESOLVER_ADDRS_MAX];
+    size_t n6 = 0, n4 = 0;
+    int first_family = 0;
+
+    for (const struct addrinfo* ai = list; ai; ai = ai->ai_next) {
+        if (ai->ai_addrlen > sizeof(struct sockaddr_storage)) continue;
+        colyseus_resolved_addr_t* slot;
+        if (ai->ai_family == AF_INET6 && n6 < RESOLVER_ADDRS_MAX) {
+            slot = &v6[n6++];
+        } else if (ai->ai_family == AF_INET && n4 < RESOLVER_ADDRS_MAX) {
+            slot = &v4[n4++];
+        } else {
+            continue;
+        }
+        if (!first_family) first_family = ai->ai_family;
+        memset(slot, 0, sizeof(*slot));
+        memcpy(&slot->addr, ai->ai_addr, ai->ai_addrlen);
+        slot->len = (socklen_t)ai->ai_addrlen;
+    }
+
+    size_t count = 0, i6 = 0, i4 = 0;
+    bool take_v6 = first_family != AF_INET;
+    while (count < RESOLVER_ADDRS_MAX && (i6 < n6 || i4 < n4)) {
+        if ((take_v6 && i6 < n6) || i4 >= n4) {
+            out[count++] = v6[i6++];
+        } else {
+            out[count++] = v4[i4++];
+        }
+        take_v6 = !take_v6;
+    }
+    return count;
+}
+
+/* ── Cache ── */
+
+static resolver_entry_t* resolver_find(const char* host) {
+    for (resolver_entry_t** link = &g_cache; *link; link = &(*link)->next) {
+        resolver_entry_t* e = *link;
+        if (strcmp(e->host, host) == 0) {
+            *link = e->next;  /* move to the front */
+            e->next = g_cache;
+            g_cache = e;
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void resolver_evict(void) {
+    int count = 0;
+    for (resolver_entry_t** link = &g_cache; *link; ) {
+        resolver_entry_t* e = *link;
+        if (++count > RESOLVER_CACHE_MAX && !e->resolving) {
+            *link = e->next;
+            free(e->host);
+            free(e->addrs);
+            free(e);
+            continue;
+        }
+        link = &e->next;
+    }
+}
+
+/* ── Lookup threads ── */
+
+#ifdef _WIN32
+static DWORD WINAPI resolver_thread_func(void* arg);
+#else
+static void* resolver_thread_func(void* arg);
+#endif
+
+/* Caller holds g_lock */
+static void resolver_queue(resolver_entry_t* e) {
+    e->resolving = true;
+    e->job_next = NULL;
+    if (g_jobs_tail) g_jobs_tail->job_next = e; else g_jobs_head = e;
+    g_jobs_tail = e;
+
+    if (g_threads >= RESOLVER_THREADS_MAX) return;
+#ifdef _WIN32
+    HANDLE thread = CreateThread(NULL, 0, resolver_thread_func, NULL, 0, NULL);
+    if (thread) {
+        CloseHandle(thread);
+        g_threads++;
+    }
+#else
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, resolver_thread_func, NULL) == 0) {
+        pthread_detach(thread);
+        g_threads++;
+    }
+#endif
+    /* No thread could be started: a running one picks the job up; with
+     * none at all, the waiters fail below. */
+    if (g_threads == 0) {
+        g_jobs_head = g_jobs_tail = NULL;
+        e->resolving = false;
+        while (e->waiters) {
+            colyseus_resolve_t* w = e->waiters;
+            e->waiters = w->next;
+            w->entry = NULL;
+            atomic_store(&w->status, COLYSEUS_RESOLVE_FAILED);
+        }
+    }
+}
+
+/* Caller holds g_lock */
+static void resolver_complete(resolver_entry_t* e) {
+    e->resolving = false;
+    while (e->waiters) {
+        colyseus_resolve_t* w = e->waiters;
+        e->waiters = w->next;
+        w->entry = NULL;
+        bool ok = resolver_fill(w, e->addrs, e->count);
+        atomic_store(&w->status, ok ? COLYSEUS_RESOLVE_DONE : COLYSEUS_RESOLVE_FAILED);
+        if (w->on_done) w->on_done(w->ctx);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI resolver_thread_func(void* arg) {
+#else
+static void* resolver_thread_func(void* arg) {
+#endif
+    (void)arg;
+    resolver_lock(&g_lock);
+    while (g_jobs_head) {
+        resolver_entry_t* e = g_jobs_head;
+        g_jobs_head = e->job_next;
+        if (!g_jobs_head) g_jobs_tail = NULL;
+        /* The entry isn't evicted or renamed while resolving */
+        const char* host = e->host;
+        resolver_unlock(&g_lock);
+
+        uint64_t started = colyseus_monotonic_ms();
+        struct addrinfo hints, *list = NULL;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        int ret = getaddrinfo(host, NULL, &hints, &list);
+
+        colyseus_resolved_addr_t found[RESOLVER_ADDRS_MAX];
+        size_t count = ret == 0 ? resolver_collect(list, found) : 0;
+        if (list) freeaddrinfo(list);
+        RESOLVER_LOG("%s: %zu address(es) in %llu ms (getaddrinfo=%d)", host, count,
+                     (unsigned long long)(colyseus_monotonic_ms() - started), ret);
+
+        colyseus_resolved_addr_t* addrs = count ? malloc(count * sizeof(colyseus_resolved_addr_t)) : NULL;
+        if (addrs) memcpy(addrs, found, count * sizeof(colyseus_resolved_addr_t));
+
+        resolver_lock(&g_lock);
+        if (addrs) {
+            free(e->addrs);
+            e->addrs = addrs;
+            e->count = count;
+            e->expires_ms = colyseus_monotonic_ms() + atomic_load(&g_ttl_ms);
+        }
+        /* Failed refresh: waiters get the stale addresses, if any */
+        resolver_complete(e);
+    }
+    g_threads--;
+    resolver_unlock(&g_lock);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* ── API ── */
+
+/* IPv4 / IPv6 literals need no lookup */
+static size_t resolver_parse_numeric(const char* host, colyseus_resolved_addr_t* out) {
+    memset(out, 0, sizeof(*out));
+    struct sockaddr_in* v4 = (struct sockaddr_in*)&out->addr;
+    if (inet_pton(AF_INET, host, &v4->sin_addr) == 1) {
+        v4->sin_family = AF_INET;
+        out->len = sizeof(struct sockaddr_in);
+        return 1;
+    }
+    struct sockaddr_in6* v6 = (struct sockaddr_in6*)&out->addr;
+    if (inet_pton(AF_INET6, host, &v6->sin6_addr) == 1) {
+        v6->sin6_family = AF_INET6;
+        out->len = sizeof(struct sockaddr_in6);
+        return 1;
+    }
+    return 0;
+}
+
+colyseus_resolve_t* colyseus_resolve_start(const char* host, int port,
+                                           colyseus_resolve_fn on_done, void* ctx) {
+    if (!host) return NULL;
+    colyseus_resolve_t* req = calloc(1, sizeof(colyseus_resolve_t));
+    if (!req) return NULL;
+    req->port = port;
+    req->on_done = on_done;
+    req->ctx = ctx;
+    atomic_init(&req->status, COLYSEUS_RESOLVE_PENDING);
+
+    colyseus_resolved_addr_t numeric;
+    if (resolver_parse_numeric(host, &numeric)) {
+        req->cached = true;
+        atomic_store(&req->status, resolver_fill(req, &numeric, 1) ? COLYSEUS_RESOLVE_DONE
+                                                                  : COLYSEUS_RESOLVE_FAILED);
+        return req;
+    }
+
+    resolver_lock(&g_lock);
+    resolver_entry_t* e = resolver_find(host);
+    if (e && e->count > 0 && colyseus_monotonic_ms() < e->expires_ms) {
+        req->cached = true;
+        atomic_store(&req->status, resolver_fill(req, e->addrs, e->count) ? COLYSEUS_RESOLVE_DONE
+                                                                          : COLYSEUS_RESOLVE_FAILED);
+        resolver_unlock(&g_lock);
+        return req;
+    }
+
+    if (!e) {
+        e = calloc(1, sizeof(resolver_entry_t));
+        if (e) e->host = strdup(host);
+        if (!e || !e->host) {
+            resolver_unlock(&g_lock);
+            free(e);
+            free(req);
+            return NULL;
+        }
+        e->next = g_cache;
+        g_cache = e;
+        resolver_evict();
+    }
+
+    req->entry = e;
+    req->next = e->waiters;
+    e->waiters = req;
+    if (!e->resolving) resolver_queue(e);
+    resolver_unlock(&g_lock);
+    return req;
+}
+
+int colyseus_resolve_status(const colyseus_resolve_t* req) {
+    return req ? atomic_load(&req->status) : COLYSEUS_RESOLVE_FAILED;
+}
+
+const colyseus_resolved_addr_t* colyseus_resolve_addresses(const colyseus_resolve_t* req,
+                                                           size_t* count) {
+    if (!req || atomic_load(&req->status) != COLYSEUS_RESOLVE_DONE) {
+        if (count) *count = 0;
+        return NULL;
+    }
+    if (count) *count = req->count;
+    return req->addrs;
+}
+
+bool colyseus_resolve_was_cached(const colyseus_resolve_t* req) {
+    return req && req->cached;
+}
+
+void colyseus_resolve_free(colyseus_resolve_t* req) {
+    if (!req) return;
+    resolver_lock(&g_lock);
+    if (req->entry) {
+        for (colyseus_resolve_t** link = &req->entry->waiters; *link; link = &(*link)->next) {
+            if (*link == req) {
+                *link = req->next;
+                break;
+            }
+        }
+        req->entry = NULL;
+    }
+    resolver_unlock(&g_lock);
+    free(req->addrs);
+    free(req);
+}
+
+void colyseus_resolver_prefetch(const char* host) {
+    colyseus_resolve_free(colyseus_resolve_start(host, 0, NULL, NULL));
+}
+
+void colyseus_resolver_invalidate(const char* host) {
+    if (!host) return;
+    resolver_lock(&g_lock);
+    for (resolver_entry_t* e = g_cache; e; e = e->next) {
+        if (strcmp(e->host, host) == 0) {
+            e->expires_ms = 0;
+            break;
+        }
+    }
+    resolver_unlock(&g_lock);
+}
+
+void colyseus_resolver_set_ttl_ms(uint32_t ttl_ms) {
+    atomic_store(&g_ttl_ms, ttl_ms);
+}
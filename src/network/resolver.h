@@ -0,0 +1,81 @@
+#ifndef COLYSEUS_RESOLVER_H
+#define COLYSEUS_RESOLVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <sys/socket.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host name resolution (internal)
+ *
+ * getaddrinfo() blocks, so lookups run on short-lived resolver threads and
+ * the caller polls or gets a callback. Results are cached per host and
+ * shared by every connection in the process (WebSocket transports, and
+ * http.zig prefetches through it). Concurrent lookups of one host share a
+ * single getaddrinfo() call. getaddrinfo() doesn't report record TTLs, so
+ * entries live for a fixed time; an expired entry is still used if the
+ * refresh fails.
+ *
+ * Addresses come back in RFC 8305 order: the resolver's preferred family
+ * first, then alternating IPv6 / IPv4.
+ */
+
+#define COLYSEUS_RESOLVE_PENDING  0
+#define COLYSEUS_RESOLVE_DONE     1
+#define COLYSEUS_RESOLVE_FAILED  -1
+
+typedef struct {
+    struct sockaddr_storage addr;
+    socklen_t len;
+} colyseus_resolved_addr_t;
+
+typedef struct colyseus_resolve colyseus_resolve_t;
+
+/* Runs on a resolver thread, with the resolver's lock held: it may only
+ * signal the owner (no resolver calls). */
+typedef void (*colyseus_resolve_fn)(void* ctx);
+
+/* Start resolving host:port. NULL on allocation failure. Numeric hosts and
+ * cache hits complete immediately and never call `on_done`. */
+colyseus_resolve_t* colyseus_resolve_start(const char* host, int port,
+                                           colyseus_resolve_fn on_done, void* ctx);
+
+/* COLYSEUS_RESOLVE_*. Any thread. */
+int colyseus_resolve_status(const colyseus_resolve_t* req);
+
+/* The addresses, ports set, once DONE. Owned by the request. */
+const colyseus_resolved_addr_t* colyseus_resolve_addresses(const colyseus_resolve_t* req,
+                                                           size_t* count);
+
+/* True if no lookup was needed (cache hit or numeric host) */
+bool colyseus_resolve_was_cached(const colyseus_resolve_t* req);
+
+/* Cancel if pending and free. `on_done` never runs after this returns. */
+void colyseus_resolve_free(colyseus_resolve_t* req);
+
+/* Start a lookup in the background so a later connect hits the cache */
+void colyseus_resolver_prefetch(const char* host);
+
+/* Make the next connect to `host` look it up again (none of the cached
+ * addresses could be reached). They stay as the fallback. */
+void colyseus_resolver_invalidate(const char* host);
+
+/* How long results are reused, in milliseconds (default 60000) */
+void colyseus_resolver_set_ttl_ms(uint32_t ttl_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_RESOLVER_H */
@@ -0,0 +1,374 @@
+#include "colyseus/tls_context.h"
+#include "certs/system_certs.h"
+#include "certs/ca_bundle.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    typedef SRWLOCK tls_lock_t;
+    #define TLS_LOCK_INITIALIZER SRWLOCK_INIT
+    static void tls_lock_init(tls_lock_t* lock) { InitializeSRWLock(lock); }
+    static void tls_lock_destroy(tls_lock_t* lock) { (void)lock; }
+    static void tls_lock(tls_lock_t* lock) { AcquireSRWLockExclusive(lock); }
+    static void tls_unlock(tls_lock_t* lock) { ReleaseSRWLockExclusive(lock); }
+#else
+    #include <pthread.h>
+    typedef pthread_mutex_t tls_lock_t;
+    #define TLS_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+    static void tls_lock_init(tls_lock_t* lock) { pthread_mutex_init(lock, NULL); }
+    static void tls_lock_destroy(tls_lock_t* lock) { pthread_mutex_destroy(lock); }
+    static void tls_lock(tls_lock_t* lock) { pthread_mutex_lock(lock); }
+    static void tls_unlock(tls_lock_t* lock) { pthread_mutex_unlock(lock); }
+#endif
+
+/* Same switch as the WebSocket transport's diagnostics */
+static int tls_debug_enabled(void) {
+    static int cached = -1;
+    if (cached == -1) {
+        const char* v = getenv("COLYSEUS_WS_DEBUG");
+        cached = (v && v[0] && v[0] != '0') ? 1 : 0;
+    }
+    return cached;
+}
+
+#define TLS_LOG(fmt, ...) do { \
+    if (tls_debug_enabled()) { fprintf(stderr, "[TLS] " fmt "\n", ##__VA_ARGS__); fflush(stderr); } \
+} while (0)
+
+/* Unreferenced configurations kept for the next connect (reconnects reuse
+ * them); older idle ones are freed. */
+#define TLS_CONFIG_IDLE_MAX 4
+
+/* Resumable sessions kept per configuration (one per host:port) */
+#define TLS_SESSION_CACHE_MAX 16
+
+typedef struct tls_session_entry {
+    char* host;
+    int port;
+    mbedtls_ssl_session session;
+    struct tls_session_entry* next;
+} tls_session_entry_t;
+
+struct colyseus_tls_config {
+    mbedtls_ssl_config conf;
+    mbedtls_entropy_context entropy;
+    mbedtls_ctr_drbg_context ctr_drbg;
+    mbedtls_x509_crt ca_chain;
+    bool ca_chain_initialized;
+
+    /* mbedtls is built without MBEDTLS_THREADING_C: every connection
+     * draws from the shared DRBG through this lock. */
+    tls_lock_t rng_lock;
+
+    /* Most recently used first, guarded by session_lock */
+    tls_session_entry_t* sessions;
+    tls_lock_t session_lock;
+
+    /* Key */
+    bool skip_verify;
+    unsigned char* ca_pem;    /* copy of the settings override */
+    size_t ca_pem_len;
+
+    int refs;                 /* guarded by g_registry_lock */
+    struct colyseus_tls_config* next;
+};
+
+/* Most recently used first */
+static tls_lock_t g_registry_lock = TLS_LOCK_INITIALIZER;
+static colyseus_tls_config_t* g_configs = NULL;
+static atomic_int g_build_count;
+
+static int tls_config_random(void* ctx, unsigned char* out, size_t len) {
+    colyseus_tls_config_t* config = (colyseus_tls_config_t*)ctx;
+    tls_lock(&config->rng_lock);
+    int ret = mbedtls_ctr_drbg_random(&config->ctr_drbg, out, len);
+    tls_unlock(&config->rng_lock);
+    return ret;
+}
+
+/* Parse one PEM CA source into the chain. mbedtls parses permissively and
+ * appends, so sources are additive. `pem` must be null-terminated with
+ * `pem_len` including the terminator. Returns 1 if at least one certificate was
+ * added, else 0 (empty/unparseable source — logged, non-fatal). */
+static int tls_config_add_ca(mbedtls_x509_crt* chain, const unsigned char* pem,
+                             size_t pem_len, const char* source) {
+    if (!pem || pem_len == 0) return 0;
+
+    int ret = mbedtls_x509_crt_parse(chain, pem, pem_len);
+    if (ret < 0) {
+        TLS_LOG("CA source '%s' failed to parse: -0x%04x", source, (unsigned int)(-ret));
+        return 0;
+    }
+    if (ret > 0) {
+        TLS_LOG("CA source '%s' loaded (%d cert(s) skipped)", source, ret);
+    } else {
+        TLS_LOG("CA source '%s' loaded", source);
+    }
+    return 1;
+}
+
+static void tls_session_entry_free(tls_session_entry_t* entry) {
+    mbedtls_ssl_session_free(&entry->session);
+    free(entry->host);
+    free(entry);
+}
+
+static void tls_config_free(colyseus_tls_config_t* config) {
+    while (config->sessions) {
+        tls_session_entry_t* next = config->sessions->next;
+        tls_session_entry_free(config->sessions);
+        config->sessions = next;
+    }
+    mbedtls_ssl_config_free(&config->conf);
+    mbedtls_ctr_drbg_free(&config->ctr_drbg);
+    mbedtls_entropy_free(&config->entropy);
+    if (config->ca_chain_initialized) {
+        mbedtls_x509_crt_free(&config->ca_chain);
+    }
+    tls_lock_destroy(&config->rng_lock);
+    tls_lock_destroy(&config->session_lock);
+    free(config->ca_pem);
+    free(config);
+}
+
+static colyseus_tls_config_t* tls_config_build(bool skip_verify, const unsigned char* ca_pem,
+                                               size_t ca_pem_len, const char** out_err) {
+    colyseus_tls_config_t* config = calloc(1, sizeof(colyseus_tls_config_t));
+    if (!config) {
+        if (out_err) *out_err = "TLS allocation failed";
+        return NULL;
+    }
+
+    mbedtls_ssl_config_init(&config->conf);
+    mbedtls_entropy_init(&config->entropy);
+    mbedtls_ctr_drbg_init(&config->ctr_drbg);
+    tls_lock_init(&config->rng_lock);
+    tls_lock_init(&config->session_lock);
+    config->skip_verify = skip_verify;
+    if (ca_pem && ca_pem_len > 0) {
+        config->ca_pem = malloc(ca_pem_len);
+        if (!config->ca_pem) {
+            if (out_err) *out_err = "TLS allocation failed";
+            tls_config_free(config);
+            return NULL;
+        }
+        memcpy(config->ca_pem, ca_pem, ca_pem_len);
+        config->ca_pem_len = ca_pem_len;
+    }
+
+    if (mbedtls_ctr_drbg_seed(&config->ctr_drbg, mbedtls_entropy_func, &config->entropy, NULL, 0) != 0 ||
+        mbedtls_ssl_config_defaults(&config->conf, MBEDTLS_SSL_IS_CLIENT,
+                                    MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+        if (out_err) *out_err = "TLS configuration failed";
+        tls_config_free(config);
+        return NULL;
+    }
+
+    if (skip_verify) {
+        mbedtls_ssl_conf_authmode(&config->conf, MBEDTLS_SSL_VERIFY_NONE);
+    } else {
+        mbedtls_ssl_conf_authmode(&config->conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+
+        /* Merge every available CA source into one trust chain rather than
+         * picking a single one. mbedtls appends and parses permissively, so the
+         * sources are additive. The bundled Mozilla set is always included as a
+         * device-independent baseline; the system store and any settings-
+         * provided override are layered on top for private/enterprise roots.
+         *
+         * The previous pick-one order let a device's system store shadow the
+         * bundled set (and aborted TLS entirely if that store failed to parse),
+         * which made Android release builds fail non-deterministically when the
+         * server's root was missing from the device store (#24). */
+        mbedtls_x509_crt_init(&config->ca_chain);
+        config->ca_chain_initialized = true;
+
+        int sources = 0;
+
+        /* Bundled Mozilla CA — always present, deterministic baseline. */
+        sources += tls_config_add_ca(&config->ca_chain, colyseus_ca_bundle_pem,
+                                     colyseus_ca_bundle_pem_len, "bundled Mozilla CA");
+
+        /* System trust store — additive; picks up device/enterprise roots. */
+        if (colyseus_system_certs_init()) {
+            sources += tls_config_add_ca(&config->ca_chain, colyseus_system_certs_get_pem(),
+                                         colyseus_system_certs_get_pem_len(), "system");
+        }
+
+        /* Explicit settings/override certificates — additive. */
+        sources += tls_config_add_ca(&config->ca_chain, config->ca_pem,
+                                     config->ca_pem_len, "settings");
+
+        if (sources == 0) {
+            TLS_LOG("No CA certificates could be loaded - cannot verify TLS peer");
+            if (out_err) *out_err = "No CA certificates available for TLS verification";
+            tls_config_free(config);
+            return NULL;
+        }
+
+        mbedtls_ssl_conf_ca_chain(&config->conf, &config->ca_chain, NULL);
+    }
+
+    mbedtls_ssl_conf_rng(&config->conf, tls_config_random, config);
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+    mbedtls_ssl_conf_session_tickets(&config->conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#if defined(MBEDTLS_SSL_PROTO_TLS1_3) && defined(MBEDTLS_SSL_TLS1_3_SIGNAL_NEW_SESSION_TICKETS_ENABLED)
+    /* Since 3.6.1 TLS 1.3 tickets are discarded unless mbedtls_ssl_read()
+     * reports them (MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) */
+    mbedtls_ssl_conf_tls13_enable_signal_new_session_tickets(
+        &config->conf, MBEDTLS_SSL_TLS1_3_SIGNAL_NEW_SESSION_TICKETS_ENABLED);
+#endif
+#endif
+
+    atomic_fetch_add(&g_build_count, 1);
+    TLS_LOG("TLS configuration built (skip_verify=%d, override=%zu bytes)",
+            (int)skip_verify, ca_pem_len);
+    return config;
+}
+
+static bool tls_config_matches(const colyseus_tls_config_t* config, bool skip_verify,
+                               const unsigned char* ca_pem, size_t ca_pem_len) {
+    if (config->skip_verify != skip_verify) return false;
+    /* Verification is off: the CA sources don't matter */
+    if (skip_verify) return true;
+    if (!ca_pem) ca_pem_len = 0;
+    return config->ca_pem_len == ca_pem_len &&
+           (ca_pem_len == 0 || memcmp(config->ca_pem, ca_pem, ca_pem_len) == 0);
+}
+
+colyseus_tls_config_t* colyseus_tls_config_acquire(bool skip_verify,
+                                                   const unsigned char* ca_pem,
+                                                   size_t ca_pem_len,
+                                                   const char** out_err) {
+    /* Built under the lock: when many connections start at once, one of
+     * them parses the CA sources and the others wait for the result. */
+    tls_lock(&g_registry_lock);
+
+    colyseus_tls_config_t** link = &g_configs;
+    colyseus_tls_config_t* config = NULL;
+    while (*link) {
+        if (tls_config_matches(*link, skip_verify, ca_pem, ca_pem_len)) {
+            config = *link;
+            *link = config->next;  /* moved to the front below */
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    if (!config) {
+        config = tls_config_build(skip_verify, skip_verify ? NULL : ca_pem,
+                                  skip_verify ? 0 : ca_pem_len, out_err);
+        if (!config) {
+            tls_unlock(&g_registry_lock);
+            return NULL;
+        }
+    }
+
+    config->refs++;
+    config->next = g_configs;
+    g_configs = config;
+
+    tls_unlock(&g_registry_lock);
+    return config;
+}
+
+void colyseus_tls_config_release(colyseus_tls_config_t* config) {
+    if (!config) return;
+
+    colyseus_tls_config_t* evicted = NULL;
+    tls_lock(&g_registry_lock);
+    config->refs--;
+
+    /* Keep the TLS_CONFIG_IDLE_MAX most recently used idle configurations */
+    int idle = 0;
+    for (colyseus_tls_config_t** link = &g_configs; *link; ) {
+        colyseus_tls_config_t* c = *link;
+        if (c->refs == 0 && ++idle > TLS_CONFIG_IDLE_MAX) {
+            *link = c->next;
+            c->next = evicted;
+            evicted = c;
+            continue;
+        }
+        link = &c->next;
+    }
+    tls_unlock(&g_registry_lock);
+
+    while (evicted) {
+        colyseus_tls_config_t* next = evicted->next;
+        tls_config_free(evicted);
+        evicted = next;
+    }
+}
+
+bool colyseus_tls_config_offer_session(colyseus_tls_config_t* config, const char* host,
+                                       int port, mbedtls_ssl_context* ssl) {
+    if (!config || config->skip_verify || !host) return false;
+
+    bool offered = false;
+    tls_lock(&config->session_lock);
+    for (tls_session_entry_t* e = config->sessions; e; e = e->next) {
+        if (e->port == port && strcmp(e->host, host) == 0) {
+            /* Copied into the connection; the entry stays for other joins */
+            offered = mbedtls_ssl_set_session(ssl, &e->session) == 0;
+            break;
+        }
+    }
+    tls_unlock(&config->session_lock);
+    return offered;
+}
+
+void colyseus_tls_config_save_session(colyseus_tls_config_t* config, const char* host,
+                                      int port, mbedtls_ssl_context* ssl) {
+    if (!config || config->skip_verify || !host) return;
+
+    tls_session_entry_t* fresh = calloc(1, sizeof(tls_session_entry_t));
+    if (!fresh) return;
+    mbedtls_ssl_session_init(&fresh->session);
+    fresh->port = port;
+    fresh->host = strdup(host);
+
+    /* Fails when there is nothing to resume yet (TLS 1.3 before a ticket
+     * arrives, or a server that issues neither IDs nor tickets) */
+    int ret = mbedtls_ssl_get_session(ssl, &fresh->session);
+    if (ret != 0 || !fresh->host) {
+        tls_session_entry_free(fresh);
+        return;
+    }
+
+    tls_session_entry_t* stale = NULL;
+    tls_lock(&config->session_lock);
+    int count = 0;
+    for (tls_session_entry_t** link = &config->sessions; *link; ) {
+        tls_session_entry_t* e = *link;
+        if ((e->port == port && strcmp(e->host, host) == 0) ||
+            ++count >= TLS_SESSION_CACHE_MAX) {
+            *link = e->next;
+            e->next = stale;
+            stale = e;
+            continue;
+        }
+        link = &e->next;
+    }
+    fresh->next = config->sessions;
+    config->sessions = fresh;
+    tls_unlock(&config->session_lock);
+
+    while (stale) {
+        tls_session_entry_t* next = stale->next;
+        tls_session_entry_free(stale);
+        stale = next;
+    }
+    TLS_LOG("TLS session saved for %s:%d", host, port);
+}
+
+const mbedtls_ssl_config* colyseus_tls_config_get_ssl_config(const colyseus_tls_config_t* config) {
+    return config ? &config->conf : NULL;
+}
+
+int colyseus_tls_config_get_build_count(void) {
+    return atomic_load(&g_build_count);
+}
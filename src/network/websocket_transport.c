@@ -1,15 +1,19 @@
 #include "colyseus/websocket_transport.h"
 #include "colyseus/utils/strUtil.h"
+#include "colyseus/utils/inflate.h"
 #include "sds.h"
 #include <wslay/wslay.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
+#include <stdatomic.h>
 #include "../../include/colyseus/tls_context.h"
 #include "colyseus/settings.h"
-#include "certs/system_certs.h"
-#include "certs/ca_bundle.h"
+#include "colyseus/utils/time.h"
+#include "io_loop.h"
+#include "resolver.h"
+#include "utils/spinlock.h"
 
 /* Platform-specific includes */
 #ifdef _WIN32
@@ -28,6 +32,11 @@
     #include <fcntl.h>
     #include <arpa/inet.h>
     #include <netinet/tcp.h>  /* For TCP keepalive options */
+    #include <poll.h>
+    #include <sys/uio.h>
+    #ifdef __linux__
+        #include <sys/eventfd.h>
+    #endif
     typedef pthread_t thread_t;
     typedef void* thread_return_t;
     #define THREAD_CALL
@@ -64,6 +73,8 @@ static void ws_hex_dump(const char* tag, const uint8_t* buf, size_t len) {
 /* Forward declarations */
 static void ws_connect_impl(colyseus_transport_t* transport, const char* url);
 static void ws_send_impl(colyseus_transport_t* transport, const uint8_t* data, size_t length);
+static void ws_send_parts_impl(colyseus_transport_t* transport, const colyseus_transport_buf_t* parts, size_t count);
+static void ws_send_batch_impl(colyseus_transport_t* transport, const colyseus_transport_buf_t* messages, size_t count);
 static void ws_send_unreliable_impl(colyseus_transport_t* transport, const uint8_t* data, size_t length);
 static void ws_close_impl(colyseus_transport_t* transport, int code, const char* reason);
 static bool ws_is_open_impl(const colyseus_transport_t* transport);
@@ -78,22 +89,81 @@ static void ws_tls_cleanup(colyseus_ws_transport_data_t* data);
 #define WS_TLS_HS_CERT_FAILED -2
 static int ws_tls_handshake_tick(colyseus_ws_transport_data_t* data);
 
+/* Result codes for the connect / HTTP upgrade steps. Failures must close,
+ * otherwise the event-driven tick loop would wait on a dead socket. */
+#define WS_STEP_PENDING  0
+#define WS_STEP_DONE     1
+#define WS_STEP_FAILED  -1
+
 /* Internal functions */
 static thread_return_t THREAD_CALL ws_tick_thread_func(void* arg);
 static void ws_tick_once(colyseus_transport_t* transport);
 static bool ws_connect_init(colyseus_ws_transport_data_t* data);
-static bool ws_connect_tick(colyseus_ws_transport_data_t* data);
+static int ws_connect_tick(colyseus_ws_transport_data_t* data);
+typedef struct ws_connector ws_connector_t;
+static void ws_connector_free(colyseus_ws_transport_data_t* data);
+static void ws_on_resolved(void* ctx);
+static int ws_io_timeout_ms(colyseus_ws_transport_data_t* data);
+static void ws_start_upgrade(colyseus_ws_transport_data_t* data);
+static void ws_prewarm_apply(colyseus_transport_t* transport);
+static void ws_prewarm_settle(colyseus_transport_t* transport);
+static void ws_prewarm_free(colyseus_ws_transport_data_t* data);
 static bool ws_http_handshake_init(colyseus_ws_transport_data_t* data);
-static bool ws_http_handshake_send(colyseus_ws_transport_data_t* data);
-static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data);
+static int ws_http_handshake_send(colyseus_ws_transport_data_t* data);
+static int ws_http_handshake_receive(colyseus_ws_transport_data_t* data);
 static ssize_t ws_socket_recv(colyseus_ws_transport_data_t* data, uint8_t* buf, size_t len, int* would_block, int* eof);
 static ssize_t ws_socket_send(colyseus_ws_transport_data_t* data, const uint8_t* buf, size_t len, int* would_block);
 static void ws_socket_close(colyseus_ws_transport_data_t* data);
 static void ws_cleanup_wslay(colyseus_ws_transport_data_t* data);
+static void ws_stop_io(colyseus_ws_transport_data_t* data);
+static void ws_finish_deferred_close(colyseus_transport_t* transport);
+static bool ws_io_attach(colyseus_transport_t* transport);
+static void ws_io_on_ready(void* ctx);
+static bool ws_io_step(colyseus_transport_t* transport);
+static int ws_io_interest(colyseus_ws_transport_data_t* data, bool* immediate);
+
+/* Tick thread wakeup / I/O wait */
+static bool ws_wakeup_init(colyseus_ws_transport_data_t* data);
+static void ws_wakeup_signal(colyseus_ws_transport_data_t* data);
+static void ws_wakeup_drain(colyseus_ws_transport_data_t* data);
+static void ws_wakeup_close(colyseus_ws_transport_data_t* data);
+static void ws_wait_for_io(colyseus_ws_transport_data_t* data);
+
+/* Outbound send queue */
+typedef struct ws_send_queue ws_send_queue_t;
+static ws_send_queue_t* ws_send_queue_create(void);
+static void ws_send_queue_free(ws_send_queue_t* q);
+static void ws_send_queue_clear(ws_send_queue_t* q);
+static bool ws_send_queue_push(ws_send_queue_t* q, const colyseus_transport_buf_t* parts, size_t count);
+static void ws_send_queue_count_call(ws_send_queue_t* q);
+static bool ws_send_queue_take_wakeup(ws_send_queue_t* q);
+static bool ws_send_queue_in_flight(const ws_send_queue_t* q);
+static bool ws_send_queue_pending(ws_send_queue_t* q);
+static int ws_flush_outbound(colyseus_ws_transport_data_t* data);
+
+/* Inbound frame reader */
+typedef struct ws_frame_reader ws_frame_reader_t;
+static ws_frame_reader_t* ws_frame_reader_create(void);
+static void ws_frame_reader_free(ws_frame_reader_t* r);
+static void ws_frame_reader_reset(ws_frame_reader_t* r);
+static bool ws_frame_reader_absorb(ws_frame_reader_t* r, const uint8_t* bytes, size_t length);
+static bool ws_frame_reader_has_frame(const ws_frame_reader_t* r);
+static uint16_t ws_frame_reader_close_code(const ws_frame_reader_t* r);
+static int ws_receive(colyseus_transport_t* transport, const char** reason);
+static bool ws_frame_reader_enable_deflate(ws_frame_reader_t* r, int window_bits,
+                                           bool context_takeover, size_t max_memory);
+static int ws_deflate_window_bits(size_t max_memory);
+
+/* Pings and pong deadline */
+typedef struct ws_keepalive ws_keepalive_t;
+static ws_keepalive_t* ws_keepalive_create(void);
+static void ws_keepalive_start(ws_keepalive_t* k);
+static void ws_keepalive_seen(ws_keepalive_t* k);
+static void ws_keepalive_on_pong(ws_keepalive_t* k, const uint8_t* payload, size_t length);
+static bool ws_keepalive_tick(colyseus_ws_transport_data_t* data);
+static int ws_keepalive_timeout_ms(const ws_keepalive_t* k);
 
 /* wslay callbacks */
-static void ws_on_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg* arg, void* user_data);
-static ssize_t ws_recv_callback(wslay_event_context_ptr ctx, uint8_t* data, size_t len, int flags, void* user_data);
 static ssize_t ws_send_callback(wslay_event_context_ptr ctx, const uint8_t* data, size_t len, int flags, void* user_data);
 static int ws_genmask_callback(wslay_event_context_ptr ctx, uint8_t* buf, size_t len, void* user_data);
 
@@ -109,6 +179,8 @@ colyseus_transport_t* colyseus_websocket_transport_create(const colyseus_transpo
     transport->close = ws_close_impl;
     transport->is_open = ws_is_open_impl;
     transport->destroy = ws_destroy_impl;
+    transport->send_parts = ws_send_parts_impl;
+    transport->send_batch = ws_send_batch_impl;
 
     /* Copy events */
     if (events) {
@@ -132,8 +204,14 @@ colyseus_transport_t* colyseus_websocket_transport_create(const colyseus_transpo
     data->pending_close_code = 0;
     data->pending_close_reason = NULL;
     data->socket_fd = -1;
+    data->wakeup_fds[0] = -1;
+    data->wakeup_fds[1] = -1;
+    data->wakeup_socket = -1;
     data->buffer_size = 8192;
     data->buffer = malloc(data->buffer_size);
+    data->send_queue = ws_send_queue_create();
+    data->frame_reader = ws_frame_reader_create();
+    data->keepalive = ws_keepalive_create();
     data->use_tls = false;
     data->tls_skip_verify = false;
     data->tls_ctx = NULL;
@@ -159,7 +237,9 @@ static void ws_connect_impl(colyseus_transport_t* transport, const char* url) {
 
     data->url = strdup(url);
 
-    if (!ws_connect_init(data)) {
+    bool io_ready = data->external_loop ? true :
+                    data->io_runtime ? ws_io_attach(transport) : ws_wakeup_init(data);
+    if (!io_ready || !ws_connect_init(data)) {
         WS_LOG("Connect init failed");
         free(data->url);
         data->url = NULL;
@@ -173,6 +253,19 @@ static void ws_connect_impl(colyseus_transport_t* transport, const char* url) {
     data->state = COLYSEUS_WS_CONNECTING;
     data->running = true;
 
+    /* External loop: the host drives it through colyseus_transport_on_*() */
+    if (data->external_loop) {
+        WS_LOG("Driven by external event loop");
+        return;
+    }
+
+    /* Shared runtime: the handle's first on_ready starts the state machine */
+    if (data->io_handle) {
+        colyseus_io_handle_wake((colyseus_io_handle_t*)data->io_handle);
+        WS_LOG("Attached to shared I/O runtime");
+        return;
+    }
+
     /* Create tick thread */
 #ifdef _WIN32
     data->tick_thread = CreateThread(NULL, 0, ws_tick_thread_func, transport, 0, NULL);
@@ -186,24 +279,59 @@ static void ws_connect_impl(colyseus_transport_t* transport, const char* url) {
 }
 
 static void ws_send_impl(colyseus_transport_t* transport, const uint8_t* data, size_t length) {
+    colyseus_transport_buf_t part = { data, length };
+    ws_send_parts_impl(transport, &part, 1);
+}
+
+static void ws_send_parts_impl(colyseus_transport_t* transport, const colyseus_transport_buf_t* parts, size_t count) {
     colyseus_ws_transport_data_t* impl = (colyseus_ws_transport_data_t*)transport->impl_data;
 
-    WS_LOG("ws_send_impl called: state=%d length=%zu", impl->state, length);
-    ws_hex_dump("ws_send_impl_payload", data, length);
+    WS_LOG("ws_send_impl called: state=%d parts=%zu", impl->state, count);
+    for (size_t i = 0; i < count; i++) {
+        ws_hex_dump("ws_send_impl_payload", parts[i].data, parts[i].length);
+    }
 
     if (impl->state != COLYSEUS_WS_CONNECTED) {
         WS_LOG("ws_send_impl: DROPPING - not connected (state=%d)", impl->state);
         return;
     }
 
-    struct wslay_event_msg msg = {
-        .opcode = WSLAY_BINARY_FRAME,
-        .msg = data,
-        .msg_length = length
-    };
+    /* Frame on the caller's thread; the tick thread only writes bytes out.
+     * Never touches wslay_ctx, so this is safe from any thread. */
+    ws_send_queue_t* q = (ws_send_queue_t*)impl->send_queue;
+    if (!ws_send_queue_push(q, parts, count)) {
+        WS_LOG("ws_send_impl: DROPPING - out of memory");
+        return;
+    }
+
+    /* The tick thread is blocked in poll(); wake it to flush the frame now.
+     * Wakeups are coalesced until the tick thread drains the queue. */
+    if (ws_send_queue_take_wakeup(q)) {
+        ws_wakeup_signal(impl);
+    }
+}
 
-    int qret = wslay_event_queue_msg(impl->wslay_ctx, &msg);
-    WS_LOG("wslay_event_queue_msg returned %d", qret);
+static void ws_send_batch_impl(colyseus_transport_t* transport, const colyseus_transport_buf_t* messages, size_t count) {
+    colyseus_ws_transport_data_t* impl = (colyseus_ws_transport_data_t*)transport->impl_data;
+
+    WS_LOG("ws_send_batch_impl called: state=%d messages=%zu", impl->state, count);
+    if (impl->state != COLYSEUS_WS_CONNECTED) {
+        WS_LOG("ws_send_batch_impl: DROPPING - not connected (state=%d)", impl->state);
+        return;
+    }
+
+    /* Queue every frame before the single wakeup, so the tick thread
+     * writes them out together (one writev / TLS record batch) */
+    ws_send_queue_t* q = (ws_send_queue_t*)impl->send_queue;
+    for (size_t i = 0; i < count; i++) {
+        if (!ws_send_queue_push(q, &messages[i], 1)) {
+            WS_LOG("ws_send_batch_impl: DROPPING %zu messages - out of memory", count - i);
+            break;
+        }
+    }
+    if (ws_send_queue_take_wakeup(q)) {
+        ws_wakeup_signal(impl);
+    }
 }
 
 static void ws_send_unreliable_impl(colyseus_transport_t* transport, const uint8_t* data, size_t length) {
@@ -213,6 +341,29 @@ static void ws_send_unreliable_impl(colyseus_transport_t* transport, const uint8
     (void)length;
 }
 
+/* Best effort, before the socket goes: flush queued frames, then the close
+ * frame unless a data frame is still half-written (it would corrupt the
+ * stream). A close from the server is answered by echoing its status
+ * (RFC 6455 §5.5.1); 1005 / 1006 / 1015 never go on the wire. Tick thread
+ * only (or after it joined). */
+static void ws_send_close_frame(colyseus_ws_transport_data_t* data, int code, const char* reason) {
+    bool remote = data->state == COLYSEUS_WS_REMOTE_DISCONNECT;
+    if (!data->wslay_ctx || (data->state != COLYSEUS_WS_CONNECTED && !remote)) return;
+
+    ws_flush_outbound(data);
+    if (ws_send_queue_in_flight((ws_send_queue_t*)data->send_queue)) return;
+
+    if (code == 1005 || code == 1006 || code == 1015) {
+        wslay_event_queue_close(data->wslay_ctx, 0, NULL, 0);
+    } else if (remote) {
+        wslay_event_queue_close(data->wslay_ctx, (uint16_t)code, NULL, 0);
+    } else {
+        wslay_event_queue_close(data->wslay_ctx, (uint16_t)code, (const uint8_t*)reason,
+                                reason ? strlen(reason) : 0);
+    }
+    wslay_event_send(data->wslay_ctx);
+}
+
 static void ws_close_impl(colyseus_transport_t* transport, int code, const char* reason) {
     colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
 
@@ -221,18 +372,7 @@ static void ws_close_impl(colyseus_transport_t* transport, int code, const char*
          * The tick thread function has returned by now (or is about to),
          * but the OS handle hasn't been reaped yet — join it before
          * destroy() releases the surrounding struct. */
-        if (data->tick_thread) {
-#ifdef _WIN32
-            WaitForSingleObject(data->tick_thread, INFINITE);
-            CloseHandle(data->tick_thread);
-            data->tick_thread = NULL;
-#else
-            pthread_t* thread = (pthread_t*)data->tick_thread;
-            pthread_join(*thread, NULL);
-            free(thread);
-            data->tick_thread = NULL;
-#endif
-        }
+        ws_stop_io(data);
         return;
     }
 
@@ -248,34 +388,26 @@ static void ws_close_impl(colyseus_transport_t* transport, int code, const char*
         return;
     }
 
+    /* Stop the tick thread first: it may be blocked in poll() on the socket,
+     * so wake it, and wait for it before touching wslay / TLS state. */
     data->running = false;
+    ws_wakeup_signal(data);
+    ws_stop_io(data);
 
-    if (data->wslay_ctx && data->state == COLYSEUS_WS_CONNECTED) {
-        wslay_event_queue_close(data->wslay_ctx, code, (const uint8_t*)reason, reason ? strlen(reason) : 0);
-        wslay_event_send(data->wslay_ctx);
+    /* The tick thread ran a deferred close (and on_close) while exiting */
+    if (data->state == COLYSEUS_WS_DISCONNECTED) {
+        return;
     }
 
+    ws_send_close_frame(data, code, reason);
+
     ws_tls_cleanup(data);
+    ws_connector_free(data);
     ws_socket_close(data);
     ws_cleanup_wslay(data);
 
-    /* Wait for thread */
-#ifdef _WIN32
-    if (data->tick_thread) {
-        WaitForSingleObject(data->tick_thread, INFINITE);
-        CloseHandle(data->tick_thread);
-        data->tick_thread = NULL;
-    }
-#else
-    if (data->tick_thread) {
-        pthread_t* thread = (pthread_t*)data->tick_thread;
-        pthread_join(*thread, NULL);
-        free(thread);
-        data->tick_thread = NULL;
-    }
-#endif
-
     data->state = COLYSEUS_WS_DISCONNECTED;
+    ws_prewarm_settle(transport);
 
     if (transport->events.on_close) {
         transport->events.on_close(code, reason, transport->events.userdata);
@@ -300,6 +432,12 @@ static void ws_destroy_impl(colyseus_transport_t* transport) {
         free(data->client_key);
         free(data->buffer);
         free(data->pending_close_reason);
+        colyseus_io_handle_release((colyseus_io_handle_t*)data->io_handle);
+        ws_send_queue_free((ws_send_queue_t*)data->send_queue);
+        ws_frame_reader_free((ws_frame_reader_t*)data->frame_reader);
+        free(data->keepalive);
+        ws_wakeup_close(data);
+        ws_prewarm_free(data);
         free(data);
     }
 
@@ -316,59 +454,125 @@ static thread_return_t THREAD_CALL ws_tick_thread_func(void* arg) {
     while (data->running) {
         ws_tick_once(transport);
 
+        /* Block until the socket is ready or ws_send_impl()/close wakes us */
+        if (data->running) {
+            ws_wait_for_io(data);
+        }
+    }
+
+    data->in_tick_thread = false;
+
+    /* Handle deferred close (was requested from within tick thread) */
+    ws_finish_deferred_close(transport);
+
 #ifdef _WIN32
-        Sleep(10);  /* 10ms */
+    return 0;
 #else
-        usleep(10000);  /* 10ms */
+    return NULL;
 #endif
+}
+
+/* Close requested from within the tick thread / an on_ready callback.
+ * Doesn't touch the transport after on_close (which may destroy it). */
+static void ws_finish_deferred_close(colyseus_transport_t* transport) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    if (!data->pending_close) return;
+
+    int code = data->pending_close_code;
+    char* reason = data->pending_close_reason;
+    data->pending_close_reason = NULL;
+    data->pending_close = false;
+
+    WS_LOG("Handling deferred close: code=%d, reason=%s", code, reason ? reason : "(null)");
+
+    ws_send_close_frame(data, code, reason);
+    ws_tls_cleanup(data);
+    ws_connector_free(data);
+    ws_socket_close(data);
+    ws_cleanup_wslay(data);
+
+    data->state = COLYSEUS_WS_DISCONNECTED;
+    ws_prewarm_settle(transport);
+
+    if (transport->events.on_close) {
+        transport->events.on_close(code, reason, transport->events.userdata);
     }
 
-    data->in_tick_thread = false;
+    free(reason);
+}
 
-    /* Handle deferred close (was requested from within tick thread) */
-    if (data->pending_close) {
-        WS_LOG("Handling deferred close: code=%d, reason=%s",
-               data->pending_close_code,
-               data->pending_close_reason ? data->pending_close_reason : "(null)");
+/* Shared I/O runtime: replaces the tick thread. The runtime calls
+ * ws_io_on_ready() when the socket matches the interest set here, or after
+ * a wakeup (send/close), and never concurrently for one transport. */
+static bool ws_io_attach(colyseus_transport_t* transport) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    colyseus_io_handle_release((colyseus_io_handle_t*)data->io_handle);
+    data->io_handle = colyseus_io_handle_attach((colyseus_io_runtime_t*)data->io_runtime,
+                                                ws_io_on_ready, transport);
+    return data->io_handle != NULL;
+}
 
-        ws_tls_cleanup(data);
-        ws_socket_close(data);
-        ws_cleanup_wslay(data);
+/* One step of the state machine for the event-driven drivers (runtime,
+ * external loop). Returns false once the transport has stopped; the caller
+ * must then run ws_finish_deferred_close() as its last action. */
+static bool ws_io_step(colyseus_transport_t* transport) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
 
-        data->state = COLYSEUS_WS_DISCONNECTED;
+    data->in_tick_thread = true;
+    ws_tick_once(transport);
+    data->in_tick_thread = false;
 
-        if (transport->events.on_close) {
-            transport->events.on_close(data->pending_close_code,
-                                       data->pending_close_reason,
-                                       transport->events.userdata);
-        }
+    return data->running;
+}
 
-        free(data->pending_close_reason);
-        data->pending_close_reason = NULL;
-        data->pending_close = false;
+static void ws_io_on_ready(void* ctx) {
+    colyseus_transport_t* transport = (colyseus_transport_t*)ctx;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    colyseus_io_handle_t* handle = (colyseus_io_handle_t*)data->io_handle;
+
+    if (!data->running) return;
+
+    if (!ws_io_step(transport)) {
+        colyseus_io_handle_set_interest(handle, -1, 0);
+        ws_finish_deferred_close(transport);
+        return;
     }
 
-#ifdef _WIN32
-    return 0;
-#else
-    return NULL;
-#endif
+    bool immediate = false;
+    int events = ws_io_interest(data, &immediate);
+    colyseus_io_handle_set_interest(handle, data->socket_fd, events);
+    if (immediate) {
+        colyseus_io_handle_wake(handle);
+    }
+    int timeout = ws_io_timeout_ms(data);
+    colyseus_io_handle_set_deadline(handle, timeout < 0 ? 0 : colyseus_monotonic_ms() + (uint64_t)timeout);
 }
 
 static void ws_tick_once(colyseus_transport_t* transport) {
     colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
 
+    if (data->warm_only) {
+        ws_prewarm_apply(transport);
+    }
+
     if (data->state == COLYSEUS_WS_CONNECTED) {
-        int ret = wslay_event_recv(data->wslay_ctx);
+        const char* reason = NULL;
+        int ret = ws_receive(transport, &reason);
         if (ret != 0) {
-            WS_LOG("wslay_event_recv error: %d", ret);
-            ws_close_impl(transport, 1006, "Receive error");
+            WS_LOG("receive error: %d (%s)", ret, reason);
+            ws_close_impl(transport, ret, reason);
+            return;
+        }
+
+        if (!ws_keepalive_tick(data)) {
+            WS_LOG("no answer to ping, closing");
+            ws_close_impl(transport, 1006, "Ping timeout");
             return;
         }
 
-        ret = wslay_event_send(data->wslay_ctx);
+        ret = ws_flush_outbound(data);
         if (ret != 0) {
-            WS_LOG("wslay_event_send error: %d", ret);
+            WS_LOG("outbound flush error: %d", ret);
             ws_close_impl(transport, 1006, "Send error");
             return;
         }
@@ -378,15 +582,21 @@ static void ws_tick_once(colyseus_transport_t* transport) {
 
     if (data->state == COLYSEUS_WS_REMOTE_DISCONNECT) {
         WS_LOG("Remote disconnect");
-        uint16_t code = wslay_event_get_status_code_received(data->wslay_ctx);
+        uint16_t code = ws_frame_reader_close_code((ws_frame_reader_t*)data->frame_reader);
         ws_close_impl(transport, code, "Remote disconnect");
         return;
     }
 
     /* State machine */
     if (data->state == COLYSEUS_WS_CONNECTING) {
-        if (ws_connect_tick(data)) {
+        int step = ws_connect_tick(data);
+        if (step == WS_STEP_FAILED) {
+            ws_close_impl(transport, 1006, "Connection failed");
+            return;
+        }
+        if (step == WS_STEP_DONE) {
             WS_LOG("TCP connected");
+            data->phase_started_ms = colyseus_monotonic_ms();
             if (data->use_tls) {
                 const char* tls_err = "TLS init failed";
                 if (!ws_tls_init(data, &tls_err)) {
@@ -395,17 +605,16 @@ static void ws_tick_once(colyseus_transport_t* transport) {
                 }
                 data->state = COLYSEUS_WS_TLS_HANDSHAKE;
             } else {
-                data->state = COLYSEUS_WS_HANDSHAKE_SENDING;
-                ws_http_handshake_init(data);
+                ws_start_upgrade(data);
             }
         }
     }
     else if (data->state == COLYSEUS_WS_TLS_HANDSHAKE) {
         int hs = ws_tls_handshake_tick(data);
         if (hs == WS_TLS_HS_DONE) {
-            WS_LOG("TLS handshake complete");
-            data->state = COLYSEUS_WS_HANDSHAKE_SENDING;
-            ws_http_handshake_init(data);
+            data->tls_ms = (uint32_t)(colyseus_monotonic_ms() - data->phase_started_ms);
+            WS_LOG("TLS handshake complete in %u ms", data->tls_ms);
+            ws_start_upgrade(data);
         } else if (hs == WS_TLS_HS_CERT_FAILED) {
             ws_close_impl(transport, 1015, "TLS certificate verification failed");
             return;
@@ -415,28 +624,50 @@ static void ws_tick_once(colyseus_transport_t* transport) {
         }
     }
     else if (data->state == COLYSEUS_WS_HANDSHAKE_SENDING) {
-        if (ws_http_handshake_send(data)) {
+        int step = ws_http_handshake_send(data);
+        if (step == WS_STEP_FAILED) {
+            ws_close_impl(transport, 1006, "WebSocket handshake failed");
+            return;
+        }
+        if (step == WS_STEP_DONE) {
             WS_LOG("Handshake sent");
             data->state = COLYSEUS_WS_HANDSHAKE_RECEIVING;
         }
     }
     else if (data->state == COLYSEUS_WS_HANDSHAKE_RECEIVING) {
-        if (ws_http_handshake_receive(data)) {
-            WS_LOG("Handshake received, WS connected");
+        int step = ws_http_handshake_receive(data);
+        if (step == WS_STEP_FAILED) {
+            ws_close_impl(transport, 1006, "WebSocket handshake failed");
+            return;
+        }
+        if (step == WS_STEP_DONE) {
+            data->upgrade_ms = (uint32_t)(colyseus_monotonic_ms() - data->phase_started_ms);
+            WS_LOG("Handshake received in %u ms, WS connected", data->upgrade_ms);
             data->state = COLYSEUS_WS_CONNECTED;
 
             /* Initialize wslay */
+            /* wslay only writes control frames (pong, close); frames are
+             * received by ws_receive() */
             struct wslay_event_callbacks callbacks = {
-                ws_recv_callback,
+                NULL,
                 ws_send_callback,
                 ws_genmask_callback,
                 NULL,
                 NULL,
                 NULL,
-                ws_on_msg_recv_callback
+                NULL
             };
 
             wslay_event_context_client_init(&data->wslay_ctx, &callbacks, transport);
+            ws_keepalive_start((ws_keepalive_t*)data->keepalive);
+
+            /* Frames that arrived with the upgrade response */
+            if (!ws_frame_reader_absorb((ws_frame_reader_t*)data->frame_reader,
+                                        (const uint8_t*)data->buffer, data->buffer_offset)) {
+                ws_close_impl(transport, 1006, "Out of memory");
+                return;
+            }
+            data->buffer_offset = 0;
 
             WS_LOG("Calling on_open callback");
 
@@ -445,8 +676,171 @@ static void ws_tick_once(colyseus_transport_t* transport) {
             }
         }
     }
+    else if (data->state == COLYSEUS_WS_WARM) {
+        /* The server sends nothing before the upgrade: readable means it
+         * closed the idle connection (TLS 1.3 tickets are taken on the way) */
+        uint8_t byte;
+        int would_block = 0;
+        int eof = 0;
+        ssize_t n = ws_socket_recv(data, &byte, 1, &would_block, &eof);
+        if (!would_block || n != 0) {
+            WS_LOG("Pre-warmed connection lost");
+            ws_close_impl(transport, 1006, "Connection lost");
+            return;
+        }
+    }
+}
+
+/* TCP (and TLS) is up: send the upgrade, or wait for its URL when
+ * pre-warming */
+static void ws_start_upgrade(colyseus_ws_transport_data_t* data) {
+    if (data->warm_only) {
+        WS_LOG("Pre-warmed, waiting for the upgrade");
+        data->state = COLYSEUS_WS_WARM;
+        return;
+    }
+    data->phase_started_ms = colyseus_monotonic_ms();
+    data->state = COLYSEUS_WS_HANDSHAKE_SENDING;
+    ws_http_handshake_init(data);
+}
+
+/* Pre-warming
+ *
+ * The URL (and the events to report to) arrive from another thread while
+ * the driver owns the connection, so they're handed over through `state`:
+ * colyseus_websocket_upgrade() moves it from WAITING to REQUESTED, and the
+ * driver applies the request on its next step. If the warm connection dies
+ * first, the driver moves it to CLOSED and the upgrade is refused; if both
+ * race, the request wins and the failure is reported to its events. */
+
+#define WS_PREWARM_WAITING   0
+#define WS_PREWARM_REQUESTED 1
+#define WS_PREWARM_CLOSED    2
+
+typedef struct {
+    atomic_int state;
+    char* url;
+    sds url_path;
+    colyseus_transport_events_t events;
+} ws_prewarm_t;
+
+bool colyseus_websocket_prewarm(colyseus_transport_t* transport, const char* url,
+                                const colyseus_settings_t* settings) {
+    if (!transport || !url || (settings && settings->external_event_loop)) return false;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    if (data->state != COLYSEUS_WS_DISCONNECTED || data->prewarm) return false;
+
+    ws_prewarm_t* p = calloc(1, sizeof(ws_prewarm_t));
+    if (!p) return false;
+    atomic_init(&p->state, WS_PREWARM_WAITING);
+    data->prewarm = p;
+    data->warm_only = true;
+
+    /* The events are swapped at the upgrade: report nothing until then */
+    memset(&transport->events, 0, sizeof(colyseus_transport_events_t));
+    colyseus_websocket_connect_with_settings(transport, url, settings);
+    return data->url != NULL;  /* only cleared when the connect couldn't start */
+}
+
+bool colyseus_websocket_upgrade(colyseus_transport_t* transport, const char* url,
+                                const colyseus_transport_events_t* events) {
+    if (!transport || !url) return false;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    ws_prewarm_t* p = (ws_prewarm_t*)data->prewarm;
+    if (!p || !data->url_host || atomic_load(&p->state) != WS_PREWARM_WAITING) return false;
+
+    /* url_host / url_port / use_tls were set before the driver started */
+    colyseus_url_parts_t* parts = colyseus_parse_url(url);
+    if (!parts) return false;
+    bool tls = strcmp(parts->scheme, "wss") == 0;
+    int port = parts->port ? *parts->port : (tls ? 443 : 80);
+    bool same = tls == data->use_tls && port == data->url_port &&
+                strcmp(parts->host, data->url_host) == 0;
+    if (same) {
+        p->url = strdup(url);
+        p->url_path = sdscatprintf(sdsempty(), "/%s", parts->path_and_args);
+        p->events = events ? *events : (colyseus_transport_events_t){0};
+    }
+    colyseus_url_parts_free(parts);
+    if (!same || !p->url) return false;
+
+    int expected = WS_PREWARM_WAITING;
+    if (!atomic_compare_exchange_strong(&p->state, &expected, WS_PREWARM_REQUESTED)) {
+        return false;  /* it just died; ws_prewarm_free() takes url / path */
+    }
+    ws_wakeup_signal(data);
+    return true;
+}
+
+/* Driver: take a requested upgrade */
+static void ws_prewarm_apply(colyseus_transport_t* transport) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    ws_prewarm_t* p = (ws_prewarm_t*)data->prewarm;
+    if (!p || atomic_load(&p->state) != WS_PREWARM_REQUESTED) return;
+
+    transport->events = p->events;
+    free(data->url);
+    data->url = p->url;
+    sdsfree(data->url_path);
+    data->url_path = p->url_path;
+    p->url = NULL;
+    p->url_path = NULL;
+    data->warm_only = false;
+
+    WS_LOG("Upgrading pre-warmed connection: %s", data->url);
+    if (data->state == COLYSEUS_WS_WARM) {
+        ws_start_upgrade(data);
+    }
+}
+
+/* Driver, closing: a pending upgrade gets the failure, otherwise refuse
+ * later ones */
+static void ws_prewarm_settle(colyseus_transport_t* transport) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    ws_prewarm_t* p = (ws_prewarm_t*)data->prewarm;
+    if (!p || !data->warm_only) return;
+
+    int expected = WS_PREWARM_WAITING;
+    if (!atomic_compare_exchange_strong(&p->state, &expected, WS_PREWARM_CLOSED)) {
+        ws_prewarm_apply(transport);
+    }
+}
+
+static void ws_prewarm_free(colyseus_ws_transport_data_t* data) {
+    ws_prewarm_t* p = (ws_prewarm_t*)data->prewarm;
+    if (!p) return;
+    free(p->url);
+    sdsfree(p->url_path);
+    free(p);
+    data->prewarm = NULL;
 }
 
+/* Connection racing (RFC 8305, "Happy Eyeballs")
+ *
+ * Attempts start on the resolved addresses in order, the next one after
+ * WS_CONNECT_ATTEMPT_DELAY_MS or as soon as the previous one fails, and the
+ * first to complete wins. The drivers only watch data->socket_fd, the
+ * newest attempt; older ones are checked every WS_CONNECT_RECHECK_MS while
+ * more than one is in flight. A new socket is always opened before a failed
+ * one is closed, so its fd number never repeats the watched one (the
+ * runtime would take it for the registration the kernel just dropped). */
+
+#define WS_CONNECT_ATTEMPT_DELAY_MS 250
+#define WS_CONNECT_RECHECK_MS       25
+#define WS_CONNECT_ATTEMPTS_MAX     8   /* in flight at once */
+#define WS_RESOLVE_POLL_MS          10  /* external loop: nothing wakes the host */
+
+struct ws_connector {
+    colyseus_resolve_t* resolve;
+    bool resolved;
+    size_t next_addr;
+    int fds[WS_CONNECT_ATTEMPTS_MAX];  /* oldest first */
+    int count;
+    uint64_t started_ms;
+    uint64_t resolved_ms;
+    uint64_t next_attempt_ms;
+};
+
 /* Connection functions */
 static bool ws_connect_init(colyseus_ws_transport_data_t* data) {
     colyseus_url_parts_t* parts = colyseus_parse_url(data->url);
@@ -467,19 +861,69 @@ static bool ws_connect_init(colyseus_ws_transport_data_t* data) {
 
     colyseus_url_parts_free(parts);
 
-    /* Create socket */
-    data->socket_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (data->socket_fd < 0) {
+    /* Resolution runs off this thread; ws_connect_tick() takes it from here */
+    ws_connector_free(data);
+    ws_connector_t* c = calloc(1, sizeof(ws_connector_t));
+    if (!c) {
+        return false;
+    }
+    c->started_ms = colyseus_monotonic_ms();
+    data->connector = c;
+    data->resolve_ms = 0;
+    data->connect_ms = 0;
+    data->connect_attempts = 0;
+    data->tls_ms = 0;
+    data->upgrade_ms = 0;
+
+    c->resolve = colyseus_resolve_start(data->url_host, data->url_port, ws_on_resolved, data);
+    if (!c->resolve) {
+        ws_connector_free(data);
         return false;
     }
+    return true;
+}
+
+static void ws_close_fd(int fd) {
+#ifdef _WIN32
+    closesocket(fd);
+#else
+    close(fd);
+#endif
+}
+
+/* Resolver thread */
+static void ws_on_resolved(void* ctx) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)ctx;
+    if (data->io_handle) {
+        colyseus_io_handle_wake((colyseus_io_handle_t*)data->io_handle);
+    } else if (!data->external_loop) {
+        ws_wakeup_signal(data);
+    }
+}
+
+/* Closes the attempts still in flight; data->socket_fd is only kept once it
+ * won. */
+static void ws_connector_free(colyseus_ws_transport_data_t* data) {
+    ws_connector_t* c = (ws_connector_t*)data->connector;
+    if (!c) return;
+
+    for (int i = 0; i < c->count; i++) {
+        if (c->fds[i] == data->socket_fd) data->socket_fd = -1;
+        ws_close_fd(c->fds[i]);
+    }
+    colyseus_resolve_free(c->resolve);
+    free(c);
+    data->connector = NULL;
+}
 
+static void ws_socket_configure(int fd) {
     /* Set non-blocking */
 #ifdef _WIN32
     u_long mode = 1;
-    ioctlsocket(data->socket_fd, FIONBIO, &mode);
+    ioctlsocket(fd, FIONBIO, &mode);
 #else
-    int flags = fcntl(data->socket_fd, F_GETFL, 0);
-    fcntl(data->socket_fd, F_SETFL, flags | O_NONBLOCK);
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
 #endif
 
     /* Enable TCP keepalive to detect dead connections faster */
@@ -495,64 +939,182 @@ static bool ws_connect_init(colyseus_ws_transport_data_t* data) {
         .keepaliveinterval = 5000  /* 5 seconds between probes */
     };
     DWORD bytes_returned;
-    WSAIoctl(data->socket_fd, SIO_KEEPALIVE_VALS, &keepalive_vals, sizeof(keepalive_vals),
+    WSAIoctl(fd, SIO_KEEPALIVE_VALS, &keepalive_vals, sizeof(keepalive_vals),
              NULL, 0, &bytes_returned, NULL, NULL);
 #else
     int keepalive = 1;
-    setsockopt(data->socket_fd, SOL_SOCKET, SO_KEEPALIVE, (const char*)&keepalive, sizeof(keepalive));
+    setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, (const char*)&keepalive, sizeof(keepalive));
 
 #ifdef __linux__
     /* Linux-specific: set keepalive parameters for faster detection */
     int keepidle = 10;   /* Start probing after 10 seconds of inactivity */
     int keepintvl = 5;   /* Probe interval: 5 seconds */
     int keepcnt = 3;     /* Give up after 3 failed probes */
-    setsockopt(data->socket_fd, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle));
-    setsockopt(data->socket_fd, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl));
-    setsockopt(data->socket_fd, IPPROTO_TCP, TCP_KEEPCNT, &keepcnt, sizeof(keepcnt));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &keepcnt, sizeof(keepcnt));
 #elif defined(__APPLE__)
     /* macOS: set keepalive idle time */
     int keepidle = 10;
-    setsockopt(data->socket_fd, IPPROTO_TCP, TCP_KEEPALIVE, &keepidle, sizeof(keepidle));
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPALIVE, &keepidle, sizeof(keepidle));
 #endif
 #endif /* _WIN32 */
 
-    /* Resolve hostname using getaddrinfo (modern, alignment-safe) */
-    struct addrinfo hints, *result;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-    
-    char port_str[16];
-    snprintf(port_str, sizeof(port_str), "%d", data->url_port);
-    
-    if (getaddrinfo(data->url_host, port_str, &hints, &result) != 0) {
-        ws_socket_close(data);
-        return false;
-    }
+    /* Frames are coalesced by the transport itself (one write per flush);
+     * Nagle would only hold small messages back for an ACK. */
+    int nodelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+}
 
-    /* Connect */
-    connect(data->socket_fd, result->ai_addr, result->ai_addrlen);
-    freeaddrinfo(result);
+/* Start a non-blocking connect. Returns the socket, or -1 if it failed
+ * right away (e.g. no route for that family). */
+static int ws_connect_start(const colyseus_resolved_addr_t* addr) {
+    int fd = (int)socket(addr->addr.ss_family, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    ws_socket_configure(fd);
 
-    return true;
+    if (connect(fd, (const struct sockaddr*)&addr->addr, addr->len) != 0) {
+#ifdef _WIN32
+        bool in_progress = WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        bool in_progress = errno == EINPROGRESS;
+#endif
+        if (!in_progress) {
+            ws_close_fd(fd);
+            return -1;
+        }
+    }
+    return fd;
 }
 
-static bool ws_connect_tick(colyseus_ws_transport_data_t* data) {
-    fd_set write_fds;
+/* 1 connected, 0 still connecting, -1 failed */
+static int ws_connect_check(int fd) {
+#ifdef _WIN32
+    /* A failed connect shows up in the except set (WSAPoll misses it on
+     * older Windows) */
+    fd_set write_fds, except_fds;
     FD_ZERO(&write_fds);
-    FD_SET(data->socket_fd, &write_fds);
-
+    FD_ZERO(&except_fds);
+    FD_SET(fd, &write_fds);
+    FD_SET(fd, &except_fds);
     struct timeval tv = {0, 0};
-    int ret = select(data->socket_fd + 1, NULL, &write_fds, NULL, &tv);
+    if (select(fd + 1, NULL, &write_fds, &except_fds, &tv) <= 0) return 0;
+#else
+    struct pollfd pfd = { fd, POLLOUT, 0 };
+    if (poll(&pfd, 1, 0) <= 0) return 0;
+#endif
+
+    int error = 0;
+    socklen_t len = sizeof(error);
+    getsockopt(fd, SOL_SOCKET, SO_ERROR, (char*)&error, &len);
+    if (error != 0) {
+        WS_LOG("connect() failed: %d", error);
+        return -1;
+    }
+    return 1;
+}
+
+static int ws_connect_tick(colyseus_ws_transport_data_t* data) {
+    ws_connector_t* c = (ws_connector_t*)data->connector;
+    if (!c) return WS_STEP_FAILED;
+
+    if (!c->resolved) {
+        int status = colyseus_resolve_status(c->resolve);
+        if (status == COLYSEUS_RESOLVE_PENDING) return WS_STEP_PENDING;
+        if (status == COLYSEUS_RESOLVE_FAILED) {
+            WS_LOG("Could not resolve %s", data->url_host);
+            return WS_STEP_FAILED;
+        }
+        c->resolved = true;
+        c->resolved_ms = colyseus_monotonic_ms();
+        data->resolve_ms = colyseus_resolve_was_cached(c->resolve) ? 0 :
+                           (uint32_t)(c->resolved_ms - c->started_ms);
+        WS_LOG("Resolved %s in %u ms%s", data->url_host, data->resolve_ms,
+               colyseus_resolve_was_cached(c->resolve) ? " (cached)" : "");
+    }
+
+    size_t addr_count = 0;
+    const colyseus_resolved_addr_t* addrs = colyseus_resolve_addresses(c->resolve, &addr_count);
+
+    /* Settle the attempts in flight. Failed ones stay open until the next
+     * attempt has its socket (see above). */
+    int failed[WS_CONNECT_ATTEMPTS_MAX];
+    int failed_count = 0;
+    for (int i = 0; i < c->count; ) {
+        int result = ws_connect_check(c->fds[i]);
+        if (result > 0) {
+            int fd = c->fds[i];
+            memmove(&c->fds[i], &c->fds[i + 1], (size_t)(c->count - i - 1) * sizeof(int));
+            c->count--;
+            for (int j = 0; j < failed_count; j++) ws_close_fd(failed[j]);
+
+            data->connect_ms = (uint32_t)(colyseus_monotonic_ms() - c->resolved_ms);
+            WS_LOG("Connected on attempt %u in %u ms", data->connect_attempts, data->connect_ms);
+            ws_connector_free(data);  /* closes the losers */
+            data->socket_fd = fd;
+            return WS_STEP_DONE;
+        }
+        if (result < 0) {
+            failed[failed_count++] = c->fds[i];
+            memmove(&c->fds[i], &c->fds[i + 1], (size_t)(c->count - i - 1) * sizeof(int));
+            c->count--;
+            c->next_attempt_ms = 0;  /* don't wait for the delay */
+            continue;
+        }
+        i++;
+    }
+
+    uint64_t now = colyseus_monotonic_ms();
+    while (c->next_addr < addr_count && c->count < WS_CONNECT_ATTEMPTS_MAX &&
+           now >= c->next_attempt_ms) {
+        data->connect_attempts++;
+        int fd = ws_connect_start(&addrs[c->next_addr++]);
+        if (fd < 0) continue;
+        c->fds[c->count++] = fd;
+        c->next_attempt_ms = now + WS_CONNECT_ATTEMPT_DELAY_MS;
+    }
+    for (int j = 0; j < failed_count; j++) ws_close_fd(failed[j]);
+
+    if (c->count == 0) {
+        WS_LOG("No address of %s could be reached", data->url_host);
+        data->socket_fd = -1;
+        if (colyseus_resolve_was_cached(c->resolve)) {
+            colyseus_resolver_invalidate(data->url_host);
+        }
+        return WS_STEP_FAILED;
+    }
+
+    data->socket_fd = c->fds[c->count - 1];
+    return WS_STEP_PENDING;
+}
+
+/* Milliseconds until the connect state machine needs to run again without
+ * socket activity, -1 for none. */
+static int ws_io_timeout_ms(colyseus_ws_transport_data_t* data) {
+    if (data->state == COLYSEUS_WS_CONNECTED) {
+        return ws_keepalive_timeout_ms((const ws_keepalive_t*)data->keepalive);
+    }
 
-    if (ret > 0 && FD_ISSET(data->socket_fd, &write_fds)) {
-        int error = 0;
-        socklen_t len = sizeof(error);
-        getsockopt(data->socket_fd, SOL_SOCKET, SO_ERROR, (char*)&error, &len);
-        return error == 0;
+    ws_connector_t* c = (ws_connector_t*)data->connector;
+    if (data->state != COLYSEUS_WS_CONNECTING || !c) return -1;
+
+    if (!c->resolved) {
+        return data->external_loop ? WS_RESOLVE_POLL_MS : -1;
     }
 
-    return false;
+    int timeout = -1;
+    size_t addr_count = 0;
+    colyseus_resolve_addresses(c->resolve, &addr_count);
+    if (c->next_addr < addr_count && c->count < WS_CONNECT_ATTEMPTS_MAX) {
+        uint64_t now = colyseus_monotonic_ms();
+        timeout = c->next_attempt_ms > now ? (int)(c->next_attempt_ms - now) : 0;
+    }
+    if (c->count > 1 && (timeout < 0 || timeout > WS_CONNECT_RECHECK_MS)) {
+        timeout = WS_CONNECT_RECHECK_MS;
+    }
+    return timeout;
 }
 
 static bool ws_http_handshake_init(colyseus_ws_transport_data_t* data) {
@@ -573,6 +1135,15 @@ static bool ws_http_handshake_init(colyseus_ws_transport_data_t* data) {
     request = sdscat(request, "Connection: Upgrade\r\n");
     request = sdscat(request, "Sec-WebSocket-Version: 13\r\n");
     request = sdscatprintf(request, "Sec-WebSocket-Key: %s\r\n", data->client_key);
+    if (data->compression) {
+        int window_bits = ws_deflate_window_bits(data->compression_max_memory);
+        if (window_bits < 15) {
+            request = sdscatprintf(request,
+                "Sec-WebSocket-Extensions: permessage-deflate; server_max_window_bits=%d\r\n", window_bits);
+        } else {
+            request = sdscat(request, "Sec-WebSocket-Extensions: permessage-deflate\r\n");
+        }
+    }
     request = sdscat(request, "\r\n");
 
     /* Copy to buffer */
@@ -595,7 +1166,7 @@ static bool ws_http_handshake_init(colyseus_ws_transport_data_t* data) {
 /* Continue with handshake send/receive and wslay callbacks... */
 /* (Due to length, showing key parts - full implementation follows same pattern as C++ version) */
 
-static bool ws_http_handshake_send(colyseus_ws_transport_data_t* data) {
+static int ws_http_handshake_send(colyseus_ws_transport_data_t* data) {
     size_t total_len = data->handshake_len;
 
     while (data->buffer_offset < total_len) {
@@ -605,8 +1176,8 @@ static bool ws_http_handshake_send(colyseus_ws_transport_data_t* data) {
             total_len - data->buffer_offset,
             &would_block);
 
-        if (sent < 0) return false;
-        if (would_block) return false;
+        if (sent < 0) return WS_STEP_FAILED;
+        if (would_block) return WS_STEP_PENDING;
 
         data->buffer_offset += sent;
     }
@@ -614,10 +1185,114 @@ static bool ws_http_handshake_send(colyseus_ws_transport_data_t* data) {
     /* Reset for receiving */
     data->buffer_offset = 0;
     memset(data->buffer, 0, data->buffer_size);
+    return WS_STEP_DONE;
+}
+
+/* permessage-deflate (RFC 7692)
+ *
+ * Only the server compresses. Client messages go out uncompressed, which
+ * the extension allows, so there is no deflater and the client_* response
+ * parameters are accepted as-is. The inflater keeps the server's window
+ * across messages (context takeover) unless the server opts out. */
+
+/* Largest window that leaves 3/4 of the memory cap for messages */
+static int ws_deflate_window_bits(size_t max_memory) {
+    int bits = 15;
+    while (bits > 9 && ((size_t)1 << bits) > max_memory / 4) bits--;
+    return bits;
+}
+
+static bool ws_token_equals(const char* s, size_t len, const char* token) {
+    if (len != strlen(token)) return false;
+    for (size_t i = 0; i < len; i++) {
+        char ch = s[i];
+        if (ch >= 'A' && ch <= 'Z') ch = (char)(ch - 'A' + 'a');
+        if (ch != token[i]) return false;
+    }
     return true;
 }
 
-static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
+static void ws_token_trim(const char** s, size_t* len) {
+    while (*len > 0 && (**s == ' ' || **s == '\t' || **s == '"')) { (*s)++; (*len)--; }
+    while (*len > 0 && ((*s)[*len - 1] == ' ' || (*s)[*len - 1] == '\t' || (*s)[*len - 1] == '"')) (*len)--;
+}
+
+/* Apply the Sec-WebSocket-Extensions response header. False when the
+ * server accepted something that wasn't offered. */
+static bool ws_negotiate_extensions(colyseus_ws_transport_data_t* data, const char* headers, size_t length) {
+    const int offered_bits = ws_deflate_window_bits(data->compression_max_memory);
+    bool deflate = false;
+    bool context_takeover = true;
+    int window_bits = offered_bits;
+
+    size_t line = 0;
+    while (line < length) {
+        size_t line_end = line;
+        while (line_end < length && headers[line_end] != '\r' && headers[line_end] != '\n') line_end++;
+
+        const char* colon = memchr(headers + line, ':', line_end - line);
+        if (colon && ws_token_equals(headers + line, (size_t)(colon - (headers + line)), "sec-websocket-extensions")) {
+            const char* p = colon + 1;
+            const char* stop = headers + line_end;
+            while (p < stop) {
+                const char* ext_end = memchr(p, ',', (size_t)(stop - p));
+                if (!ext_end) ext_end = stop;
+
+                bool first = true;
+                while (p < ext_end) {
+                    const char* param_end = memchr(p, ';', (size_t)(ext_end - p));
+                    if (!param_end) param_end = ext_end;
+
+                    const char* name = p;
+                    size_t name_len = (size_t)(param_end - p);
+                    const char* value = memchr(name, '=', name_len);
+                    size_t value_len = 0;
+                    if (value) {
+                        value_len = (size_t)(param_end - value - 1);
+                        name_len = (size_t)(value - name);
+                        value++;
+                        ws_token_trim(&value, &value_len);
+                    }
+                    ws_token_trim(&name, &name_len);
+
+                    if (first) {
+                        if (!data->compression || deflate || value ||
+                            !ws_token_equals(name, name_len, "permessage-deflate")) {
+                            return false;
+                        }
+                        deflate = true;
+                        first = false;
+                    } else if (ws_token_equals(name, name_len, "server_no_context_takeover")) {
+                        context_takeover = false;
+                    } else if (ws_token_equals(name, name_len, "server_max_window_bits")) {
+                        int bits = 0;
+                        for (size_t i = 0; value && i < value_len && i < 3; i++) {
+                            if (value[i] < '0' || value[i] > '9') { bits = 0; break; }
+                            bits = bits * 10 + (value[i] - '0');
+                        }
+                        if (bits < 8 || bits > offered_bits) return false;
+                        window_bits = bits;
+                    } else if (!ws_token_equals(name, name_len, "client_no_context_takeover") &&
+                               !ws_token_equals(name, name_len, "client_max_window_bits")) {
+                        return false;
+                    }
+                    p = param_end < ext_end ? param_end + 1 : ext_end;
+                }
+                p = ext_end < stop ? ext_end + 1 : stop;
+            }
+        }
+
+        line = line_end;
+        while (line < length && (headers[line] == '\r' || headers[line] == '\n')) line++;
+    }
+
+    if (!deflate) return true;
+    WS_LOG("permessage-deflate: window_bits=%d context_takeover=%d", window_bits, context_takeover);
+    return ws_frame_reader_enable_deflate((ws_frame_reader_t*)data->frame_reader, window_bits,
+                                          context_takeover, data->compression_max_memory);
+}
+
+static int ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
     int would_block = 0;
     int eof = 0;
     char buf[1024];
@@ -635,13 +1310,16 @@ static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
     }
 
     if (would_block) {
-        return false;
+        return WS_STEP_PENDING;
     }
 
     /* Connection closed during handshake */
     if (eof) {
         fprintf(stderr, "Connection closed during WebSocket handshake\n");
-        return false;
+        return WS_STEP_FAILED;
+    }
+    if (received < 0) {
+        return WS_STEP_FAILED;
     }
 
     /* Bounded search for end-of-headers (don't rely on null termination of buffer,
@@ -663,7 +1341,7 @@ static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
 
     if (!found_eoh) {
         WS_LOG("handshake_receive: \\r\\n\\r\\n not found yet (have %zu bytes)", data->buffer_offset);
-        return false;
+        return WS_STEP_PENDING;
     }
 
     // Check for HTTP 101 in the header region only (bounded)
@@ -679,7 +1357,12 @@ static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
     if (!has_101) {
         fprintf(stderr, "WebSocket handshake failed\n");
         ws_hex_dump("handshake_headers", (uint8_t*)data->buffer, eoh);
-        return false;
+        return WS_STEP_FAILED;
+    }
+
+    if (!ws_negotiate_extensions(data, data->buffer, eoh)) {
+        fprintf(stderr, "WebSocket handshake failed: unexpected Sec-WebSocket-Extensions\n");
+        return WS_STEP_FAILED;
     }
 
     size_t headers_length = eoh + 4; // +4 for \r\n\r\n
@@ -700,97 +1383,10 @@ static bool ws_http_handshake_receive(colyseus_ws_transport_data_t* data) {
         data->buffer_offset = 0;
     }
 
-    return true;
+    return WS_STEP_DONE;
 }
 
 /* wslay callbacks */
-static void ws_on_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event_on_msg_recv_arg* arg, void* user_data) {
-    colyseus_transport_t* transport = (colyseus_transport_t*)user_data;
-    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
-
-    WS_LOG("Message received: opcode=%d (%s), length=%zu",
-           arg->opcode,
-           arg->opcode == WSLAY_TEXT_FRAME ? "TEXT" :
-           arg->opcode == WSLAY_BINARY_FRAME ? "BINARY" :
-           arg->opcode == WSLAY_PING ? "PING" :
-           arg->opcode == WSLAY_PONG ? "PONG" : "OTHER",
-           arg->msg_length);
-
-    if (wslay_is_ctrl_frame(arg->opcode)) {
-        if (arg->opcode == WSLAY_CONNECTION_CLOSE) {
-            WS_LOG("Close frame received (payload_len=%zu)", arg->msg_length);
-            if (arg->msg_length >= 2 && ws_debug_enabled()) {
-                uint16_t code = ((uint16_t)arg->msg[0] << 8) | arg->msg[1];
-                size_t reason_len = arg->msg_length - 2;
-                fprintf(stderr, "[WS] Close code=%u reason=\"%.*s\"\n",
-                        (unsigned)code, (int)reason_len, (const char*)(arg->msg + 2));
-                fflush(stderr);
-            }
-            ws_hex_dump("close_payload", arg->msg, arg->msg_length);
-            data->state = COLYSEUS_WS_REMOTE_DISCONNECT;
-        }
-        // wslay handles ping/pong automatically
-    } else {
-        // Data frame
-        if (arg->msg_length > 0) {
-            ws_hex_dump("ws_data_frame", arg->msg, arg->msg_length);
-        }
-        if (transport->events.on_message) {
-            transport->events.on_message(arg->msg, arg->msg_length, transport->events.userdata);
-        }
-    }
-}
-
-static ssize_t ws_recv_callback(wslay_event_context_ptr ctx, uint8_t* buf, size_t len, int flags, void* user_data) {
-    colyseus_transport_t* transport = (colyseus_transport_t*)user_data;
-    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
-
-    // Check if we have buffered data from handshake first
-    if (data->buffer_offset > 0) {
-        size_t to_copy = data->buffer_offset < len ? data->buffer_offset : len;
-        memcpy(buf, data->buffer, to_copy);
-
-        WS_LOG("wslay recv_callback: returning %zu buffered bytes (requested=%zu)", to_copy, len);
-        ws_hex_dump("wslay_from_buffer", buf, to_copy);
-
-        // Shift remaining buffer data
-        if (to_copy < data->buffer_offset) {
-            memmove(data->buffer, data->buffer + to_copy, data->buffer_offset - to_copy);
-        }
-        data->buffer_offset -= to_copy;
-
-        return (ssize_t)to_copy;
-    }
-
-    // No buffered data, read from socket
-    int would_block = 0;
-    int eof = 0;
-    ssize_t ret = ws_socket_recv(data, buf, len, &would_block, &eof);
-
-    if (ret > 0 || eof) {
-        WS_LOG("wslay recv_callback: requested=%zu, received=%zd, would_block=%d, eof=%d", len, ret, would_block, eof);
-    }
-
-    if (would_block) {
-        wslay_event_set_error(ctx, WSLAY_ERR_WOULDBLOCK);
-        return -1;
-    } else if (ret < 0) {
-        wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
-        return -1;
-    } else if (eof) {
-        /* Connection was closed by remote (server killed, network issue, etc.) */
-        WS_LOG("EOF detected - connection closed by remote");
-        wslay_event_set_error(ctx, WSLAY_ERR_CALLBACK_FAILURE);
-        return -1;
-    }
-
-    if (ret > 0) {
-        WS_LOG("wslay received %zd bytes from socket", ret);
-    }
-
-    return ret;
-}
-
 static ssize_t ws_send_callback(wslay_event_context_ptr ctx, const uint8_t* buf, size_t len, int flags, void* user_data) {
     colyseus_transport_t* transport = (colyseus_transport_t*)user_data;
     colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
@@ -821,6 +1417,24 @@ static int ws_genmask_callback(wslay_event_context_ptr ctx, uint8_t* buf, size_t
 }
 
 /* Socket I/O */
+
+/* Plain recv()/send() on the socket, or through the runtime handle when its
+ * backend owns the data path (io_uring). */
+static ssize_t ws_raw_recv(colyseus_ws_transport_data_t* data, void* buf, size_t len) {
+    if (data->io_handle && colyseus_io_handle_is_buffered((colyseus_io_handle_t*)data->io_handle)) {
+        return colyseus_io_handle_recv((colyseus_io_handle_t*)data->io_handle, buf, len);
+    }
+    return recv(data->socket_fd, (char*)buf, len, 0);
+}
+
+static ssize_t ws_raw_send(colyseus_ws_transport_data_t* data, const void* buf, size_t len) {
+    if (data->io_handle && colyseus_io_handle_is_buffered((colyseus_io_handle_t*)data->io_handle)) {
+        return colyseus_io_handle_send((colyseus_io_handle_t*)data->io_handle, buf, len);
+    }
+    ws_send_queue_count_call((ws_send_queue_t*)data->send_queue);
+    return send(data->socket_fd, (const char*)buf, len, 0);
+}
+
 static ssize_t ws_socket_recv(colyseus_ws_transport_data_t* data, uint8_t* buf, size_t len, int* would_block, int* eof) {
     *would_block = 0;
     *eof = 0;
@@ -828,7 +1442,12 @@ static ssize_t ws_socket_recv(colyseus_ws_transport_data_t* data, uint8_t* buf,
     if (data->use_tls && data->tls_ctx) {
         colyseus_tls_context_t* tls = (colyseus_tls_context_t*)data->tls_ctx;
         int ret = mbedtls_ssl_read(&tls->ssl, buf, len);
-        
+        while (ret == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET) {
+            /* TLS 1.3 tickets arrive after the handshake */
+            colyseus_tls_config_save_session(tls->config, data->url_host, data->url_port, &tls->ssl);
+            ret = mbedtls_ssl_read(&tls->ssl, buf, len);
+        }
+
         if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
             *would_block = 1;
             return 0;
@@ -846,7 +1465,7 @@ static ssize_t ws_socket_recv(colyseus_ws_transport_data_t* data, uint8_t* buf,
         return ret;
     }
 
-    ssize_t ret = recv(data->socket_fd, (char*)buf, len, 0);
+    ssize_t ret = ws_raw_recv(data, buf, len);
 
     if (ret < 0) {
 #ifdef _WIN32
@@ -885,7 +1504,7 @@ static ssize_t ws_socket_send(colyseus_ws_transport_data_t* data, const uint8_t*
         return ret;
     }
 
-    ssize_t ret = send(data->socket_fd, (const char*)buf, len, 0);
+    ssize_t ret = ws_raw_send(data, buf, len);
 
     if (ret < 0) {
 #ifdef _WIN32
@@ -906,6 +1525,7 @@ static void ws_socket_close(colyseus_ws_transport_data_t* data) {
     if (data->socket_fd >= 0) {
 #ifdef _WIN32
         closesocket(data->socket_fd);
+        data->wakeup_socket = -1;  /* closing dropped the event selection */
 #else
         close(data->socket_fd);
 #endif
@@ -918,13 +1538,1128 @@ static void ws_cleanup_wslay(colyseus_ws_transport_data_t* data) {
         wslay_event_context_free(data->wslay_ctx);
         data->wslay_ctx = NULL;
     }
+    /* Frames queued for this connection are never sent */
+    ws_send_queue_clear((ws_send_queue_t*)data->send_queue);
+    ws_frame_reader_reset((ws_frame_reader_t*)data->frame_reader);
+}
+
+/* Stop the I/O driver: join the tick thread, or detach from the runtime
+ * (waits for an on_ready in progress). */
+static void ws_stop_io(colyseus_ws_transport_data_t* data) {
+    if (data->io_handle) {
+        colyseus_io_handle_detach((colyseus_io_handle_t*)data->io_handle);
+        return;
+    }
+    if (!data->tick_thread) return;
+#ifdef _WIN32
+    WaitForSingleObject(data->tick_thread, INFINITE);
+    CloseHandle(data->tick_thread);
+#else
+    pthread_t* thread = (pthread_t*)data->tick_thread;
+    pthread_join(*thread, NULL);
+    free(thread);
+#endif
+    data->tick_thread = NULL;
+}
+
+/* Tick thread wakeup
+ *
+ * The tick thread blocks in poll() on the socket plus a wakeup descriptor
+ * (an eventfd on Linux, a non-blocking pipe elsewhere). ws_send_impl() and
+ * ws_close_impl() signal it so queued frames go out immediately instead of
+ * waiting for the next socket event. WSAPoll() can't wait on anything but
+ * sockets, so on Windows the socket is bound to an event object with
+ * WSAEventSelect() and the tick thread waits on that; ws_wakeup_signal()
+ * sets the same event. */
+
+static bool ws_wakeup_init(colyseus_ws_transport_data_t* data) {
+#ifdef _WIN32
+    if (data->wakeup_event) return true;
+    WSAEVENT event = WSACreateEvent();
+    if (event == WSA_INVALID_EVENT) return false;
+    data->wakeup_event = event;
+    return true;
+#else
+    if (data->wakeup_fds[0] >= 0) return true;
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) return false;
+    data->wakeup_fds[0] = fd;
+    data->wakeup_fds[1] = fd;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL, 0) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    data->wakeup_fds[0] = fds[0];
+    data->wakeup_fds[1] = fds[1];
+#endif
+    return true;
+#endif
+}
+
+static void ws_wakeup_signal(colyseus_ws_transport_data_t* data) {
+    if (data->io_handle) {
+        colyseus_io_handle_wake((colyseus_io_handle_t*)data->io_handle);
+        return;
+    }
+#ifndef _WIN32
+    if (data->wakeup_fds[1] < 0) return;
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t ret = write(data->wakeup_fds[1], &one, sizeof(one));
+#else
+    uint8_t one = 1;
+    ssize_t ret = write(data->wakeup_fds[1], &one, sizeof(one));
+#endif
+    (void)ret;  /* EAGAIN: a wakeup is already pending */
+#else
+    if (data->wakeup_event) WSASetEvent((WSAEVENT)data->wakeup_event);
+#endif
+}
+
+static void ws_wakeup_drain(colyseus_ws_transport_data_t* data) {
+#ifndef _WIN32
+    uint64_t buf[8];
+    while (read(data->wakeup_fds[0], buf, sizeof(buf)) > 0) {
+    }
+#else
+    WSAResetEvent((WSAEVENT)data->wakeup_event);
+#endif
+}
+
+static void ws_wakeup_close(colyseus_ws_transport_data_t* data) {
+#ifndef _WIN32
+    if (data->wakeup_fds[0] >= 0) {
+        close(data->wakeup_fds[0]);
+    }
+    if (data->wakeup_fds[1] >= 0 && data->wakeup_fds[1] != data->wakeup_fds[0]) {
+        close(data->wakeup_fds[1]);
+    }
+#else
+    if (data->wakeup_event) {
+        WSACloseEvent((WSAEVENT)data->wakeup_event);
+        data->wakeup_event = NULL;
+    }
+#endif
+    data->wakeup_fds[0] = -1;
+    data->wakeup_fds[1] = -1;
+}
+
+/* Decrypted bytes mbedtls holds that no socket event will report */
+static bool ws_tls_bytes_buffered(colyseus_ws_transport_data_t* data) {
+    return data->use_tls && data->tls_ctx &&
+           mbedtls_ssl_get_bytes_avail(&((colyseus_tls_context_t*)data->tls_ctx)->ssl) > 0;
+}
+
+/* Socket interest (COLYSEUS_IO_*) for the current state. `immediate` is
+ * set when there's already work buffered (handshake leftovers, decrypted
+ * TLS records) that the OS can't report. */
+static int ws_io_interest(colyseus_ws_transport_data_t* data, bool* immediate) {
+    int events = 0;
+    *immediate = false;
+
+    switch (data->state) {
+        case COLYSEUS_WS_CONNECTING:
+        case COLYSEUS_WS_HANDSHAKE_SENDING:
+            events = COLYSEUS_IO_WRITE;
+            break;
+        case COLYSEUS_WS_TLS_HANDSHAKE:
+            events = COLYSEUS_IO_READ | (data->io_want_write ? COLYSEUS_IO_WRITE : 0);
+            break;
+        case COLYSEUS_WS_HANDSHAKE_RECEIVING:
+            /* The response is read 1 KB at a time: the rest of its record
+             * (and frames sent with it) may already be decrypted */
+            events = COLYSEUS_IO_READ;
+            *immediate = ws_tls_bytes_buffered(data);
+            break;
+        case COLYSEUS_WS_WARM:
+            events = COLYSEUS_IO_READ;
+            break;
+        case COLYSEUS_WS_CONNECTED:
+            events = COLYSEUS_IO_READ;
+            if ((data->wslay_ctx && wslay_event_want_write(data->wslay_ctx)) ||
+                ws_send_queue_pending((ws_send_queue_t*)data->send_queue)) {
+                events |= COLYSEUS_IO_WRITE;
+            }
+            if (ws_frame_reader_has_frame((ws_frame_reader_t*)data->frame_reader)) {
+                *immediate = true;
+            }
+            if (ws_tls_bytes_buffered(data)) {
+                *immediate = true;
+            }
+            break;
+        default:
+            *immediate = true;
+            break;
+    }
+    return events;
+}
+
+/* Wait until the current state can make progress (tick thread mode). */
+static void ws_wait_for_io(colyseus_ws_transport_data_t* data) {
+    bool immediate = false;
+    int interest = ws_io_interest(data, &immediate);
+    if (immediate) return;
+
+    short events = (short)(((interest & COLYSEUS_IO_READ) ? POLLIN : 0) |
+                           ((interest & COLYSEUS_IO_WRITE) ? POLLOUT : 0));
+
+    int timeout = ws_io_timeout_ms(data);
+
+#ifdef _WIN32
+    /* Network events are edge-triggered (FD_WRITE only follows a blocked
+     * send), so readiness is checked with a zero-timeout WSAPoll() first
+     * and the event only covers what happens after that check. */
+    if (data->socket_fd >= 0) {
+        if (data->wakeup_socket != data->socket_fd) {
+            WSAEventSelect((SOCKET)data->socket_fd, (WSAEVENT)data->wakeup_event,
+                           FD_READ | FD_WRITE | FD_CONNECT | FD_CLOSE);
+            data->wakeup_socket = data->socket_fd;
+        }
+        WSAPOLLFD pfd;
+        pfd.fd = (SOCKET)data->socket_fd;
+        pfd.events = events;
+        pfd.revents = 0;
+        if (events && WSAPoll(&pfd, 1, 0) > 0) return;
+    }
+
+    WSAWaitForMultipleEvents(1, (const WSAEVENT*)&data->wakeup_event, FALSE,
+                             timeout < 0 ? WSA_INFINITE : (DWORD)timeout, FALSE);
+    ws_wakeup_drain(data);
+#else
+    struct pollfd fds[2];
+    nfds_t nfds = 0;
+    if (data->socket_fd >= 0) {
+        fds[nfds].fd = data->socket_fd;
+        fds[nfds].events = events;
+        fds[nfds].revents = 0;
+        nfds++;
+    }
+    fds[nfds].fd = data->wakeup_fds[0];
+    fds[nfds].events = POLLIN;
+    fds[nfds].revents = 0;
+    nfds++;
+
+    int ret = poll(fds, nfds, timeout);
+    if (ret > 0 && (fds[nfds - 1].revents & POLLIN)) {
+        ws_wakeup_drain(data);
+    }
+#endif
+}
+
+/* Inbound frame reader
+ *
+ * Socket bytes land in one large receive buffer that is reused for the
+ * life of the transport. Complete frames are parsed in place: an
+ * unfragmented data frame is handed to on_message as a slice of that
+ * buffer, without the copies wslay makes to assemble a message. Only
+ * fragmented messages are copied, into a separate reassembly buffer. The
+ * buffer grows to hold the largest frame seen so it's always contiguous.
+ *
+ * Server frames are never masked (RFC 6455 5.1), so masked frames are
+ * protocol errors, as are RSV bits other than RSV1 on the first frame of a
+ * message when permessage-deflate was negotiated. Compressed messages are
+ * inflated whole, then delivered from the inflater's buffer. Pings are
+ * answered through wslay, which still writes control frames. */
+
+#define WS_RECV_BUFFER_INITIAL (64 * 1024)
+#define WS_RECV_MAX_MESSAGE    (64u * 1024 * 1024)
+
+#define WS_OPCODE_CONTINUATION 0x0
+#define WS_OPCODE_TEXT         0x1
+#define WS_OPCODE_BINARY       0x2
+#define WS_OPCODE_CLOSE        0x8
+#define WS_OPCODE_PING         0x9
+#define WS_OPCODE_PONG         0xA
+
+#define WS_RSV1                0x40   /* permessage-deflate: compressed message */
+
+struct ws_frame_reader {
+    uint8_t* buf;
+    size_t cap;
+    size_t start;               /* first unparsed byte */
+    size_t len;                 /* bytes received */
+
+    /* Fragmented message being reassembled */
+    uint8_t* frag;
+    size_t frag_len;
+    size_t frag_cap;
+    bool in_fragment;
+
+    uint16_t close_code;        /* status of the close frame received */
+
+    colyseus_inflate_t* inflater;  /* permessage-deflate negotiated */
+    bool frag_compressed;
+
+    /* Stats (written by the tick thread, read from any thread) */
+    atomic_uint_fast64_t messages_received;
+    atomic_uint_fast64_t bytes_received;
+};
+
+typedef struct {
+    bool fin;
+    uint8_t rsv;
+    uint8_t opcode;
+    bool masked;
+    size_t header_len;
+    uint64_t payload_len;
+} ws_frame_header_t;
+
+static ws_frame_reader_t* ws_frame_reader_create(void) {
+    ws_frame_reader_t* r = calloc(1, sizeof(ws_frame_reader_t));
+    if (r) r->close_code = 1005;
+    return r;
+}
+
+static void ws_frame_reader_free(ws_frame_reader_t* r) {
+    if (!r) return;
+    free(r->buf);
+    free(r->frag);
+    colyseus_inflate_free(r->inflater);
+    free(r);
+}
+
+/* Drop buffered bytes; the buffers are kept for the next connection. */
+static void ws_frame_reader_reset(ws_frame_reader_t* r) {
+    if (!r) return;
+    r->start = 0;
+    r->len = 0;
+    r->frag_len = 0;
+    r->in_fragment = false;
+    r->close_code = 1005;
+    colyseus_inflate_free(r->inflater);
+    r->inflater = NULL;
+    r->frag_compressed = false;
+}
+
+/* The inflater gets what the window leaves of max_memory for output. */
+static bool ws_frame_reader_enable_deflate(ws_frame_reader_t* r, int window_bits,
+                                           bool context_takeover, size_t max_memory) {
+    if (!r) return false;
+    size_t window = (size_t)1 << window_bits;
+    size_t max_output = max_memory > window ? max_memory - window : 0;
+    if (max_output > WS_RECV_MAX_MESSAGE) max_output = WS_RECV_MAX_MESSAGE;
+    colyseus_inflate_free(r->inflater);
+    r->inflater = colyseus_inflate_create(window_bits, context_takeover, max_output);
+    return r->inflater != NULL;
+}
+
+static bool ws_frame_reader_reserve(ws_frame_reader_t* r, size_t needed) {
+    if (needed <= r->cap) return true;
+    size_t cap = r->cap ? r->cap : WS_RECV_BUFFER_INITIAL;
+    while (cap < needed) cap *= 2;
+    uint8_t* buf = realloc(r->buf, cap);
+    if (!buf) return false;
+    r->buf = buf;
+    r->cap = cap;
+    return true;
+}
+
+/* Move the unparsed tail to the front of the buffer. */
+static void ws_frame_reader_compact(ws_frame_reader_t* r) {
+    if (r->start == 0) return;
+    if (r->start < r->len) {
+        memmove(r->buf, r->buf + r->start, r->len - r->start);
+    }
+    r->len -= r->start;
+    r->start = 0;
+}
+
+/* Bytes received before the reader took over (after the upgrade response). */
+static bool ws_frame_reader_absorb(ws_frame_reader_t* r, const uint8_t* bytes, size_t length) {
+    if (!r) return false;
+    if (length == 0) return true;
+    ws_frame_reader_compact(r);
+    if (!ws_frame_reader_reserve(r, r->len + length)) return false;
+    memcpy(r->buf + r->len, bytes, length);
+    r->len += length;
+    return true;
+}
+
+/* 1: header complete, 0: need more bytes. */
+static int ws_frame_parse_header(const uint8_t* p, size_t avail, ws_frame_header_t* h) {
+    if (avail < 2) return 0;
+    h->fin = (p[0] & 0x80) != 0;
+    h->rsv = (uint8_t)(p[0] & 0x70);
+    h->opcode = (uint8_t)(p[0] & 0x0F);
+    h->masked = (p[1] & 0x80) != 0;
+
+    uint8_t len7 = (uint8_t)(p[1] & 0x7F);
+    h->header_len = 2;
+    if (len7 == 126) {
+        if (avail < 4) return 0;
+        h->payload_len = ((uint64_t)p[2] << 8) | p[3];
+        h->header_len = 4;
+    } else if (len7 == 127) {
+        if (avail < 10) return 0;
+        h->payload_len = 0;
+        for (int i = 0; i < 8; i++) h->payload_len = (h->payload_len << 8) | p[2 + i];
+        h->header_len = 10;
+    } else {
+        h->payload_len = len7;
+    }
+    if (h->masked) h->header_len += 4;
+    return avail >= h->header_len ? 1 : 0;
+}
+
+static bool ws_frame_reader_has_frame(const ws_frame_reader_t* r) {
+    if (!r || r->len == r->start) return false;
+    ws_frame_header_t h;
+    if (ws_frame_parse_header(r->buf + r->start, r->len - r->start, &h) != 1) return false;
+    /* Invalid frames count too: the next receive reports them */
+    return h.payload_len > WS_RECV_MAX_MESSAGE ||
+           r->len - r->start >= h.header_len + (size_t)h.payload_len;
+}
+
+static uint16_t ws_frame_reader_close_code(const ws_frame_reader_t* r) {
+    return r ? r->close_code : 1005;
+}
+
+static void ws_deliver_message(colyseus_transport_t* transport, const uint8_t* payload, size_t length) {
+    ws_frame_reader_t* r = (ws_frame_reader_t*)((colyseus_ws_transport_data_t*)transport->impl_data)->frame_reader;
+    atomic_fetch_add_explicit(&r->messages_received, 1, memory_order_relaxed);
+    if (length > 0) {
+        ws_hex_dump("ws_data_frame", payload, length);
+    }
+    if (transport->events.on_message) {
+        transport->events.on_message(payload, length, transport->events.userdata);
+    }
+}
+
+static int ws_deliver_compressed(colyseus_transport_t* transport, const uint8_t* payload, size_t length,
+                                 const char** reason) {
+    ws_frame_reader_t* r = (ws_frame_reader_t*)((colyseus_ws_transport_data_t*)transport->impl_data)->frame_reader;
+    const uint8_t* message = NULL;
+    size_t message_len = 0;
+    switch (colyseus_inflate_message(r->inflater, payload, length, &message, &message_len)) {
+        case COLYSEUS_INFLATE_OK:
+            ws_deliver_message(transport, message, message_len);
+            return 0;
+        case COLYSEUS_INFLATE_TOO_BIG:
+            *reason = "Message too big";
+            return 1009;
+        case COLYSEUS_INFLATE_NO_MEMORY:
+            *reason = "Out of memory";
+            return 1006;
+        default:
+            *reason = "Invalid compressed data";
+            return 1007;
+    }
+}
+
+/* Handle one complete frame. Returns 0 or a close code. */
+static int ws_handle_frame(colyseus_transport_t* transport, const ws_frame_header_t* h,
+                           const uint8_t* payload, const char** reason) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    ws_frame_reader_t* r = (ws_frame_reader_t*)data->frame_reader;
+    size_t length = (size_t)h->payload_len;
+
+    WS_LOG("Frame received: opcode=%d fin=%d length=%zu", h->opcode, h->fin, length);
+
+    if (h->opcode & 0x8) {
+        /* Control frames: never fragmented, payload <= 125 */
+        if (!h->fin || length > 125 || h->rsv) {
+            *reason = "Invalid control frame";
+            return 1002;
+        }
+        switch (h->opcode) {
+            case WS_OPCODE_CLOSE:
+                r->close_code = length >= 2 ? (uint16_t)(((uint16_t)payload[0] << 8) | payload[1]) : 1005;
+                WS_LOG("Close frame received (payload_len=%zu)", length);
+                if (length >= 2 && ws_debug_enabled()) {
+                    fprintf(stderr, "[WS] Close code=%u reason=\"%.*s\"\n",
+                            (unsigned)r->close_code, (int)(length - 2), (const char*)(payload + 2));
+                    fflush(stderr);
+                }
+                ws_hex_dump("close_payload", payload, length);
+                data->state = COLYSEUS_WS_REMOTE_DISCONNECT;
+                return 0;
+            case WS_OPCODE_PING: {
+                struct wslay_event_msg pong = { WSLAY_PONG, payload, length };
+                wslay_event_queue_msg(data->wslay_ctx, &pong);
+                return 0;
+            }
+            case WS_OPCODE_PONG:
+                ws_keepalive_on_pong((ws_keepalive_t*)data->keepalive, payload, length);
+                return 0;
+            default:
+                *reason = "Unknown opcode";
+                return 1002;
+        }
+    }
+
+    switch (h->opcode) {
+        case WS_OPCODE_TEXT:
+        case WS_OPCODE_BINARY:
+            if (r->in_fragment) {
+                *reason = "Expected continuation frame";
+                return 1002;
+            }
+            if (h->fin) {
+                if (h->rsv & WS_RSV1) return ws_deliver_compressed(transport, payload, length, reason);
+                /* Zero-copy: a slice of the receive buffer */
+                ws_deliver_message(transport, payload, length);
+                return 0;
+            }
+            r->in_fragment = true;
+            r->frag_compressed = (h->rsv & WS_RSV1) != 0;
+            r->frag_len = 0;
+            break;
+        case WS_OPCODE_CONTINUATION:
+            if (!r->in_fragment) {
+                *reason = "Unexpected continuation frame";
+                return 1002;
+            }
+            if (h->rsv) {
+                *reason = "Unexpected RSV bits";
+                return 1002;
+            }
+            break;
+        default:
+            *reason = "Unknown opcode";
+            return 1002;
+    }
+
+    if (r->frag_len + length > WS_RECV_MAX_MESSAGE) {
+        *reason = "Message too big";
+        return 1009;
+    }
+    if (r->frag_len + length > r->frag_cap) {
+        size_t cap = r->frag_cap ? r->frag_cap : WS_RECV_BUFFER_INITIAL;
+        while (cap < r->frag_len + length) cap *= 2;
+        uint8_t* frag = realloc(r->frag, cap);
+        if (!frag) {
+            *reason = "Out of memory";
+            return 1006;
+        }
+        r->frag = frag;
+        r->frag_cap = cap;
+    }
+    if (length > 0) {
+        memcpy(r->frag + r->frag_len, payload, length);
+        r->frag_len += length;
+    }
+    if (h->fin) {
+        size_t message_len = r->frag_len;
+        r->in_fragment = false;
+        r->frag_len = 0;
+        if (r->frag_compressed) return ws_deliver_compressed(transport, r->frag, message_len, reason);
+        ws_deliver_message(transport, r->frag, message_len);
+    }
+    return 0;
+}
+
+/* Read until the socket would block, delivering every complete frame.
+ * Tick thread only. Returns 0, or a close code with `reason` set. */
+static int ws_receive(colyseus_transport_t* transport, const char** reason) {
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    ws_frame_reader_t* r = (ws_frame_reader_t*)data->frame_reader;
+    if (!r) {
+        *reason = "Out of memory";
+        return 1006;
+    }
+
+    for (;;) {
+        /* Parse what's buffered */
+        size_t needed = 0;
+        while (r->start < r->len) {
+            ws_frame_header_t h;
+            size_t avail = r->len - r->start;
+            if (ws_frame_parse_header(r->buf + r->start, avail, &h) == 0) {
+                needed = 10 + 4;  /* longest header */
+                break;
+            }
+            if (h.masked || (h.rsv & ~(r->inflater ? WS_RSV1 : 0))) {
+                *reason = h.masked ? "Masked frame from server" : "Unexpected RSV bits";
+                return 1002;
+            }
+            if (h.payload_len > WS_RECV_MAX_MESSAGE) {
+                *reason = "Message too big";
+                return 1009;
+            }
+            size_t frame_len = h.header_len + (size_t)h.payload_len;
+            if (avail < frame_len) {
+                needed = frame_len;
+                break;
+            }
+
+            /* Consume before dispatching: on_message may close */
+            const uint8_t* payload = r->buf + r->start + h.header_len;
+            r->start += frame_len;
+            int code = ws_handle_frame(transport, &h, payload, reason);
+            if (code != 0) return code;
+            if (data->state != COLYSEUS_WS_CONNECTED || data->pending_close || !data->running) {
+                return 0;
+            }
+        }
+
+        /* Keep only the partial frame, at the front */
+        ws_frame_reader_compact(r);
+        if (!ws_frame_reader_reserve(r, needed > r->len ? needed : r->len + 1)) {
+            *reason = "Out of memory";
+            return 1006;
+        }
+
+        int would_block = 0;
+        int eof = 0;
+        ssize_t received = ws_socket_recv(data, r->buf + r->len, r->cap - r->len, &would_block, &eof);
+        if (would_block) return 0;
+        if (received < 0 || eof) {
+            /* Connection was closed by remote (server killed, network issue, etc.) */
+            WS_LOG("receive failed: received=%zd eof=%d", received, eof);
+            *reason = "Receive error";
+            return 1006;
+        }
+        WS_LOG("received %zd bytes from socket", received);
+        atomic_fetch_add_explicit(&r->bytes_received, (uint_fast64_t)received, memory_order_relaxed);
+        ws_keepalive_seen((ws_keepalive_t*)data->keepalive);
+        r->len += (size_t)received;
+    }
+}
+
+/* Keepalive
+ *
+ * TCP keepalive takes tens of seconds to give up on a dead peer. While
+ * connected, the driver pings every interval_ms with its send time
+ * (microseconds, big-endian) as the payload; the pong echoes it, so every
+ * pong is one RTT sample without tracking pings in flight. Samples are
+ * smoothed as in RFC 6298 (srtt gains 1/8 of the error, rttvar 1/4).
+ *
+ * If nothing at all arrives within timeout_ms of a ping, the connection is
+ * closed with 1006 and the room reconnects. Any received bytes count as a
+ * sign of life, so a pong queued behind a large message doesn't get a
+ * healthy connection killed. */
+
+#define WS_PING_PAYLOAD 8
+
+struct ws_keepalive {
+    /* Driver only */
+    uint32_t interval_ms;       /* 0: no pings */
+    uint32_t timeout_ms;        /* 0: no deadline */
+    uint64_t next_ping_ms;
+    uint64_t deadline_ms;       /* 0 while nothing is awaited */
+
+    /* Written by the driver, read from any thread */
+    atomic_uint_fast64_t last_seen_ms;
+    atomic_uint_fast64_t rtt_us;
+    atomic_uint_fast64_t srtt_us;
+    atomic_uint_fast64_t rttvar_us;
+    atomic_uint_fast64_t pings_sent;
+    atomic_uint_fast64_t pongs_received;
+};
+
+static ws_keepalive_t* ws_keepalive_create(void) {
+    return calloc(1, sizeof(ws_keepalive_t));
+}
+
+/* Connected: the first ping goes out one interval from now */
+static void ws_keepalive_start(ws_keepalive_t* k) {
+    if (!k) return;
+    uint64_t now = colyseus_monotonic_ms();
+    k->next_ping_ms = now + k->interval_ms;
+    k->deadline_ms = 0;
+    atomic_store_explicit(&k->last_seen_ms, now, memory_order_relaxed);
+}
+
+static void ws_keepalive_seen(ws_keepalive_t* k) {
+    if (!k) return;
+    k->deadline_ms = 0;
+    atomic_store_explicit(&k->last_seen_ms, colyseus_monotonic_ms(), memory_order_relaxed);
+}
+
+static void ws_keepalive_on_pong(ws_keepalive_t* k, const uint8_t* payload, size_t length) {
+    if (!k || length != WS_PING_PAYLOAD) return;  /* not one of ours */
+    uint64_t sent_us = 0;
+    for (size_t i = 0; i < WS_PING_PAYLOAD; i++) sent_us = (sent_us << 8) | payload[i];
+    uint64_t now_us = colyseus_monotonic_us();
+    if (sent_us > now_us) return;
+    uint64_t rtt = now_us - sent_us;
+
+    uint64_t srtt = atomic_load_explicit(&k->srtt_us, memory_order_relaxed);
+    uint64_t rttvar = atomic_load_explicit(&k->rttvar_us, memory_order_relaxed);
+    if (atomic_fetch_add_explicit(&k->pongs_received, 1, memory_order_relaxed) == 0) {
+        srtt = rtt;
+        rttvar = rtt / 2;
+    } else {
+        uint64_t err = rtt > srtt ? rtt - srtt : srtt - rtt;
+        rttvar = rttvar - rttvar / 4 + err / 4;
+        srtt = srtt - srtt / 8 + rtt / 8;
+    }
+    atomic_store_explicit(&k->rtt_us, rtt, memory_order_relaxed);
+    atomic_store_explicit(&k->srtt_us, srtt, memory_order_relaxed);
+    atomic_store_explicit(&k->rttvar_us, rttvar, memory_order_relaxed);
+}
+
+/* Send a due ping. Returns false when the pong deadline passed. */
+static bool ws_keepalive_tick(colyseus_ws_transport_data_t* data) {
+    ws_keepalive_t* k = (ws_keepalive_t*)data->keepalive;
+    if (!k || k->interval_ms == 0) return true;
+
+    uint64_t now = colyseus_monotonic_ms();
+    if (k->deadline_ms && now >= k->deadline_ms) return false;
+    if (now < k->next_ping_ms) return true;
+
+    uint8_t payload[WS_PING_PAYLOAD];
+    uint64_t now_us = colyseus_monotonic_us();
+    for (size_t i = 0; i < WS_PING_PAYLOAD; i++) {
+        payload[i] = (uint8_t)(now_us >> (8 * (WS_PING_PAYLOAD - 1 - i)));
+    }
+    struct wslay_event_msg ping = { WSLAY_PING, payload, sizeof(payload) };
+    if (wslay_event_queue_msg(data->wslay_ctx, &ping) == 0) {
+        atomic_fetch_add_explicit(&k->pings_sent, 1, memory_order_relaxed);
+    }
+    k->next_ping_ms = now + k->interval_ms;
+    if (!k->deadline_ms && k->timeout_ms) k->deadline_ms = now + k->timeout_ms;
+    return true;
+}
+
+/* Milliseconds until the next ping or the pong deadline, -1 for none */
+static int ws_keepalive_timeout_ms(const ws_keepalive_t* k) {
+    if (!k || k->interval_ms == 0) return -1;
+    uint64_t due = k->next_ping_ms;
+    if (k->deadline_ms && k->deadline_ms < due) due = k->deadline_ms;
+    uint64_t now = colyseus_monotonic_ms();
+    return due > now ? (int)(due - now) : 0;
+}
+
+/* Outbound send queue
+ *
+ * ws_send_impl() may be called from any thread while the tick thread owns
+ * wslay_ctx. Instead of wslay_event_queue_msg() (unsynchronized, and it
+ * copies the payload again), the caller builds the complete masked frame in
+ * one allocation and pushes it into a bounded lock-free MPSC ring (Vyukov
+ * style: producers claim a slot with a CAS on enqueue_pos and publish it
+ * through the slot sequence). The tick thread is the only consumer and
+ * writes frames straight to the socket.
+ *
+ * When the ring is full, frames go to a spinlock-guarded overflow list, as
+ * in the room poll queue; producers keep using it until the consumer has
+ * drained the ring and taken the list, so per-thread FIFO order holds.
+ *
+ * wslay still produces control frames (pong, close). The two streams are
+ * interleaved only at frame boundaries: queued frames are written when
+ * wslay has nothing pending, and wslay is flushed only when no queued frame
+ * is half-written.
+ *
+ * The consumer takes up to WS_WRITE_BATCH frames at a time and writes them
+ * with one writev() (WSASend() on Windows). Over TLS the frames are packed
+ * into one record-sized staging buffer and written with one
+ * mbedtls_ssl_write(). Frame headers live in the same allocation as the
+ * masked payload: masking needs that copy anyway, so there's no separate
+ * header buffer to gather. */
+
+#define WS_SEND_RING_SIZE 1024 /* power of two */
+#define WS_WRITE_BATCH    64   /* frames per writev() (<= IOV_MAX) */
+#define WS_TLS_RECORD_MAX 16384
+
+typedef struct ws_out_frame {
+    struct ws_out_frame* next;  /* overflow list link */
+    size_t length;
+    uint8_t bytes[];            /* header + masked payload */
+} ws_out_frame_t;
+
+typedef struct {
+    atomic_size_t seq;
+    ws_out_frame_t* frame;
+} ws_send_slot_t;
+
+struct ws_send_queue {
+    ws_send_slot_t ring[WS_SEND_RING_SIZE];
+    atomic_size_t enqueue_pos;  /* producers */
+    size_t dequeue_pos;         /* consumer only */
+
+    /* Overflow list (any thread) */
+    colyseus_spinlock_t overflow_lock;
+    atomic_bool overflowed;
+    ws_out_frame_t* overflow_head;
+    ws_out_frame_t* overflow_tail;
+    ws_out_frame_t* pending;    /* taken from the overflow list (consumer only) */
+
+    /* Frames being written and bytes of batch[0] already sent (consumer only) */
+    ws_out_frame_t* batch[WS_WRITE_BATCH];
+    size_t batch_count;
+    size_t batch_offset;
+
+    /* TLS: frames packed into one record; must be retried unchanged */
+    uint8_t tls_stage[WS_TLS_RECORD_MAX];
+    size_t tls_stage_len;
+    size_t tls_stage_offset;
+    size_t tls_stage_frames;    /* frames whose last byte is in the record */
+
+    atomic_bool wakeup_armed;   /* false while a wakeup is already pending */
+    atomic_uint_fast64_t mask_seed;
+
+    /* Stats (written by the consumer, read from any thread) */
+    atomic_uint_fast64_t frames_sent;
+    atomic_uint_fast64_t bytes_sent;
+    atomic_uint_fast64_t send_calls;
+};
+
+static ws_send_queue_t* ws_send_queue_create(void) {
+    ws_send_queue_t* q = calloc(1, sizeof(ws_send_queue_t));
+    if (!q) return NULL;
+    for (size_t i = 0; i < WS_SEND_RING_SIZE; i++) {
+        atomic_init(&q->ring[i].seq, i);
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    colyseus_spinlock_init(&q->overflow_lock);
+    atomic_init(&q->overflowed, false);
+    atomic_init(&q->wakeup_armed, true);
+    atomic_init(&q->mask_seed, (uint_fast64_t)(uintptr_t)q ^ (uint_fast64_t)rand());
+    return q;
+}
+
+/* splitmix64 over a shared counter: lock-free masking keys for any thread */
+static uint32_t ws_send_queue_next_mask(ws_send_queue_t* q) {
+    uint64_t z = (uint64_t)atomic_fetch_add_explicit(&q->mask_seed, 0x9E3779B97F4A7C15ull,
+                                                      memory_order_relaxed);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return (uint32_t)(z ^ (z >> 31));
+}
+
+/* Build a single FIN binary frame with a client mask (RFC 6455 5.2) whose
+ * payload is the concatenation of `parts`. */
+static ws_out_frame_t* ws_out_frame_create(ws_send_queue_t* q, const colyseus_transport_buf_t* parts, size_t count) {
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) length += parts[i].length;
+
+    size_t header_len = 2 + 4;
+    if (length > 65535) header_len += 8;
+    else if (length > 125) header_len += 2;
+
+    ws_out_frame_t* frame = malloc(sizeof(ws_out_frame_t) + header_len + length);
+    if (!frame) return NULL;
+    frame->next = NULL;
+    frame->length = header_len + length;
+
+    uint8_t* p = frame->bytes;
+    *p++ = 0x80 | WSLAY_BINARY_FRAME;
+    if (length > 65535) {
+        *p++ = 0x80 | 127;
+        for (int i = 7; i >= 0; i--) *p++ = (uint8_t)((uint64_t)length >> (i * 8));
+    } else if (length > 125) {
+        *p++ = 0x80 | 126;
+        *p++ = (uint8_t)(length >> 8);
+        *p++ = (uint8_t)length;
+    } else {
+        *p++ = (uint8_t)(0x80 | length);
+    }
+
+    uint32_t mask_word = ws_send_queue_next_mask(q);
+    uint8_t mask[4];
+    memcpy(mask, &mask_word, 4);
+    memcpy(p, mask, 4);
+    p += 4;
+
+    size_t offset = 0;
+    for (size_t part = 0; part < count; part++) {
+        const uint8_t* payload = parts[part].data;
+        for (size_t i = 0; i < parts[part].length; i++, offset++) {
+            p[offset] = payload[i] ^ mask[offset & 3];
+        }
+    }
+    return frame;
+}
+
+/* Any thread. */
+static bool ws_send_queue_push(ws_send_queue_t* q, const colyseus_transport_buf_t* parts, size_t count) {
+    if (!q) return false;
+    ws_out_frame_t* frame = ws_out_frame_create(q, parts, count);
+    if (!frame) return false;
+
+    if (!atomic_load_explicit(&q->overflowed, memory_order_acquire)) {
+        size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        for (;;) {
+            ws_send_slot_t* slot = &q->ring[pos & (WS_SEND_RING_SIZE - 1)];
+            size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                          memory_order_relaxed, memory_order_relaxed)) {
+                    slot->frame = frame;
+                    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                break;  /* full */
+            } else {
+                pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+            }
+        }
+    }
+
+    colyseus_spinlock_lock(&q->overflow_lock);
+    if (q->overflow_tail) {
+        q->overflow_tail->next = frame;
+    } else {
+        q->overflow_head = frame;
+    }
+    q->overflow_tail = frame;
+    atomic_store_explicit(&q->overflowed, true, memory_order_release);
+    colyseus_spinlock_unlock(&q->overflow_lock);
+    return true;
+}
+
+/* Consumer only. */
+static ws_out_frame_t* ws_send_queue_pop(ws_send_queue_t* q) {
+    if (q->pending) {
+        ws_out_frame_t* frame = q->pending;
+        q->pending = frame->next;
+        return frame;
+    }
+
+    size_t pos = q->dequeue_pos;
+    ws_send_slot_t* slot = &q->ring[pos & (WS_SEND_RING_SIZE - 1)];
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) == pos + 1) {
+        ws_out_frame_t* frame = slot->frame;
+        atomic_store_explicit(&slot->seq, pos + WS_SEND_RING_SIZE, memory_order_release);
+        q->dequeue_pos = pos + 1;
+        return frame;
+    }
+
+    /* A claimed slot isn't published yet: its producer will wake us again.
+     * Only take the overflow list once the ring is really empty. */
+    if (atomic_load_explicit(&q->enqueue_pos, memory_order_acquire) != pos) return NULL;
+    if (!atomic_load_explicit(&q->overflowed, memory_order_acquire)) return NULL;
+
+    colyseus_spinlock_lock(&q->overflow_lock);
+    ws_out_frame_t* frame = q->overflow_head;
+    q->overflow_head = NULL;
+    q->overflow_tail = NULL;
+    atomic_store_explicit(&q->overflowed, false, memory_order_release);
+    colyseus_spinlock_unlock(&q->overflow_lock);
+
+    if (frame) q->pending = frame->next;
+    return frame;
+}
+
+/* Returns true if the caller should signal the tick thread. */
+static bool ws_send_queue_take_wakeup(ws_send_queue_t* q) {
+    return atomic_exchange_explicit(&q->wakeup_armed, false, memory_order_acq_rel);
+}
+
+static bool ws_send_queue_in_flight(const ws_send_queue_t* q) {
+    return q && (q->batch_count > 0 || q->tls_stage_offset < q->tls_stage_len);
+}
+
+/* Consumer only. True if any frame is waiting to be written. */
+static bool ws_send_queue_pending(ws_send_queue_t* q) {
+    if (!q) return false;
+    return ws_send_queue_in_flight(q) || q->pending ||
+           atomic_load_explicit(&q->enqueue_pos, memory_order_acquire) != q->dequeue_pos ||
+           atomic_load_explicit(&q->overflowed, memory_order_acquire);
+}
+
+static void ws_out_frame_list_free(ws_out_frame_t* frame) {
+    while (frame) {
+        ws_out_frame_t* next = frame->next;
+        free(frame);
+        frame = next;
+    }
+}
+
+/* Consumer only. Drops every frame not yet written, including ring slots
+ * already claimed whose producer hasn't published the frame yet (popping
+ * would stop at the first of those and leave the rest behind). */
+static void ws_send_queue_clear(ws_send_queue_t* q) {
+    if (!q) return;
+    for (size_t i = 0; i < q->batch_count; i++) {
+        free(q->batch[i]);
+    }
+    q->batch_count = 0;
+    q->batch_offset = 0;
+    q->tls_stage_len = 0;
+    q->tls_stage_offset = 0;
+    q->tls_stage_frames = 0;
+
+    ws_out_frame_list_free(q->pending);
+    q->pending = NULL;
+
+    size_t end = atomic_load_explicit(&q->enqueue_pos, memory_order_acquire);
+    while (q->dequeue_pos != end) {
+        size_t pos = q->dequeue_pos;
+        ws_send_slot_t* slot = &q->ring[pos & (WS_SEND_RING_SIZE - 1)];
+        while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos + 1) {
+            /* spin: the producer is between claiming and publishing */
+        }
+        free(slot->frame);
+        slot->frame = NULL;
+        atomic_store_explicit(&slot->seq, pos + WS_SEND_RING_SIZE, memory_order_release);
+        q->dequeue_pos = pos + 1;
+    }
+
+    colyseus_spinlock_lock(&q->overflow_lock);
+    ws_out_frame_t* overflow = q->overflow_head;
+    q->overflow_head = NULL;
+    q->overflow_tail = NULL;
+    atomic_store_explicit(&q->overflowed, false, memory_order_release);
+    colyseus_spinlock_unlock(&q->overflow_lock);
+    ws_out_frame_list_free(overflow);
+}
+
+static void ws_send_queue_free(ws_send_queue_t* q) {
+    ws_send_queue_clear(q);
+    free(q);
+}
+
+static void ws_send_queue_count_call(ws_send_queue_t* q) {
+    if (q) atomic_fetch_add_explicit(&q->send_calls, 1, memory_order_relaxed);
+}
+
+/* Bytes the socket (or TLS) accepted, not bytes staged */
+static void ws_send_queue_count_bytes(ws_send_queue_t* q, size_t written) {
+    atomic_fetch_add_explicit(&q->bytes_sent, written, memory_order_relaxed);
+}
+
+/* Consumer only. Top the batch up from the queue. */
+static void ws_send_queue_fill_batch(ws_send_queue_t* q) {
+    while (q->batch_count < WS_WRITE_BATCH) {
+        ws_out_frame_t* frame = ws_send_queue_pop(q);
+        if (!frame) break;
+        q->batch[q->batch_count++] = frame;
+    }
+}
+
+/* Consumer only. Drop `written` bytes from the front of the batch.
+ * Returns the number of frames finished. */
+static size_t ws_send_queue_consume(ws_send_queue_t* q, size_t written) {
+    size_t done = 0;
+    while (done < q->batch_count) {
+        ws_out_frame_t* frame = q->batch[done];
+        size_t left = frame->length - q->batch_offset;
+        if (written < left) {
+            q->batch_offset += written;
+            break;
+        }
+        written -= left;
+        q->batch_offset = 0;
+        ws_hex_dump("queued_frame_sent", frame->bytes, frame->length);
+        free(frame);
+        done++;
+    }
+    if (done > 0) {
+        memmove(q->batch, q->batch + done, (q->batch_count - done) * sizeof(q->batch[0]));
+        q->batch_count -= done;
+    }
+    return done;
+}
+
+static void ws_send_queue_count_frames(ws_send_queue_t* q, size_t frames) {
+    if (frames > 0) atomic_fetch_add_explicit(&q->frames_sent, frames, memory_order_relaxed);
+}
+
+/* Write as much of the batch as the socket takes with a single call.
+ * Returns 1 on progress, 0 if the socket would block, -1 on error. */
+static int ws_write_batch(colyseus_ws_transport_data_t* data, ws_send_queue_t* q) {
+    int would_block = 0;
+
+    if (data->use_tls && data->tls_ctx) {
+        if (q->tls_stage_offset == q->tls_stage_len) {
+            /* Pack the next frames into one record */
+            q->tls_stage_len = 0;
+            q->tls_stage_offset = 0;
+            q->tls_stage_frames = 0;
+            while (q->batch_count > 0 && q->tls_stage_len < WS_TLS_RECORD_MAX) {
+                ws_out_frame_t* frame = q->batch[0];
+                size_t n = frame->length - q->batch_offset;
+                if (n > WS_TLS_RECORD_MAX - q->tls_stage_len) n = WS_TLS_RECORD_MAX - q->tls_stage_len;
+                memcpy(q->tls_stage + q->tls_stage_len, frame->bytes + q->batch_offset, n);
+                q->tls_stage_len += n;
+                q->tls_stage_frames += ws_send_queue_consume(q, n);
+            }
+        }
+        ssize_t sent = ws_socket_send(data, q->tls_stage + q->tls_stage_offset,
+                                      q->tls_stage_len - q->tls_stage_offset, &would_block);
+        if (sent < 0) return -1;
+        if (would_block) return 0;
+        q->tls_stage_offset += (size_t)sent;
+        ws_send_queue_count_bytes(q, (size_t)sent);
+        /* Staged frames count as sent once TLS took the whole record */
+        if (q->tls_stage_offset == q->tls_stage_len) {
+            ws_send_queue_count_frames(q, q->tls_stage_frames);
+            q->tls_stage_frames = 0;
+        }
+        return 1;
+    }
+
+    if (data->io_handle && colyseus_io_handle_is_buffered((colyseus_io_handle_t*)data->io_handle)) {
+        /* The runtime batches the actual send */
+        ws_out_frame_t* frame = q->batch[0];
+        ssize_t sent = ws_socket_send(data, frame->bytes + q->batch_offset,
+                                      frame->length - q->batch_offset, &would_block);
+        if (sent < 0) return -1;
+        if (would_block) return 0;
+        ws_send_queue_count_bytes(q, (size_t)sent);
+        ws_send_queue_count_frames(q, ws_send_queue_consume(q, (size_t)sent));
+        return 1;
+    }
+
+    size_t count = q->batch_count;
+    ws_send_queue_count_call(q);
+#ifdef _WIN32
+    WSABUF bufs[WS_WRITE_BATCH];
+    for (size_t i = 0; i < count; i++) {
+        size_t skip = i == 0 ? q->batch_offset : 0;
+        bufs[i].buf = (char*)(q->batch[i]->bytes + skip);
+        bufs[i].len = (ULONG)(q->batch[i]->length - skip);
+    }
+    DWORD sent = 0;
+    if (WSASend(data->socket_fd, bufs, (DWORD)count, &sent, 0, NULL, NULL) == SOCKET_ERROR) {
+        return WSAGetLastError() == WSAEWOULDBLOCK ? 0 : -1;
+    }
+#else
+    struct iovec iov[WS_WRITE_BATCH];
+    for (size_t i = 0; i < count; i++) {
+        size_t skip = i == 0 ? q->batch_offset : 0;
+        iov[i].iov_base = q->batch[i]->bytes + skip;
+        iov[i].iov_len = q->batch[i]->length - skip;
+    }
+    ssize_t sent = writev(data->socket_fd, iov, (int)count);
+    if (sent < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+#endif
+    ws_send_queue_count_bytes(q, (size_t)sent);
+    ws_send_queue_count_frames(q, ws_send_queue_consume(q, (size_t)sent));
+    return 1;
+}
+
+/* Write wslay control frames and queued data frames until the queue is
+ * empty or the socket would block. Tick thread only (or after it joined).
+ * Returns 0, or non-zero on a socket / wslay error. */
+static int ws_flush_outbound(colyseus_ws_transport_data_t* data) {
+    ws_send_queue_t* q = (ws_send_queue_t*)data->send_queue;
+
+    /* Re-arm before draining so a send racing with us signals again */
+    if (q) atomic_store_explicit(&q->wakeup_armed, true, memory_order_release);
+
+    for (;;) {
+        if (!ws_send_queue_in_flight(q)) {
+            int ret = wslay_event_send(data->wslay_ctx);
+            if (ret != 0) return ret;
+            if (!q || wslay_event_want_write(data->wslay_ctx)) return 0;
+
+            ws_send_queue_fill_batch(q);
+            if (q->batch_count == 0) return 0;
+        } else if (q->batch_count < WS_WRITE_BATCH) {
+            /* Frames queued since the last write join this one */
+            ws_send_queue_fill_batch(q);
+        }
+
+        int ret = ws_write_batch(data, q);
+        if (ret < 0) return -1;
+        if (ret == 0) return 0;
+    }
 }
 
 /* TLS functions */
 
 static int tls_bio_send(void* ctx, const unsigned char* buf, size_t len) {
-    int fd = *(int*)ctx;
-    ssize_t ret = send(fd, (const char*)buf, len, 0);
+    ssize_t ret = ws_raw_send((colyseus_ws_transport_data_t*)ctx, buf, len);
     if (ret < 0) {
 #ifdef _WIN32
         if (WSAGetLastError() == WSAEWOULDBLOCK) return MBEDTLS_ERR_SSL_WANT_WRITE;
@@ -937,8 +2672,7 @@ static int tls_bio_send(void* ctx, const unsigned char* buf, size_t len) {
 }
 
 static int tls_bio_recv(void* ctx, unsigned char* buf, size_t len) {
-    int fd = *(int*)ctx;
-    ssize_t ret = recv(fd, (char*)buf, len, 0);
+    ssize_t ret = ws_raw_recv((colyseus_ws_transport_data_t*)ctx, buf, len);
     if (ret < 0) {
 #ifdef _WIN32
         if (WSAGetLastError() == WSAEWOULDBLOCK) return MBEDTLS_ERR_SSL_WANT_READ;
@@ -951,25 +2685,12 @@ static int tls_bio_recv(void* ctx, unsigned char* buf, size_t len) {
     return (int)ret;
 }
 
-/* Parse one PEM CA source into the chain. mbedtls parses permissively and
- * appends, so sources are additive. `pem` must be null-terminated with
- * `pem_len` including the terminator. Returns 1 if at least one certificate was
- * added, else 0 (empty/unparseable source — logged, non-fatal). */
-static int ws_tls_add_ca(mbedtls_x509_crt* chain, const unsigned char* pem,
-                         size_t pem_len, const char* source) {
-    if (!pem || pem_len == 0) return 0;
-
-    int ret = mbedtls_x509_crt_parse(chain, pem, pem_len);
-    if (ret < 0) {
-        WS_LOG("CA source '%s' failed to parse: -0x%04x", source, (unsigned int)(-ret));
-        return 0;
-    }
-    if (ret > 0) {
-        WS_LOG("CA source '%s' loaded (%d cert(s) skipped)", source, ret);
-    } else {
-        WS_LOG("CA source '%s' loaded", source);
-    }
-    return 1;
+/* Called for each certificate of the chain the server sends, which it only
+ * does in a full handshake. Leaves the verification result untouched. */
+static int ws_tls_verify_cb(void* ctx, mbedtls_x509_crt* crt, int depth, uint32_t* flags) {
+    (void)crt; (void)depth; (void)flags;
+    ((colyseus_tls_context_t*)ctx)->peer_verified = 1;
+    return 0;
 }
 
 static bool ws_tls_init(colyseus_ws_transport_data_t* data, const char** out_err) {
@@ -978,99 +2699,49 @@ static bool ws_tls_init(colyseus_ws_transport_data_t* data, const char** out_err
         if (out_err) *out_err = "TLS allocation failed";
         return false;
     }
-    
+
     mbedtls_ssl_init(&tls->ssl);
-    mbedtls_ssl_config_init(&tls->conf);
-    mbedtls_entropy_init(&tls->entropy);
-    mbedtls_ctr_drbg_init(&tls->ctr_drbg);
-    tls->ca_chain_initialized = 0;
     tls->handshake_done = 0;
+    tls->session_offered = 0;
+    tls->peer_verified = 0;
     data->tls_ctx = tls;  /* assign early so ws_tls_cleanup can free it */
-    
-    if (mbedtls_ctr_drbg_seed(&tls->ctr_drbg, mbedtls_entropy_func, &tls->entropy, NULL, 0) != 0) {
-        ws_tls_cleanup(data);
-        return false;
-    }
-    
-    if (mbedtls_ssl_config_defaults(&tls->conf, MBEDTLS_SSL_IS_CLIENT,
-                                     MBEDTLS_SSL_TRANSPORT_STREAM,
-                                     MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+
+    /* CA chain, ssl_config and DRBG are shared by every connection with the
+     * same verification settings (see tls_context.h) */
+    tls->config = colyseus_tls_config_acquire(data->tls_skip_verify, data->ca_pem_data,
+                                              data->ca_pem_len, out_err);
+    if (!tls->config) {
         ws_tls_cleanup(data);
         return false;
     }
-    
-    if (data->tls_skip_verify) {
-        mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_NONE);
-    } else {
-        mbedtls_ssl_conf_authmode(&tls->conf, MBEDTLS_SSL_VERIFY_REQUIRED);
-
-        /* Merge every available CA source into one trust chain rather than
-         * picking a single one. mbedtls appends and parses permissively, so the
-         * sources are additive. The bundled Mozilla set is always included as a
-         * device-independent baseline; the system store and any settings-
-         * provided override are layered on top for private/enterprise roots.
-         *
-         * The previous pick-one order let a device's system store shadow the
-         * bundled set (and aborted TLS entirely if that store failed to parse),
-         * which made Android release builds fail non-deterministically when the
-         * server's root was missing from the device store (#24). */
-        mbedtls_x509_crt_init(&tls->ca_chain);
-        tls->ca_chain_initialized = 1;
-
-        int sources = 0;
-
-        /* Bundled Mozilla CA — always present, deterministic baseline. */
-        sources += ws_tls_add_ca(&tls->ca_chain, colyseus_ca_bundle_pem,
-                                 colyseus_ca_bundle_pem_len, "bundled Mozilla CA");
-
-        /* System trust store — additive; picks up device/enterprise roots. */
-        if (colyseus_system_certs_init()) {
-            sources += ws_tls_add_ca(&tls->ca_chain, colyseus_system_certs_get_pem(),
-                                     colyseus_system_certs_get_pem_len(), "system");
-        }
-
-        /* Explicit settings/override certificates — additive. */
-        sources += ws_tls_add_ca(&tls->ca_chain, data->ca_pem_data,
-                                 data->ca_pem_len, "settings");
-
-        if (sources == 0) {
-            WS_LOG("No CA certificates could be loaded - cannot verify TLS peer");
-            if (out_err) *out_err = "No CA certificates available for TLS verification";
-            ws_tls_cleanup(data);
-            return false;
-        }
 
-        mbedtls_ssl_conf_ca_chain(&tls->conf, &tls->ca_chain, NULL);
-    }
-    
-    mbedtls_ssl_conf_rng(&tls->conf, mbedtls_ctr_drbg_random, &tls->ctr_drbg);
-    
-    if (mbedtls_ssl_setup(&tls->ssl, &tls->conf) != 0) {
+    if (mbedtls_ssl_setup(&tls->ssl, colyseus_tls_config_get_ssl_config(tls->config)) != 0) {
         ws_tls_cleanup(data);
         return false;
     }
-    
+
     if (mbedtls_ssl_set_hostname(&tls->ssl, data->url_host) != 0) {
         ws_tls_cleanup(data);
         return false;
     }
-    
-    mbedtls_ssl_set_bio(&tls->ssl, &data->socket_fd, tls_bio_send, tls_bio_recv, NULL);
+
+    mbedtls_ssl_set_bio(&tls->ssl, data, tls_bio_send, tls_bio_recv, NULL);
+
+    /* Resume the last session with this server if there is one. mbedtls
+     * falls back to a full handshake when the server declines it. */
+    mbedtls_ssl_set_verify(&tls->ssl, ws_tls_verify_cb, tls);
+    tls->session_offered = colyseus_tls_config_offer_session(tls->config, data->url_host,
+                                                             data->url_port, &tls->ssl) ? 1 : 0;
 
     return true;
 }
 
 static void ws_tls_cleanup(colyseus_ws_transport_data_t* data) {
     if (!data->tls_ctx) return;
-    
+
     colyseus_tls_context_t* tls = (colyseus_tls_context_t*)data->tls_ctx;
     mbedtls_ssl_free(&tls->ssl);
-    mbedtls_ssl_config_free(&tls->conf);
-    mbedtls_ctr_drbg_free(&tls->ctr_drbg);
-    mbedtls_entropy_free(&tls->entropy);
-    if (tls->ca_chain_initialized) {
-        mbedtls_x509_crt_free(&tls->ca_chain);
-    }
+    colyseus_tls_config_release(tls->config);
     free(tls);
     data->tls_ctx = NULL;
 }
@@ -1086,9 +2757,19 @@ static int ws_tls_handshake_tick(colyseus_ws_transport_data_t* data) {
     if (tls->handshake_done) return WS_TLS_HS_DONE;
 
     int ret = mbedtls_ssl_handshake(&tls->ssl);
+    data->io_want_write = (ret == MBEDTLS_ERR_SSL_WANT_WRITE);
 
     if (ret == 0) {
         tls->handshake_done = 1;
+        /* Without verification no certificate callback runs, so there is
+         * nothing to tell the two apart by (and no session is cached) */
+        if (tls->session_offered && !tls->peer_verified && !data->tls_skip_verify) {
+            data->tls_resumed = true;
+            WS_LOG("TLS session resumed");
+        } else {
+            data->tls_full_handshake = true;
+        }
+        colyseus_tls_config_save_session(tls->config, data->url_host, data->url_port, &tls->ssl);
         return WS_TLS_HS_DONE;
     }
 
@@ -1115,9 +2796,105 @@ void colyseus_websocket_connect_with_settings(colyseus_transport_t* transport,
     data->tls_skip_verify = settings ? settings->tls_skip_verification : false;
     data->ca_pem_data    = settings ? settings->ca_pem_data : NULL;
     data->ca_pem_len     = settings ? settings->ca_pem_len : 0;
+    data->io_runtime     = settings ? settings->io_runtime : NULL;
+    data->external_loop  = settings ? settings->external_event_loop : false;
+    data->compression    = settings ? settings->ws_compression : false;
+    data->compression_max_memory = settings ? settings->ws_compression_max_memory : 0;
+    ws_keepalive_t* k = (ws_keepalive_t*)data->keepalive;
+    if (k) {
+        k->interval_ms = settings ? settings->ws_ping_interval_ms : 0;
+        k->timeout_ms = settings ? settings->ws_pong_timeout_ms : 0;
+    }
     transport->connect(transport, url);
 }
 
+/* External event loop entry points. Every state is driven by non-blocking
+ * calls, so readable / writable / timeout all run the same step. */
+static void ws_external_step(colyseus_transport_t* transport) {
+    if (!transport) return;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    if (!data->external_loop || !data->running) return;
+
+    if (!ws_io_step(transport)) {
+        ws_finish_deferred_close(transport);
+    }
+}
+
+int colyseus_transport_get_fd(const colyseus_transport_t* transport) {
+    if (!transport) return -1;
+    const colyseus_ws_transport_data_t* data = (const colyseus_ws_transport_data_t*)transport->impl_data;
+    return data->running ? data->socket_fd : -1;
+}
+
+int colyseus_transport_get_interest(const colyseus_transport_t* transport) {
+    if (!transport) return 0;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    if (!data->running) return 0;
+
+    bool immediate = false;
+    int events = ws_io_interest(data, &immediate);
+    return ((events & COLYSEUS_IO_READ) ? COLYSEUS_TRANSPORT_WANT_READ : 0) |
+           ((events & COLYSEUS_IO_WRITE) ? COLYSEUS_TRANSPORT_WANT_WRITE : 0);
+}
+
+int colyseus_transport_get_timeout_ms(const colyseus_transport_t* transport) {
+    if (!transport) return -1;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+    if (!data->running) return -1;
+
+    bool immediate = false;
+    ws_io_interest(data, &immediate);
+    return immediate ? 0 : ws_io_timeout_ms(data);
+}
+
+void colyseus_transport_on_readable(colyseus_transport_t* transport) {
+    ws_external_step(transport);
+}
+
+void colyseus_transport_on_writable(colyseus_transport_t* transport) {
+    ws_external_step(transport);
+}
+
+void colyseus_transport_on_timeout(colyseus_transport_t* transport) {
+    ws_external_step(transport);
+}
+
+void colyseus_transport_get_stats(const colyseus_transport_t* transport,
+                                  colyseus_transport_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(colyseus_transport_stats_t));
+    if (!transport) return;
+    colyseus_ws_transport_data_t* data = (colyseus_ws_transport_data_t*)transport->impl_data;
+
+    ws_send_queue_t* q = (ws_send_queue_t*)data->send_queue;
+    if (q) {
+        out->frames_sent = atomic_load_explicit(&q->frames_sent, memory_order_relaxed);
+        out->bytes_sent = atomic_load_explicit(&q->bytes_sent, memory_order_relaxed);
+        out->send_calls = atomic_load_explicit(&q->send_calls, memory_order_relaxed);
+    }
+    ws_frame_reader_t* r = (ws_frame_reader_t*)data->frame_reader;
+    if (r) {
+        out->messages_received = atomic_load_explicit(&r->messages_received, memory_order_relaxed);
+        out->bytes_received = atomic_load_explicit(&r->bytes_received, memory_order_relaxed);
+    }
+    out->resolve_ms = data->resolve_ms;
+    out->connect_ms = data->connect_ms;
+    out->connect_attempts = data->connect_attempts;
+    out->tls_full_handshakes = data->tls_full_handshake ? 1 : 0;
+    out->tls_resumed_handshakes = data->tls_resumed ? 1 : 0;
+    out->tls_ms = data->tls_ms;
+    out->upgrade_ms = data->upgrade_ms;
+    ws_keepalive_t* k = (ws_keepalive_t*)data->keepalive;
+    if (k) {
+        out->pings_sent = atomic_load_explicit(&k->pings_sent, memory_order_relaxed);
+        out->pongs_received = atomic_load_explicit(&k->pongs_received, memory_order_relaxed);
+        out->rtt_us = atomic_load_explicit(&k->rtt_us, memory_order_relaxed);
+        out->srtt_us = atomic_load_explicit(&k->srtt_us, memory_order_relaxed);
+        out->rtt_jitter_us = atomic_load_explicit(&k->rttvar_us, memory_order_relaxed);
+        out->last_seen_ms = atomic_load_explicit(&k->last_seen_ms, memory_order_relaxed);
+    }
+}
+
 void colyseus_http_poll(void) {
     /* Native HTTP is synchronous - no polling needed */
 }
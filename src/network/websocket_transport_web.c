@@ -177,6 +177,8 @@ colyseus_transport_t* colyseus_websocket_transport_create(const colyseus_transpo
     transport->close = web_ws_close_impl;
     transport->is_open = web_ws_is_open_impl;
     transport->destroy = web_ws_destroy_impl;
+    transport->send_parts = NULL;
+    transport->send_batch = NULL;
 
     if (events) {
         transport->events = *events;
@@ -469,6 +471,8 @@ colyseus_transport_t* colyseus_websocket_transport_create(const colyseus_transpo
     transport->close = web_ws_close_impl;
     transport->is_open = web_ws_is_open_impl;
     transport->destroy = web_ws_destroy_impl;
+    transport->send_parts = NULL;
+    transport->send_batch = NULL;
 
     if (events) {
         transport->events = *events;
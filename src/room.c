@@ -1,11 +1,16 @@
 #include "colyseus/room.h"
 #include "colyseus/websocket_transport.h"
 #include "colyseus/schema.h"
+#include "colyseus/schema/snapshot.h"
 #include "colyseus/messages.h"
 #include "colyseus/utils/time.h"
+#include "utils/spinlock.h"
+#include "utils/timers.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdatomic.h>
+#include <limits.h>
 
 /* Platform-specific threading + sleep */
 #ifdef __EMSCRIPTEN__
@@ -26,20 +31,31 @@ static void room_on_transport_open(void* userdata);
 static void room_on_transport_message(const uint8_t* data, size_t length, void* userdata);
 static void room_on_transport_close(int code, const char* reason, void* userdata);
 static void room_on_transport_error(const char* error, void* userdata);
-static void room_dispatch_message(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length);
-static void room_dispatch_message_bytes(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length);
+typedef struct room_message_type room_message_type_t;
+static void room_dispatch_message(colyseus_room_t* room, const room_message_type_t* type,
+                                  const uint8_t* message, size_t length);
+static void room_dispatch_message_bytes(colyseus_room_t* room, const room_message_type_t* type,
+                                        const uint8_t* message, size_t length);
 static char* room_get_message_key_str(const char* type);
 static char* room_get_message_key_int(int type);
+static void room_join_timings_begin(colyseus_room_t* room, uint64_t started_ms,
+                                    uint32_t matchmake_ms, bool prewarmed);
+static void room_join_timings_end(colyseus_room_t* room);
 
 /* Decode helpers using schema decode functions */
 static float decode_number(const uint8_t* bytes, size_t* offset);
 static char* decode_string(const uint8_t* bytes, size_t* offset);
+static bool room_decode_message_type(const uint8_t* bytes, size_t length, size_t* offset,
+                                     room_message_type_t* out);
 
 /* Reconnection helpers */
-static void room_enqueue_message(colyseus_room_t* room, const uint8_t* data, size_t length);
+static void* room_msg_queue_create(void);
 static void room_clear_message_queue(colyseus_room_t* room);
+static void room_msg_queue_reserve(colyseus_room_t* room);
 static void room_flush_message_queue(colyseus_room_t* room);
-static bool room_send_or_enqueue(colyseus_room_t* room, const uint8_t* data, size_t length);
+static bool room_msg_is_droppable(colyseus_room_t* room, const char* type, int int_type);
+static bool room_send_parts_or_enqueue(colyseus_room_t* room, const colyseus_transport_buf_t* parts,
+                                       size_t count, bool droppable);
 static char* room_build_reconnect_url(const colyseus_room_t* room);
 static void room_handle_reconnection(colyseus_room_t* room, int code, const char* reason);
 static void room_reconnection_signal_attempt_done(colyseus_room_t* room);
@@ -48,9 +64,22 @@ static void room_reconnection_cancel(colyseus_room_t* room);
 static void room_reconnection_init(colyseus_room_t* room);
 static void room_reconnection_teardown(colyseus_room_t* room);
 
-/* Reconnection worker:
- * - On native (pthreads/Win32), a dedicated thread runs the retry loop with
- *   a timed condvar wait. Cancelling sets `cancelled=true` and signals.
+/* Poll mode helpers */
+static colyseus_transport_events_t room_transport_events(colyseus_room_t* room);
+static void room_on_reconnect_failed(colyseus_room_t* room);
+#ifndef __EMSCRIPTEN__
+static void room_emit_close(colyseus_room_t* room, int code, const char* reason);
+static void room_emit_reconnect_failed(colyseus_room_t* room);
+#endif
+
+/* Reconnection scheduling:
+ * - On native (pthreads/Win32), each room has a timer on the shared timer
+ *   wheel (utils/timers.h): the backoff delay is a blocking timer, so the
+ *   attempt (transport teardown, connect, close callbacks) runs on a timer
+ *   worker rather than the wheel thread, and the attempt's close/error arms
+ *   the next one. Rooms don't own threads, so a mass drop costs one
+ *   sleeping thread plus a few workers.
+ *   Cancelling sets `cancelled=true` and disarms the timer.
  * - On Emscripten, the worker is a no-op: automatic reconnection is not
  *   currently supported in the browser build (the JS event loop driving
  *   `emscripten_fetch` cannot host a blocking retry loop).
@@ -59,23 +88,20 @@ typedef struct colyseus_reconnection_worker {
 #ifdef __EMSCRIPTEN__
     int _unused;
 #elif defined(_WIN32)
-    HANDLE thread;
     CRITICAL_SECTION mutex;
-    CONDITION_VARIABLE cond;
-    bool thread_started;
+    colyseus_timer_t* timer;
     bool pending_attempt;
 #else
-    pthread_t thread;
     pthread_mutex_t mutex;
-    pthread_cond_t cond;
-    bool thread_started;
+    colyseus_timer_t* timer;
     bool pending_attempt;
 #endif
 } colyseus_reconnection_worker_t;
 
 #ifdef __EMSCRIPTEN__
 
-static colyseus_reconnection_worker_t* room_worker_create(void) {
+static colyseus_reconnection_worker_t* room_worker_create(colyseus_room_t* room) {
+    (void)room;
     return NULL;
 }
 static void room_worker_destroy(colyseus_reconnection_worker_t* w) { (void)w; }
@@ -85,81 +111,49 @@ static void room_worker_destroy(colyseus_reconnection_worker_t* w) { (void)w; }
 #ifdef _WIN32
     #define WORKER_LOCK(w)   EnterCriticalSection(&(w)->mutex)
     #define WORKER_UNLOCK(w) LeaveCriticalSection(&(w)->mutex)
-    #define WORKER_SIGNAL(w) WakeConditionVariable(&(w)->cond)
 #else
     #define WORKER_LOCK(w)   pthread_mutex_lock(&(w)->mutex)
     #define WORKER_UNLOCK(w) pthread_mutex_unlock(&(w)->mutex)
-    #define WORKER_SIGNAL(w) pthread_cond_signal(&(w)->cond)
 #endif
 
-static colyseus_reconnection_worker_t* room_worker_create(void) {
+static void room_reconnect_timer_fn(void* arg);
+
+static colyseus_reconnection_worker_t* room_worker_create(colyseus_room_t* room) {
     colyseus_reconnection_worker_t* w = malloc(sizeof(*w));
     if (!w) return NULL;
     memset(w, 0, sizeof(*w));
+    w->timer = colyseus_timer_create_blocking(room_reconnect_timer_fn, room);
+    if (!w->timer) {
+        free(w);
+        return NULL;
+    }
 #ifdef _WIN32
     InitializeCriticalSection(&w->mutex);
-    InitializeConditionVariable(&w->cond);
 #else
     pthread_mutex_init(&w->mutex, NULL);
-    pthread_cond_init(&w->cond, NULL);
 #endif
-    w->thread_started = false;
     w->pending_attempt = false;
     return w;
 }
 
+/* Waits for a running attempt callback, unless called from it */
 static void room_worker_destroy(colyseus_reconnection_worker_t* w) {
     if (!w) return;
+    colyseus_timer_free(w->timer);
 #ifdef _WIN32
     DeleteCriticalSection(&w->mutex);
 #else
     pthread_mutex_destroy(&w->mutex);
-    pthread_cond_destroy(&w->cond);
 #endif
     free(w);
 }
 
-/* Wait on the worker condvar for up to delay_ms milliseconds. Caller holds
- * the worker mutex. */
-static void room_worker_timedwait(colyseus_reconnection_worker_t* w, int delay_ms) {
-#ifdef _WIN32
-    SleepConditionVariableCS(&w->cond, &w->mutex, (DWORD)delay_ms);
-#else
-    struct timespec ts;
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    uint64_t total_ns = (uint64_t)tv.tv_sec * 1000000000ULL
-                      + (uint64_t)tv.tv_usec * 1000ULL
-                      + (uint64_t)delay_ms * 1000000ULL;
-    ts.tv_sec = (time_t)(total_ns / 1000000000ULL);
-    ts.tv_nsec = (long)(total_ns % 1000000000ULL);
-    pthread_cond_timedwait(&w->cond, &w->mutex, &ts);
-#endif
-}
-
-/* Block on the worker condvar until signalled. Caller holds the worker mutex. */
-static void room_worker_wait(colyseus_reconnection_worker_t* w) {
-#ifdef _WIN32
-    SleepConditionVariableCS(&w->cond, &w->mutex, INFINITE);
-#else
-    pthread_cond_wait(&w->cond, &w->mutex);
-#endif
-}
-
 #endif /* __EMSCRIPTEN__ */
 
-/* ── Reconnection worker (native only) ─────────────────────────── */
+/* ── Reconnection attempts (native only) ───────────────────────── */
 
 #ifndef __EMSCRIPTEN__
 
-#ifdef _WIN32
-typedef DWORD worker_return_t;
-#define WORKER_THREAD_CALL WINAPI
-#else
-typedef void* worker_return_t;
-#define WORKER_THREAD_CALL
-#endif
-
 static int room_compute_backoff_delay(const colyseus_reconnection_options_t* opts, int attempt) {
     /* (1 << attempt) * delay_ms, clamped to [min_delay_ms, max_delay_ms].
      * Cap the shift at 30 to avoid overflow on pathological max_retries. */
@@ -167,6 +161,12 @@ static int room_compute_backoff_delay(const colyseus_reconnection_options_t* opt
     if (shift > 30) shift = 30;
     long long delay = (long long)(1u << shift) * (long long)opts->delay_ms;
     if (delay > (long long)opts->max_delay_ms) delay = opts->max_delay_ms;
+
+    /* Rooms dropped together by a server restart would otherwise retry in
+     * lockstep: keep the upper half of the delay, randomize the lower */
+    if (opts->jitter && delay > 1) {
+        delay = delay - delay / 2 + (long long)colyseus_timer_jitter((uint32_t)(delay / 2));
+    }
     if (delay < (long long)opts->min_delay_ms) delay = opts->min_delay_ms;
     return (int)delay;
 }
@@ -180,29 +180,23 @@ static void room_attempt_reconnect(colyseus_room_t* room) {
         room->transport = NULL;
     }
 
-    colyseus_transport_events_t events = {
-        .on_open = room_on_transport_open,
-        .on_message = room_on_transport_message,
-        .on_close = room_on_transport_close,
-        .on_error = room_on_transport_error,
-        .userdata = room
-    };
+    colyseus_transport_events_t events = room_transport_events(room);
 
     room->transport = room->transport_factory(&events);
     if (!room->transport) {
         /* Treat as an immediate failure; the close path will route us back
          * into the worker for another retry. */
-        room_on_transport_close(COLYSEUS_CLOSE_ABNORMAL_CLOSURE,
-                                "Failed to create transport for reconnect",
-                                room);
+        room_emit_close(room, COLYSEUS_CLOSE_ABNORMAL_CLOSURE,
+                        "Failed to create transport for reconnect");
         return;
     }
 
+    room_join_timings_begin(room, colyseus_monotonic_ms(), 0, false);
+
     char* url = room_build_reconnect_url(room);
     if (!url) {
-        room_on_transport_close(COLYSEUS_CLOSE_ABNORMAL_CLOSURE,
-                                "Failed to build reconnect URL",
-                                room);
+        room_emit_close(room, COLYSEUS_CLOSE_ABNORMAL_CLOSURE,
+                        "Failed to build reconnect URL");
         return;
     }
 
@@ -215,85 +209,49 @@ static void room_attempt_reconnect(colyseus_room_t* room) {
     free(url);
 }
 
-static worker_return_t WORKER_THREAD_CALL room_reconnect_worker_func(void* arg) {
-    colyseus_room_t* room = (colyseus_room_t*)arg;
+/* Arm the timer for the next attempt, or give up after max_retries */
+static void room_reconnection_schedule_next(colyseus_room_t* room) {
     colyseus_reconnection_worker_t* w =
         (colyseus_reconnection_worker_t*)room->reconnection.worker;
 
     WORKER_LOCK(w);
-    while (!room->reconnection.cancelled && room->reconnection.is_reconnecting) {
-        room->reconnection.retry_count++;
-
-        if (room->reconnection.retry_count > room->reconnection.options.max_retries) {
-            room->reconnection.is_reconnecting = false;
-            WORKER_UNLOCK(w);
-            if (room->serializer) {
-                colyseus_schema_serializer_teardown(room->serializer);
-            }
-            if (room->on_leave) {
-                room->on_leave(COLYSEUS_CLOSE_FAILED_TO_RECONNECT,
-                               "No more retries. Reconnection failed.",
-                               room->on_leave_userdata);
-            }
-            goto done;
-        }
+    if (room->reconnection.cancelled || !room->reconnection.is_reconnecting) {
+        WORKER_UNLOCK(w);
+        return;
+    }
 
+    room->reconnection.retry_count++;
+    if (room->reconnection.retry_count <= room->reconnection.options.max_retries) {
         int delay = room_compute_backoff_delay(&room->reconnection.options,
                                                room->reconnection.retry_count);
-
-        room_worker_timedwait(w, delay);
-        if (room->reconnection.cancelled || !room->reconnection.is_reconnecting) {
-            break;
-        }
-
-        w->pending_attempt = true;
-        WORKER_UNLOCK(w);
-        room_attempt_reconnect(room);
-        WORKER_LOCK(w);
-
-        /* Wait for either a successful JOIN_ROOM (sets is_reconnecting=false
-         * and signals) or a close/error from the failed attempt (clears
-         * pending_attempt and signals). */
-        while (w->pending_attempt
-               && !room->reconnection.cancelled
-               && room->reconnection.is_reconnecting) {
-            room_worker_wait(w);
+        if (colyseus_timer_arm(w->timer, (uint32_t)delay)) {
+            WORKER_UNLOCK(w);
+            return;
         }
     }
-    WORKER_UNLOCK(w);
 
-done:
-#ifdef _WIN32
-    return 0;
-#else
-    return NULL;
-#endif
+    room->reconnection.is_reconnecting = false;
+    WORKER_UNLOCK(w);
+    room_emit_reconnect_failed(room);
 }
 
-static void room_reconnect_worker_spawn(colyseus_room_t* room) {
+/* Timer worker: the backoff delay elapsed */
+static void room_reconnect_timer_fn(void* arg) {
+    colyseus_room_t* room = (colyseus_room_t*)arg;
     colyseus_reconnection_worker_t* w =
         (colyseus_reconnection_worker_t*)room->reconnection.worker;
-    if (!w) return;
-    /* Caller must already hold w->mutex. */
-    if (w->thread_started) return;
-    w->thread_started = true;
-#ifdef _WIN32
-    w->thread = CreateThread(NULL, 0, room_reconnect_worker_func, room, 0, NULL);
-#else
-    pthread_create(&w->thread, NULL, room_reconnect_worker_func, room);
-#endif
-}
 
-static void room_reconnect_worker_join(colyseus_reconnection_worker_t* w) {
-    if (!w) return;
-    if (!w->thread_started) return;
-#ifdef _WIN32
-    WaitForSingleObject(w->thread, INFINITE);
-    CloseHandle(w->thread);
-#else
-    pthread_join(w->thread, NULL);
-#endif
-    w->thread_started = false;
+    WORKER_LOCK(w);
+    if (room->reconnection.cancelled || !room->reconnection.is_reconnecting) {
+        WORKER_UNLOCK(w);
+        return;
+    }
+    w->pending_attempt = true;
+    WORKER_UNLOCK(w);
+
+    /* Resolves with JOIN_ROOM (room_reconnection_signal_success) or a
+     * close / error (room_reconnection_signal_attempt_done) */
+    room_attempt_reconnect(room);
 }
 
 #endif /* !__EMSCRIPTEN__ */
@@ -309,6 +267,9 @@ void colyseus_reconnection_options_init_defaults(colyseus_reconnection_options_t
     options->min_uptime_ms = 5000;
     options->delay_ms = 100;
     options->max_enqueued_messages = 10;
+    options->jitter = true;
+    options->max_enqueued_bytes = 64 * 1024;
+    options->drop_policy = COLYSEUS_QUEUE_DROP_OLDEST;
 }
 
 static void room_reconnection_init(colyseus_room_t* room) {
@@ -316,22 +277,15 @@ static void room_reconnection_init(colyseus_room_t* room) {
     room->reconnection.retry_count = 0;
     room->reconnection.is_reconnecting = false;
     room->reconnection.cancelled = false;
-    room->reconnection.queue_head = NULL;
-    room->reconnection.queue_tail = NULL;
-    room->reconnection.queue_count = 0;
-    room->reconnection.worker = room_worker_create();
+    room->reconnection.queue = room_msg_queue_create();
+    room->reconnection.worker = room_worker_create(room);
 }
 
 static void room_reconnection_teardown(colyseus_room_t* room) {
     room_reconnection_cancel(room);
     room_clear_message_queue(room);
 
-    colyseus_reconnection_worker_t* w =
-        (colyseus_reconnection_worker_t*)room->reconnection.worker;
-#ifndef __EMSCRIPTEN__
-    room_reconnect_worker_join(w);
-#endif
-    room_worker_destroy(w);
+    room_worker_destroy((colyseus_reconnection_worker_t*)room->reconnection.worker);
     room->reconnection.worker = NULL;
 }
 
@@ -345,7 +299,7 @@ static void room_reconnection_cancel(colyseus_room_t* room) {
     WORKER_LOCK(w);
     room->reconnection.cancelled = true;
     room->reconnection.is_reconnecting = false;
-    WORKER_SIGNAL(w);
+    colyseus_timer_cancel(w->timer);
     WORKER_UNLOCK(w);
 #endif
 }
@@ -361,7 +315,6 @@ static void room_reconnection_signal_success(colyseus_room_t* room) {
     room->reconnection.is_reconnecting = false;
     w->pending_attempt = false;
     room->reconnection.retry_count = 0;
-    WORKER_SIGNAL(w);
     WORKER_UNLOCK(w);
 #endif
 }
@@ -373,85 +326,391 @@ static void room_reconnection_signal_attempt_done(colyseus_room_t* room) {
     colyseus_reconnection_worker_t* w =
         (colyseus_reconnection_worker_t*)room->reconnection.worker;
     if (!w) return;
+    /* close and error can both report one attempt */
     WORKER_LOCK(w);
+    bool was_pending = w->pending_attempt;
     w->pending_attempt = false;
-    WORKER_SIGNAL(w);
     WORKER_UNLOCK(w);
+    if (was_pending) {
+        room_reconnection_schedule_next(room);
+    }
 #endif
 }
 
 /* ── Pending message queue ─────────────────────────────────────── */
 
-static void room_clear_message_queue(colyseus_room_t* room) {
-    colyseus_pending_msg_t* m = room->reconnection.queue_head;
-    while (m) {
-        colyseus_pending_msg_t* next = m->next;
-        free(m->data);
-        free(m);
-        m = next;
+/* Messages sent while reconnecting are copied into one contiguous buffer of
+ * max_enqueued_bytes, allocated when a reconnection first starts and kept
+ * for the room's lifetime. Each record is an 8-byte header followed by the
+ * message, padded to 8 bytes. Dropping from the front advances `head`;
+ * dropping by type tombstones the record in place. When a message doesn't
+ * fit behind `tail`, the live records slide back to the start (squeezing
+ * out tombstones), so the buffer wraps without ever splitting a message.
+ * The flush hands every live record to the transport as one batch.
+ * Messages sent while it runs go into a second buffer, which grows as
+ * needed (the connection is live: no budget, nothing dropped), and are
+ * flushed right after, so they neither overtake the backlog nor get lost.
+ *
+ * Sends come from the user's thread and the flush from the network
+ * thread; a spinlock covers the buffer (held for memcpy's, not I/O). */
+
+typedef struct {
+    uint32_t length;
+    uint8_t droppable;
+    uint8_t dead;
+    uint8_t pad[2];
+} room_msg_record_t;
+
+#define ROOM_MSG_ALIGN(n)   (((n) + 7) & ~(size_t)7)
+#define ROOM_MSG_SIZE(len)  (sizeof(room_msg_record_t) + ROOM_MSG_ALIGN(len))
+#define ROOM_MSG_FLUSH_CHUNK 64
+
+typedef struct room_droppable_type {
+    char* type;                 /* NULL for numeric types */
+    int int_type;
+    struct room_droppable_type* next;
+} room_droppable_type_t;
+
+typedef struct {
+    colyseus_spinlock_t lock;
+    uint8_t* buf;
+    size_t capacity;
+    size_t head;                /* first live record (or == tail) */
+    size_t tail;                /* end of the last record */
+    size_t live_bytes;          /* record bytes not tombstoned */
+    int count;                  /* live records */
+    atomic_bool flushing;       /* the backlog is detached and being sent */
+    room_droppable_type_t* droppable;
+} room_msg_queue_t;
+
+static void* room_msg_queue_create(void) {
+    room_msg_queue_t* q = calloc(1, sizeof(*q));
+    if (!q) return NULL;
+    colyseus_spinlock_init(&q->lock);
+    atomic_init(&q->flushing, false);
+    return q;
+}
+
+static inline room_msg_record_t* room_msg_at(room_msg_queue_t* q, size_t pos) {
+    return (room_msg_record_t*)(q->buf + pos);
+}
+
+static void room_msg_queue_reset(room_msg_queue_t* q) {
+    q->head = 0;
+    q->tail = 0;
+    q->live_bytes = 0;
+    q->count = 0;
+}
+
+/* Move head past tombstones */
+static void room_msg_queue_skip_dead(room_msg_queue_t* q) {
+    while (q->head < q->tail && room_msg_at(q, q->head)->dead) {
+        q->head += ROOM_MSG_SIZE(room_msg_at(q, q->head)->length);
+    }
+    if (q->head == q->tail) room_msg_queue_reset(q);
+}
+
+static void room_msg_queue_kill(room_msg_queue_t* q, size_t pos) {
+    room_msg_record_t* rec = room_msg_at(q, pos);
+    rec->dead = 1;
+    q->live_bytes -= ROOM_MSG_SIZE(rec->length);
+    q->count--;
+    if (pos == q->head) room_msg_queue_skip_dead(q);
+}
+
+/* Drop one message to make room. By-type takes the oldest droppable one
+ * if there is any, otherwise (and for drop-oldest) the front. */
+static void room_msg_queue_drop_one(room_msg_queue_t* q, colyseus_queue_drop_policy_t policy) {
+    if (policy == COLYSEUS_QUEUE_DROP_BY_TYPE) {
+        for (size_t pos = q->head; pos < q->tail; ) {
+            room_msg_record_t* rec = room_msg_at(q, pos);
+            if (!rec->dead && rec->droppable) {
+                room_msg_queue_kill(q, pos);
+                return;
+            }
+            pos += ROOM_MSG_SIZE(rec->length);
+        }
     }
-    room->reconnection.queue_head = NULL;
-    room->reconnection.queue_tail = NULL;
-    room->reconnection.queue_count = 0;
+    room_msg_queue_kill(q, q->head);
+}
+
+/* Slide live records to the start of the buffer */
+static void room_msg_queue_compact(room_msg_queue_t* q) {
+    size_t out = 0;
+    for (size_t pos = q->head; pos < q->tail; ) {
+        room_msg_record_t* rec = room_msg_at(q, pos);
+        size_t size = ROOM_MSG_SIZE(rec->length);
+        if (!rec->dead) {
+            if (out != pos) memmove(q->buf + out, q->buf + pos, size);
+            out += size;
+        }
+        pos += size;
+    }
+    q->head = 0;
+    q->tail = out;
+}
+
+/* Reconnection is starting: make sure the buffer exists and matches the
+ * configured budget (resized only while empty) */
+static void room_msg_queue_reserve(colyseus_room_t* room) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q) return;
+    size_t capacity = ROOM_MSG_ALIGN(room->reconnection.options.max_enqueued_bytes);
+
+    colyseus_spinlock_lock(&q->lock);
+    if (q->capacity != capacity && q->count == 0) {
+        free(q->buf);
+        q->buf = capacity ? malloc(capacity) : NULL;
+        q->capacity = q->buf ? capacity : 0;
+        room_msg_queue_reset(q);
+    }
+    colyseus_spinlock_unlock(&q->lock);
 }
 
-static void room_enqueue_message(colyseus_room_t* room, const uint8_t* data, size_t length) {
-    if (length == 0) return;
-    /* Drop oldest if at capacity (parity with TS SDK). */
-    while (room->reconnection.queue_count >= room->reconnection.options.max_enqueued_messages) {
-        colyseus_pending_msg_t* old = room->reconnection.queue_head;
-        if (!old) break;
-        room->reconnection.queue_head = old->next;
-        if (!room->reconnection.queue_head) room->reconnection.queue_tail = NULL;
-        room->reconnection.queue_count--;
-        free(old->data);
-        free(old);
-    }
-
-    colyseus_pending_msg_t* m = malloc(sizeof(*m));
-    if (!m) return;
-    m->data = malloc(length);
-    if (!m->data) { free(m); return; }
-    memcpy(m->data, data, length);
-    m->length = length;
-    m->next = NULL;
-
-    if (room->reconnection.queue_tail) {
-        room->reconnection.queue_tail->next = m;
+static void room_clear_message_queue(colyseus_room_t* room) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q) return;
+    free(q->buf);
+    room_droppable_type_t* d = q->droppable;
+    while (d) {
+        room_droppable_type_t* next = d->next;
+        free(d->type);
+        free(d);
+        d = next;
+    }
+    free(q);
+    room->reconnection.queue = NULL;
+}
+
+/* Lock held. Room for `size` bytes behind tail without dropping anything:
+ * the buffer grows (starting from `initial` bytes) */
+static bool room_msg_queue_grow(room_msg_queue_t* q, size_t size, size_t initial) {
+    if (q->buf && q->tail + size <= q->capacity) return true;
+    size_t capacity = q->buf && q->capacity ? q->capacity : (initial ? initial : ROOM_MSG_ALIGN(size));
+    while (capacity < q->tail + size) {
+        if (capacity > SIZE_MAX / 2) return false;
+        capacity *= 2;
+    }
+    uint8_t* buf = realloc(q->buf, capacity);
+    if (!buf) return false;
+    q->buf = buf;
+    q->capacity = capacity;
+    return true;
+}
+
+/* Lock held. Copy `parts` in as one message. False if it was refused
+ * (too big, or the queue is full under drop-newest). */
+static bool room_msg_queue_append(colyseus_room_t* room, room_msg_queue_t* q,
+                                  const colyseus_transport_buf_t* parts, size_t count, bool droppable) {
+    const colyseus_reconnection_options_t* opts = &room->reconnection.options;
+
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) length += parts[i].length;
+    if (length == 0 || length > UINT32_MAX) return false;
+    size_t size = ROOM_MSG_SIZE(length);
+
+    if (atomic_load_explicit(&q->flushing, memory_order_relaxed)) {
+        /* Behind a flush on a live connection: the reconnection budget and
+         * drop policy don't apply, the buffer grows instead */
+        if (!room_msg_queue_grow(q, size, ROOM_MSG_ALIGN(opts->max_enqueued_bytes))) return false;
     } else {
-        room->reconnection.queue_head = m;
+        if (size > q->capacity) return false;
+
+        bool full_count = opts->max_enqueued_messages > 0 && q->count >= opts->max_enqueued_messages;
+        if (opts->drop_policy == COLYSEUS_QUEUE_DROP_NEWEST &&
+            (full_count || q->live_bytes + size > q->capacity)) {
+            return false;
+        }
+        while (q->count > 0 &&
+               ((opts->max_enqueued_messages > 0 && q->count >= opts->max_enqueued_messages) ||
+                q->live_bytes + size > q->capacity)) {
+            room_msg_queue_drop_one(q, opts->drop_policy);
+        }
+        if (q->tail + size > q->capacity) {
+            room_msg_queue_compact(q);
+        }
     }
-    room->reconnection.queue_tail = m;
-    room->reconnection.queue_count++;
-}
 
+    room_msg_record_t* rec = room_msg_at(q, q->tail);
+    rec->length = (uint32_t)length;
+    rec->droppable = droppable;
+    rec->dead = 0;
+    uint8_t* out = q->buf + q->tail + sizeof(*rec);
+    for (size_t i = 0; i < count; i++) {
+        if (parts[i].length == 0) continue;
+        memcpy(out, parts[i].data, parts[i].length);
+        out += parts[i].length;
+    }
+    q->tail += size;
+    q->live_bytes += size;
+    q->count++;
+    return true;
+}
+
+static bool room_enqueue_message(colyseus_room_t* room, const colyseus_transport_buf_t* parts,
+                                 size_t count, bool droppable) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q) return false;
+    colyseus_spinlock_lock(&q->lock);
+    bool queued = room_msg_queue_append(room, q, parts, count, droppable);
+    colyseus_spinlock_unlock(&q->lock);
+    return queued;
+}
+
+/* While a flush runs, queue behind the backlog instead of overtaking it on
+ * the transport. False (nothing done) if no flush is running. */
+static bool room_enqueue_behind_flush(colyseus_room_t* room, const colyseus_transport_buf_t* parts,
+                                      size_t count, bool droppable, bool* queued) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q || !atomic_load_explicit(&q->flushing, memory_order_acquire)) return false;
+
+    colyseus_spinlock_lock(&q->lock);
+    bool flushing = atomic_load_explicit(&q->flushing, memory_order_relaxed);
+    if (flushing) *queued = room_msg_queue_append(room, q, parts, count, droppable);
+    colyseus_spinlock_unlock(&q->lock);
+    return flushing;
+}
+
+/* Send the backlog as one batch. The buffer is detached while sending so
+ * the lock isn't held across the transport; whatever was queued behind it
+ * meanwhile is detached and sent in turn until nothing is left. */
 static void room_flush_message_queue(colyseus_room_t* room) {
-    if (!room->transport) return;
-    colyseus_pending_msg_t* m = room->reconnection.queue_head;
-    while (m) {
-        colyseus_pending_msg_t* next = m->next;
-        colyseus_transport_send(room->transport, m->data, m->length);
-        free(m->data);
-        free(m);
-        m = next;
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q || !room->transport) return;
+
+    colyseus_spinlock_lock(&q->lock);
+    uint8_t* buf = q->buf;
+    size_t capacity = q->capacity;
+    size_t head = q->head, tail = q->tail;
+    q->buf = NULL;
+    q->capacity = 0;
+    room_msg_queue_reset(q);
+    atomic_store_explicit(&q->flushing, buf != NULL, memory_order_release);
+    colyseus_spinlock_unlock(&q->lock);
+
+    while (buf) {
+        colyseus_transport_buf_t batch[ROOM_MSG_FLUSH_CHUNK];
+        size_t n = 0;
+        for (size_t pos = head; pos < tail; ) {
+            room_msg_record_t* rec = (room_msg_record_t*)(buf + pos);
+            if (!rec->dead) {
+                batch[n++] = (colyseus_transport_buf_t){ (const uint8_t*)(rec + 1), rec->length };
+                if (n == ROOM_MSG_FLUSH_CHUNK) {
+                    colyseus_transport_send_batch(room->transport, batch, n);
+                    n = 0;
+                }
+            }
+            pos += ROOM_MSG_SIZE(rec->length);
+        }
+        if (n > 0) colyseus_transport_send_batch(room->transport, batch, n);
+
+        colyseus_spinlock_lock(&q->lock);
+        if (q->count > 0) {
+            /* Sent during the flush: those go next */
+            uint8_t* sent = buf;
+            buf = q->buf;
+            capacity = q->capacity;
+            head = q->head;
+            tail = q->tail;
+            q->buf = NULL;
+            q->capacity = 0;
+            room_msg_queue_reset(q);
+            colyseus_spinlock_unlock(&q->lock);
+            free(sent);
+            continue;
+        }
+
+        /* Hand the buffer back for the next reconnection */
+        if (!q->buf) {
+            q->buf = buf;
+            q->capacity = capacity;
+            buf = NULL;
+        }
+        atomic_store_explicit(&q->flushing, false, memory_order_release);
+        colyseus_spinlock_unlock(&q->lock);
+        free(buf);
+        break;
+    }
+}
+
+static bool room_msg_is_droppable(colyseus_room_t* room, const char* type, int int_type) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q || room->reconnection.options.drop_policy != COLYSEUS_QUEUE_DROP_BY_TYPE) return false;
+    bool found = false;
+    colyseus_spinlock_lock(&q->lock);
+    for (room_droppable_type_t* d = q->droppable; d; d = d->next) {
+        if (type ? (d->type && strcmp(d->type, type) == 0)
+                 : (!d->type && d->int_type == int_type)) {
+            found = true;
+            break;
+        }
+    }
+    colyseus_spinlock_unlock(&q->lock);
+    return found;
+}
+
+static void room_set_droppable(colyseus_room_t* room, const char* type, int int_type, bool droppable) {
+    room_msg_queue_t* q = (room_msg_queue_t*)room->reconnection.queue;
+    if (!q) return;
+
+    room_droppable_type_t* added = NULL;
+    if (droppable) {
+        added = calloc(1, sizeof(*added));
+        if (!added) return;
+        added->int_type = int_type;
+        if (type && !(added->type = strdup(type))) {
+            free(added);
+            return;
+        }
+    }
+
+    room_droppable_type_t* removed = NULL;
+    colyseus_spinlock_lock(&q->lock);
+    for (room_droppable_type_t** p = &q->droppable; *p; p = &(*p)->next) {
+        room_droppable_type_t* d = *p;
+        if (type ? (d->type && strcmp(d->type, type) == 0)
+                 : (!d->type && d->int_type == int_type)) {
+            *p = d->next;
+            removed = d;
+            break;
+        }
+    }
+    if (added) {
+        added->next = q->droppable;
+        q->droppable = added;
+    }
+    colyseus_spinlock_unlock(&q->lock);
+
+    if (removed) {
+        free(removed->type);
+        free(removed);
     }
-    room->reconnection.queue_head = NULL;
-    room->reconnection.queue_tail = NULL;
-    room->reconnection.queue_count = 0;
 }
 
-/* Send `data` over the transport, or enqueue if disconnected and a
+void colyseus_room_set_message_droppable(colyseus_room_t* room, const char* type, bool droppable) {
+    if (!room || !type) return;
+    room_set_droppable(room, type, 0, droppable);
+}
+
+void colyseus_room_set_message_droppable_int(colyseus_room_t* room, int type, bool droppable) {
+    if (!room) return;
+    room_set_droppable(room, NULL, type, droppable);
+}
+
+/* Send `parts` over the transport, or enqueue if disconnected and a
  * reconnect is in progress. Returns true if sent or enqueued; false if
  * dropped. */
-static bool room_send_or_enqueue(colyseus_room_t* room, const uint8_t* data, size_t length) {
+static bool room_send_parts_or_enqueue(colyseus_room_t* room, const colyseus_transport_buf_t* parts,
+                                       size_t count, bool droppable) {
     if (!room) return false;
     if (room->transport && colyseus_transport_is_open(room->transport)) {
-        colyseus_transport_send(room->transport, data, length);
+        bool queued = false;
+        if (room_enqueue_behind_flush(room, parts, count, droppable, &queued)) return queued;
+        colyseus_transport_send_parts(room->transport, parts, count);
         return true;
     }
     if (room->reconnection.is_reconnecting && room->reconnection.options.enabled) {
-        room_enqueue_message(room, data, length);
-        return true;
+        return room_enqueue_message(room, parts, count, droppable);
     }
     return false;
 }
@@ -558,14 +817,415 @@ static void room_handle_reconnection(colyseus_room_t* room, int code, const char
     }
 
     WORKER_LOCK(w);
-    if (!room->reconnection.is_reconnecting) {
+    bool start = !room->reconnection.is_reconnecting;
+    if (start) {
         room->reconnection.retry_count = 0;
         room->reconnection.is_reconnecting = true;
         room->reconnection.cancelled = false;
-        room_reconnect_worker_spawn(room);
     }
     WORKER_UNLOCK(w);
+    if (start) {
+        room_msg_queue_reserve(room);
+        room_reconnection_schedule_next(room);
+    }
+#endif
+}
+
+/* ── Poll mode ─────────────────────────────────────────────────── */
+
+/* Transport events are copied into a per-room queue by the network thread
+ * and dispatched by colyseus_room_poll() on the caller's thread.
+ *
+ * Messages go through a lock-free SPSC ring (producer: transport thread,
+ * consumer: poll caller). When the ring is full, or for rare events that
+ * may come from other threads (open/close/error, reconnection worker),
+ * events are appended to a spinlock-guarded overflow list instead. Once the
+ * overflow list is in use, the producer keeps appending to it until the
+ * consumer has drained the ring and taken the list. The consumer checks
+ * the list's flag before the ring, so a ring push that preceded an
+ * overflow push is always seen, and dispatched, first. */
+
+#define ROOM_POLL_RING_SIZE 256 /* power of two */
+
+typedef enum {
+    ROOM_EVENT_OPEN,
+    ROOM_EVENT_MESSAGE,
+    ROOM_EVENT_CLOSE,
+    ROOM_EVENT_ERROR,
+    ROOM_EVENT_RECONNECT_FAILED
+} room_event_kind_t;
+
+typedef struct room_event {
+    room_event_kind_t kind;
+    int code;
+    char* text;     /* close reason / error message */
+    size_t length;  /* message payload length */
+    struct room_event* next;
+    uint8_t data[]; /* message payload */
+} room_event_t;
+
+typedef struct {
+    /* SPSC ring */
+    room_event_t* ring[ROOM_POLL_RING_SIZE];
+    atomic_size_t head; /* written by the producer */
+    atomic_size_t tail; /* written by the consumer */
+
+    /* Overflow list (any thread) */
+    colyseus_spinlock_t overflow_lock;
+    atomic_bool overflowed;
+    room_event_t* overflow_head;
+    room_event_t* overflow_tail;
+
+    /* Taken from the overflow list, not yet dispatched (consumer only) */
+    room_event_t* pending;
+
+    /* Poll group membership */
+    colyseus_room_poll_group_t* group;
+    colyseus_room_t* group_prev;
+    colyseus_room_t* group_next;
+} room_poll_queue_t;
+
+struct colyseus_room_poll_group {
+    colyseus_room_t* rooms;
+    /* Next room a running group poll visits. Callbacks may free or remove
+     * rooms meanwhile: removal moves it along instead of leaving it
+     * dangling. */
+    colyseus_room_t* poll_next;
+};
+
+static room_event_t* room_event_create(room_event_kind_t kind, int code,
+                                       const char* text,
+                                       const uint8_t* data, size_t length) {
+    room_event_t* ev = malloc(sizeof(room_event_t) + length);
+    if (!ev) return NULL;
+    ev->kind = kind;
+    ev->code = code;
+    ev->text = text ? strdup(text) : NULL;
+    ev->length = length;
+    ev->next = NULL;
+    if (length > 0) memcpy(ev->data, data, length);
+    return ev;
+}
+
+static void room_event_free(room_event_t* ev) {
+    if (!ev) return;
+    free(ev->text);
+    free(ev);
+}
+
+static void room_poll_push_overflow(room_poll_queue_t* q, room_event_t* ev) {
+    colyseus_spinlock_lock(&q->overflow_lock);
+    if (q->overflow_tail) {
+        q->overflow_tail->next = ev;
+    } else {
+        q->overflow_head = ev;
+    }
+    q->overflow_tail = ev;
+    atomic_store_explicit(&q->overflowed, true, memory_order_release);
+    colyseus_spinlock_unlock(&q->overflow_lock);
+}
+
+/* Transport thread only. */
+static void room_poll_push(room_poll_queue_t* q, room_event_t* ev) {
+    if (!atomic_load_explicit(&q->overflowed, memory_order_acquire)) {
+        size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+        size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head - tail < ROOM_POLL_RING_SIZE) {
+            q->ring[head & (ROOM_POLL_RING_SIZE - 1)] = ev;
+            atomic_store_explicit(&q->head, head + 1, memory_order_release);
+            return;
+        }
+    }
+    room_poll_push_overflow(q, ev);
+}
+
+/* Consumer only. */
+static room_event_t* room_poll_pop(room_poll_queue_t* q) {
+    if (q->pending) {
+        room_event_t* ev = q->pending;
+        q->pending = ev->next;
+        return ev;
+    }
+
+    /* Load the flag first: if the producer pushed to the ring and then
+     * overflowed, seeing the flag guarantees seeing that ring push too. */
+    bool overflowed = atomic_load_explicit(&q->overflowed, memory_order_acquire);
+
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    if (tail != head) {
+        room_event_t* ev = q->ring[tail & (ROOM_POLL_RING_SIZE - 1)];
+        atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+        return ev;
+    }
+
+    /* Ring drained: everything left is in the overflow list. */
+    if (!overflowed) return NULL;
+
+    colyseus_spinlock_lock(&q->overflow_lock);
+    room_event_t* ev = q->overflow_head;
+    q->overflow_head = NULL;
+    q->overflow_tail = NULL;
+    atomic_store_explicit(&q->overflowed, false, memory_order_release);
+    colyseus_spinlock_unlock(&q->overflow_lock);
+
+    if (ev) q->pending = ev->next;
+    return ev;
+}
+
+static void room_poll_queue_free(room_poll_queue_t* q) {
+    if (!q) return;
+    room_event_t* ev;
+    while ((ev = room_poll_pop(q))) {
+        room_event_free(ev);
+    }
+    free(q);
+}
+
+static void room_poll_group_remove(colyseus_room_t* room) {
+    room_poll_queue_t* q = (room_poll_queue_t*)room->poll_queue;
+    if (!q || !q->group) return;
+
+    if (q->group->poll_next == room) {
+        q->group->poll_next = q->group_next;
+    }
+    if (q->group_prev) {
+        ((room_poll_queue_t*)q->group_prev->poll_queue)->group_next = q->group_next;
+    } else {
+        q->group->rooms = q->group_next;
+    }
+    if (q->group_next) {
+        ((room_poll_queue_t*)q->group_next->poll_queue)->group_prev = q->group_prev;
+    }
+    q->group = NULL;
+    q->group_prev = NULL;
+    q->group_next = NULL;
+}
+
+/* Queue an event for the poll caller. Events that may originate outside
+ * the transport thread always take the overflow path. */
+static void room_poll_enqueue(colyseus_room_t* room, room_event_kind_t kind,
+                              int code, const char* text) {
+    room_poll_queue_t* q = (room_poll_queue_t*)room->poll_queue;
+    room_event_t* ev = room_event_create(kind, code, text, NULL, 0);
+    if (!ev) {
+        fprintf(stderr, "Room poll queue: out of memory, event dropped\n");
+        return;
+    }
+    room_poll_push_overflow(q, ev);
+}
+
+static void room_poll_on_open(void* userdata) {
+    room_poll_enqueue((colyseus_room_t*)userdata, ROOM_EVENT_OPEN, 0, NULL);
+}
+
+static void room_poll_on_message(const uint8_t* data, size_t length, void* userdata) {
+    colyseus_room_t* room = (colyseus_room_t*)userdata;
+    if (length == 0) return;
+
+    room_event_t* ev = room_event_create(ROOM_EVENT_MESSAGE, 0, NULL, data, length);
+    if (!ev) {
+        fprintf(stderr, "Room poll queue: out of memory, message dropped\n");
+        return;
+    }
+    room_poll_push((room_poll_queue_t*)room->poll_queue, ev);
+}
+
+static void room_poll_on_close(int code, const char* reason, void* userdata) {
+    room_poll_enqueue((colyseus_room_t*)userdata, ROOM_EVENT_CLOSE, code, reason);
+}
+
+static void room_poll_on_error(const char* error, void* userdata) {
+    room_poll_enqueue((colyseus_room_t*)userdata, ROOM_EVENT_ERROR, 0, error);
+}
+
+static colyseus_transport_events_t room_transport_events(colyseus_room_t* room) {
+    colyseus_transport_events_t events = {
+        .on_open = room_on_transport_open,
+        .on_message = room_on_transport_message,
+        .on_close = room_on_transport_close,
+        .on_error = room_on_transport_error,
+        .userdata = room
+    };
+
+    if (room->poll_queue) {
+        events.on_open = room_poll_on_open;
+        events.on_message = room_poll_on_message;
+        events.on_close = room_poll_on_close;
+        events.on_error = room_poll_on_error;
+    }
+
+    return events;
+}
+
+static void room_on_reconnect_failed(colyseus_room_t* room) {
+    if (room->serializer) {
+        colyseus_schema_serializer_teardown(room->serializer);
+    }
+    if (room->on_leave) {
+        room->on_leave(COLYSEUS_CLOSE_FAILED_TO_RECONNECT,
+                       "No more retries. Reconnection failed.",
+                       room->on_leave_userdata);
+    }
+}
+
+#ifndef __EMSCRIPTEN__
+/* Events raised by the reconnection worker rather than the transport.
+ * Routed through the queue in poll mode. */
+static void room_emit_close(colyseus_room_t* room, int code, const char* reason) {
+    if (room->poll_queue) {
+        room_poll_enqueue(room, ROOM_EVENT_CLOSE, code, reason);
+    } else {
+        room_on_transport_close(code, reason, room);
+    }
+}
+
+static void room_emit_reconnect_failed(colyseus_room_t* room) {
+    if (room->poll_queue) {
+        room_poll_enqueue(room, ROOM_EVENT_RECONNECT_FAILED, 0, NULL);
+    } else {
+        room_on_reconnect_failed(room);
+    }
+}
 #endif
+
+static void room_poll_dispatch(colyseus_room_t* room, room_event_t* ev) {
+    switch (ev->kind) {
+        case ROOM_EVENT_OPEN:
+            room_on_transport_open(room);
+            break;
+        case ROOM_EVENT_MESSAGE:
+            room_on_transport_message(ev->data, ev->length, room);
+            break;
+        case ROOM_EVENT_CLOSE:
+            room_on_transport_close(ev->code, ev->text ? ev->text : "", room);
+            break;
+        case ROOM_EVENT_ERROR:
+            room_on_transport_error(ev->text ? ev->text : "", room);
+            break;
+        case ROOM_EVENT_RECONNECT_FAILED:
+            room_on_reconnect_failed(room);
+            break;
+    }
+}
+
+static bool room_event_is_patch(const colyseus_room_t* room, const room_event_t* ev) {
+    return room->serializer &&
+           ev->kind == ROOM_EVENT_MESSAGE &&
+           ev->data[0] == COLYSEUS_PROTOCOL_ROOM_STATE_PATCH;
+}
+
+static void room_poll_end_patch_batch(colyseus_room_t* room) {
+    colyseus_schema_serializer_end_batch(room->serializer);
+    if (room->on_state_change) {
+        room->on_state_change(room->on_state_change_userdata);
+    }
+}
+
+static int room_poll_until(colyseus_room_t* room, uint64_t deadline_ms) {
+    room_poll_queue_t* q = (room_poll_queue_t*)room->poll_queue;
+    if (!q) return 0;
+
+    /* Consecutive queued patches (catch-up after a stall) are applied as one
+     * batch: callbacks, GC and on_state_change run once at the end. */
+    bool batching = false;
+
+    int count = 0;
+    room_event_t* ev;
+    while ((ev = room_poll_pop(q))) {
+        if (room_event_is_patch(room, ev)) {
+            if (!batching) {
+                colyseus_schema_serializer_begin_batch(room->serializer);
+                batching = true;
+            }
+            colyseus_schema_serializer_patch(room->serializer, ev->data, ev->length, 1);
+        } else {
+            if (batching) {
+                room_poll_end_patch_batch(room);
+                batching = false;
+            }
+            room_poll_dispatch(room, ev);
+        }
+        room_event_free(ev);
+        count++;
+        if (deadline_ms && colyseus_monotonic_ms() >= deadline_ms) break;
+    }
+
+    if (batching) {
+        room_poll_end_patch_batch(room);
+    }
+    return count;
+}
+
+void colyseus_room_enable_poll_mode(colyseus_room_t* room) {
+    if (!room || room->poll_queue) return;
+    if (room->transport) {
+        fprintf(stderr, "colyseus_room_enable_poll_mode: must be called before connect\n");
+        return;
+    }
+
+    room_poll_queue_t* q = calloc(1, sizeof(room_poll_queue_t));
+    if (!q) return;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->overflowed, false);
+    colyseus_spinlock_init(&q->overflow_lock);
+    room->poll_queue = q;
+}
+
+bool colyseus_room_is_poll_mode(const colyseus_room_t* room) {
+    return room && room->poll_queue != NULL;
+}
+
+int colyseus_room_poll(colyseus_room_t* room, int budget_ms) {
+    if (!room) return 0;
+    uint64_t deadline = budget_ms > 0 ? colyseus_monotonic_ms() + (uint64_t)budget_ms : 0;
+    return room_poll_until(room, deadline);
+}
+
+colyseus_room_poll_group_t* colyseus_room_poll_group_create(void) {
+    return calloc(1, sizeof(colyseus_room_poll_group_t));
+}
+
+void colyseus_room_poll_group_free(colyseus_room_poll_group_t* group) {
+    if (!group) return;
+    while (group->rooms) {
+        room_poll_group_remove(group->rooms);
+    }
+    free(group);
+}
+
+void colyseus_room_poll_group_add(colyseus_room_poll_group_t* group, colyseus_room_t* room) {
+    if (!group || !room) return;
+    colyseus_room_enable_poll_mode(room);
+
+    room_poll_queue_t* q = (room_poll_queue_t*)room->poll_queue;
+    if (!q || q->group == group) return;
+    room_poll_group_remove(room);
+
+    q->group = group;
+    q->group_prev = NULL;
+    q->group_next = group->rooms;
+    if (group->rooms) {
+        ((room_poll_queue_t*)group->rooms->poll_queue)->group_prev = room;
+    }
+    group->rooms = room;
+}
+
+int colyseus_room_poll_group_poll(colyseus_room_poll_group_t* group, int budget_ms) {
+    if (!group) return 0;
+    uint64_t deadline = budget_ms > 0 ? colyseus_monotonic_ms() + (uint64_t)budget_ms : 0;
+
+    int count = 0;
+    colyseus_room_t* room = group->rooms;
+    while (room) {
+        group->poll_next = ((room_poll_queue_t*)room->poll_queue)->group_next;
+        count += room_poll_until(room, deadline);
+        if (deadline && colyseus_monotonic_ms() >= deadline) break;
+        room = group->poll_next;
+    }
+    group->poll_next = NULL;
+    return count;
 }
 
 /* ── Room lifecycle ────────────────────────────────────────────── */
@@ -595,9 +1255,9 @@ colyseus_room_t* colyseus_room_create(const char* name, colyseus_transport_facto
 void colyseus_room_free(colyseus_room_t* room) {
     if (!room) return;
 
-    /* Cancel and join the reconnection worker before tearing down the
-     * transport — the worker may otherwise try to reconnect against a
-     * half-freed room. */
+    /* Cancel reconnection and wait out a running attempt before tearing
+     * down the transport — it may otherwise reconnect against a half-freed
+     * room. */
     room_reconnection_teardown(room);
 
     /* Cleanup transport */
@@ -605,7 +1265,12 @@ void colyseus_room_free(colyseus_room_t* room) {
         colyseus_transport_destroy(room->transport);
     }
 
-    /* Cleanup serializer */
+    /* The transport is gone, nothing produces events anymore */
+    room_poll_group_remove(room);
+    room_poll_queue_free((room_poll_queue_t*)room->poll_queue);
+
+    /* Cleanup serializer (snapshot publisher first, it listens on the decoder) */
+    colyseus_snapshot_publisher_free((colyseus_snapshot_publisher_t*)room->state_snapshots);
     if (room->serializer) {
         colyseus_schema_serializer_free(room->serializer);
     }
@@ -625,6 +1290,7 @@ void colyseus_room_free(colyseus_room_t* room) {
         free(handler->key);
         free(handler);
     }
+    free(room->int_handlers);
 
     free(room);
 }
@@ -641,50 +1307,151 @@ void* colyseus_room_get_state(colyseus_room_t* room) {
     return colyseus_schema_serializer_get_state(room->serializer);
 }
 
+/* The publisher is created on the decode thread when the serializer is
+ * (JOIN_ROOM) and published with a release store, so readers on other
+ * threads see it fully built. */
+void colyseus_room_enable_state_snapshots(colyseus_room_t* room) {
+    if (!room) return;
+    if (room->transport) {
+        fprintf(stderr, "colyseus_room_enable_state_snapshots: must be called before connect\n");
+        return;
+    }
+    room->state_snapshots_enabled = true;
+}
+
+colyseus_state_snapshot_t* colyseus_room_acquire_state_snapshot(colyseus_room_t* room) {
+    if (!room) return NULL;
+    colyseus_snapshot_publisher_t* publisher = __atomic_load_n(&room->state_snapshots, __ATOMIC_ACQUIRE);
+    if (!publisher) return NULL;
+    return colyseus_snapshot_publisher_acquire(publisher);
+}
+
 /* Connection */
-void colyseus_room_connect(
+static void room_join_timings_begin(colyseus_room_t* room, uint64_t started_ms,
+                                    uint32_t matchmake_ms, bool prewarmed) {
+    room->join_started_ms = started_ms;
+    room->opened_at_ms = 0;
+    memset(&room->join_progress, 0, sizeof(room->join_progress));
+    room->join_progress.matchmake_ms = matchmake_ms;
+    room->join_progress.prewarmed = prewarmed;
+}
+
+/* JOIN_ROOM arrived: fill in the join timings */
+static void room_join_timings_end(colyseus_room_t* room) {
+    uint64_t now = colyseus_monotonic_ms();
+    colyseus_join_timings_t* t = &room->join_progress;
+
+#ifndef __EMSCRIPTEN__
+    if (room->transport_factory == colyseus_websocket_transport_create) {
+        colyseus_transport_stats_t stats;
+        colyseus_transport_get_stats(room->transport, &stats);
+        t->resolve_ms = (uint32_t)stats.resolve_ms;
+        t->connect_ms = (uint32_t)stats.connect_ms;
+        t->tls_ms = (uint32_t)stats.tls_ms;
+        t->upgrade_ms = (uint32_t)stats.upgrade_ms;
+    }
+#endif
+    t->join_ms = room->opened_at_ms ? (uint32_t)(now - room->opened_at_ms) : 0;
+    t->total_ms = room->join_started_ms ? (uint32_t)(now - room->join_started_ms) : 0;
+    room->join_timings = *t;
+}
+
+/* Create the transport and start connecting; failures go to the callbacks
+ * stored by room_connect_save() */
+static void room_connect_transport(
     colyseus_room_t* room,
     const char* endpoint,
-    const colyseus_settings_t* settings,
-    void (*on_success)(void* userdata),
-    void (*on_error)(int code, const char* message, void* userdata),
-    void* userdata
+    const colyseus_settings_t* settings
 ) {
-    /* Setup transport events */
-    colyseus_transport_events_t events = {
-        .on_open = room_on_transport_open,
-        .on_message = room_on_transport_message,
-        .on_close = room_on_transport_close,
-        .on_error = room_on_transport_error,
-        .userdata = room
-    };
+    /* Setup transport events (queued for colyseus_room_poll() in poll mode) */
+    colyseus_transport_events_t events = room_transport_events(room);
 
     /* Create transport */
     room->transport = room->transport_factory(&events);
     if (!room->transport) {
-        if (on_error) {
-            on_error(-1, "Failed to create transport", userdata);
+        if (room->connect_on_error) {
+            room->connect_on_error(-1, "Failed to create transport", room->connect_userdata);
         }
         return;
     }
 
-    /* Store connection callbacks */
+    /* Connect (with TLS settings if provided) */
+    if (settings) {
+        colyseus_websocket_connect_with_settings(room->transport, endpoint, settings);
+    } else {
+        colyseus_transport_connect(room->transport, endpoint);
+    }
+}
+
+/* Store the connection callbacks, and the endpoint + settings so the
+ * reconnection worker can rebuild the URL with an updated
+ * `reconnectionToken=` on retries. */
+static void room_connect_save(
+    colyseus_room_t* room,
+    const char* endpoint,
+    const colyseus_settings_t* settings,
+    void (*on_success)(void* userdata),
+    void (*on_error)(int code, const char* message, void* userdata),
+    void* userdata
+) {
     room->connect_on_success = on_success;
     room->connect_on_error = on_error;
     room->connect_userdata = userdata;
 
-    /* Save the endpoint + settings so the reconnection worker can rebuild
-     * the URL with an updated `reconnectionToken=` on retries. */
     free(room->endpoint_url);
     room->endpoint_url = endpoint ? strdup(endpoint) : NULL;
     room->settings = settings;
+}
 
-    /* Connect (with TLS settings if provided) */
-    if (settings) {
-        colyseus_websocket_connect_with_settings(room->transport, endpoint, settings);
-    } else {
-        colyseus_transport_connect(room->transport, endpoint);
+void colyseus_room_connect(
+    colyseus_room_t* room,
+    const char* endpoint,
+    const colyseus_settings_t* settings,
+    void (*on_success)(void* userdata),
+    void (*on_error)(int code, const char* message, void* userdata),
+    void* userdata
+) {
+    room_join_timings_begin(room, colyseus_monotonic_ms(), 0, false);
+    room_connect_save(room, endpoint, settings, on_success, on_error, userdata);
+    room_connect_transport(room, endpoint, settings);
+}
+
+void colyseus_room_connect_prewarmed(
+    colyseus_room_t* room,
+    const char* endpoint,
+    const colyseus_settings_t* settings,
+    colyseus_transport_t* prewarmed,
+    uint64_t started_ms,
+    uint32_t matchmake_ms,
+    void (*on_success)(void* userdata),
+    void (*on_error)(int code, const char* message, void* userdata),
+    void* userdata
+) {
+    room_join_timings_begin(room, started_ms, matchmake_ms, prewarmed != NULL);
+    room_connect_save(room, endpoint, settings, on_success, on_error, userdata);
+
+#ifndef __EMSCRIPTEN__
+    if (prewarmed) {
+        colyseus_transport_events_t events = room_transport_events(room);
+
+        /* Events may fire from the driver as soon as the upgrade is
+         * requested, so the room owns the transport first */
+        room->transport = prewarmed;
+        if (colyseus_websocket_upgrade(prewarmed, endpoint, &events)) {
+            return;
+        }
+        room->transport = NULL;
+        colyseus_transport_destroy(prewarmed);
+        room->join_progress.prewarmed = false;
     }
+#else
+    if (prewarmed) {
+        colyseus_transport_destroy(prewarmed);
+        room->join_progress.prewarmed = false;
+    }
+#endif
+
+    room_connect_transport(room, endpoint, settings);
 }
 
 void colyseus_room_leave(colyseus_room_t* room, bool consented) {
@@ -750,6 +1517,35 @@ const char* colyseus_room_get_reconnection_token(const colyseus_room_t* room) {
     return room ? room->reconnection_token : NULL;
 }
 
+bool colyseus_room_get_join_timings(const colyseus_room_t* room, colyseus_join_timings_t* out) {
+    if (!room || !out || !room->has_joined) return false;
+    *out = room->join_timings;
+    return true;
+}
+
+bool colyseus_room_get_latency(const colyseus_room_t* room, colyseus_room_latency_t* out) {
+    if (!room || !out) return false;
+    memset(out, 0, sizeof(*out));
+#ifdef __EMSCRIPTEN__
+    return false;
+#else
+    if (room->transport_factory != colyseus_websocket_transport_create ||
+        !room->transport || !colyseus_transport_is_open(room->transport)) {
+        return false;
+    }
+    colyseus_transport_stats_t stats;
+    colyseus_transport_get_stats(room->transport, &stats);
+    uint64_t now = colyseus_monotonic_ms();
+    out->rtt_us = (uint32_t)stats.rtt_us;
+    out->smoothed_rtt_us = (uint32_t)stats.srtt_us;
+    out->jitter_us = (uint32_t)stats.rtt_jitter_us;
+    out->last_seen_ms_ago = now > stats.last_seen_ms ? (uint32_t)(now - stats.last_seen_ms) : 0;
+    out->pings_sent = stats.pings_sent;
+    out->pongs_received = stats.pongs_received;
+    return true;
+#endif
+}
+
 /* Event handlers */
 void colyseus_room_on_join(colyseus_room_t* room, colyseus_room_on_join_fn callback, void* userdata) {
     if (!room) return;
@@ -818,6 +1614,28 @@ static colyseus_message_handler_t* room_find_or_create_handler(colyseus_room_t*
     return handler;
 }
 
+/* Numeric types up to this are looked up by index instead of by key */
+#define ROOM_INT_HANDLERS_MAX 1024
+
+/* Same for a numeric type, also indexing it when small enough */
+static colyseus_message_handler_t* room_find_or_create_int_handler(colyseus_room_t* room, int type) {
+    colyseus_message_handler_t* handler = room_find_or_create_handler(room, room_get_message_key_int(type));
+    if (type < 0 || type >= ROOM_INT_HANDLERS_MAX) return handler;
+
+    size_t index = (size_t)type;
+    if (index >= room->int_handlers_count) {
+        colyseus_message_handler_t** grown =
+            realloc(room->int_handlers, (index + 1) * sizeof(*grown));
+        if (!grown) return handler;  /* still found by key */
+        memset(grown + room->int_handlers_count, 0,
+               (index + 1 - room->int_handlers_count) * sizeof(*grown));
+        room->int_handlers = grown;
+        room->int_handlers_count = index + 1;
+    }
+    room->int_handlers[index] = handler;
+    return handler;
+}
+
 /* Message handlers - default (msgpack reader) */
 void colyseus_room_on_message(colyseus_room_t* room, const char* type, colyseus_room_on_message_fn callback, void* userdata) {
     if (!room) return;
@@ -829,8 +1647,7 @@ void colyseus_room_on_message(colyseus_room_t* room, const char* type, colyseus_
 
 void colyseus_room_on_message_int(colyseus_room_t* room, int type, colyseus_room_on_message_fn callback, void* userdata) {
     if (!room) return;
-    char* key = room_get_message_key_int(type);
-    colyseus_message_handler_t* handler = room_find_or_create_handler(room, key);
+    colyseus_message_handler_t* handler = room_find_or_create_int_handler(room, type);
     handler->callback = callback;
     handler->userdata = userdata;
 }
@@ -858,8 +1675,7 @@ void colyseus_room_on_message_encoded(colyseus_room_t* room, const char* type, c
 
 void colyseus_room_on_message_int_encoded(colyseus_room_t* room, int type, colyseus_room_on_message_encoded_fn callback, void* userdata) {
     if (!room) return;
-    char* key = room_get_message_key_int(type);
-    colyseus_message_handler_t* handler = room_find_or_create_handler(room, key);
+    colyseus_message_handler_t* handler = room_find_or_create_int_handler(room, type);
     handler->callback_encoded = callback;
     handler->userdata_encoded = userdata;
 }
@@ -887,8 +1703,7 @@ void colyseus_room_on_message_bytes(colyseus_room_t* room, const char* type, col
 
 void colyseus_room_on_message_int_bytes(colyseus_room_t* room, int type, colyseus_room_on_message_bytes_fn callback, void* userdata) {
     if (!room) return;
-    char* key = room_get_message_key_int(type);
-    colyseus_message_handler_t* handler = room_find_or_create_handler(room, key);
+    colyseus_message_handler_t* handler = room_find_or_create_int_handler(room, type);
     handler->callback_bytes = callback;
     handler->userdata_bytes = userdata;
 }
@@ -905,35 +1720,31 @@ void colyseus_room_on_message_any_with_type_bytes(colyseus_room_t* room, colyseu
     room->on_message_any_with_type_bytes_userdata = userdata;
 }
 
-/* Helper function to encode msgpack string */
-static size_t msgpack_encode_string(uint8_t* dest, const char* str, size_t str_len) {
+/* Helper function to encode a msgpack string header (the bytes follow) */
+static size_t msgpack_encode_string_header(uint8_t* dest, size_t str_len) {
     if (str_len <= 31) {
         /* fixstr: 0xa0 | length */
         dest[0] = 0xa0 | (uint8_t)str_len;
-        memcpy(dest + 1, str, str_len);
-        return 1 + str_len;
+        return 1;
     } else if (str_len <= 255) {
-        /* str8: 0xd9, length (1 byte), string */
+        /* str8: 0xd9, length (1 byte) */
         dest[0] = 0xd9;
         dest[1] = (uint8_t)str_len;
-        memcpy(dest + 2, str, str_len);
-        return 2 + str_len;
+        return 2;
     } else if (str_len <= 65535) {
-        /* str16: 0xda, length (2 bytes big-endian), string */
+        /* str16: 0xda, length (2 bytes big-endian) */
         dest[0] = 0xda;
         dest[1] = (uint8_t)(str_len >> 8);
         dest[2] = (uint8_t)(str_len & 0xff);
-        memcpy(dest + 3, str, str_len);
-        return 3 + str_len;
+        return 3;
     } else {
-        /* str32: 0xdb, length (4 bytes big-endian), string */
+        /* str32: 0xdb, length (4 bytes big-endian) */
         dest[0] = 0xdb;
         dest[1] = (uint8_t)(str_len >> 24);
         dest[2] = (uint8_t)((str_len >> 16) & 0xff);
         dest[3] = (uint8_t)((str_len >> 8) & 0xff);
         dest[4] = (uint8_t)(str_len & 0xff);
-        memcpy(dest + 5, str, str_len);
-        return 5 + str_len;
+        return 5;
     }
 }
 
@@ -984,9 +1795,90 @@ static char* decode_string(const uint8_t* bytes, size_t* offset) {
     return result;
 }
 
-static bool decode_number_check(const uint8_t* bytes, size_t offset) {
-    colyseus_iterator_t it = { .offset = (int)offset };
-    return colyseus_decode_number_check(bytes, &it);
+/* ROOM_DATA message type: a number or a string, pointing into the frame */
+struct room_message_type {
+    const char* str;    /* not NUL-terminated */
+    size_t len;
+    int num;
+    bool is_int;
+};
+
+/* Decode the type at `*offset` without copying it. Numbers are read as
+ * integers (floats truncate). False if it is missing or runs past
+ * `length`. */
+static bool room_decode_message_type(const uint8_t* bytes, size_t length, size_t* offset,
+                                     room_message_type_t* out) {
+    memset(out, 0, sizeof(*out));
+    size_t pos = *offset;
+    if (pos >= length) return false;
+    uint8_t prefix = bytes[pos++];
+
+    /* Numbers: fixints, uint/int 8-64, float 32/64 (little-endian, as
+     * colyseus_decode_number) */
+    if (prefix < 0x80 || prefix >= 0xe0 || (prefix >= 0xca && prefix <= 0xd3)) {
+        size_t width = 0;
+        switch (prefix) {
+            case 0xcc: case 0xd0: width = 1; break;
+            case 0xcd: case 0xd1: width = 2; break;
+            case 0xca: case 0xce: case 0xd2: width = 4; break;
+            case 0xcb: case 0xcf: case 0xd3: width = 8; break;
+            default: break;
+        }
+        if (width > length - pos) return false;
+
+        colyseus_iterator_t it = { .offset = (int)pos };
+        int64_t value;
+        switch (prefix) {
+            case 0xcc: value = colyseus_decode_uint8(bytes, &it); break;
+            case 0xcd: value = colyseus_decode_uint16(bytes, &it); break;
+            case 0xce: value = colyseus_decode_uint32(bytes, &it); break;
+            case 0xcf: {
+                uint64_t u = colyseus_decode_uint64(bytes, &it);
+                value = u > INT64_MAX ? INT64_MAX : (int64_t)u;
+                break;
+            }
+            case 0xd0: value = colyseus_decode_int8(bytes, &it); break;
+            case 0xd1: value = colyseus_decode_int16(bytes, &it); break;
+            case 0xd2: value = colyseus_decode_int32(bytes, &it); break;
+            case 0xd3: value = colyseus_decode_int64(bytes, &it); break;
+            case 0xca:
+            case 0xcb: {
+                double d = prefix == 0xca ? colyseus_decode_float32(bytes, &it)
+                                          : colyseus_decode_float64(bytes, &it);
+                value = d != d ? 0 : d > (double)INT_MAX ? INT_MAX : d < (double)INT_MIN ? INT_MIN : (int64_t)d;
+                break;
+            }
+            default: value = (int8_t)prefix; break;  /* positive / negative fixint */
+        }
+        out->is_int = true;
+        out->num = value > INT_MAX ? INT_MAX : value < INT_MIN ? INT_MIN : (int)value;
+        *offset = pos + width;
+        return true;
+    }
+
+    /* msgpack string header (same prefixes as colyseus_decode_string) */
+    size_t str_len = 0;
+    size_t len_bytes = 0;
+    if (prefix >= 0xa0 && prefix <= 0xbf) {
+        str_len = prefix & 0x1f;
+    } else if (prefix == 0xd9) {
+        len_bytes = 1;
+    } else if (prefix == 0xda) {
+        len_bytes = 2;
+    } else if (prefix == 0xdb) {
+        len_bytes = 4;
+    }
+    if (len_bytes > length - pos) return false;
+    for (size_t i = 0; i < len_bytes; i++) {
+        /* Little-endian, as colyseus_decode_uint16/32 */
+        str_len |= (size_t)bytes[pos++] << (8 * i);
+    }
+    if (str_len == 0 || str_len > length - pos) return false;
+
+    out->str = (const char*)bytes + pos;
+    out->len = str_len;
+    *offset = pos + str_len;
+    return true;
 }
 
 /* Send messages (colyseus message - default, encodes automatically) */
@@ -1012,126 +1904,98 @@ void colyseus_room_send_int(colyseus_room_t* room, int type, colyseus_message_t*
     }
 }
 
-/* Send messages (pre-encoded msgpack bytes) */
-void colyseus_room_send_encoded(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length) {
-    if (!room || !type) return;
-
-    /* Build message: [PROTOCOL][msgpack-encoded type string][message] */
-    size_t type_len = strlen(type);
+/* [protocol][msgpack type][payload], handed to the transport as parts so
+ * the message is never joined into a temporary copy */
+static void room_send_typed(colyseus_room_t* room, uint8_t protocol, const char* type, bool int_type,
+                            int type_num, const uint8_t* message, size_t length) {
+    uint8_t prefix[1 + 5];  /* protocol + msgpack string header / int32 */
+    prefix[0] = protocol;
 
-    /* Calculate msgpack encoding size */
-    size_t msgpack_size = (type_len <= 31) ? (1 + type_len) :
-                          (type_len <= 255) ? (2 + type_len) :
-                          (type_len <= 65535) ? (3 + type_len) :
-                          (5 + type_len);
-
-    size_t total_len = 1 + msgpack_size + length;
-    uint8_t* data = malloc(total_len);
-    if (!data) return;
-
-    /* Protocol byte */
-    data[0] = COLYSEUS_PROTOCOL_ROOM_DATA;
-
-    /* Msgpack-encoded type string */
-    size_t encoded_len = msgpack_encode_string(data + 1, type, type_len);
-
-    /* Message payload */
+    colyseus_transport_buf_t parts[3];
+    size_t count = 0;
+    if (int_type) {
+        parts[count++] = (colyseus_transport_buf_t){ prefix, 1 + msgpack_encode_number(prefix + 1, type_num) };
+    } else {
+        size_t type_len = strlen(type);
+        parts[count++] = (colyseus_transport_buf_t){ prefix, 1 + msgpack_encode_string_header(prefix + 1, type_len) };
+        parts[count++] = (colyseus_transport_buf_t){ (const uint8_t*)type, type_len };
+    }
     if (message && length > 0) {
-        memcpy(data + 1 + encoded_len, message, length);
+        parts[count++] = (colyseus_transport_buf_t){ message, length };
     }
 
-    room_send_or_enqueue(room, data, total_len);
-    free(data);
+    room_send_parts_or_enqueue(room, parts, count, room_msg_is_droppable(room, type, type_num));
+}
+
+/* Send messages (pre-encoded msgpack bytes) */
+void colyseus_room_send_encoded(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length) {
+    if (!room || !type) return;
+    room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA, type, false, 0, message, length);
 }
 
 void colyseus_room_send_int_encoded(colyseus_room_t* room, int type, const uint8_t* message, size_t length) {
     if (!room) return;
+    room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA, NULL, true, type, message, length);
+}
+
+/* [protocol][msgpack type] written backwards into the writer's headroom,
+ * so header and payload go out as a single buffer */
+static void room_send_writer_typed(colyseus_room_t* room, const char* type, bool int_type, int type_num,
+                                   colyseus_msgwriter_t* writer) {
+    size_t length = 0;
+    const uint8_t* payload = colyseus_msgwriter_data(writer, &length);
+    if (!payload) {
+        if (colyseus_msgwriter_ok(writer)) {
+            /* nothing written yet */
+            room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA, type, int_type, type_num, NULL, 0);
+        }
+        return;
+    }
 
-    /* Build message: [PROTOCOL][msgpack-encoded type integer][message] */
-    uint8_t type_buffer[5];  /* Max size for int32 msgpack encoding */
-    size_t type_encoded_size = msgpack_encode_number(type_buffer, type);
-
-    size_t total_len = 1 + type_encoded_size + length;
-    uint8_t* data = malloc(total_len);
-    if (!data) return;
+    uint8_t prefix[1 + 5];
+    prefix[0] = COLYSEUS_PROTOCOL_ROOM_DATA;
+    size_t type_len = int_type ? 0 : strlen(type);
+    size_t prefix_len = 1 + (int_type ? msgpack_encode_number(prefix + 1, type_num)
+                                      : msgpack_encode_string_header(prefix + 1, type_len));
+    if (prefix_len + type_len > COLYSEUS_MSGWRITER_HEADROOM) {
+        room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA, type, int_type, type_num, payload, length);
+        return;
+    }
 
-    /* Protocol byte */
-    data[0] = COLYSEUS_PROTOCOL_ROOM_DATA;
+    uint8_t* start = writer->buf + COLYSEUS_MSGWRITER_HEADROOM - prefix_len - type_len;
+    memcpy(start, prefix, prefix_len);
+    if (type_len > 0) memcpy(start + prefix_len, type, type_len);
 
-    /* Msgpack-encoded type integer */
-    memcpy(data + 1, type_buffer, type_encoded_size);
+    colyseus_transport_buf_t part = { start, prefix_len + type_len + length };
+    room_send_parts_or_enqueue(room, &part, 1, room_msg_is_droppable(room, type, type_num));
+}
 
-    /* Message payload */
-    if (message && length > 0) {
-        memcpy(data + 1 + type_encoded_size, message, length);
-    }
+void colyseus_room_send_writer(colyseus_room_t* room, const char* type, colyseus_msgwriter_t* writer) {
+    if (!room || !type || !writer) return;
+    room_send_writer_typed(room, type, false, 0, writer);
+}
 
-    room_send_or_enqueue(room, data, total_len);
-    free(data);
+void colyseus_room_send_int_writer(colyseus_room_t* room, int type, colyseus_msgwriter_t* writer) {
+    if (!room || !writer) return;
+    room_send_writer_typed(room, NULL, true, type, writer);
 }
 
 /* Send raw bytes (ROOM_DATA_BYTES protocol) */
 void colyseus_room_send_bytes(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length) {
     if (!room || !type) return;
-
-    /* Build message: [PROTOCOL][msgpack-encoded type string][raw bytes] */
-    size_t type_len = strlen(type);
-
-    /* Calculate msgpack encoding size */
-    size_t msgpack_size = (type_len <= 31) ? (1 + type_len) :
-                          (type_len <= 255) ? (2 + type_len) :
-                          (type_len <= 65535) ? (3 + type_len) :
-                          (5 + type_len);
-
-    size_t total_len = 1 + msgpack_size + length;
-    uint8_t* data = malloc(total_len);
-    if (!data) return;
-
-    /* Protocol byte */
-    data[0] = COLYSEUS_PROTOCOL_ROOM_DATA_BYTES;
-
-    /* Msgpack-encoded type string */
-    size_t encoded_len = msgpack_encode_string(data + 1, type, type_len);
-
-    /* Raw bytes payload */
-    if (message && length > 0) {
-        memcpy(data + 1 + encoded_len, message, length);
-    }
-
-    room_send_or_enqueue(room, data, total_len);
-    free(data);
+    room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA_BYTES, type, false, 0, message, length);
 }
 
 void colyseus_room_send_int_bytes(colyseus_room_t* room, int type, const uint8_t* message, size_t length) {
     if (!room) return;
-
-    /* Build message: [PROTOCOL][msgpack-encoded type integer][raw bytes] */
-    uint8_t type_buffer[5];  /* Max size for int32 msgpack encoding */
-    size_t type_encoded_size = msgpack_encode_number(type_buffer, type);
-
-    size_t total_len = 1 + type_encoded_size + length;
-    uint8_t* data = malloc(total_len);
-    if (!data) return;
-
-    /* Protocol byte */
-    data[0] = COLYSEUS_PROTOCOL_ROOM_DATA_BYTES;
-
-    /* Msgpack-encoded type integer */
-    memcpy(data + 1, type_buffer, type_encoded_size);
-
-    /* Raw bytes payload */
-    if (message && length > 0) {
-        memcpy(data + 1 + type_encoded_size, message, length);
-    }
-
-    room_send_or_enqueue(room, data, total_len);
-    free(data);
+    room_send_typed(room, COLYSEUS_PROTOCOL_ROOM_DATA_BYTES, NULL, true, type, message, length);
 }
 
 /* Transport event handlers */
 static void room_on_transport_open(void* userdata) {
-    (void)userdata;
+    colyseus_room_t* room = (colyseus_room_t*)userdata;
     /* Connection established, wait for JOIN_ROOM from server */
+    room->opened_at_ms = colyseus_monotonic_ms();
 }
 
 static void room_on_transport_message(const uint8_t* data, size_t length, void* userdata) {
@@ -1139,16 +2003,19 @@ static void room_on_transport_message(const uint8_t* data, size_t length, void*
 
     if (length == 0) return;
 
-    {
+    /* Looked up once: getenv() scans the environment */
+    static int debug = -1;
+    if (debug < 0) {
         const char* dbg = getenv("COLYSEUS_WS_DEBUG");
-        if (dbg && dbg[0] && dbg[0] != '0') {
-            size_t max = length < 64 ? length : 64;
-            fprintf(stderr, "[ROOM] transport_message len=%zu bytes:", length);
-            for (size_t i = 0; i < max; i++) fprintf(stderr, " %02x", data[i]);
-            if (length > max) fprintf(stderr, " ...");
-            fprintf(stderr, "\n");
-            fflush(stderr);
-        }
+        debug = (dbg && dbg[0] && dbg[0] != '0') ? 1 : 0;
+    }
+    if (debug) {
+        size_t max = length < 64 ? length : 64;
+        fprintf(stderr, "[ROOM] transport_message len=%zu bytes:", length);
+        for (size_t i = 0; i < max; i++) fprintf(stderr, " %02x", data[i]);
+        if (length > max) fprintf(stderr, " ...");
+        fprintf(stderr, "\n");
+        fflush(stderr);
     }
 
     colyseus_protocol_t code = (colyseus_protocol_t)data[0];
@@ -1192,6 +2059,7 @@ static void room_on_transport_message(const uint8_t* data, size_t length, void*
             }
 
             bool is_reconnect = room->has_joined;
+            room_join_timings_end(room);
 
             /* On first join only: instantiate serializer + apply handshake.
              * On reconnect, the server replays JOIN_ROOM with just the
@@ -1202,6 +2070,12 @@ static void room_on_transport_message(const uint8_t* data, size_t length, void*
                     /* Create serializer - pass NULL if no vtable, handshake will auto-detect */
                     room->serializer = colyseus_schema_serializer_create(room->state_vtable);
 
+                    if (room->serializer && room->state_snapshots_enabled) {
+                        __atomic_store_n(&room->state_snapshots,
+                                         colyseus_snapshot_publisher_create(room->serializer->decoder),
+                                         __ATOMIC_RELEASE);
+                    }
+
                     /* Handle handshake if there's more data */
                     if (offset < length && room->serializer) {
                         colyseus_schema_serializer_handshake(room->serializer, data, length, (int)offset);
@@ -1288,52 +2162,18 @@ static void room_on_transport_message(const uint8_t* data, size_t length, void*
 
         case COLYSEUS_PROTOCOL_ROOM_DATA: {
             /* Decode message type and msgpack data */
-            if (length > offset) {
-                char type_str[256] = {0};
-
-                if (decode_number_check(data, offset)) {
-                    /* Numeric type */
-                    int type_num = (int)decode_number(data, &offset);
-                    snprintf(type_str, sizeof(type_str), "i%d", type_num);
-                } else {
-                    /* String type */
-                    char* decoded_type = decode_string(data, &offset);
-                    if (decoded_type) {
-                        strncpy(type_str, decoded_type, sizeof(type_str) - 1);
-                        free(decoded_type);
-                    }
-                }
-
-                /* Dispatch the msgpack message */
-                if (strlen(type_str) > 0) {
-                    room_dispatch_message(room, type_str, data + offset, length - offset);
-                }
+            room_message_type_t type;
+            if (room_decode_message_type(data, length, &offset, &type)) {
+                room_dispatch_message(room, &type, data + offset, length - offset);
             }
             break;
         }
 
         case COLYSEUS_PROTOCOL_ROOM_DATA_BYTES: {
             /* Decode message type and raw bytes data */
-            if (length > offset) {
-                char type_str[256] = {0};
-
-                if (decode_number_check(data, offset)) {
-                    /* Numeric type */
-                    int type_num = (int)decode_number(data, &offset);
-                    snprintf(type_str, sizeof(type_str), "i%d", type_num);
-                } else {
-                    /* String type */
-                    char* decoded_type = decode_string(data, &offset);
-                    if (decoded_type) {
-                        strncpy(type_str, decoded_type, sizeof(type_str) - 1);
-                        free(decoded_type);
-                    }
-                }
-
-                /* Dispatch the raw bytes message */
-                if (strlen(type_str) > 0) {
-                    room_dispatch_message_bytes(room, type_str, data + offset, length - offset);
-                }
+            room_message_type_t type;
+            if (room_decode_message_type(data, length, &offset, &type)) {
+                room_dispatch_message_bytes(room, &type, data + offset, length - offset);
             }
             break;
         }
@@ -1402,12 +2242,45 @@ static void room_on_transport_error(const char* error, void* userdata) {
     }
 }
 
-/* Helper functions */
-static void room_dispatch_message(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length) {
-    char* key = room_get_message_key_str(type);
-
+/* Handler for a decoded type: numeric types by index, strings matched in
+ * place against the interned keys. No allocation. An empty index slot
+ * still falls back to the key, which on_message("i<n>") registers. */
+static colyseus_message_handler_t* room_find_handler(colyseus_room_t* room, const room_message_type_t* type) {
     colyseus_message_handler_t* handler = NULL;
-    HASH_FIND_STR(room->message_handlers, key, handler);
+    if (type->is_int) {
+        if (type->num >= 0 && (size_t)type->num < room->int_handlers_count &&
+            room->int_handlers[type->num]) {
+            return room->int_handlers[type->num];
+        }
+        char key[16];
+        int n = snprintf(key, sizeof(key), "i%d", type->num);
+        HASH_FIND(hh, room->message_handlers, key, (size_t)n, handler);
+        return handler;
+    }
+    HASH_FIND(hh, room->message_handlers, type->str, type->len, handler);
+    return handler;
+}
+
+/* NUL-terminated type for the *_with_type callbacks: the handler's key
+ * when there is one, else formatted into `buf` (long strings truncate) */
+static const char* room_message_type_name(const room_message_type_t* type,
+                                          const colyseus_message_handler_t* handler,
+                                          char* buf, size_t size) {
+    if (handler) return handler->key;
+    if (type->is_int) {
+        snprintf(buf, size, "i%d", type->num);
+    } else {
+        size_t copy = type->len < size - 1 ? type->len : size - 1;
+        memcpy(buf, type->str, copy);
+        buf[copy] = '\0';
+    }
+    return buf;
+}
+
+/* Helper functions */
+static void room_dispatch_message(colyseus_room_t* room, const room_message_type_t* type,
+                                  const uint8_t* message, size_t length) {
+    colyseus_message_handler_t* handler = room_find_handler(room, type);
 
     colyseus_message_reader_t* reader = NULL;
     bool reader_created = false;
@@ -1430,6 +2303,11 @@ static void room_dispatch_message(colyseus_room_t* room, const char* type, const
     }
 
     /* Call wildcard handlers */
+    char name_buf[256];
+    const char* name = NULL;
+    if (room->on_message_any_with_type || room->on_message_any_with_type_encoded) {
+        name = room_message_type_name(type, handler, name_buf, sizeof(name_buf));
+    }
 
     /* Default wildcard (msgpack reader) */
     if (room->on_message_any) {
@@ -1446,7 +2324,7 @@ static void room_dispatch_message(colyseus_room_t* room, const char* type, const
             reader = colyseus_message_reader_create(message, length);
             reader_created = true;
         }
-        room->on_message_any_with_type(type, reader, room->on_message_any_with_type_userdata);
+        room->on_message_any_with_type(name, reader, room->on_message_any_with_type_userdata);
     }
 
     /* Encoded wildcard (raw msgpack bytes) */
@@ -1456,23 +2334,19 @@ static void room_dispatch_message(colyseus_room_t* room, const char* type, const
 
     /* Encoded wildcard with type (raw msgpack bytes) */
     if (room->on_message_any_with_type_encoded) {
-        room->on_message_any_with_type_encoded(type, message, length, room->on_message_any_with_type_encoded_userdata);
+        room->on_message_any_with_type_encoded(name, message, length, room->on_message_any_with_type_encoded_userdata);
     }
 
     /* Free reader if created */
     if (reader) {
         colyseus_message_reader_free(reader);
     }
-
-    free(key);
 }
 
 /* Dispatch raw bytes message (ROOM_DATA_BYTES protocol) */
-static void room_dispatch_message_bytes(colyseus_room_t* room, const char* type, const uint8_t* message, size_t length) {
-    char* key = room_get_message_key_str(type);
-
-    colyseus_message_handler_t* handler = NULL;
-    HASH_FIND_STR(room->message_handlers, key, handler);
+static void room_dispatch_message_bytes(colyseus_room_t* room, const room_message_type_t* type,
+                                        const uint8_t* message, size_t length) {
+    colyseus_message_handler_t* handler = room_find_handler(room, type);
 
     /* Call type-specific bytes handler if registered */
     if (handler && handler->callback_bytes) {
@@ -1485,10 +2359,10 @@ static void room_dispatch_message_bytes(colyseus_room_t* room, const char* type,
     }
 
     if (room->on_message_any_with_type_bytes) {
-        room->on_message_any_with_type_bytes(type, message, length, room->on_message_any_with_type_bytes_userdata);
+        char name_buf[256];
+        const char* name = room_message_type_name(type, handler, name_buf, sizeof(name_buf));
+        room->on_message_any_with_type_bytes(name, message, length, room->on_message_any_with_type_bytes_userdata);
     }
-
-    free(key);
 }
 
 static char* room_get_message_key_str(const char* type) {
@@ -20,6 +20,7 @@ colyseus_changes_t* colyseus_changes_create(void) {
 
 void colyseus_changes_free(colyseus_changes_t* changes) {
     if (!changes) return;
+    colyseus_changes_clear(changes);
     free(changes->items);
     free(changes);
 }
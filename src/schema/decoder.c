@@ -82,6 +82,8 @@ colyseus_decoder_t* colyseus_decoder_create(const colyseus_schema_vtable_t* stat
     decoder->state_vtable = state_vtable;
     decoder->trigger_changes = NULL;
     decoder->trigger_userdata = NULL;
+    decoder->decode_listeners = NULL;
+    decoder->batch_depth = 0;
 
     /* Create initial state (handles both static and dynamic vtables) */
     decoder->state = create_schema_from_vtable(state_vtable);
@@ -108,6 +110,13 @@ void colyseus_decoder_free(colyseus_decoder_t* decoder) {
     colyseus_type_context_free(decoder->context);
     colyseus_changes_free(decoder->changes);
 
+    colyseus_decode_listener_t* listener = decoder->decode_listeners;
+    while (listener) {
+        colyseus_decode_listener_t* next = listener->next;
+        free(listener);
+        listener = next;
+    }
+
     /* Free state if vtable has destroy function.
      * For dynamic schemas, ref_tracker_clear already destroyed everything.
      * For static schemas, we need to call destroy here. */
@@ -127,6 +136,39 @@ void colyseus_decoder_set_trigger_callback(colyseus_decoder_t* decoder,
     decoder->trigger_userdata = userdata;
 }
 
+void colyseus_decoder_add_decode_listener(colyseus_decoder_t* decoder,
+    colyseus_decode_end_fn callback, void* userdata) {
+    if (!decoder || !callback) return;
+
+    colyseus_decode_listener_t* listener = malloc(sizeof(colyseus_decode_listener_t));
+    if (!listener) return;
+
+    listener->callback = callback;
+    listener->userdata = userdata;
+    listener->next = NULL;
+
+    /* Append to keep registration order */
+    colyseus_decode_listener_t** tail = &decoder->decode_listeners;
+    while (*tail) tail = &(*tail)->next;
+    *tail = listener;
+}
+
+void colyseus_decoder_remove_decode_listener(colyseus_decoder_t* decoder,
+    colyseus_decode_end_fn callback, void* userdata) {
+    if (!decoder) return;
+
+    colyseus_decode_listener_t** curr = &decoder->decode_listeners;
+    while (*curr) {
+        if ((*curr)->callback == callback && (*curr)->userdata == userdata) {
+            colyseus_decode_listener_t* to_delete = *curr;
+            *curr = (*curr)->next;
+            free(to_delete);
+            return;
+        }
+        curr = &(*curr)->next;
+    }
+}
+
 colyseus_schema_t* colyseus_decoder_get_state(colyseus_decoder_t* decoder) {
     return decoder ? decoder->state : NULL;
 }
@@ -185,6 +227,7 @@ static bool decode_array_schema(colyseus_decoder_t* decoder, const uint8_t* byte
     colyseus_iterator_t* it, colyseus_array_schema_t* arr);
 static bool decode_map_schema(colyseus_decoder_t* decoder, const uint8_t* bytes, size_t length,
     colyseus_iterator_t* it, colyseus_map_schema_t* map);
+static void decoder_flush(colyseus_decoder_t* decoder);
 
 /* Get concrete schema type from bytes (handles TYPE_ID marker) */
 static const colyseus_schema_vtable_t* get_schema_type(colyseus_decoder_t* decoder,
@@ -632,6 +675,47 @@ static void* decode_value(
     return colyseus_decode_primitive(field_type, bytes, it);
 }
 
+/* Bytes a primitive field occupies */
+static size_t primitive_field_size(colyseus_field_type_t type) {
+    switch (type) {
+        case COLYSEUS_FIELD_NUMBER:
+        case COLYSEUS_FIELD_FLOAT64:
+        case COLYSEUS_FIELD_INT64:
+        case COLYSEUS_FIELD_UINT64:  return 8;
+        case COLYSEUS_FIELD_FLOAT32:
+        case COLYSEUS_FIELD_INT32:
+        case COLYSEUS_FIELD_UINT32:  return 4;
+        case COLYSEUS_FIELD_INT16:
+        case COLYSEUS_FIELD_UINT16:  return 2;
+        case COLYSEUS_FIELD_BOOLEAN: return sizeof(bool);
+        default:                     return 1;
+    }
+}
+
+/*
+ * Inside a batch, a change's previous value must survive the later patches
+ * of the batch: they overwrite the field storage it points at, or free the
+ * string / map value. Returns an owned copy of a primitive previous value,
+ * or NULL to keep the original (refs live until GC; not batching).
+ */
+static void* batch_previous_value(colyseus_decoder_t* decoder, colyseus_field_type_t type,
+                                  const void* previous_value) {
+    if (decoder->batch_depth == 0 || !previous_value) return NULL;
+    switch (type) {
+        case COLYSEUS_FIELD_REF:
+        case COLYSEUS_FIELD_ARRAY:
+        case COLYSEUS_FIELD_MAP:
+            return NULL;
+        case COLYSEUS_FIELD_STRING:
+            return strdup((const char*)previous_value);
+        default: {
+            void* copy = calloc(1, sizeof(double));  /* all primitives fit */
+            if (copy) memcpy(copy, previous_value, primitive_field_size(type));
+            return copy;
+        }
+    }
+}
+
 /* ============================================================================
  * Schema decode
  * ============================================================================ */
@@ -680,6 +764,8 @@ static bool decode_schema(colyseus_decoder_t* decoder, const uint8_t* bytes, siz
         child_primitive_type = field->child_primitive_type;
     }
 
+    colyseus_ref_tracker_mark_dirty(decoder->refs, schema->__refId, field_index);
+
     void* previous_value = is_dynamic 
         ? get_dyn_schema_field((colyseus_dynamic_schema_t*)schema, dyn_field)
         : get_schema_field(schema, field);
@@ -694,6 +780,12 @@ static bool decode_schema(colyseus_decoder_t* decoder, const uint8_t* bytes, siz
         (operation & (uint8_t)COLYSEUS_OP_DELETE) == (uint8_t)COLYSEUS_OP_DELETE) {
         previous_value_for_change = strdup((const char*)previous_value);
         owns_previous_value = true;
+    } else {
+        void* copy = batch_previous_value(decoder, field_type, previous_value);
+        if (copy) {
+            previous_value_for_change = copy;
+            owns_previous_value = true;
+        }
     }
 
     /* Handle DELETE operations */
@@ -830,11 +922,13 @@ static bool decode_map_schema(colyseus_decoder_t* decoder, const uint8_t* bytes,
     uint8_t operation = bytes[it->offset++];
 
     if (operation == (uint8_t)COLYSEUS_OP_CLEAR) {
+        colyseus_ref_tracker_mark_dirty(decoder->refs, map->__refId, -1);
         colyseus_map_schema_clear(map, decoder->changes, decoder->refs);
         return true;
     }
 
     int field_index = colyseus_decode_varint(bytes, it);
+    colyseus_ref_tracker_mark_dirty(decoder->refs, map->__refId, field_index);
 
     const char* field_type = map->has_schema_child ? "ref" : map->child_primitive_type;
     const colyseus_schema_vtable_t* child_vtable = map->child_vtable;
@@ -851,6 +945,9 @@ static bool decode_map_schema(colyseus_decoder_t* decoder, const uint8_t* bytes,
 
     void* value = NULL;
     void* previous_value = colyseus_map_schema_get_by_index(map, field_index);
+    void* previous_copy = map->has_schema_child ? NULL :
+        batch_previous_value(decoder, colyseus_field_type_from_string(map->child_primitive_type),
+                             previous_value);
 
     /* Handle DELETE */
     if ((operation & (uint8_t)COLYSEUS_OP_DELETE) == (uint8_t)COLYSEUS_OP_DELETE) {
@@ -880,13 +977,14 @@ static bool decode_map_schema(colyseus_decoder_t* decoder, const uint8_t* bytes,
             .field = NULL,
             .dynamic_index = dynamic_index,  /* Ownership transfers */
             .value = value,
-            .previous_value = previous_value,
+            .previous_value = previous_copy ? previous_copy : previous_value,
             .field_type = map->has_schema_child ? COLYSEUS_FIELD_REF : COLYSEUS_FIELD_STRING,
-            .owns_previous_value = false
+            .owns_previous_value = previous_copy != NULL
         };
         colyseus_changes_add(decoder->changes, &change);
     } else {
         free(dynamic_index);
+        free(previous_copy);
     }
 
     return true;
@@ -903,11 +1001,13 @@ static bool decode_array_schema(colyseus_decoder_t* decoder, const uint8_t* byte
     int index = 0;
 
     if (operation == (uint8_t)COLYSEUS_OP_CLEAR) {
+        colyseus_ref_tracker_mark_dirty(decoder->refs, arr->__refId, -1);
         colyseus_array_schema_clear(arr, decoder->changes, decoder->refs);
         return true;
     }
 
     if (operation == (uint8_t)COLYSEUS_OP_REVERSE) {
+        colyseus_ref_tracker_mark_dirty(decoder->refs, arr->__refId, -1);
         colyseus_array_schema_reverse(arr);
         return true;
     }
@@ -928,6 +1028,7 @@ static bool decode_array_schema(colyseus_decoder_t* decoder, const uint8_t* byte
          */
         if (index >= 0) {
             colyseus_array_schema_delete(arr, index);
+            colyseus_ref_tracker_mark_dirty(decoder->refs, arr->__refId, index);
         }
 
         int* idx_ptr = malloc(sizeof(int));
@@ -960,6 +1061,8 @@ static bool decode_array_schema(colyseus_decoder_t* decoder, const uint8_t* byte
         index = colyseus_decode_varint(bytes, it);
     }
 
+    colyseus_ref_tracker_mark_dirty(decoder->refs, arr->__refId, index);
+
     const char* field_type = arr->has_schema_child ? "ref" : arr->child_primitive_type;
     const colyseus_schema_vtable_t* child_vtable = arr->child_vtable;
 
@@ -1024,7 +1127,11 @@ void colyseus_decoder_decode(colyseus_decoder_t* decoder, const uint8_t* bytes,
     void* _ref = decoder->state;
     decode_ref_type_t current_ref_type = DECODE_REF_SCHEMA;
 
-    colyseus_changes_clear(decoder->changes);
+    /* In a batch, changes and dirty state accumulate until end_batch() */
+    if (decoder->batch_depth == 0) {
+        colyseus_changes_clear(decoder->changes);
+        colyseus_ref_tracker_begin_epoch(decoder->refs);
+    }
 
     while (it->offset < (int)length) {
         /* Check for SWITCH_TO_STRUCTURE */
@@ -1106,6 +1213,14 @@ void colyseus_decoder_decode(colyseus_decoder_t* decoder, const uint8_t* bytes,
         colyseus_array_schema_on_decode_end((colyseus_array_schema_t*)_ref);
     }
 
+    if (decoder->batch_depth > 0) return;
+
+    decoder_flush(decoder);
+}
+
+/* Trigger callbacks, collect garbage and notify listeners for the changes
+ * of the last patch (or batch of patches) */
+static void decoder_flush(colyseus_decoder_t* decoder) {
     /* Trigger changes callback */
     if (decoder->trigger_changes) {
         decoder->trigger_changes(decoder->changes, decoder->trigger_userdata);
@@ -1113,4 +1228,203 @@ void colyseus_decoder_decode(colyseus_decoder_t* decoder, const uint8_t* bytes,
 
     /* Run garbage collection */
     colyseus_ref_tracker_gc(decoder->refs);
+
+    /* Notify post-decode listeners */
+    colyseus_decode_listener_t* listener = decoder->decode_listeners;
+    while (listener) {
+        colyseus_decode_listener_t* next = listener->next;
+        listener->callback(decoder, listener->userdata);
+        listener = next;
+    }
+}
+
+/* ============================================================================
+ * Batched decode (catch-up)
+ * ============================================================================ */
+
+/* Coalescing key: schema field or map key of one ref */
+typedef struct batch_change_key {
+    char* key;
+    int first;
+    int last;
+    /* The first change's previous value: the value before the batch, which
+     * the net change reports. Taken over (ownership included) when the
+     * first change is merged away. */
+    void* previous_value;
+    bool owns_previous_value;
+    UT_hash_handle hh;
+} batch_change_key_t;
+
+static bool is_ref_field_type(colyseus_field_type_t type) {
+    return type == COLYSEUS_FIELD_REF ||
+           type == COLYSEUS_FIELD_ARRAY ||
+           type == COLYSEUS_FIELD_MAP;
+}
+
+/* Created and released within the current batch: never surfaced */
+static bool is_transient_ref(colyseus_decoder_t* decoder, int ref_id) {
+    colyseus_ref_entry_t* entry = colyseus_ref_tracker_get_entry(decoder->refs, ref_id);
+    return entry && entry->ref_count <= 0 &&
+        entry->created_epoch == colyseus_ref_tracker_get_epoch(decoder->refs);
+}
+
+static char* batch_change_key(colyseus_decoder_t* decoder, const colyseus_data_change_t* change) {
+    char buf[320];
+    if (change->field) {
+        snprintf(buf, sizeof(buf), "%d.%s", change->ref_id, change->field);
+        return strdup(buf);
+    }
+    colyseus_ref_entry_t* entry = colyseus_ref_tracker_get_entry(decoder->refs, change->ref_id);
+    if (entry && entry->ref_type == COLYSEUS_REF_TYPE_MAP && change->dynamic_index) {
+        snprintf(buf, sizeof(buf), "%d[%s", change->ref_id, (const char*)change->dynamic_index);
+        return strdup(buf);
+    }
+    /* Array indexes shift between patches; array changes are kept as-is */
+    return NULL;
+}
+
+static void drop_change(colyseus_data_change_t* change) {
+    if (change->owns_previous_value && change->previous_value) {
+        free(change->previous_value);
+    }
+    change->owns_previous_value = false;
+    change->previous_value = NULL;
+}
+
+/*
+ * Merge the changes accumulated by a batch into one net change per schema
+ * field / map key (emitted at the position of the last one), and drop
+ * everything that only concerns refs created and released within the batch.
+ */
+static void merge_batched_changes(colyseus_decoder_t* decoder) {
+    colyseus_changes_t* changes = decoder->changes;
+    if (changes->count == 0) return;
+
+    batch_change_key_t* keys = NULL;
+    batch_change_key_t** key_of = calloc((size_t)changes->count, sizeof(batch_change_key_t*));
+    if (!key_of) return;
+
+    for (int i = 0; i < changes->count; i++) {
+        char* key = batch_change_key(decoder, &changes->items[i]);
+        if (!key) continue;
+
+        batch_change_key_t* entry = NULL;
+        HASH_FIND_STR(keys, key, entry);
+        if (entry) {
+            entry->last = i;
+            free(key);
+        } else {
+            entry = malloc(sizeof(batch_change_key_t));
+            if (!entry) {
+                free(key);
+                continue;
+            }
+            entry->key = key;
+            entry->first = i;
+            entry->last = i;
+            entry->previous_value = NULL;
+            entry->owns_previous_value = false;
+            HASH_ADD_KEYPTR(hh, keys, entry->key, strlen(entry->key), entry);
+        }
+        key_of[i] = entry;
+    }
+
+    int out = 0;
+    for (int i = 0; i < changes->count; i++) {
+        colyseus_data_change_t change = changes->items[i];
+        batch_change_key_t* entry = key_of[i];
+        bool is_ref = is_ref_field_type(change.field_type);
+
+        if (entry && entry->last != i) {
+            /* Superseded by a later change of the same field/key. The
+             * first one's previous value moves to the net change; items
+             * may be overwritten below, so it's kept on the key. */
+            if (entry->first == i) {
+                entry->previous_value = change.previous_value;
+                entry->owns_previous_value = change.owns_previous_value;
+            } else {
+                drop_change(&change);
+            }
+            continue;
+        }
+
+        if (entry && entry->first != i) {
+            void* before = entry->previous_value;
+            void* after = change.value;
+
+            /* Intermediate previous values go; the pre-batch one stays
+             * (schema instances stay valid until GC, primitives were
+             * copied when recorded) */
+            drop_change(&change);
+            change.previous_value = before;
+            change.owns_previous_value = entry->owns_previous_value;
+            entry->previous_value = NULL;
+            entry->owns_previous_value = false;
+
+            if (before == NULL && after == NULL) {
+                continue;
+            }
+
+            if (before == NULL) {
+                change.op = (uint8_t)COLYSEUS_OP_ADD;
+            } else if (after == NULL) {
+                change.op = (uint8_t)COLYSEUS_OP_DELETE;
+            } else if (is_ref && before != after) {
+                change.op = (uint8_t)COLYSEUS_OP_DELETE_AND_ADD;
+            }
+        }
+
+        if (is_transient_ref(decoder, change.ref_id)) {
+            drop_change(&change);
+            continue;
+        }
+
+        if (is_ref) {
+            bool value_transient = change.value &&
+                is_transient_ref(decoder, COLYSEUS_REF_ID(change.value));
+            bool previous_transient = change.previous_value &&
+                is_transient_ref(decoder, COLYSEUS_REF_ID(change.previous_value));
+
+            if (value_transient) {
+                change.value = NULL;
+                change.op = (uint8_t)COLYSEUS_OP_DELETE;
+            }
+            if (previous_transient) {
+                change.previous_value = NULL;
+                if (change.value) change.op = (uint8_t)COLYSEUS_OP_ADD;
+            }
+            if (change.value == NULL && change.previous_value == NULL) {
+                continue;
+            }
+        }
+
+        changes->items[out++] = change;
+    }
+    changes->count = out;
+
+    batch_change_key_t *entry, *tmp;
+    HASH_ITER(hh, keys, entry, tmp) {
+        HASH_DEL(keys, entry);
+        if (entry->owns_previous_value) free(entry->previous_value);
+        free(entry->key);
+        free(entry);
+    }
+    free(key_of);
+}
+
+void colyseus_decoder_begin_batch(colyseus_decoder_t* decoder) {
+    if (!decoder) return;
+
+    if (decoder->batch_depth++ == 0) {
+        colyseus_changes_clear(decoder->changes);
+        colyseus_ref_tracker_begin_epoch(decoder->refs);
+    }
+}
+
+void colyseus_decoder_end_batch(colyseus_decoder_t* decoder) {
+    if (!decoder || decoder->batch_depth == 0) return;
+    if (--decoder->batch_depth > 0) return;
+
+    merge_batched_changes(decoder);
+    decoder_flush(decoder);
 }
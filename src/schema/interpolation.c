@@ -0,0 +1,476 @@
+#include "colyseus/schema/interpolation.h"
+#include "colyseus/schema/decoder.h"
+#include "colyseus/schema/dynamic_schema.h"
+#include "colyseus/utils/time.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERP_INITIAL_CAPACITY 64
+
+/* refId -> slot index */
+typedef struct {
+    int ref_id;
+    int slot;
+    UT_hash_handle hh;
+} interp_slot_entry_t;
+
+/* Resolved field for one channel */
+typedef struct {
+    int index;
+    colyseus_field_type_t type;
+    size_t offset;              /* Static schemas only */
+} interp_channel_t;
+
+struct colyseus_interp_buffer {
+    colyseus_decoder_t* decoder;
+    const colyseus_schema_vtable_t* vtable;
+    bool is_dynamic;
+
+    interp_channel_t* channels;
+    int channel_count;
+    uint64_t channel_mask;      /* Dirty bits of tracked fields */
+
+    /* Sample ring */
+    int history;                /* Power of two */
+    int sample_count;
+    int head;                   /* Index of newest sample */
+    double* times;
+
+    /* values[channel] = history rows of `capacity` floats */
+    float** values;
+
+    /* Entity slots */
+    int* ref_ids;
+    int count;
+    int capacity;
+    interp_slot_entry_t* slots;
+
+    double max_extrapolation_ms;
+};
+
+/* ============================================================================
+ * Field access
+ * ============================================================================ */
+
+static bool is_numeric_type(colyseus_field_type_t type) {
+    switch (type) {
+        case COLYSEUS_FIELD_NUMBER:
+        case COLYSEUS_FIELD_FLOAT32:
+        case COLYSEUS_FIELD_FLOAT64:
+        case COLYSEUS_FIELD_INT8:
+        case COLYSEUS_FIELD_UINT8:
+        case COLYSEUS_FIELD_INT16:
+        case COLYSEUS_FIELD_UINT16:
+        case COLYSEUS_FIELD_INT32:
+        case COLYSEUS_FIELD_UINT32:
+        case COLYSEUS_FIELD_INT64:
+        case COLYSEUS_FIELD_UINT64:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static float read_numeric(const void* ptr, colyseus_field_type_t type) {
+    switch (type) {
+        case COLYSEUS_FIELD_NUMBER:
+        case COLYSEUS_FIELD_FLOAT64: return (float)*(const double*)ptr;
+        case COLYSEUS_FIELD_FLOAT32: return *(const float*)ptr;
+        case COLYSEUS_FIELD_INT8:    return (float)*(const int8_t*)ptr;
+        case COLYSEUS_FIELD_UINT8:   return (float)*(const uint8_t*)ptr;
+        case COLYSEUS_FIELD_INT16:   return (float)*(const int16_t*)ptr;
+        case COLYSEUS_FIELD_UINT16:  return (float)*(const uint16_t*)ptr;
+        case COLYSEUS_FIELD_INT32:   return (float)*(const int32_t*)ptr;
+        case COLYSEUS_FIELD_UINT32:  return (float)*(const uint32_t*)ptr;
+        case COLYSEUS_FIELD_INT64:   return (float)*(const int64_t*)ptr;
+        case COLYSEUS_FIELD_UINT64:  return (float)*(const uint64_t*)ptr;
+        default:                     return 0.0f;
+    }
+}
+
+static float read_channel(colyseus_interp_buffer_t* buf, void* ref, const interp_channel_t* ch) {
+    if (buf->is_dynamic) {
+        colyseus_dynamic_value_t* value = colyseus_dynamic_schema_get(
+            (colyseus_dynamic_schema_t*)ref, ch->index);
+        return value ? read_numeric(&value->data, ch->type) : 0.0f;
+    }
+    return read_numeric((const char*)ref + ch->offset, ch->type);
+}
+
+static bool resolve_channel(const colyseus_schema_vtable_t* vtable, bool is_dynamic,
+    const char* name, interp_channel_t* out) {
+    if (!name) return false;
+
+    if (is_dynamic) {
+        const colyseus_dynamic_field_t* field = colyseus_dynamic_vtable_find_field_by_name(
+            colyseus_vtable_as_dynamic(vtable), name);
+        if (!field || !is_numeric_type(field->type)) return false;
+        out->index = field->index;
+        out->type = field->type;
+        out->offset = 0;
+        return true;
+    }
+
+    for (int i = 0; i < vtable->field_count; i++) {
+        const colyseus_field_t* field = &vtable->fields[i];
+        if (strcmp(field->name, name) == 0) {
+            if (!is_numeric_type(field->type)) return false;
+            out->index = field->index;
+            out->type = field->type;
+            out->offset = field->offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* ============================================================================
+ * Slots
+ * ============================================================================ */
+
+static inline float* row(colyseus_interp_buffer_t* buf, int channel, int sample) {
+    return buf->values[channel] + (size_t)sample * buf->capacity;
+}
+
+static bool grow_slots(colyseus_interp_buffer_t* buf) {
+    int new_capacity = buf->capacity * 2;
+
+    int* new_ids = realloc(buf->ref_ids, new_capacity * sizeof(int));
+    if (!new_ids) return false;
+    buf->ref_ids = new_ids;
+
+    /* Rows are strided by capacity, so every channel is re-laid out.
+     * Allocate all of them first so a failure leaves the buffer intact. */
+    float** new_values = calloc(buf->channel_count, sizeof(float*));
+    if (!new_values) return false;
+
+    for (int c = 0; c < buf->channel_count; c++) {
+        new_values[c] = malloc((size_t)buf->history * new_capacity * sizeof(float));
+        if (!new_values[c]) {
+            for (int j = 0; j < c; j++) free(new_values[j]);
+            free(new_values);
+            return false;
+        }
+    }
+
+    for (int c = 0; c < buf->channel_count; c++) {
+        for (int s = 0; s < buf->history; s++) {
+            memcpy(new_values[c] + (size_t)s * new_capacity,
+                buf->values[c] + (size_t)s * buf->capacity,
+                buf->count * sizeof(float));
+        }
+        free(buf->values[c]);
+    }
+    free(buf->values);
+
+    buf->values = new_values;
+    buf->capacity = new_capacity;
+    return true;
+}
+
+static void add_slot(colyseus_interp_buffer_t* buf, int ref_id, void* ref) {
+    if (buf->count >= buf->capacity && !grow_slots(buf)) return;
+
+    int slot = buf->count++;
+    buf->ref_ids[slot] = ref_id;
+
+    /* Backfill the whole history so a new entity doesn't lerp in from 0 */
+    for (int c = 0; c < buf->channel_count; c++) {
+        float value = read_channel(buf, ref, &buf->channels[c]);
+        for (int s = 0; s < buf->history; s++) {
+            row(buf, c, s)[slot] = value;
+        }
+    }
+
+    interp_slot_entry_t* entry = malloc(sizeof(interp_slot_entry_t));
+    if (!entry) return;
+    entry->ref_id = ref_id;
+    entry->slot = slot;
+    HASH_ADD_INT(buf->slots, ref_id, entry);
+}
+
+static void add_slot_if_tracked(colyseus_interp_buffer_t* buf, colyseus_ref_entry_t* entry) {
+    if (!entry || !entry->ref || entry->ref_type != COLYSEUS_REF_TYPE_SCHEMA ||
+        entry->vtable != buf->vtable) {
+        return;
+    }
+
+    interp_slot_entry_t* slot_entry = NULL;
+    HASH_FIND_INT(buf->slots, &entry->ref_id, slot_entry);
+    if (!slot_entry) add_slot(buf, entry->ref_id, entry->ref);
+}
+
+/* Slot every live instance in the tracker: used on create (a buffer created
+ * after the first patch would otherwise only see entities as they next
+ * change) and when the dirty list overflowed */
+static void scan_slots(colyseus_interp_buffer_t* buf) {
+    colyseus_ref_entry_t* entry;
+    colyseus_ref_entry_t* tmp;
+    HASH_ITER(hh, buf->decoder->refs->refs, entry, tmp) {
+        add_slot_if_tracked(buf, entry);
+    }
+}
+
+static void remove_slot(colyseus_interp_buffer_t* buf, int slot) {
+    int last = buf->count - 1;
+
+    interp_slot_entry_t* entry = NULL;
+    HASH_FIND_INT(buf->slots, &buf->ref_ids[slot], entry);
+    if (entry) {
+        HASH_DEL(buf->slots, entry);
+        free(entry);
+    }
+
+    if (slot != last) {
+        /* Move last slot into the hole */
+        buf->ref_ids[slot] = buf->ref_ids[last];
+        for (int c = 0; c < buf->channel_count; c++) {
+            for (int s = 0; s < buf->history; s++) {
+                float* r = row(buf, c, s);
+                r[slot] = r[last];
+            }
+        }
+
+        HASH_FIND_INT(buf->slots, &buf->ref_ids[slot], entry);
+        if (entry) entry->slot = slot;
+    }
+
+    buf->count--;
+}
+
+/* ============================================================================
+ * Create / free
+ * ============================================================================ */
+
+static void interp_on_decode_end(colyseus_decoder_t* decoder, void* userdata) {
+    (void)decoder;
+    colyseus_interp_buffer_capture((colyseus_interp_buffer_t*)userdata,
+        (double)colyseus_monotonic_ms());
+}
+
+colyseus_interp_buffer_t* colyseus_interp_buffer_create(colyseus_decoder_t* decoder,
+    const colyseus_schema_vtable_t* vtable, const char* const* field_names,
+    int channel_count, int history) {
+    if (!decoder || !vtable || !field_names || channel_count <= 0) return NULL;
+
+    colyseus_interp_buffer_t* buf = calloc(1, sizeof(colyseus_interp_buffer_t));
+    if (!buf) return NULL;
+
+    buf->decoder = decoder;
+    buf->vtable = vtable;
+    buf->is_dynamic = colyseus_vtable_is_dynamic(vtable);
+    buf->channel_count = channel_count;
+    buf->max_extrapolation_ms = 100.0;
+    buf->head = -1;
+
+    buf->history = 2;
+    while (buf->history < history) buf->history <<= 1;
+
+    buf->channels = calloc(channel_count, sizeof(interp_channel_t));
+    buf->values = calloc(channel_count, sizeof(float*));
+    buf->times = calloc(buf->history, sizeof(double));
+    buf->capacity = INTERP_INITIAL_CAPACITY;
+    buf->ref_ids = malloc(buf->capacity * sizeof(int));
+    if (!buf->channels || !buf->values || !buf->times || !buf->ref_ids) {
+        colyseus_interp_buffer_free(buf);
+        return NULL;
+    }
+
+    for (int c = 0; c < channel_count; c++) {
+        if (!resolve_channel(vtable, buf->is_dynamic, field_names[c], &buf->channels[c])) {
+            colyseus_interp_buffer_free(buf);
+            return NULL;
+        }
+        buf->channel_mask |= COLYSEUS_DIRTY_BIT(buf->channels[c].index);
+
+        buf->values[c] = malloc((size_t)buf->history * buf->capacity * sizeof(float));
+        if (!buf->values[c]) {
+            colyseus_interp_buffer_free(buf);
+            return NULL;
+        }
+    }
+
+    scan_slots(buf);
+    colyseus_decoder_add_decode_listener(decoder, interp_on_decode_end, buf);
+
+    return buf;
+}
+
+void colyseus_interp_buffer_free(colyseus_interp_buffer_t* buf) {
+    if (!buf) return;
+
+    colyseus_decoder_remove_decode_listener(buf->decoder, interp_on_decode_end, buf);
+
+    interp_slot_entry_t* entry;
+    interp_slot_entry_t* tmp;
+    HASH_ITER(hh, buf->slots, entry, tmp) {
+        HASH_DEL(buf->slots, entry);
+        free(entry);
+    }
+
+    if (buf->values) {
+        for (int c = 0; c < buf->channel_count; c++) {
+            free(buf->values[c]);
+        }
+        free(buf->values);
+    }
+    free(buf->channels);
+    free(buf->times);
+    free(buf->ref_ids);
+    free(buf);
+}
+
+void colyseus_interp_buffer_set_max_extrapolation(colyseus_interp_buffer_t* buf, double ms) {
+    if (!buf) return;
+    buf->max_extrapolation_ms = ms < 0 ? 0 : ms;
+}
+
+/* ============================================================================
+ * Capture
+ * ============================================================================ */
+
+void colyseus_interp_buffer_capture(colyseus_interp_buffer_t* buf, double time_ms) {
+    if (!buf) return;
+
+    colyseus_ref_tracker_t* refs = buf->decoder->refs;
+    int mask = buf->history - 1;
+    int prev = buf->head;
+
+    buf->head = (buf->head + 1) & mask;
+    buf->times[buf->head] = time_ms;
+    if (buf->sample_count < buf->history) buf->sample_count++;
+
+    /* Carry unchanged values forward (contiguous row copy) */
+    if (prev >= 0) {
+        for (int c = 0; c < buf->channel_count; c++) {
+            memcpy(row(buf, c, buf->head), row(buf, c, prev), buf->count * sizeof(float));
+        }
+    }
+
+    /* Refresh changed entities, drop collected ones */
+    for (int slot = 0; slot < buf->count; ) {
+        colyseus_ref_entry_t* entry = colyseus_ref_tracker_get_entry(refs, buf->ref_ids[slot]);
+        if (!entry || !entry->ref || entry->vtable != buf->vtable) {
+            remove_slot(buf, slot);
+            continue;  /* Re-visit the slot that was moved in */
+        }
+        if (entry->dirty_fields & buf->channel_mask) {
+            for (int c = 0; c < buf->channel_count; c++) {
+                row(buf, c, buf->head)[slot] = read_channel(buf, entry->ref, &buf->channels[c]);
+            }
+        }
+        slot++;
+    }
+
+    /* Pick up new instances from the dirty list */
+    if (colyseus_ref_tracker_dirty_overflowed(refs)) {
+        scan_slots(buf);
+        return;
+    }
+
+    int dirty_count = 0;
+    const int* dirty = colyseus_ref_tracker_get_dirty_refs(refs, &dirty_count);
+    for (int i = 0; i < dirty_count; i++) {
+        add_slot_if_tracked(buf, colyseus_ref_tracker_get_entry(refs, dirty[i]));
+    }
+}
+
+/* ============================================================================
+ * Sampling
+ * ============================================================================ */
+
+/* Find the two samples bracketing `time_ms` and the blend factor between
+ * them. t > 1 means extrapolation past the newest sample. */
+static bool find_bracket(colyseus_interp_buffer_t* buf, double time_ms, int* a, int* b, float* t) {
+    if (buf->sample_count == 0) return false;
+
+    int mask = buf->history - 1;
+    int newest = buf->head;
+
+    *a = *b = newest;
+    *t = 0.0f;
+
+    if (time_ms >= buf->times[newest]) {
+        if (buf->sample_count < 2) return true;
+        int before = (newest - 1) & mask;
+        double span = buf->times[newest] - buf->times[before];
+        if (span <= 0) return true;
+
+        double limit = buf->times[newest] + buf->max_extrapolation_ms;
+        if (time_ms > limit) time_ms = limit;
+
+        *a = before;
+        *t = (float)((time_ms - buf->times[before]) / span);
+        return true;
+    }
+
+    /* Walk back from newest until we find a sample at or before time_ms */
+    for (int i = 1; i < buf->sample_count; i++) {
+        int idx = (newest - i) & mask;
+        if (buf->times[idx] <= time_ms) {
+            int next = (idx + 1) & mask;
+            double span = buf->times[next] - buf->times[idx];
+            *a = idx;
+            *b = next;
+            *t = span > 0 ? (float)((time_ms - buf->times[idx]) / span) : 0.0f;
+            return true;
+        }
+    }
+
+    /* Older than the oldest sample: hold the oldest */
+    *a = *b = (newest - (buf->sample_count - 1)) & mask;
+    return true;
+}
+
+void colyseus_interp_buffer_sample_channel(colyseus_interp_buffer_t* buf, int channel,
+    double render_time_ms, float* out) {
+    if (!buf || !out || channel < 0 || channel >= buf->channel_count) return;
+
+    int a, b;
+    float t;
+    if (!find_bracket(buf, render_time_ms, &a, &b, &t)) return;
+
+    const float* ra = row(buf, channel, a);
+    const float* rb = row(buf, channel, b);
+    int count = buf->count;
+
+    for (int i = 0; i < count; i++) {
+        out[i] = ra[i] + (rb[i] - ra[i]) * t;
+    }
+}
+
+bool colyseus_interp_buffer_sample_entity(colyseus_interp_buffer_t* buf, int ref_id,
+    double render_time_ms, float* out) {
+    if (!buf || !out) return false;
+
+    int slot = colyseus_interp_buffer_find_slot(buf, ref_id);
+    if (slot < 0) return false;
+
+    int a, b;
+    float t;
+    if (!find_bracket(buf, render_time_ms, &a, &b, &t)) return false;
+
+    for (int c = 0; c < buf->channel_count; c++) {
+        float va = row(buf, c, a)[slot];
+        float vb = row(buf, c, b)[slot];
+        out[c] = va + (vb - va) * t;
+    }
+    return true;
+}
+
+int colyseus_interp_buffer_get_count(colyseus_interp_buffer_t* buf) {
+    return buf ? buf->count : 0;
+}
+
+const int* colyseus_interp_buffer_get_ref_ids(colyseus_interp_buffer_t* buf) {
+    return buf ? buf->ref_ids : NULL;
+}
+
+int colyseus_interp_buffer_find_slot(colyseus_interp_buffer_t* buf, int ref_id) {
+    if (!buf) return -1;
+
+    interp_slot_entry_t* entry = NULL;
+    HASH_FIND_INT(buf->slots, &ref_id, entry);
+
+    return entry ? entry->slot : -1;
+}
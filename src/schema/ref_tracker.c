@@ -14,6 +14,13 @@ colyseus_ref_tracker_t* colyseus_ref_tracker_create(void) {
 
     tracker->refs = NULL;
     tracker->deleted = NULL;
+    tracker->dirty_refs = NULL;
+    tracker->dirty_count = 0;
+    tracker->dirty_capacity = 0;
+    tracker->dirty_overflow = false;
+    tracker->dirty_gen = 1;
+    tracker->dirty_epoch = 0;
+    tracker->dirty_auto_clear = true;
 
     return tracker;
 }
@@ -22,6 +29,7 @@ void colyseus_ref_tracker_free(colyseus_ref_tracker_t* tracker) {
     if (!tracker) return;
 
     colyseus_ref_tracker_clear(tracker);
+    free(tracker->dirty_refs);
     free(tracker);
 }
 
@@ -50,6 +58,9 @@ void colyseus_ref_tracker_add(colyseus_ref_tracker_t* tracker, int ref_id, void*
         entry->ref_count = increment_count ? 1 : 0;
         entry->ref_type = ref_type;
         entry->vtable = vtable;
+        entry->dirty_fields = 0;
+        entry->dirty_gen = 0;
+        entry->created_epoch = tracker->dirty_epoch;
 
         HASH_ADD_INT(tracker->refs, ref_id, entry);
     }
@@ -321,4 +332,112 @@ void colyseus_ref_tracker_clear(colyseus_ref_tracker_t* tracker) {
         free(to_delete);
     }
     tracker->deleted = NULL;
+
+    tracker->dirty_count = 0;
+    tracker->dirty_overflow = false;
+    tracker->dirty_gen++;
+}
+
+/* ============================================================================
+ * Dirty field tracking
+ * ============================================================================ */
+
+void colyseus_ref_tracker_mark_dirty(colyseus_ref_tracker_t* tracker, int ref_id, int index) {
+    if (!tracker) return;
+
+    colyseus_ref_entry_t* entry = NULL;
+    HASH_FIND_INT(tracker->refs, &ref_id, entry);
+    if (!entry) return;
+
+    entry->dirty_fields |= (index < 0) ? COLYSEUS_DIRTY_ALL : COLYSEUS_DIRTY_BIT(index);
+
+    if (entry->dirty_gen == tracker->dirty_gen) return;  /* Already listed */
+
+    if (tracker->dirty_count >= tracker->dirty_capacity) {
+        int new_capacity = tracker->dirty_capacity ? tracker->dirty_capacity * 2 : 16;
+        int* new_refs = realloc(tracker->dirty_refs, new_capacity * sizeof(int));
+        if (!new_refs) {
+            /* The mask is set but the ref can't be listed: readers must
+             * scan every entry until the next clear */
+            tracker->dirty_overflow = true;
+            return;
+        }
+        tracker->dirty_refs = new_refs;
+        tracker->dirty_capacity = new_capacity;
+    }
+
+    tracker->dirty_refs[tracker->dirty_count++] = ref_id;
+    entry->dirty_gen = tracker->dirty_gen;
+}
+
+uint64_t colyseus_ref_tracker_get_dirty_fields(colyseus_ref_tracker_t* tracker, int ref_id) {
+    if (!tracker) return 0;
+
+    colyseus_ref_entry_t* entry = NULL;
+    HASH_FIND_INT(tracker->refs, &ref_id, entry);
+
+    return entry ? entry->dirty_fields : 0;
+}
+
+const int* colyseus_ref_tracker_get_dirty_refs(colyseus_ref_tracker_t* tracker, int* out_count) {
+    if (!tracker) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+
+    if (out_count) *out_count = tracker->dirty_count;
+    return tracker->dirty_refs;
+}
+
+bool colyseus_ref_tracker_dirty_overflowed(colyseus_ref_tracker_t* tracker) {
+    return tracker ? tracker->dirty_overflow : false;
+}
+
+void colyseus_ref_tracker_clear_dirty(colyseus_ref_tracker_t* tracker) {
+    if (!tracker) return;
+
+    if (tracker->dirty_overflow) {
+        /* Unlisted refs carry dirty bits too */
+        colyseus_ref_entry_t* entry;
+        colyseus_ref_entry_t* tmp;
+        HASH_ITER(hh, tracker->refs, entry, tmp) {
+            entry->dirty_fields = 0;
+        }
+        tracker->dirty_overflow = false;
+    } else {
+        for (int i = 0; i < tracker->dirty_count; i++) {
+            colyseus_ref_entry_t* entry = NULL;
+            HASH_FIND_INT(tracker->refs, &tracker->dirty_refs[i], entry);
+            if (entry) entry->dirty_fields = 0;
+        }
+    }
+
+    tracker->dirty_count = 0;
+    tracker->dirty_gen++;
+}
+
+void colyseus_ref_tracker_clear_dirty_ref(colyseus_ref_tracker_t* tracker, int ref_id) {
+    if (!tracker) return;
+
+    colyseus_ref_entry_t* entry = NULL;
+    HASH_FIND_INT(tracker->refs, &ref_id, entry);
+    if (entry) entry->dirty_fields = 0;
+}
+
+void colyseus_ref_tracker_set_dirty_auto_clear(colyseus_ref_tracker_t* tracker, bool enabled) {
+    if (!tracker) return;
+    tracker->dirty_auto_clear = enabled;
+}
+
+void colyseus_ref_tracker_begin_epoch(colyseus_ref_tracker_t* tracker) {
+    if (!tracker) return;
+
+    if (tracker->dirty_auto_clear) {
+        colyseus_ref_tracker_clear_dirty(tracker);
+    }
+    tracker->dirty_epoch++;
+}
+
+unsigned int colyseus_ref_tracker_get_epoch(colyseus_ref_tracker_t* tracker) {
+    return tracker ? tracker->dirty_epoch : 0;
 }
\ No newline at end of file
@@ -246,6 +246,28 @@ void colyseus_schema_serializer_patch(colyseus_schema_serializer_t* serializer,
     colyseus_decoder_decode(serializer->decoder, data, length, &serializer->it);
 }
 
+void colyseus_schema_serializer_begin_batch(colyseus_schema_serializer_t* serializer) {
+    if (!serializer) return;
+    colyseus_decoder_begin_batch(serializer->decoder);
+}
+
+void colyseus_schema_serializer_end_batch(colyseus_schema_serializer_t* serializer) {
+    if (!serializer) return;
+    colyseus_decoder_end_batch(serializer->decoder);
+}
+
+void colyseus_schema_serializer_patch_batch(colyseus_schema_serializer_t* serializer,
+    const colyseus_patch_frame_t* patches, int count) {
+    if (!serializer || !patches) return;
+
+    colyseus_decoder_begin_batch(serializer->decoder);
+    for (int i = 0; i < count; i++) {
+        serializer->it.offset = patches[i].offset;
+        colyseus_decoder_decode(serializer->decoder, patches[i].data, patches[i].length, &serializer->it);
+    }
+    colyseus_decoder_end_batch(serializer->decoder);
+}
+
 void colyseus_schema_serializer_teardown(colyseus_schema_serializer_t* serializer) {
     if (!serializer) return;
     colyseus_decoder_teardown(serializer->decoder);
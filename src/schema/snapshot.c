@@ -0,0 +1,488 @@
+#include "colyseus/schema/snapshot.h"
+#include "colyseus/schema/decoder.h"
+#include "colyseus/schema/dynamic_schema.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Immutable copy of one ref, shared between snapshot versions */
+typedef struct snap_node {
+    atomic_int refcount;
+    colyseus_ref_type_t type;
+    void* payload;                  /* Schema struct copy / array / map */
+
+    struct snap_node** children;    /* Retained child nodes (NULL entries allowed) */
+    int child_count;
+
+    void** owned;                   /* Heap copies owned by this node (strings, primitives) */
+    int owned_count;
+} snap_node_t;
+
+struct colyseus_state_snapshot {
+    atomic_int refcount;
+    snap_node_t* root;
+    unsigned int epoch;
+};
+
+/* Publisher-side index: latest node built for each refId */
+typedef struct {
+    int ref_id;
+    snap_node_t* node;              /* Retained */
+    unsigned int gen;               /* Build generation this entry was last visited in */
+    UT_hash_handle hh;
+} snap_index_entry_t;
+
+struct colyseus_snapshot_publisher {
+    colyseus_decoder_t* decoder;
+    snap_index_entry_t* index;
+    unsigned int gen;
+
+    /* Latest published version. Readers never wait: they count themselves
+     * in on one of two counters while they load and retain it. The
+     * publisher swaps the pointer, flips readers over to the other counter
+     * and waits for the first to drain before releasing what it replaced
+     * (left-right): by then nobody can still be about to retain it. */
+    _Atomic(colyseus_state_snapshot_t*) latest;
+    atomic_int readers[2];
+    atomic_int reader_side;
+};
+
+/* ============================================================================
+ * Nodes
+ * ============================================================================ */
+
+static void node_retain(snap_node_t* node) {
+    if (node) atomic_fetch_add_explicit(&node->refcount, 1, memory_order_relaxed);
+}
+
+static void node_release(snap_node_t* node) {
+    if (!node) return;
+    if (atomic_fetch_sub_explicit(&node->refcount, 1, memory_order_acq_rel) != 1) return;
+
+    for (int i = 0; i < node->child_count; i++) {
+        node_release(node->children[i]);
+    }
+    free(node->children);
+
+    for (int i = 0; i < node->owned_count; i++) {
+        free(node->owned[i]);
+    }
+    free(node->owned);
+
+    switch (node->type) {
+        case COLYSEUS_REF_TYPE_SCHEMA:
+            free(node->payload);
+            break;
+        case COLYSEUS_REF_TYPE_ARRAY:
+            colyseus_array_schema_free((colyseus_array_schema_t*)node->payload, NULL);
+            break;
+        case COLYSEUS_REF_TYPE_MAP:
+            colyseus_map_schema_free((colyseus_map_schema_t*)node->payload, NULL);
+            break;
+    }
+
+    free(node);
+}
+
+/* Take ownership of a heap copy. Returns it, or NULL if it had to be dropped. */
+static void* node_own(snap_node_t* node, void* ptr) {
+    if (!ptr) return NULL;
+    void** owned = realloc(node->owned, (node->owned_count + 1) * sizeof(void*));
+    if (!owned) {
+        free(ptr);
+        return NULL;
+    }
+    node->owned = owned;
+    node->owned[node->owned_count++] = ptr;
+    return ptr;
+}
+
+/* Next pre-built child node, in the same order collect_children() visited them */
+static snap_node_t* node_next_child(snap_node_t* node, int* cursor) {
+    return *cursor < node->child_count ? node->children[(*cursor)++] : NULL;
+}
+
+static size_t primitive_size(colyseus_field_type_t type) {
+    switch (type) {
+        case COLYSEUS_FIELD_NUMBER:
+        case COLYSEUS_FIELD_FLOAT64:
+        case COLYSEUS_FIELD_INT64:
+        case COLYSEUS_FIELD_UINT64:  return 8;
+        case COLYSEUS_FIELD_FLOAT32:
+        case COLYSEUS_FIELD_INT32:
+        case COLYSEUS_FIELD_UINT32:  return 4;
+        case COLYSEUS_FIELD_INT16:
+        case COLYSEUS_FIELD_UINT16:  return 2;
+        case COLYSEUS_FIELD_BOOLEAN: return sizeof(bool);
+        default:                     return 1;
+    }
+}
+
+/* Copy a primitive collection value (as allocated by colyseus_decode_primitive) */
+static void* copy_primitive(const char* type, const void* value) {
+    if (!type || !value) return NULL;
+
+    if (strcmp(type, "string") == 0) {
+        return strdup((const char*)value);
+    }
+
+    size_t size = primitive_size(colyseus_field_type_from_string(type));
+    void* copy = malloc(size);
+    if (copy) memcpy(copy, value, size);
+    return copy;
+}
+
+/* ============================================================================
+ * Build
+ * ============================================================================ */
+
+static snap_node_t* build_ref(colyseus_snapshot_publisher_t* publisher, int ref_id);
+
+static snap_node_t* node_create(colyseus_ref_type_t type, snap_node_t** children, int child_count) {
+    snap_node_t* node = calloc(1, sizeof(snap_node_t));
+    if (!node) return NULL;
+
+    atomic_init(&node->refcount, 1);
+    node->type = type;
+    node->children = children;
+    node->child_count = child_count;
+
+    for (int i = 0; i < child_count; i++) {
+        node_retain(children[i]);
+    }
+    return node;
+}
+
+static void* copy_schema(snap_node_t* node, colyseus_schema_t* schema,
+    const colyseus_schema_vtable_t* vtable) {
+    char* copy = malloc(vtable->size);
+    if (!copy) return NULL;
+    memcpy(copy, schema, vtable->size);
+
+    int child = 0;
+    for (int i = 0; i < vtable->field_count; i++) {
+        const colyseus_field_t* field = &vtable->fields[i];
+        void** slot = (void**)(copy + field->offset);
+
+        switch (field->type) {
+            case COLYSEUS_FIELD_STRING:
+                *slot = *slot ? node_own(node, strdup((const char*)*slot)) : NULL;
+                break;
+            case COLYSEUS_FIELD_REF:
+            case COLYSEUS_FIELD_ARRAY:
+            case COLYSEUS_FIELD_MAP: {
+                snap_node_t* child_node = node_next_child(node, &child);
+                *slot = child_node ? child_node->payload : NULL;
+                break;
+            }
+            default:
+                break;  /* Primitives copied by value */
+        }
+    }
+    return copy;
+}
+
+static void* copy_array(snap_node_t* node, colyseus_array_schema_t* arr) {
+    colyseus_array_schema_t* copy = colyseus_array_schema_create();
+    if (!copy) return NULL;
+
+    copy->__refId = arr->__refId;
+    copy->has_schema_child = arr->has_schema_child;
+    copy->child_primitive_type = arr->child_primitive_type;
+    copy->child_vtable = arr->child_vtable;
+
+    /* Replicate items directly (see colyseus_array_schema_clone) */
+    colyseus_array_item_t** tail = &copy->items;
+    int child = 0;
+    for (colyseus_array_item_t* item = arr->items; item; item = item->next) {
+        colyseus_array_item_t* new_item = malloc(sizeof(colyseus_array_item_t));
+        if (!new_item) break;
+
+        new_item->index = item->index;
+        new_item->next = NULL;
+        if (arr->has_schema_child) {
+            snap_node_t* child_node = node_next_child(node, &child);
+            new_item->value = child_node ? child_node->payload : NULL;
+        } else {
+            new_item->value = node_own(node, copy_primitive(arr->child_primitive_type, item->value));
+        }
+
+        *tail = new_item;
+        tail = &new_item->next;
+        copy->count++;
+    }
+    return copy;
+}
+
+static void* copy_map(snap_node_t* node, colyseus_map_schema_t* map) {
+    colyseus_map_schema_t* copy = colyseus_map_schema_create();
+    if (!copy) return NULL;
+
+    copy->__refId = map->__refId;
+    copy->has_schema_child = map->has_schema_child;
+    copy->child_primitive_type = map->child_primitive_type;
+    copy->child_vtable = map->child_vtable;
+
+    int child = 0;
+    colyseus_map_item_t* item;
+    colyseus_map_item_t* tmp;
+    HASH_ITER(hh, map->items, item, tmp) {
+        void* value;
+        if (map->has_schema_child) {
+            snap_node_t* child_node = node_next_child(node, &child);
+            value = child_node ? child_node->payload : NULL;
+        } else {
+            value = node_own(node, copy_primitive(map->child_primitive_type, item->value));
+        }
+        colyseus_map_schema_set_by_index(copy, item->field_index, item->key, value);
+    }
+    return copy;
+}
+
+/* Collect child nodes of a live ref, building them first (post-order) */
+static int collect_children(colyseus_snapshot_publisher_t* publisher, colyseus_ref_entry_t* entry,
+    snap_node_t*** out_children) {
+    int count = 0;
+    snap_node_t** children = NULL;
+
+    switch (entry->ref_type) {
+        case COLYSEUS_REF_TYPE_SCHEMA: {
+            const colyseus_schema_vtable_t* vtable = entry->vtable;
+            for (int i = 0; i < vtable->field_count; i++) {
+                colyseus_field_type_t type = vtable->fields[i].type;
+                if (type == COLYSEUS_FIELD_REF || type == COLYSEUS_FIELD_ARRAY || type == COLYSEUS_FIELD_MAP) {
+                    count++;
+                }
+            }
+            if (count == 0) break;
+            children = calloc(count, sizeof(snap_node_t*));
+            if (!children) return -1;
+
+            int c = 0;
+            for (int i = 0; i < vtable->field_count; i++) {
+                const colyseus_field_t* field = &vtable->fields[i];
+                if (field->type != COLYSEUS_FIELD_REF &&
+                    field->type != COLYSEUS_FIELD_ARRAY &&
+                    field->type != COLYSEUS_FIELD_MAP) {
+                    continue;
+                }
+                void* value = *(void**)((char*)entry->ref + field->offset);
+                children[c++] = value ? build_ref(publisher, COLYSEUS_REF_ID(value)) : NULL;
+            }
+            break;
+        }
+
+        case COLYSEUS_REF_TYPE_ARRAY: {
+            colyseus_array_schema_t* arr = (colyseus_array_schema_t*)entry->ref;
+            if (!arr->has_schema_child || arr->count == 0) break;
+            children = calloc(arr->count, sizeof(snap_node_t*));
+            if (!children) return -1;
+
+            for (colyseus_array_item_t* item = arr->items; item && count < arr->count; item = item->next) {
+                children[count++] = item->value
+                    ? build_ref(publisher, ((colyseus_schema_t*)item->value)->__refId) : NULL;
+            }
+            break;
+        }
+
+        case COLYSEUS_REF_TYPE_MAP: {
+            colyseus_map_schema_t* map = (colyseus_map_schema_t*)entry->ref;
+            if (!map->has_schema_child || map->count == 0) break;
+            children = calloc(map->count, sizeof(snap_node_t*));
+            if (!children) return -1;
+
+            colyseus_map_item_t* item;
+            colyseus_map_item_t* tmp;
+            HASH_ITER(hh, map->items, item, tmp) {
+                if (count >= map->count) break;
+                children[count++] = item->value
+                    ? build_ref(publisher, ((colyseus_schema_t*)item->value)->__refId) : NULL;
+            }
+            break;
+        }
+    }
+
+    *out_children = children;
+    return count;
+}
+
+static snap_node_t* build_ref(colyseus_snapshot_publisher_t* publisher, int ref_id) {
+    colyseus_ref_entry_t* entry = colyseus_ref_tracker_get_entry(publisher->decoder->refs, ref_id);
+    if (!entry || !entry->ref) return NULL;
+    if (entry->ref_type == COLYSEUS_REF_TYPE_SCHEMA &&
+        (!entry->vtable || colyseus_vtable_is_dynamic(entry->vtable))) {
+        return NULL;
+    }
+
+    snap_index_entry_t* idx = NULL;
+    HASH_FIND_INT(publisher->index, &ref_id, idx);
+    if (!idx) {
+        idx = calloc(1, sizeof(snap_index_entry_t));
+        if (!idx) return NULL;
+        idx->ref_id = ref_id;
+        HASH_ADD_INT(publisher->index, ref_id, idx);
+    } else if (idx->gen == publisher->gen) {
+        /* Shared ref already visited in this pass */
+        return idx->node;
+    }
+    idx->gen = publisher->gen;
+
+    snap_node_t** children = NULL;
+    int child_count = collect_children(publisher, entry, &children);
+    if (child_count < 0) return idx->node;
+
+    /* Structural sharing: untouched ref with identical children */
+    snap_node_t* previous = idx->node;
+    if (previous && entry->dirty_fields == 0 && previous->child_count == child_count &&
+        (child_count == 0 || memcmp(previous->children, children, child_count * sizeof(snap_node_t*)) == 0)) {
+        free(children);
+        return previous;
+    }
+
+    snap_node_t* node = node_create(entry->ref_type, children, child_count);
+    if (!node) {
+        free(children);
+        return previous;
+    }
+
+    switch (entry->ref_type) {
+        case COLYSEUS_REF_TYPE_SCHEMA:
+            node->payload = copy_schema(node, (colyseus_schema_t*)entry->ref, entry->vtable);
+            break;
+        case COLYSEUS_REF_TYPE_ARRAY:
+            node->payload = copy_array(node, (colyseus_array_schema_t*)entry->ref);
+            break;
+        case COLYSEUS_REF_TYPE_MAP:
+            node->payload = copy_map(node, (colyseus_map_schema_t*)entry->ref);
+            break;
+    }
+
+    if (!node->payload) {
+        node_release(node);
+        return previous;
+    }
+
+    idx->node = node;
+    node_release(previous);
+    return node;
+}
+
+/* ============================================================================
+ * Publisher
+ * ============================================================================ */
+
+static void snapshot_on_decode_end(colyseus_decoder_t* decoder, void* userdata) {
+    (void)decoder;
+    colyseus_snapshot_publisher_publish((colyseus_snapshot_publisher_t*)userdata);
+}
+
+colyseus_snapshot_publisher_t* colyseus_snapshot_publisher_create(colyseus_decoder_t* decoder) {
+    if (!decoder) return NULL;
+
+    colyseus_snapshot_publisher_t* publisher = calloc(1, sizeof(colyseus_snapshot_publisher_t));
+    if (!publisher) return NULL;
+
+    publisher->decoder = decoder;
+    atomic_init(&publisher->latest, NULL);
+    atomic_init(&publisher->readers[0], 0);
+    atomic_init(&publisher->readers[1], 0);
+    atomic_init(&publisher->reader_side, 0);
+
+    colyseus_decoder_add_decode_listener(decoder, snapshot_on_decode_end, publisher);
+
+    return publisher;
+}
+
+void colyseus_snapshot_publisher_free(colyseus_snapshot_publisher_t* publisher) {
+    if (!publisher) return;
+
+    colyseus_decoder_remove_decode_listener(publisher->decoder, snapshot_on_decode_end, publisher);
+
+    /* Readers holding snapshots keep their nodes alive */
+    colyseus_state_snapshot_release(atomic_load(&publisher->latest));
+
+    snap_index_entry_t* idx;
+    snap_index_entry_t* tmp;
+    HASH_ITER(hh, publisher->index, idx, tmp) {
+        HASH_DEL(publisher->index, idx);
+        node_release(idx->node);
+        free(idx);
+    }
+
+    free(publisher);
+}
+
+void colyseus_snapshot_publisher_publish(colyseus_snapshot_publisher_t* publisher) {
+    if (!publisher) return;
+
+    colyseus_state_snapshot_t* snapshot = malloc(sizeof(colyseus_state_snapshot_t));
+    if (!snapshot) return;
+
+    publisher->gen++;
+    snap_node_t* root = build_ref(publisher, 0);
+
+    /* Drop index entries for refs no longer reachable from the root */
+    snap_index_entry_t* idx;
+    snap_index_entry_t* tmp;
+    HASH_ITER(hh, publisher->index, idx, tmp) {
+        if (idx->gen != publisher->gen) {
+            HASH_DEL(publisher->index, idx);
+            node_release(idx->node);
+            free(idx);
+        }
+    }
+
+    atomic_init(&snapshot->refcount, 1);
+    snapshot->root = root;
+    snapshot->epoch = colyseus_ref_tracker_get_epoch(publisher->decoder->refs);
+    node_retain(root);
+
+    colyseus_state_snapshot_t* previous = atomic_exchange(&publisher->latest, snapshot);
+    if (!previous) return;
+
+    /* Readers may have loaded `previous` and not retained it yet. Those
+     * counted on the other side came in before an earlier flip and are
+     * about done; wait them out, flip, then drain the current side. Anyone
+     * counted in after that loads the new pointer. */
+    int side = atomic_load(&publisher->reader_side);
+    while (atomic_load(&publisher->readers[!side]) != 0) {
+        /* spin: a reader is between its load and retain */
+    }
+    atomic_store(&publisher->reader_side, !side);
+    while (atomic_load(&publisher->readers[side]) != 0) {
+        /* spin: as above */
+    }
+
+    colyseus_state_snapshot_release(previous);
+}
+
+colyseus_state_snapshot_t* colyseus_snapshot_publisher_acquire(colyseus_snapshot_publisher_t* publisher) {
+    if (!publisher) return NULL;
+
+    /* Wait-free: a fixed handful of atomics, whatever the publisher does */
+    int side = atomic_load(&publisher->reader_side);
+    atomic_fetch_add(&publisher->readers[side], 1);
+    colyseus_state_snapshot_t* snapshot = atomic_load(&publisher->latest);
+    if (snapshot) {
+        atomic_fetch_add_explicit(&snapshot->refcount, 1, memory_order_relaxed);
+    }
+    atomic_fetch_sub(&publisher->readers[side], 1);
+
+    return snapshot;
+}
+
+void colyseus_state_snapshot_release(colyseus_state_snapshot_t* snapshot) {
+    if (!snapshot) return;
+    if (atomic_fetch_sub_explicit(&snapshot->refcount, 1, memory_order_acq_rel) != 1) return;
+
+    node_release(snapshot->root);
+    free(snapshot);
+}
+
+const colyseus_schema_t* colyseus_state_snapshot_get_state(const colyseus_state_snapshot_t* snapshot) {
+    return (snapshot && snapshot->root) ? (const colyseus_schema_t*)snapshot->root->payload : NULL;
+}
+
+unsigned int colyseus_state_snapshot_get_epoch(const colyseus_state_snapshot_t* snapshot) {
+    return snapshot ? snapshot->epoch : 0;
+}
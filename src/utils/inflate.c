@@ -0,0 +1,358 @@
+#include "colyseus/utils/inflate.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Canonical Huffman decoding as in zlib's puff.c, with a FAST_BITS lookup
+ * table in front for the short codes that make up most of a stream. */
+
+#define INFLATE_MAX_BITS     15
+#define INFLATE_FAST_BITS    9
+#define INFLATE_MAX_LCODES   286
+#define INFLATE_MAX_DCODES   30
+#define INFLATE_FIXED_LCODES 288
+#define INFLATE_INITIAL_CAP  4096
+
+typedef struct {
+    uint16_t count[INFLATE_MAX_BITS + 1];     /* codes per length */
+    uint16_t symbol[INFLATE_FIXED_LCODES];    /* symbols in canonical order */
+    uint16_t fast[1 << INFLATE_FAST_BITS];    /* (length << 9) | symbol, 0: slow path */
+} inflate_huffman_t;
+
+struct colyseus_inflate {
+    uint8_t* buf;          /* history, then the message being inflated */
+    size_t cap;
+    size_t history;
+    size_t len;
+    size_t window;
+    size_t max_output;
+    bool context_takeover;
+
+    inflate_huffman_t fixed_lit;
+    inflate_huffman_t fixed_dist;
+    inflate_huffman_t lit;
+    inflate_huffman_t dist;
+};
+
+/* Input bits, LSB first. The 00 00 ff ff tail the sender stripped is
+ * read as if it were still there. */
+typedef struct {
+    const uint8_t* in;
+    size_t in_len;
+    size_t total;          /* in_len + tail */
+    size_t pos;            /* next byte to load */
+    uint64_t bits;
+    unsigned count;
+} inflate_bits_t;
+
+static const uint8_t inflate_tail[4] = { 0x00, 0x00, 0xff, 0xff };
+
+static const uint16_t inflate_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t inflate_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t inflate_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577 };
+static const uint8_t inflate_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+static inline uint8_t inflate_byte_at(const inflate_bits_t* s, size_t i) {
+    if (i < s->in_len) return s->in[i];
+    if (i < s->total) return inflate_tail[i - s->in_len];
+    return 0;  /* past the end: caught by inflate_overrun() */
+}
+
+static inline void inflate_refill(inflate_bits_t* s) {
+    while (s->count <= 56) {
+        s->bits |= (uint64_t)inflate_byte_at(s, s->pos) << s->count;
+        s->pos++;
+        s->count += 8;
+    }
+}
+
+static inline uint32_t inflate_bits(inflate_bits_t* s, unsigned n) {
+    if (s->count < n) inflate_refill(s);
+    uint32_t v = (uint32_t)(s->bits & ((1ull << n) - 1));
+    s->bits >>= n;
+    s->count -= n;
+    return v;
+}
+
+/* More bits consumed than the input holds */
+static inline bool inflate_overrun(const inflate_bits_t* s) {
+    return s->pos * 8 - s->count > s->total * 8;
+}
+
+static unsigned inflate_reverse(unsigned code, unsigned length) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < length; i++) {
+        r = (r << 1) | (code & 1);
+        code >>= 1;
+    }
+    return r;
+}
+
+/* Returns 0 for a complete code, > 0 if incomplete, < 0 if over-subscribed. */
+static int inflate_build(inflate_huffman_t* h, const uint8_t* lengths, int n) {
+    uint16_t offs[INFLATE_MAX_BITS + 1];
+
+    memset(h->count, 0, sizeof(h->count));
+    memset(h->fast, 0, sizeof(h->fast));
+    for (int i = 0; i < n; i++) h->count[lengths[i]]++;
+    if (h->count[0] == n) return 0;  /* no codes: complete, but decoding fails */
+
+    int left = 1;
+    for (int len = 1; len <= INFLATE_MAX_BITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if (left < 0) return left;
+    }
+
+    offs[1] = 0;
+    for (int len = 1; len < INFLATE_MAX_BITS; len++) offs[len + 1] = (uint16_t)(offs[len] + h->count[len]);
+    for (int i = 0; i < n; i++) {
+        if (lengths[i] != 0) h->symbol[offs[lengths[i]]++] = (uint16_t)i;
+    }
+
+    unsigned code = 0;
+    int index = 0;
+    for (unsigned len = 1; len <= INFLATE_FAST_BITS; len++) {
+        for (unsigned k = 0; k < h->count[len]; k++) {
+            uint16_t entry = (uint16_t)((len << 9) | h->symbol[index + k]);
+            for (unsigned fill = inflate_reverse(code + k, len); fill < (1u << INFLATE_FAST_BITS); fill += 1u << len) {
+                h->fast[fill] = entry;
+            }
+        }
+        index += h->count[len];
+        code = (code + h->count[len]) << 1;
+    }
+    return left;
+}
+
+/* Incomplete codes are only valid as a single one-bit code */
+static bool inflate_build_checked(inflate_huffman_t* h, const uint8_t* lengths, int n) {
+    int err = inflate_build(h, lengths, n);
+    return err == 0 || (err > 0 && n == h->count[0] + h->count[1]);
+}
+
+static int inflate_decode(inflate_bits_t* s, const inflate_huffman_t* h) {
+    if (s->count < INFLATE_MAX_BITS) inflate_refill(s);
+
+    uint16_t entry = h->fast[s->bits & ((1u << INFLATE_FAST_BITS) - 1)];
+    if (entry) {
+        unsigned len = entry >> 9;
+        s->bits >>= len;
+        s->count -= len;
+        return entry & 0x1FF;
+    }
+
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len <= INFLATE_MAX_BITS; len++) {
+        code |= (int)((s->bits >> (len - 1)) & 1);
+        int count = h->count[len];
+        if (code - count < first) {
+            s->bits >>= len;
+            s->count -= (unsigned)len;
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+static int inflate_reserve(colyseus_inflate_t* inf, size_t extra) {
+    size_t needed = inf->len + extra;
+    if (needed - inf->history > inf->max_output) return COLYSEUS_INFLATE_TOO_BIG;
+    if (needed <= inf->cap) return COLYSEUS_INFLATE_OK;
+
+    size_t limit = inf->history + inf->max_output;
+    size_t cap = inf->cap ? inf->cap : INFLATE_INITIAL_CAP;
+    while (cap < needed) cap *= 2;
+    if (cap > limit) cap = limit;
+    uint8_t* buf = realloc(inf->buf, cap);
+    if (!buf) return COLYSEUS_INFLATE_NO_MEMORY;
+    inf->buf = buf;
+    inf->cap = cap;
+    return COLYSEUS_INFLATE_OK;
+}
+
+static int inflate_stored(colyseus_inflate_t* inf, inflate_bits_t* s) {
+    /* Skip to the byte boundary, then hand back the whole buffered bytes */
+    s->count -= s->count & 7;
+    s->pos -= s->count / 8;
+    s->bits = 0;
+    s->count = 0;
+
+    if (s->pos + 4 > s->total) return COLYSEUS_INFLATE_DATA_ERROR;
+    unsigned len = inflate_byte_at(s, s->pos) | ((unsigned)inflate_byte_at(s, s->pos + 1) << 8);
+    unsigned nlen = inflate_byte_at(s, s->pos + 2) | ((unsigned)inflate_byte_at(s, s->pos + 3) << 8);
+    s->pos += 4;
+    if (len != (~nlen & 0xFFFF) || s->pos + len > s->total) return COLYSEUS_INFLATE_DATA_ERROR;
+
+    int rc = inflate_reserve(inf, len);
+    if (rc != COLYSEUS_INFLATE_OK) return rc;
+    size_t from_input = s->pos < s->in_len ? s->in_len - s->pos : 0;
+    if (from_input > len) from_input = len;
+    memcpy(inf->buf + inf->len, s->in + s->pos, from_input);
+    for (size_t i = from_input; i < len; i++) inf->buf[inf->len + i] = inflate_byte_at(s, s->pos + i);
+    inf->len += len;
+    s->pos += len;
+    return COLYSEUS_INFLATE_OK;
+}
+
+static int inflate_codes(colyseus_inflate_t* inf, inflate_bits_t* s,
+                         const inflate_huffman_t* lit, const inflate_huffman_t* dist) {
+    for (;;) {
+        int sym = inflate_decode(s, lit);
+        if (sym < 0 || inflate_overrun(s)) return COLYSEUS_INFLATE_DATA_ERROR;
+
+        if (sym < 256) {
+            if (inf->len == inf->cap || inf->len - inf->history == inf->max_output) {
+                int rc = inflate_reserve(inf, 1);
+                if (rc != COLYSEUS_INFLATE_OK) return rc;
+            }
+            inf->buf[inf->len++] = (uint8_t)sym;
+            continue;
+        }
+        if (sym == 256) return COLYSEUS_INFLATE_OK;
+
+        sym -= 257;
+        if (sym >= 29) return COLYSEUS_INFLATE_DATA_ERROR;
+        size_t length = inflate_len_base[sym] + inflate_bits(s, inflate_len_extra[sym]);
+
+        int dsym = inflate_decode(s, dist);
+        if (dsym < 0 || dsym >= 30) return COLYSEUS_INFLATE_DATA_ERROR;
+        size_t distance = inflate_dist_base[dsym] + inflate_bits(s, inflate_dist_extra[dsym]);
+        if (distance > inf->len) return COLYSEUS_INFLATE_DATA_ERROR;
+
+        int rc = inflate_reserve(inf, length);
+        if (rc != COLYSEUS_INFLATE_OK) return rc;
+        uint8_t* dst = inf->buf + inf->len;
+        const uint8_t* src = dst - distance;
+        if (distance >= length) {
+            memcpy(dst, src, length);
+        } else {
+            for (size_t i = 0; i < length; i++) dst[i] = src[i];
+        }
+        inf->len += length;
+    }
+}
+
+static int inflate_dynamic(colyseus_inflate_t* inf, inflate_bits_t* s) {
+    static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    uint8_t lengths[INFLATE_MAX_LCODES + INFLATE_MAX_DCODES];
+    inflate_huffman_t lencode;
+
+    int nlen = (int)inflate_bits(s, 5) + 257;
+    int ndist = (int)inflate_bits(s, 5) + 1;
+    int ncode = (int)inflate_bits(s, 4) + 4;
+    if (nlen > INFLATE_MAX_LCODES || ndist > INFLATE_MAX_DCODES) return COLYSEUS_INFLATE_DATA_ERROR;
+
+    memset(lengths, 0, 19);
+    for (int i = 0; i < ncode; i++) lengths[order[i]] = (uint8_t)inflate_bits(s, 3);
+    if (inflate_build(&lencode, lengths, 19) != 0) return COLYSEUS_INFLATE_DATA_ERROR;
+
+    int index = 0;
+    while (index < nlen + ndist) {
+        int sym = inflate_decode(s, &lencode);
+        if (sym < 0 || inflate_overrun(s)) return COLYSEUS_INFLATE_DATA_ERROR;
+        if (sym < 16) {
+            lengths[index++] = (uint8_t)sym;
+            continue;
+        }
+        uint8_t len = 0;
+        int repeat;
+        if (sym == 16) {
+            if (index == 0) return COLYSEUS_INFLATE_DATA_ERROR;
+            len = lengths[index - 1];
+            repeat = 3 + (int)inflate_bits(s, 2);
+        } else if (sym == 17) {
+            repeat = 3 + (int)inflate_bits(s, 3);
+        } else {
+            repeat = 11 + (int)inflate_bits(s, 7);
+        }
+        if (index + repeat > nlen + ndist) return COLYSEUS_INFLATE_DATA_ERROR;
+        while (repeat--) lengths[index++] = len;
+    }
+
+    if (lengths[256] == 0) return COLYSEUS_INFLATE_DATA_ERROR;  /* no end-of-block code */
+    if (!inflate_build_checked(&inf->lit, lengths, nlen) ||
+        !inflate_build_checked(&inf->dist, lengths + nlen, ndist)) {
+        return COLYSEUS_INFLATE_DATA_ERROR;
+    }
+    return inflate_codes(inf, s, &inf->lit, &inf->dist);
+}
+
+colyseus_inflate_t* colyseus_inflate_create(int window_bits, bool context_takeover, size_t max_output) {
+    if (window_bits < 8 || window_bits > 15) return NULL;
+    colyseus_inflate_t* inf = calloc(1, sizeof(colyseus_inflate_t));
+    if (!inf) return NULL;
+    inf->window = (size_t)1 << window_bits;
+    inf->max_output = max_output;
+    inf->context_takeover = context_takeover;
+
+    uint8_t lengths[INFLATE_FIXED_LCODES];
+    int i = 0;
+    for (; i < 144; i++) lengths[i] = 8;
+    for (; i < 256; i++) lengths[i] = 9;
+    for (; i < 280; i++) lengths[i] = 7;
+    for (; i < INFLATE_FIXED_LCODES; i++) lengths[i] = 8;
+    inflate_build(&inf->fixed_lit, lengths, INFLATE_FIXED_LCODES);
+    for (i = 0; i < INFLATE_MAX_DCODES; i++) lengths[i] = 5;
+    inflate_build(&inf->fixed_dist, lengths, INFLATE_MAX_DCODES);
+    return inf;
+}
+
+void colyseus_inflate_free(colyseus_inflate_t* inflater) {
+    if (!inflater) return;
+    free(inflater->buf);
+    free(inflater);
+}
+
+int colyseus_inflate_message(colyseus_inflate_t* inf, const uint8_t* in, size_t in_len,
+                             const uint8_t** out, size_t* out_len) {
+    /* The previous output becomes history, trimmed to the window */
+    size_t keep = 0;
+    if (inf->context_takeover) keep = inf->len < inf->window ? inf->len : inf->window;
+    if (keep > 0 && inf->len > keep) memmove(inf->buf, inf->buf + inf->len - keep, keep);
+    inf->history = keep;
+    inf->len = keep;
+
+    int rc = COLYSEUS_INFLATE_OK;
+    if (in_len > 0) {
+        inflate_bits_t s = { in, in_len, in_len + sizeof(inflate_tail), 0, 0, 0 };
+        for (;;) {
+            unsigned last = inflate_bits(&s, 1);
+            unsigned type = inflate_bits(&s, 2);
+            if (type == 0) {
+                rc = inflate_stored(inf, &s);
+            } else if (type == 1) {
+                rc = inflate_codes(inf, &s, &inf->fixed_lit, &inf->fixed_dist);
+            } else if (type == 2) {
+                rc = inflate_dynamic(inf, &s);
+            } else {
+                rc = COLYSEUS_INFLATE_DATA_ERROR;
+            }
+            if (rc == COLYSEUS_INFLATE_OK && inflate_overrun(&s)) rc = COLYSEUS_INFLATE_DATA_ERROR;
+            if (rc != COLYSEUS_INFLATE_OK || last) break;
+            /* The tail is an empty stored block ending exactly at the end */
+            if (s.pos * 8 - s.count >= s.total * 8) break;
+        }
+    }
+
+    if (rc != COLYSEUS_INFLATE_OK) {
+        inf->history = 0;
+        inf->len = 0;
+        return rc;
+    }
+    *out = inf->buf + inf->history;
+    *out_len = inf->len - inf->history;
+    return COLYSEUS_INFLATE_OK;
+}
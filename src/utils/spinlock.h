@@ -0,0 +1,43 @@
+#ifndef COLYSEUS_SPINLOCK_H
+#define COLYSEUS_SPINLOCK_H
+
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Spin lock (internal)
+ *
+ * Guards the hand-off lists and buffers between producers on any thread
+ * and a single consumer (send queues, poll queues, wake lists). It is held
+ * only for a pointer push/take or a short copy, never across a callback or
+ * I/O, so a contended thread spins for a few hundred cycles at most where a
+ * mutex would put it to sleep and wake it again. Anything held longer
+ * (timer wheel, resolver and TLS caches) uses the platform mutex instead.
+ *
+ * Call colyseus_spinlock_init() before first use; there is nothing to
+ * destroy.
+ */
+
+typedef atomic_flag colyseus_spinlock_t;
+
+static inline void colyseus_spinlock_init(colyseus_spinlock_t* lock) {
+    atomic_flag_clear(lock);
+}
+
+static inline void colyseus_spinlock_lock(colyseus_spinlock_t* lock) {
+    while (atomic_flag_test_and_set_explicit(lock, memory_order_acquire)) {
+    }
+}
+
+static inline void colyseus_spinlock_unlock(colyseus_spinlock_t* lock) {
+    atomic_flag_clear_explicit(lock, memory_order_release);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_SPINLOCK_H */
@@ -29,3 +29,29 @@ uint64_t colyseus_monotonic_ms(void) {
     return (uint64_t)ts.tv_sec * 1000ULL + (uint64_t)ts.tv_nsec / 1000000ULL;
 #endif
 }
+
+uint64_t colyseus_monotonic_us(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq = {0};
+    if (freq.QuadPart == 0) {
+        QueryPerformanceFrequency(&freq);
+    }
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return (uint64_t)(t.QuadPart / freq.QuadPart) * 1000000ULL +
+           (uint64_t)(t.QuadPart % freq.QuadPart) * 1000000ULL / (uint64_t)freq.QuadPart;
+#elif defined(__EMSCRIPTEN__)
+    return (uint64_t)(emscripten_get_now() * 1000.0);
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t tb = {0};
+    if (tb.denom == 0) {
+        mach_timebase_info(&tb);
+    }
+    uint64_t t = mach_absolute_time();
+    return (t * tb.numer / tb.denom) / 1000ULL;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+#endif
+}
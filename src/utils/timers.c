@@ -0,0 +1,489 @@
+#include "timers.h"
+#include "colyseus/utils/time.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    typedef SRWLOCK timer_lock_t;
+    typedef CONDITION_VARIABLE timer_cond_t;
+    #define TIMER_LOCK_INITIALIZER SRWLOCK_INIT
+    #define TIMER_COND_INITIALIZER CONDITION_VARIABLE_INIT
+    static void timer_lock(timer_lock_t* lock) { AcquireSRWLockExclusive(lock); }
+    static void timer_unlock(timer_lock_t* lock) { ReleaseSRWLockExclusive(lock); }
+    static void timer_signal(timer_cond_t* cond) { WakeAllConditionVariable(cond); }
+#else
+    #include <pthread.h>
+    #include <sys/time.h>
+    #include <time.h>
+    typedef pthread_mutex_t timer_lock_t;
+    typedef pthread_cond_t timer_cond_t;
+    #define TIMER_LOCK_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+    #define TIMER_COND_INITIALIZER PTHREAD_COND_INITIALIZER
+    static void timer_lock(timer_lock_t* lock) { pthread_mutex_lock(lock); }
+    static void timer_unlock(timer_lock_t* lock) { pthread_mutex_unlock(lock); }
+    static void timer_signal(timer_cond_t* cond) { pthread_cond_broadcast(cond); }
+#endif
+
+#define TIMER_LEVELS   4
+#define TIMER_BITS     6
+#define TIMER_SLOTS    (1 << TIMER_BITS)
+#define TIMER_MASK     (TIMER_SLOTS - 1)
+/* Farthest a timer can be placed; longer delays are re-placed on the way */
+#define TIMER_SPAN     ((1ULL << (TIMER_LEVELS * TIMER_BITS)) - 1)
+#define TIMER_IDLE_MS  10000  /* the thread exits after this long with nothing armed */
+#define TIMER_MAX_WORKERS 4   /* threads running blocking callbacks at once */
+
+struct colyseus_timer {
+    colyseus_timer_fn fn;
+    void* userdata;
+    uint64_t expires;              /* tick */
+    struct colyseus_timer* prev;   /* slot list */
+    struct colyseus_timer* next;
+    uint8_t level;
+    uint8_t slot;
+    bool pending;
+    bool running;
+    bool free_after_run;           /* freed from its own callback */
+    bool blocking;                 /* runs on a worker, not the wheel thread */
+    bool queued;                   /* due, waiting for a worker */
+    struct colyseus_timer* run_next;
+#ifdef _WIN32
+    DWORD runner;                  /* thread running the callback */
+#else
+    pthread_t runner;
+#endif
+};
+
+static timer_lock_t g_lock = TIMER_LOCK_INITIALIZER;
+static timer_cond_t g_wake = TIMER_COND_INITIALIZER;     /* timer thread: wheel changed */
+static timer_cond_t g_ran = TIMER_COND_INITIALIZER;      /* colyseus_timer_free(): callback returned */
+static timer_cond_t g_work = TIMER_COND_INITIALIZER;     /* workers: a blocking timer is due */
+static colyseus_timer_t* g_slots[TIMER_LEVELS][TIMER_SLOTS];
+static uint64_t g_occupied[TIMER_LEVELS];                /* bit per non-empty slot */
+static uint64_t g_tick = 0;                              /* last tick processed */
+static uint64_t g_epoch_ms = 0;                          /* monotonic ms at tick 0 */
+static size_t g_pending = 0;
+static bool g_thread_alive = false;
+static bool g_in_wait = false;                           /* sleeping on g_wake */
+static colyseus_timer_t* g_run_head = NULL;              /* due blocking timers */
+static colyseus_timer_t* g_run_tail = NULL;
+static size_t g_run_count = 0;
+static int g_workers = 0;
+static int g_workers_idle = 0;
+#ifdef _WIN32
+static DWORD g_thread_id = 0;
+#else
+static pthread_t g_thread;
+#endif
+
+/* ── Wheel (caller holds g_lock) ── */
+
+static uint64_t timer_now_tick(void) {
+    return colyseus_monotonic_ms() - g_epoch_ms;
+}
+
+static void timer_link(colyseus_timer_t* t) {
+    uint64_t delta = t->expires > g_tick ? t->expires - g_tick : 0;
+    uint64_t expires = t->expires;
+    if (delta > TIMER_SPAN) {
+        expires = g_tick + TIMER_SPAN;  /* cascades back down and gets re-placed */
+        delta = TIMER_SPAN;
+    }
+
+    int level = 0;
+    while (level < TIMER_LEVELS - 1 && (delta >> (TIMER_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    int slot = (int)((expires >> (TIMER_BITS * level)) & TIMER_MASK);
+
+    t->level = (uint8_t)level;
+    t->slot = (uint8_t)slot;
+    t->prev = NULL;
+    t->next = g_slots[level][slot];
+    if (t->next) t->next->prev = t;
+    g_slots[level][slot] = t;
+    g_occupied[level] |= 1ULL << slot;
+}
+
+static void timer_unlink(colyseus_timer_t* t) {
+    if (t->prev) {
+        t->prev->next = t->next;
+    } else {
+        g_slots[t->level][t->slot] = t->next;
+        if (!t->next) g_occupied[t->level] &= ~(1ULL << t->slot);
+    }
+    if (t->next) t->next->prev = t->prev;
+    t->prev = t->next = NULL;
+}
+
+/* Re-place the timers of the level-`level` slot reached at g_tick */
+static void timer_cascade(int level) {
+    int slot = (int)((g_tick >> (TIMER_BITS * level)) & TIMER_MASK);
+    if (slot == 0 && level + 1 < TIMER_LEVELS) {
+        timer_cascade(level + 1);
+    }
+    colyseus_timer_t* list = g_slots[level][slot];
+    g_slots[level][slot] = NULL;
+    g_occupied[level] &= ~(1ULL << slot);
+    while (list) {
+        colyseus_timer_t* next = list->next;
+        timer_link(list);
+        list = next;
+    }
+}
+
+static int timer_first_bit(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+/* Ticks until the next slot is due (to run or to cascade); 0 if none */
+static uint64_t timer_next_due(void) {
+    uint64_t best = 0;
+    for (int level = 0; level < TIMER_LEVELS; level++) {
+        if (!g_occupied[level]) continue;
+        int shift = TIMER_BITS * level;
+        int current = (int)((g_tick >> shift) & TIMER_MASK);
+        /* The slots after the current one, in order; the current slot
+         * itself comes around last */
+        int rot = (current + 1) & TIMER_MASK;
+        uint64_t bits = g_occupied[level];
+        uint64_t rotated = rot ? ((bits >> rot) | (bits << (TIMER_SLOTS - rot))) : bits;
+        uint64_t ahead = (uint64_t)timer_first_bit(rotated) + 1;
+        uint64_t due = (((g_tick >> shift) + ahead) << shift) - g_tick;
+        if (best == 0 || due < best) best = due;
+    }
+    return best;
+}
+
+/* ── Thread ── */
+
+static void timer_wait(timer_cond_t* cond, int64_t timeout_ms) {
+#ifdef _WIN32
+    SleepConditionVariableSRW(cond, &g_lock, timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms, 0);
+#else
+    if (timeout_ms < 0) {
+        pthread_cond_wait(cond, &g_lock);
+        return;
+    }
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    uint64_t total_ns = (uint64_t)tv.tv_sec * 1000000000ULL
+                      + (uint64_t)tv.tv_usec * 1000ULL
+                      + (uint64_t)timeout_ms * 1000000ULL;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(total_ns / 1000000000ULL);
+    ts.tv_nsec = (long)(total_ns % 1000000000ULL);
+    pthread_cond_timedwait(cond, &g_lock, &ts);
+#endif
+}
+
+static bool timer_is_runner(const colyseus_timer_t* t) {
+#ifdef _WIN32
+    return t->running && t->runner == GetCurrentThreadId();
+#else
+    return t->running && pthread_equal(t->runner, pthread_self());
+#endif
+}
+
+static void timer_unqueue(colyseus_timer_t* t) {
+    colyseus_timer_t** link = &g_run_head;
+    colyseus_timer_t* prev = NULL;
+    while (*link && *link != t) {
+        prev = *link;
+        link = &(*link)->run_next;
+    }
+    if (*link) {
+        *link = t->run_next;
+        if (g_run_tail == t) g_run_tail = prev;
+        g_run_count--;
+    }
+    t->run_next = NULL;
+    t->queued = false;
+}
+
+/* Call the callback without the lock. The timer may be re-armed or freed
+ * (by its own callback) meanwhile. */
+static void timer_invoke(colyseus_timer_t* t) {
+    t->running = true;
+#ifdef _WIN32
+    t->runner = GetCurrentThreadId();
+#else
+    t->runner = pthread_self();
+#endif
+    timer_unlock(&g_lock);
+    t->fn(t->userdata);
+    timer_lock(&g_lock);
+    t->running = false;
+    if (t->free_after_run) {
+        if (t->pending) {
+            timer_unlink(t);
+            g_pending--;
+        }
+        if (t->queued) timer_unqueue(t);
+        free(t);
+    } else {
+        timer_signal(&g_ran);
+    }
+}
+
+static void timer_run(colyseus_timer_t* t) {
+    t->pending = false;
+    g_pending--;
+    timer_invoke(t);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI timer_worker_func(void* arg) {
+#else
+static void* timer_worker_func(void* arg) {
+#endif
+    (void)arg;
+    timer_lock(&g_lock);
+    for (;;) {
+        colyseus_timer_t* t = g_run_head;
+        if (!t) {
+            g_workers_idle++;
+            timer_wait(&g_work, TIMER_IDLE_MS);
+            g_workers_idle--;
+            if (!g_run_head) break;
+            continue;
+        }
+        timer_unqueue(t);
+        timer_invoke(t);
+    }
+    g_workers--;
+    timer_unlock(&g_lock);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static bool timer_start_worker(void) {
+#ifdef _WIN32
+    HANDLE thread = CreateThread(NULL, 0, timer_worker_func, NULL, 0, NULL);
+    if (!thread) return false;
+    CloseHandle(thread);
+#else
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, timer_worker_func, NULL) != 0) return false;
+    pthread_detach(thread);
+#endif
+    g_workers++;
+    return true;
+}
+
+/* Wheel thread: hand a due blocking timer to a worker, starting one if
+ * none is free. Without any worker it runs here after all. */
+static void timer_dispatch(colyseus_timer_t* t) {
+    t->pending = false;
+    g_pending--;
+    t->queued = true;
+    t->run_next = NULL;
+    if (g_run_tail) g_run_tail->run_next = t;
+    else g_run_head = t;
+    g_run_tail = t;
+    g_run_count++;
+
+    if (g_workers_idle > 0) timer_signal(&g_work);
+    if (g_run_count > (size_t)g_workers_idle && g_workers < TIMER_MAX_WORKERS) {
+        timer_start_worker();
+    }
+    if (g_workers == 0) {
+        timer_unqueue(t);
+        timer_invoke(t);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI timer_thread_func(void* arg) {
+#else
+static void* timer_thread_func(void* arg) {
+#endif
+    (void)arg;
+    timer_lock(&g_lock);
+    uint64_t idle_since = colyseus_monotonic_ms();
+
+    for (;;) {
+        /* Jump from one due slot to the next: the ticks in between have
+         * nothing to run or cascade */
+        uint64_t now = timer_now_tick();
+        while (g_tick < now) {
+            uint64_t due = g_pending ? timer_next_due() : 0;
+            if (due == 0 || g_tick + due > now) {
+                g_tick = now;
+                break;
+            }
+            g_tick += due;
+            int slot = (int)(g_tick & TIMER_MASK);
+            if (slot == 0) timer_cascade(1);
+
+            /* Run the slot's timers one by one: the lock is dropped while
+             * a callback runs and the list may change meanwhile */
+            colyseus_timer_t* t;
+            while ((t = g_slots[0][slot]) != NULL) {
+                timer_unlink(t);
+                if (t->expires > g_tick) {
+                    timer_link(t);  /* capped placement, not due yet */
+                    if (g_slots[0][slot] == t) break;
+                    continue;
+                }
+                if (t->blocking) {
+                    timer_dispatch(t);
+                } else {
+                    timer_run(t);
+                }
+            }
+        }
+
+        int64_t timeout;
+        if (g_pending > 0) {
+            idle_since = 0;
+            uint64_t due = timer_next_due();
+            uint64_t target = g_tick + due;
+            now = timer_now_tick();
+            timeout = target > now ? (int64_t)(target - now) : 0;
+            if (timeout == 0) continue;
+        } else {
+            uint64_t ms = colyseus_monotonic_ms();
+            if (idle_since == 0) idle_since = ms;
+            if (ms - idle_since >= TIMER_IDLE_MS) break;
+            timeout = (int64_t)(TIMER_IDLE_MS - (ms - idle_since));
+        }
+
+        g_in_wait = true;
+        timer_wait(&g_wake, timeout);
+        g_in_wait = false;
+    }
+
+    g_thread_alive = false;
+    timer_unlock(&g_lock);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+static bool timer_start_thread(void) {
+    if (g_thread_alive) return true;
+    if (g_epoch_ms == 0) {
+        g_epoch_ms = colyseus_monotonic_ms();
+        g_tick = 0;
+    } else {
+        g_tick = timer_now_tick();
+    }
+#ifdef _WIN32
+    HANDLE thread = CreateThread(NULL, 0, timer_thread_func, NULL, 0, &g_thread_id);
+    if (!thread) return false;
+    CloseHandle(thread);
+#else
+    if (pthread_create(&g_thread, NULL, timer_thread_func, NULL) != 0) return false;
+    pthread_detach(g_thread);
+#endif
+    g_thread_alive = true;
+    return true;
+}
+
+/* ── API ── */
+
+colyseus_timer_t* colyseus_timer_create(colyseus_timer_fn fn, void* userdata) {
+    colyseus_timer_t* t = calloc(1, sizeof(colyseus_timer_t));
+    if (!t) return NULL;
+    t->fn = fn;
+    t->userdata = userdata;
+    return t;
+}
+
+colyseus_timer_t* colyseus_timer_create_blocking(colyseus_timer_fn fn, void* userdata) {
+    colyseus_timer_t* t = colyseus_timer_create(fn, userdata);
+    if (t) t->blocking = true;
+    return t;
+}
+
+void colyseus_timer_free(colyseus_timer_t* timer) {
+    if (!timer) return;
+    timer_lock(&g_lock);
+    if (timer->pending) {
+        timer_unlink(timer);
+        timer->pending = false;
+        g_pending--;
+    }
+    if (timer->queued) timer_unqueue(timer);
+    if (timer->running) {
+        if (timer_is_runner(timer)) {
+            timer->free_after_run = true;
+            timer_unlock(&g_lock);
+            return;
+        }
+        while (timer->running) {
+            timer_wait(&g_ran, -1);
+        }
+    }
+    timer_unlock(&g_lock);
+    free(timer);
+}
+
+bool colyseus_timer_arm(colyseus_timer_t* timer, uint32_t delay_ms) {
+    if (!timer) return false;
+    timer_lock(&g_lock);
+    if (!timer_start_thread()) {
+        timer_unlock(&g_lock);
+        return false;
+    }
+    if (timer->queued) timer_unqueue(timer);
+    if (timer->pending) {
+        timer_unlink(timer);
+    } else {
+        timer->pending = true;
+        g_pending++;
+    }
+    /* The thread may be behind the clock; count from now, not g_tick */
+    uint64_t now = timer_now_tick();
+    timer->expires = (now > g_tick ? now : g_tick) + (delay_ms ? delay_ms : 1);
+    timer_link(timer);
+    if (g_in_wait) timer_signal(&g_wake);
+    timer_unlock(&g_lock);
+    return true;
+}
+
+bool colyseus_timer_cancel(colyseus_timer_t* timer) {
+    if (!timer) return false;
+    timer_lock(&g_lock);
+    bool was_pending = timer->pending || timer->queued;
+    if (timer->pending) {
+        timer_unlink(timer);
+        timer->pending = false;
+        g_pending--;
+    }
+    if (timer->queued) timer_unqueue(timer);
+    timer_unlock(&g_lock);
+    return was_pending;
+}
+
+uint32_t colyseus_timer_jitter(uint32_t bound) {
+    static atomic_uint_fast64_t state = 0;
+    if (bound == 0) return 0;
+
+    /* splitmix64 over a shared counter, seeded from the clock once */
+    uint64_t seed = atomic_load(&state);
+    if (seed == 0) {
+        uint64_t expected = 0;
+        uint64_t init = colyseus_monotonic_ms() ^ (uint64_t)(uintptr_t)&state;
+        atomic_compare_exchange_strong(&state, &expected, init | 1);
+    }
+    uint64_t z = atomic_fetch_add(&state, 0x9E3779B97F4A7C15ULL) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return (uint32_t)(z % bound);
+}
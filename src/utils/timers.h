@@ -0,0 +1,57 @@
+#ifndef COLYSEUS_TIMERS_H
+#define COLYSEUS_TIMERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Shared timers (internal, native only)
+ *
+ * One hierarchical timer wheel (4 levels of 64 slots, 1 ms ticks) serves
+ * every timer in the process from a single thread, so a thousand rooms
+ * waiting out a reconnection backoff cost one sleeping thread instead of
+ * a thousand. Arming and cancelling are O(1); the thread only wakes when
+ * a slot is due. It starts with the first armed timer and exits after
+ * idling a while.
+ *
+ * Callbacks run on the timer thread, one at a time, without the wheel's
+ * lock: keep them short and don't block. They may re-arm or free their
+ * own timer. Work that may block (tearing down a connection, calling user
+ * callbacks) goes on a blocking timer: the wheel hands it to a worker
+ * thread (up to 4 at once, started on demand) so other timers stay on
+ * time.
+ */
+
+typedef struct colyseus_timer colyseus_timer_t;
+typedef void (*colyseus_timer_fn)(void* userdata);
+
+/* NULL on allocation failure. Not armed. */
+colyseus_timer_t* colyseus_timer_create(colyseus_timer_fn fn, void* userdata);
+
+/* Like colyseus_timer_create(), but the callback runs on a worker thread
+ * and may block */
+colyseus_timer_t* colyseus_timer_create_blocking(colyseus_timer_fn fn, void* userdata);
+
+/* Cancel, wait for a running callback (unless called from it), free */
+void colyseus_timer_free(colyseus_timer_t* timer);
+
+/* Fire once after `delay_ms` (0 = on the next tick). Re-arming a pending
+ * timer moves it. Returns false if the timer thread couldn't start. */
+bool colyseus_timer_arm(colyseus_timer_t* timer, uint32_t delay_ms);
+
+/* Disarm. Returns true if it was pending; a callback already running is
+ * not waited for. */
+bool colyseus_timer_cancel(colyseus_timer_t* timer);
+
+/* Uniform in [0, bound), for spreading out retries. Any thread. */
+uint32_t colyseus_timer_jitter(uint32_t bound);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COLYSEUS_TIMERS_H */
@@ -39,3 +39,132 @@ test "http: request to offline service" {
 
     try testing.expectEqual(@as(c_int, 1), error_called);
 }
+
+// The pool's only worker parks in `gate` inside the first request's
+// callback, so everything queued after it waits until the test opens it.
+var gate_started = std.Thread.ResetEvent{};
+var gate = std.Thread.ResetEvent{};
+
+fn onGateSuccess(_: [*c]const c.colyseus_http_response_t, _: ?*anyopaque) callconv(.c) void {
+    gate_started.set();
+    gate.wait();
+}
+
+fn onGateError(_: [*c]const c.colyseus_http_error_t, _: ?*anyopaque) callconv(.c) void {
+    gate_started.set();
+    gate.wait();
+}
+
+fn createGatedClient(settings: ?*c.colyseus_settings_t) !?*c.colyseus_client_t {
+    c.colyseus_settings_set_address(settings, "localhost");
+    c.colyseus_settings_set_port(settings, "9999"); // Non-existent port
+
+    const client = c.colyseus_client_create(settings);
+    c.colyseus_client_set_http_concurrency(client, 1);
+
+    gate_started.reset();
+    gate.reset();
+    const id = c.colyseus_client_http_request(client, c.COLYSEUS_HTTP_GET, "/gate", null, c.COLYSEUS_HTTP_PRIORITY_HIGH, 0, onGateSuccess, onGateError, null);
+    try testing.expect(id != 0);
+    try gate_started.timedWait(5 * std.time.ns_per_s);
+    return client;
+}
+
+var order: [8]usize = undefined;
+var order_len = std.atomic.Value(usize).init(0);
+var order_done = std.Thread.ResetEvent{};
+var order_expected: usize = 0;
+
+fn recordOrder(userdata: ?*anyopaque) void {
+    const n = order_len.fetchAdd(1, .seq_cst);
+    order[n] = @intFromPtr(userdata);
+    if (n + 1 == order_expected) order_done.set();
+}
+
+fn onOrderedSuccess(_: [*c]const c.colyseus_http_response_t, userdata: ?*anyopaque) callconv(.c) void {
+    recordOrder(userdata);
+}
+
+fn onOrderedError(_: [*c]const c.colyseus_http_error_t, userdata: ?*anyopaque) callconv(.c) void {
+    recordOrder(userdata);
+}
+
+fn queueOrdered(client: ?*c.colyseus_client_t, priority: c.colyseus_http_priority_t, tag: usize) !u64 {
+    const id = c.colyseus_client_http_request(client, c.COLYSEUS_HTTP_GET, "/test", null, priority, 0, onOrderedSuccess, onOrderedError, @ptrFromInt(tag));
+    try testing.expect(id != 0);
+    return id;
+}
+
+test "http: queued requests run by priority, FIFO within one" {
+    const settings = c.colyseus_settings_create();
+    defer c.colyseus_settings_free(settings);
+    const client = try createGatedClient(settings);
+    defer c.colyseus_client_free(client);
+    defer gate.set(); // before the free, which waits for the worker
+
+    order_len.store(0, .seq_cst);
+    order_done.reset();
+    order_expected = 5;
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_LOW, 1);
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_NORMAL, 2);
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_HIGH, 3);
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_NORMAL, 4);
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_HIGH, 5);
+    gate.set();
+
+    try order_done.timedWait(10 * std.time.ns_per_s);
+    try testing.expectEqualSlices(usize, &[_]usize{ 3, 5, 2, 4, 1 }, order[0..5]);
+}
+
+test "http: queued requests can be cancelled" {
+    const settings = c.colyseus_settings_create();
+    defer c.colyseus_settings_free(settings);
+    const client = try createGatedClient(settings);
+    defer c.colyseus_client_free(client);
+    defer gate.set(); // before the free, which waits for the worker
+
+    order_len.store(0, .seq_cst);
+    order_done.reset();
+    order_expected = 2;
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_LOW, 1);
+    const cancelled = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_LOW, 2);
+    _ = try queueOrdered(client, c.COLYSEUS_HTTP_PRIORITY_LOW, 3);
+    try testing.expect(c.colyseus_client_http_cancel(client, cancelled));
+    try testing.expect(!c.colyseus_client_http_cancel(client, cancelled));
+    gate.set();
+
+    // Both neighbours ran, so the pool got past the cancelled one
+    try order_done.timedWait(10 * std.time.ns_per_s);
+    try testing.expectEqualSlices(usize, &[_]usize{ 1, 3 }, order[0..2]);
+    try testing.expectEqual(@as(usize, 2), order_len.load(.seq_cst));
+}
+
+var timeout_code = std.atomic.Value(c_int).init(0);
+var timeout_done = std.Thread.ResetEvent{};
+
+fn onTimeoutSuccess(_: [*c]const c.colyseus_http_response_t, _: ?*anyopaque) callconv(.c) void {
+    timeout_code.store(-1, .seq_cst);
+    timeout_done.set();
+}
+
+fn onTimeoutError(err: [*c]const c.colyseus_http_error_t, _: ?*anyopaque) callconv(.c) void {
+    timeout_code.store(err.*.code, .seq_cst);
+    timeout_done.set();
+}
+
+test "http: a request still queued at its deadline fails with a timeout" {
+    const settings = c.colyseus_settings_create();
+    defer c.colyseus_settings_free(settings);
+    const client = try createGatedClient(settings);
+    defer c.colyseus_client_free(client);
+    defer gate.set(); // before the free, which waits for the worker
+
+    timeout_done.reset();
+    const id = c.colyseus_client_http_request(client, c.COLYSEUS_HTTP_GET, "/test", null, c.COLYSEUS_HTTP_PRIORITY_NORMAL, 50, onTimeoutSuccess, onTimeoutError, null);
+    try testing.expect(id != 0);
+
+    // The only worker is parked, so this can only be the deadline timer
+    try timeout_done.timedWait(10 * std.time.ns_per_s);
+    try testing.expectEqual(@as(c_int, c.COLYSEUS_HTTP_TIMEOUT), timeout_code.load(.seq_cst));
+    try testing.expect(!c.colyseus_client_http_cancel(client, id));
+}
@@ -498,3 +498,73 @@ test "messages: send and receive message types" {
 
     std.Thread.sleep(50 * std.time.ns_per_ms);
 }
+
+test "messages: cursor reads in place" {
+    // {"name": "ab", "pos": [1, -2, 1.5], "hp": 300, "ok": true, 7: nil}
+    const bytes = [_]u8{
+        0x85,
+        0xa4, 'n', 'a', 'm', 'e', 0xa2, 'a', 'b',
+        0xa3, 'p', 'o', 's', 0x93, 0x01, 0xfe, 0xcb, 0x3f, 0xf8, 0, 0, 0, 0, 0, 0,
+        0xa2, 'h', 'p', 0xcd, 0x01, 0x2c,
+        0xa2, 'o', 'k', 0xc3,
+        0x07, 0xc0,
+    };
+
+    var msg: c.colyseus_message_cursor_t = undefined;
+    c.colyseus_message_cursor_init(&msg, &bytes, bytes.len);
+    try testing.expectEqual(c.COLYSEUS_MESSAGE_TYPE_MAP, c.colyseus_message_cursor_type(&msg));
+
+    var hp: i64 = 0;
+    try testing.expect(c.colyseus_message_cursor_map_get_int(&msg, "hp", &hp));
+    try testing.expectEqual(@as(i64, 300), hp);
+
+    var name: [*c]const u8 = null;
+    var name_len: usize = 0;
+    try testing.expect(c.colyseus_message_cursor_map_get_str(&msg, "name", &name, &name_len));
+    try testing.expectEqualStrings("ab", name[0..name_len]);
+    // Points into the original bytes
+    try testing.expect(@intFromPtr(name) == @intFromPtr(&bytes[7]));
+
+    var ok = false;
+    try testing.expect(c.colyseus_message_cursor_map_get_bool(&msg, "ok", &ok));
+    try testing.expect(ok);
+    try testing.expect(!c.colyseus_message_cursor_map_get_int(&msg, "missing", &hp));
+
+    var pos = msg;
+    try testing.expect(c.colyseus_message_cursor_map_find(&pos, "pos"));
+    var second: c.colyseus_message_cursor_t = undefined;
+    try testing.expect(c.colyseus_message_cursor_array_at(&pos, 1, &second));
+    // A negative doesn't fit an unsigned read: type error, cursor unmoved
+    var u: u64 = 7;
+    try testing.expect(!c.colyseus_message_cursor_read_uint(&second, &u));
+    try testing.expectEqual(@as(u64, 7), u);
+    var v: i64 = 0;
+    try testing.expect(c.colyseus_message_cursor_read_int(&second, &v));
+    try testing.expectEqual(@as(i64, -2), v);
+    var f: f64 = 0;
+    try testing.expect(c.colyseus_message_cursor_read_float(&second, &f));
+    try testing.expectEqual(@as(f64, 1.5), f);
+
+    // Skipping the whole map reaches the end
+    var all = msg;
+    try testing.expect(c.colyseus_message_cursor_skip(&all));
+    try testing.expect(c.colyseus_message_cursor_at_end(&all));
+    try testing.expect(!all.@"error");
+
+    // Indexed lookups
+    var entries: [8]c.colyseus_message_map_entry_t = undefined;
+    const count = c.colyseus_message_cursor_map_index(&msg, &entries, entries.len);
+    try testing.expectEqual(@as(usize, 4), count);
+    const hp_value = c.colyseus_message_map_index_find(&entries, count, "hp");
+    try testing.expect(hp_value != null);
+    var hp_cur = hp_value.*;
+    try testing.expect(c.colyseus_message_cursor_read_int(&hp_cur, &hp));
+    try testing.expectEqual(@as(i64, 300), hp);
+    try testing.expect(c.colyseus_message_map_index_find(&entries, count, "nope") == null);
+
+    // Truncated input fails instead of reading past the end
+    var cut: c.colyseus_message_cursor_t = undefined;
+    c.colyseus_message_cursor_init(&cut, &bytes, 20);
+    try testing.expect(!c.colyseus_message_cursor_skip(&cut));
+    try testing.expect(cut.@"error");
+}
@@ -46,3 +46,345 @@ test "room: basic operations" {
     c.colyseus_room_on_message(room, "chat", onMessageString, null);
     c.colyseus_room_on_state_change(room, onStateChange, null);
 }
+
+// Mock transport: captures the events the room installs so the test can
+// play the network thread.
+var mock_transport: c.colyseus_transport_t = undefined;
+
+fn mockConnect(transport: ?*c.colyseus_transport_t, url: [*c]const u8) callconv(.c) void {
+    _ = transport;
+    _ = url;
+}
+
+fn mockDestroy(transport: ?*c.colyseus_transport_t) callconv(.c) void {
+    _ = transport;
+}
+
+fn mockTransportFactory(events: [*c]const c.colyseus_transport_events_t) callconv(.c) ?*c.colyseus_transport_t {
+    mock_transport = std.mem.zeroes(c.colyseus_transport_t);
+    mock_transport.connect = mockConnect;
+    mock_transport.destroy = mockDestroy;
+    mock_transport.events = events.*;
+    return &mock_transport;
+}
+
+const poll_frame_count = 300; // more than the SPSC ring holds
+var poll_received: c_int = 0;
+var poll_in_order = true;
+
+fn onPollMessage(data: [*c]const u8, length: usize, userdata: ?*anyopaque) callconv(.c) void {
+    _ = userdata;
+    if (length != 1 or data[0] != @as(u8, @intCast(@mod(poll_received, 128)))) poll_in_order = false;
+    poll_received += 1;
+}
+
+fn pollProducer() void {
+    var i: usize = 0;
+    while (i < poll_frame_count) : (i += 1) {
+        // ROOM_DATA, type "chat" (fixstr), payload: positive fixint
+        const frame = [_]u8{ 13, 0xa4, 'c', 'h', 'a', 't', @intCast(i % 128) };
+        mock_transport.events.on_message.?(&frame, frame.len, mock_transport.events.userdata);
+    }
+}
+
+test "room: poll mode dispatches on the polling thread" {
+    const room = c.colyseus_room_create("test_room", mockTransportFactory);
+    defer c.colyseus_room_free(room);
+
+    c.colyseus_room_enable_poll_mode(room);
+    try testing.expect(c.colyseus_room_is_poll_mode(room));
+    c.colyseus_room_on_message_encoded(room, "chat", onPollMessage, null);
+    c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+    const producer = try std.Thread.spawn(.{}, pollProducer, .{});
+    producer.join();
+
+    // Nothing is dispatched on the network thread
+    try testing.expectEqual(@as(c_int, 0), poll_received);
+
+    var dispatched: c_int = 0;
+    while (dispatched < poll_frame_count) {
+        dispatched += c.colyseus_room_poll(room, 0);
+    }
+    try testing.expectEqual(@as(c_int, poll_frame_count), poll_received);
+    try testing.expect(poll_in_order);
+    try testing.expectEqual(@as(c_int, 0), c.colyseus_room_poll(room, 0));
+}
+
+var close_seen_after: c_int = -1;
+
+fn onPollClose(code: c_int, message: [*c]const u8, userdata: ?*anyopaque) callconv(.c) void {
+    _ = code;
+    _ = message;
+    _ = userdata;
+    close_seen_after = poll_received;
+}
+
+fn pollProducerThenClose() void {
+    pollProducer();
+    mock_transport.events.on_close.?(1006, "gone", mock_transport.events.userdata);
+}
+
+test "room: poll mode keeps order across the overflow list" {
+    // Polls while the producer fills the ring past capacity and then closes:
+    // the close (overflow list) must come after every message.
+    var round: usize = 0;
+    while (round < 20) : (round += 1) {
+        const room = c.colyseus_room_create("test_room", mockTransportFactory);
+        defer c.colyseus_room_free(room);
+
+        poll_received = 0;
+        poll_in_order = true;
+        close_seen_after = -1;
+        c.colyseus_room_enable_poll_mode(room);
+        c.colyseus_room_on_message_encoded(room, "chat", onPollMessage, null);
+        c.colyseus_room_on_error(room, onPollClose, null);
+        c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+        const producer = try std.Thread.spawn(.{}, pollProducerThenClose, .{});
+        while (close_seen_after < 0) {
+            _ = c.colyseus_room_poll(room, 0);
+        }
+        producer.join();
+
+        try testing.expectEqual(@as(c_int, poll_frame_count), close_seen_after);
+        try testing.expect(poll_in_order);
+    }
+}
+
+// Group poll: a callback on one room frees the room polled after it
+var group_rooms: [3]?*c.colyseus_room_t = .{ null, null, null };
+var group_hits = [_]c_int{0} ** 3;
+
+fn onGroupMessage(data: [*c]const u8, length: usize, userdata: ?*anyopaque) callconv(.c) void {
+    _ = data;
+    _ = length;
+    const i = @intFromPtr(userdata);
+    group_hits[i] += 1;
+    if (i == 2) {
+        c.colyseus_room_free(group_rooms[1]);
+        group_rooms[1] = null;
+    }
+}
+
+test "room: a group poll survives callbacks freeing the next room" {
+    const group = c.colyseus_room_poll_group_create();
+    defer c.colyseus_room_poll_group_free(group);
+
+    var events: [3]c.colyseus_transport_events_t = undefined;
+    for (&group_rooms, &events, 0..) |*room, *room_events, i| {
+        room.* = c.colyseus_room_create("test_room", mockTransportFactory);
+        c.colyseus_room_poll_group_add(group, room.*);
+        c.colyseus_room_on_message_int_encoded(room.*, 5, onGroupMessage, @ptrFromInt(i));
+        c.colyseus_room_connect(room.*, "ws://localhost:2567/mock", null, null, null, null);
+        room_events.* = mock_transport.events;
+    }
+    defer for (group_rooms) |room| c.colyseus_room_free(room);
+
+    // ROOM_DATA (13), type 5; newest room first: 2 frees 1, then 0 is polled
+    for (events) |room_events| {
+        room_events.on_message.?(&[_]u8{ 13, 0x05, 0x01 }, 3, room_events.userdata);
+    }
+    try testing.expectEqual(@as(c_int, 2), c.colyseus_room_poll_group_poll(group, 0));
+    try testing.expectEqualSlices(c_int, &[_]c_int{ 1, 0, 1 }, &group_hits);
+    try testing.expectEqual(@as(?*c.colyseus_room_t, null), group_rooms[1]);
+}
+
+var dispatch_hits = [_]c_int{0} ** 4;
+var dispatch_last_type: [32]u8 = undefined;
+var dispatch_last_type_len: usize = 0;
+
+fn onTypeHit(data: [*c]const u8, length: usize, userdata: ?*anyopaque) callconv(.c) void {
+    _ = data;
+    _ = length;
+    dispatch_hits[@intFromPtr(userdata)] += 1;
+}
+
+fn onAnyWithType(message_type: [*c]const u8, data: [*c]const u8, length: usize, userdata: ?*anyopaque) callconv(.c) void {
+    _ = data;
+    _ = length;
+    _ = userdata;
+    const name = std.mem.span(message_type);
+    @memcpy(dispatch_last_type[0..name.len], name);
+    dispatch_last_type_len = name.len;
+}
+
+fn deliver(frame: []const u8) void {
+    mock_transport.events.on_message.?(frame.ptr, frame.len, mock_transport.events.userdata);
+}
+
+test "room: message types dispatch by index, by key and in place" {
+    const room = c.colyseus_room_create("test_room", mockTransportFactory);
+    defer c.colyseus_room_free(room);
+
+    c.colyseus_room_on_message_int_encoded(room, 5, onTypeHit, @ptrFromInt(0));
+    c.colyseus_room_on_message_int_encoded(room, 5000, onTypeHit, @ptrFromInt(1));
+    c.colyseus_room_on_message_int_encoded(room, -3, onTypeHit, @ptrFromInt(2));
+    c.colyseus_room_on_message_encoded(room, "move", onTypeHit, @ptrFromInt(3));
+    c.colyseus_room_on_message_any_with_type_encoded(room, onAnyWithType, null);
+    c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+    // ROOM_DATA (13): positive fixint, uint16 (little-endian), negative fixint, fixstr
+    deliver(&[_]u8{ 13, 0x05, 0x01 });
+    deliver(&[_]u8{ 13, 0xcd, 0x88, 0x13, 0x01 });
+    deliver(&[_]u8{ 13, 0xfd, 0x01 });
+    deliver(&[_]u8{ 13, 0xa4, 'm', 'o', 'v', 'e', 0x01 });
+    try testing.expectEqualSlices(c_int, &[_]c_int{ 1, 1, 1, 1 }, &dispatch_hits);
+    try testing.expectEqualStrings("move", dispatch_last_type[0..dispatch_last_type_len]);
+
+    // Unhandled: the wildcard still gets a name
+    deliver(&[_]u8{ 13, 0x07, 0x01 });
+    try testing.expectEqualStrings("i7", dispatch_last_type[0..dispatch_last_type_len]);
+    deliver(&[_]u8{ 13, 0xa3, 'h', 'i', 't', 0x01 });
+    try testing.expectEqualStrings("hit", dispatch_last_type[0..dispatch_last_type_len]);
+
+    // Truncated string type is dropped
+    deliver(&[_]u8{ 13, 0xa4, 'm', 'o' });
+    try testing.expectEqualSlices(c_int, &[_]c_int{ 1, 1, 1, 1 }, &dispatch_hits);
+}
+
+test "room: a numeric type registered by key is found below an indexed one" {
+    const room = c.colyseus_room_create("test_room", mockTransportFactory);
+    defer c.colyseus_room_free(room);
+    dispatch_hits = [_]c_int{0} ** 4;
+
+    // "i5" only goes in by key; 7 makes the index cover slot 5 (left empty)
+    c.colyseus_room_on_message_encoded(room, "i5", onTypeHit, @ptrFromInt(0));
+    c.colyseus_room_on_message_int_encoded(room, 7, onTypeHit, @ptrFromInt(1));
+    c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+    deliver(&[_]u8{ 13, 0x05, 0x01 });
+    deliver(&[_]u8{ 13, 0x07, 0x01 });
+    try testing.expectEqualSlices(c_int, &[_]c_int{ 1, 1, 0, 0 }, &dispatch_hits);
+}
+
+var sent_frame: [256]u8 = undefined;
+var sent_len: usize = 0;
+var sent_ptr: usize = 0;
+
+fn mockIsOpen(transport: ?*const c.colyseus_transport_t) callconv(.c) bool {
+    _ = transport;
+    return true;
+}
+
+fn mockSend(transport: ?*c.colyseus_transport_t, data: [*c]const u8, length: usize) callconv(.c) void {
+    _ = transport;
+    @memcpy(sent_frame[0..length], data[0..length]);
+    sent_len = length;
+    sent_ptr = @intFromPtr(data);
+}
+
+fn openTransportFactory(events: [*c]const c.colyseus_transport_events_t) callconv(.c) ?*c.colyseus_transport_t {
+    _ = mockTransportFactory(events);
+    mock_transport.is_open = mockIsOpen;
+    mock_transport.send = mockSend;
+    return &mock_transport;
+}
+
+test "room: send_writer frames the payload in place" {
+    const room = c.colyseus_room_create("test_room", openTransportFactory);
+    defer c.colyseus_room_free(room);
+    c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+    var w: c.colyseus_msgwriter_t = undefined;
+    c.colyseus_msgwriter_init(&w, null, 0);
+    defer c.colyseus_msgwriter_free(&w);
+
+    c.colyseus_msgwriter_map(&w, 1);
+    c.colyseus_msgwriter_str(&w, "x");
+    c.colyseus_msgwriter_int(&w, -200);
+    c.colyseus_room_send_writer(room, "move", &w);
+
+    // ROOM_DATA (13), "move", {"x": -200}: sent straight from the writer's buffer
+    try testing.expectEqualSlices(u8, &[_]u8{ 13, 0xa4, 'm', 'o', 'v', 'e', 0x81, 0xa1, 'x', 0xd1, 0xff, 0x38 }, sent_frame[0..sent_len]);
+    try testing.expectEqual(@intFromPtr(w.buf) + c.COLYSEUS_MSGWRITER_HEADROOM - 6, sent_ptr);
+
+    c.colyseus_msgwriter_reset(&w);
+    c.colyseus_msgwriter_bool(&w, true);
+    c.colyseus_room_send_int_writer(room, 3, &w);
+    try testing.expectEqualSlices(u8, &[_]u8{ 13, 0x03, 0xc3 }, sent_frame[0..sent_len]);
+
+    // A writer that ran out of space sends nothing
+    var small: [33]u8 = undefined;
+    var full: c.colyseus_msgwriter_t = undefined;
+    c.colyseus_msgwriter_init(&full, &small, small.len);
+    c.colyseus_msgwriter_str(&full, "too long");
+    sent_len = 0;
+    c.colyseus_room_send_writer(room, "move", &full);
+    try testing.expectEqual(@as(usize, 0), sent_len);
+}
+
+// Reconnect flush: the app keeps sending while the backlog goes out
+const flush_backlog = 3;
+const flush_behind = 15; // more than max_enqueued_messages (10)
+var flush_open = false;
+var flush_room: ?*c.colyseus_room_t = null;
+var flush_seq: [32]u8 = undefined;
+var flush_seq_len: usize = 0;
+
+fn flushIsOpen(transport: ?*const c.colyseus_transport_t) callconv(.c) bool {
+    _ = transport;
+    return flush_open;
+}
+
+fn flushSendSeq(seq: u8) void {
+    const payload = [_]u8{seq};
+    c.colyseus_room_send_int_bytes(flush_room, 1, &payload, payload.len);
+}
+
+fn flushSend(transport: ?*c.colyseus_transport_t, data: [*c]const u8, length: usize) callconv(.c) void {
+    _ = transport;
+    if (length < 2 or data[0] != 17) return; // only ROOM_DATA_BYTES (17), not the JOIN ack
+    flush_seq[flush_seq_len] = data[length - 1];
+    flush_seq_len += 1;
+    if (flush_seq_len == 1) {
+        var seq: u8 = flush_backlog;
+        while (seq < flush_backlog + flush_behind) : (seq += 1) flushSendSeq(seq);
+    }
+}
+
+fn flushTransportFactory(events: [*c]const c.colyseus_transport_events_t) callconv(.c) ?*c.colyseus_transport_t {
+    _ = mockTransportFactory(events);
+    mock_transport.is_open = flushIsOpen;
+    mock_transport.send = flushSend;
+    return &mock_transport;
+}
+
+test "room: sends made during a reconnect flush queue behind it and none are dropped" {
+    const room = c.colyseus_room_create("test_room", flushTransportFactory);
+    defer c.colyseus_room_free(room);
+    flush_room = room;
+
+    // The retry timer never fires here: the second JOIN ends the reconnection
+    var options: c.colyseus_reconnection_options_t = undefined;
+    c.colyseus_room_get_reconnection_options(room, &options);
+    options.min_uptime_ms = 0;
+    options.delay_ms = 60000;
+    options.min_delay_ms = 60000;
+    options.max_delay_ms = 60000;
+    options.jitter = false;
+    c.colyseus_room_set_reconnection_options(room, &options);
+    c.colyseus_room_connect(room, "ws://localhost:2567/mock", null, null, null, null);
+
+    // JOIN_ROOM (10): token "t", serializer "none"
+    const join = [_]u8{ 10, 1, 't', 4, 'n', 'o', 'n', 'e' };
+    flush_open = true;
+    deliver(&join);
+
+    // Dropped: sends go to the reconnection buffer
+    flush_open = false;
+    mock_transport.events.on_close.?(1006, "gone", mock_transport.events.userdata);
+    try testing.expect(c.colyseus_room_is_reconnecting(room));
+    var seq: u8 = 0;
+    while (seq < flush_backlog) : (seq += 1) flushSendSeq(seq);
+    try testing.expectEqual(@as(usize, 0), flush_seq_len);
+
+    // Rejoined: the backlog flushes, and the sends made from inside it follow
+    flush_open = true;
+    deliver(&join);
+    try testing.expect(!c.colyseus_room_is_reconnecting(room));
+    try testing.expectEqual(@as(usize, flush_backlog + flush_behind), flush_seq_len);
+    for (flush_seq[0..flush_seq_len], 0..) |got, i| {
+        try testing.expectEqual(@as(u8, @intCast(i)), got);
+    }
+}
@@ -11,6 +11,8 @@ const c = @cImport({
     @cInclude("colyseus/schema/collections.h");
     @cInclude("colyseus/schema/ref_tracker.h");
     @cInclude("colyseus/schema/decoder.h");
+    @cInclude("colyseus/schema/interpolation.h");
+    @cInclude("colyseus/schema/snapshot.h");
 });
 
 // ============================================================================
@@ -526,6 +528,48 @@ test "ref_tracker_remove" {
     try testing.expect(!c.colyseus_ref_tracker_has(tracker, 10));
 }
 
+test "ref_tracker_dirty_fields" {
+    const tracker = c.colyseus_ref_tracker_create();
+    defer c.colyseus_ref_tracker_free(tracker);
+
+    var a: i32 = 0;
+    var b: i32 = 0;
+    c.colyseus_ref_tracker_add(tracker, 1, &a, c.COLYSEUS_REF_TYPE_SCHEMA, null, true);
+    c.colyseus_ref_tracker_add(tracker, 2, &b, c.COLYSEUS_REF_TYPE_ARRAY, null, true);
+
+    c.colyseus_ref_tracker_mark_dirty(tracker, 1, 0);
+    c.colyseus_ref_tracker_mark_dirty(tracker, 1, 3);
+    c.colyseus_ref_tracker_mark_dirty(tracker, 2, 100); // collapses into bit 63
+
+    try testing.expectEqual(@as(u64, 0b1001), c.colyseus_ref_tracker_get_dirty_fields(tracker, 1));
+    try testing.expectEqual(@as(u64, 1) << 63, c.colyseus_ref_tracker_get_dirty_fields(tracker, 2));
+
+    // Each ref is listed once, no matter how many fields changed
+    var count: c_int = 0;
+    const refs = c.colyseus_ref_tracker_get_dirty_refs(tracker, &count);
+    try testing.expectEqual(@as(c_int, 2), count);
+    try testing.expectEqual(@as(c_int, 1), refs[0]);
+    try testing.expectEqual(@as(c_int, 2), refs[1]);
+
+    // New epoch auto-clears
+    c.colyseus_ref_tracker_begin_epoch(tracker);
+    _ = c.colyseus_ref_tracker_get_dirty_refs(tracker, &count);
+    try testing.expectEqual(@as(c_int, 0), count);
+    try testing.expectEqual(@as(u64, 0), c.colyseus_ref_tracker_get_dirty_fields(tracker, 1));
+
+    // Manual mode accumulates across epochs
+    c.colyseus_ref_tracker_set_dirty_auto_clear(tracker, false);
+    c.colyseus_ref_tracker_mark_dirty(tracker, 1, 1);
+    c.colyseus_ref_tracker_begin_epoch(tracker);
+    c.colyseus_ref_tracker_mark_dirty(tracker, 1, 2);
+    _ = c.colyseus_ref_tracker_get_dirty_refs(tracker, &count);
+    try testing.expectEqual(@as(c_int, 1), count);
+    try testing.expectEqual(@as(u64, 0b110), c.colyseus_ref_tracker_get_dirty_fields(tracker, 1));
+
+    c.colyseus_ref_tracker_clear_dirty(tracker);
+    try testing.expectEqual(@as(u64, 0), c.colyseus_ref_tracker_get_dirty_fields(tracker, 1));
+}
+
 // ============================================================================
 // Changes list tests
 // ============================================================================
@@ -587,3 +631,254 @@ test "type_context_create_and_free" {
 
     c.colyseus_type_context_free(ctx);
 }
+
+// ============================================================================
+// Interpolation buffer tests
+// ============================================================================
+
+const Point = extern struct {
+    base: c.colyseus_schema_t,
+    x: f64,
+};
+
+const point_fields = [_]c.colyseus_field_t{
+    .{ .index = 0, .name = "x", .type = c.COLYSEUS_FIELD_NUMBER, .type_str = "number", .offset = @offsetOf(Point, "x"), .child_vtable = null, .child_primitive_type = null },
+};
+
+const point_vtable = c.colyseus_schema_vtable_t{
+    .name = "Point",
+    .size = @sizeOf(Point),
+    .create = null,
+    .destroy = null,
+    .fields = &point_fields,
+    .field_count = point_fields.len,
+};
+
+test "interp_buffer_interpolate_and_extrapolate" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+    const refs = decoder.*.refs;
+
+    var p = Point{ .base = .{ .__refId = 5, .__vtable = &point_vtable }, .x = 0 };
+    c.colyseus_ref_tracker_add(refs, 5, &p, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+
+    const names = [_][*c]const u8{"x"};
+    const buf = c.colyseus_interp_buffer_create(decoder, &point_vtable, &names, 1, 4);
+    try testing.expect(buf != null);
+    defer c.colyseus_interp_buffer_free(buf);
+
+    c.colyseus_ref_tracker_mark_dirty(refs, 5, 0);
+    c.colyseus_interp_buffer_capture(buf, 0);
+    try testing.expectEqual(@as(c_int, 1), c.colyseus_interp_buffer_get_count(buf));
+
+    c.colyseus_ref_tracker_begin_epoch(refs);
+    p.x = 10;
+    c.colyseus_ref_tracker_mark_dirty(refs, 5, 0);
+    c.colyseus_interp_buffer_capture(buf, 100);
+
+    var out: [1]f32 = undefined;
+    c.colyseus_interp_buffer_sample_channel(buf, 0, 50, &out);
+    try testing.expectApproxEqAbs(@as(f32, 5), out[0], 0.001);
+
+    // Extrapolates past the newest sample, up to the 100ms default limit
+    try testing.expect(c.colyseus_interp_buffer_sample_entity(buf, 5, 150, &out));
+    try testing.expectApproxEqAbs(@as(f32, 15), out[0], 0.001);
+    try testing.expect(c.colyseus_interp_buffer_sample_entity(buf, 5, 1000, &out));
+    try testing.expectApproxEqAbs(@as(f32, 20), out[0], 0.001);
+
+    // Collected refs are dropped on the next capture
+    _ = c.colyseus_ref_tracker_remove(refs, 5);
+    c.colyseus_ref_tracker_gc(refs);
+    c.colyseus_interp_buffer_capture(buf, 200);
+    try testing.expectEqual(@as(c_int, 0), c.colyseus_interp_buffer_get_count(buf));
+}
+
+test "interp_buffer_tracks_refs_decoded_before_create" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+    const refs = decoder.*.refs;
+
+    // Decoded and no longer dirty by the time the buffer is created
+    var p = Point{ .base = .{ .__refId = 7, .__vtable = &point_vtable }, .x = 3 };
+    c.colyseus_ref_tracker_add(refs, 7, &p, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+    c.colyseus_ref_tracker_begin_epoch(refs);
+
+    const names = [_][*c]const u8{"x"};
+    const buf = c.colyseus_interp_buffer_create(decoder, &point_vtable, &names, 1, 4);
+    try testing.expect(buf != null);
+    defer c.colyseus_interp_buffer_free(buf);
+    try testing.expectEqual(@as(c_int, 0), c.colyseus_interp_buffer_find_slot(buf, 7));
+
+    // Unchanged patches still sample it
+    c.colyseus_interp_buffer_capture(buf, 0);
+    try testing.expectEqual(@as(c_int, 1), c.colyseus_interp_buffer_get_count(buf));
+    var out: [1]f32 = undefined;
+    try testing.expect(c.colyseus_interp_buffer_sample_entity(buf, 7, 0, &out));
+    try testing.expectApproxEqAbs(@as(f32, 3), out[0], 0.001);
+}
+
+// ============================================================================
+// State snapshot tests
+// ============================================================================
+
+test "snapshot_is_isolated_from_live_state" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+    const refs = decoder.*.refs;
+
+    var root = Point{ .base = .{ .__refId = 0, .__vtable = &point_vtable }, .x = 1 };
+    c.colyseus_ref_tracker_add(refs, 0, &root, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+
+    const publisher = c.colyseus_snapshot_publisher_create(decoder);
+    defer c.colyseus_snapshot_publisher_free(publisher);
+
+    try testing.expect(c.colyseus_snapshot_publisher_acquire(publisher) == null);
+
+    c.colyseus_snapshot_publisher_publish(publisher);
+    const first = c.colyseus_snapshot_publisher_acquire(publisher);
+    try testing.expect(first != null);
+    defer c.colyseus_state_snapshot_release(first);
+
+    // Live mutation does not leak into the published copy
+    root.x = 2;
+    c.colyseus_ref_tracker_mark_dirty(refs, 0, 0);
+    c.colyseus_snapshot_publisher_publish(publisher);
+
+    const second = c.colyseus_snapshot_publisher_acquire(publisher);
+    defer c.colyseus_state_snapshot_release(second);
+
+    const first_state: *const Point = @ptrCast(@alignCast(c.colyseus_state_snapshot_get_state(first)));
+    const second_state: *const Point = @ptrCast(@alignCast(c.colyseus_state_snapshot_get_state(second)));
+    try testing.expectEqual(@as(f64, 1), first_state.x);
+    try testing.expectEqual(@as(f64, 2), second_state.x);
+
+    // Untouched refs are shared between versions
+    c.colyseus_ref_tracker_clear_dirty(refs);
+    c.colyseus_snapshot_publisher_publish(publisher);
+    const third = c.colyseus_snapshot_publisher_acquire(publisher);
+    defer c.colyseus_state_snapshot_release(third);
+    try testing.expect(c.colyseus_state_snapshot_get_state(third) == c.colyseus_state_snapshot_get_state(second));
+}
+
+var snapshot_readers_done = std.atomic.Value(bool).init(false);
+var snapshot_out_of_order = std.atomic.Value(bool).init(false);
+
+fn snapshotReader(publisher: ?*c.colyseus_snapshot_publisher_t) void {
+    var last: f64 = -1;
+    while (!snapshot_readers_done.load(.seq_cst)) {
+        const snapshot = c.colyseus_snapshot_publisher_acquire(publisher) orelse continue;
+        const state: *const Point = @ptrCast(@alignCast(c.colyseus_state_snapshot_get_state(snapshot)));
+        if (state.x < last) snapshot_out_of_order.store(true, .seq_cst);
+        last = state.x;
+        c.colyseus_state_snapshot_release(snapshot);
+    }
+}
+
+test "snapshot_acquire_races_publish" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+    const refs = decoder.*.refs;
+
+    var root = Point{ .base = .{ .__refId = 0, .__vtable = &point_vtable }, .x = 0 };
+    c.colyseus_ref_tracker_add(refs, 0, &root, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+
+    const publisher = c.colyseus_snapshot_publisher_create(decoder);
+    defer c.colyseus_snapshot_publisher_free(publisher);
+    c.colyseus_snapshot_publisher_publish(publisher);
+
+    // Every publish replaces (and releases) the version readers are grabbing
+    snapshot_readers_done.store(false, .seq_cst);
+    var readers: [3]std.Thread = undefined;
+    for (&readers) |*reader| reader.* = try std.Thread.spawn(.{}, snapshotReader, .{publisher});
+
+    var i: usize = 1;
+    while (i <= 20000) : (i += 1) {
+        root.x = @floatFromInt(i);
+        c.colyseus_ref_tracker_mark_dirty(refs, 0, 0);
+        c.colyseus_snapshot_publisher_publish(publisher);
+        c.colyseus_ref_tracker_clear_dirty(refs);
+    }
+    snapshot_readers_done.store(true, .seq_cst);
+    for (readers) |reader| reader.join();
+
+    try testing.expect(!snapshot_out_of_order.load(.seq_cst));
+    const latest = c.colyseus_snapshot_publisher_acquire(publisher);
+    defer c.colyseus_state_snapshot_release(latest);
+    const state: *const Point = @ptrCast(@alignCast(c.colyseus_state_snapshot_get_state(latest)));
+    try testing.expectEqual(@as(f64, 20000), state.x);
+}
+
+// ============================================================================
+// Batched decode tests
+// ============================================================================
+
+var batch_trigger_calls: c_int = 0;
+var batch_change_count: c_int = 0;
+
+fn onBatchTrigger(changes: [*c]c.colyseus_changes_t, userdata: ?*anyopaque) callconv(.c) void {
+    _ = userdata;
+    batch_trigger_calls += 1;
+    batch_change_count = changes.*.count;
+}
+
+test "decoder_batch_flushes_once_with_merged_changes" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+
+    var root = Point{ .base = .{ .__refId = 0, .__vtable = &point_vtable }, .x = 0 };
+    c.colyseus_ref_tracker_add(decoder.*.refs, 0, &root, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+    decoder.*.state = @ptrCast(&root);
+    defer decoder.*.state = null;
+
+    c.colyseus_decoder_set_trigger_callback(decoder, onBatchTrigger, null);
+
+    // ADD field 0 ("x") = 5, then = 7
+    const patch1 = [_]u8{ 0x80, 0x05 };
+    const patch2 = [_]u8{ 0x80, 0x07 };
+
+    c.colyseus_decoder_begin_batch(decoder);
+    c.colyseus_decoder_decode(decoder, &patch1, patch1.len, null);
+    c.colyseus_decoder_decode(decoder, &patch2, patch2.len, null);
+    try testing.expectEqual(@as(c_int, 0), batch_trigger_calls);
+    c.colyseus_decoder_end_batch(decoder);
+
+    try testing.expectEqual(@as(c_int, 1), batch_trigger_calls);
+    try testing.expectEqual(@as(c_int, 1), batch_change_count);
+    try testing.expectEqual(@as(f64, 7), root.x);
+}
+
+var batch_previous: f64 = -1;
+
+fn onBatchPrevious(changes: [*c]c.colyseus_changes_t, userdata: ?*anyopaque) callconv(.c) void {
+    _ = userdata;
+    batch_change_count = changes.*.count;
+    if (changes.*.count != 1) return;
+    const change = changes.*.items[0];
+    const previous: *const f64 = @ptrCast(@alignCast(change.previous_value));
+    batch_previous = previous.*;
+}
+
+test "decoder_batch_reports_the_pre_batch_previous_value" {
+    const decoder = c.colyseus_decoder_create(null);
+    defer c.colyseus_decoder_free(decoder);
+
+    var root = Point{ .base = .{ .__refId = 0, .__vtable = &point_vtable }, .x = 100 };
+    c.colyseus_ref_tracker_add(decoder.*.refs, 0, &root, c.COLYSEUS_REF_TYPE_SCHEMA, &point_vtable, true);
+    decoder.*.state = @ptrCast(&root);
+    defer decoder.*.state = null;
+
+    c.colyseus_decoder_set_trigger_callback(decoder, onBatchPrevious, null);
+
+    // x: 100 -> 90 -> 80 -> 70, one net change 100 -> 70
+    const patches = [_][2]u8{ .{ 0x80, 90 }, .{ 0x80, 80 }, .{ 0x80, 70 } };
+
+    c.colyseus_decoder_begin_batch(decoder);
+    for (patches) |patch| {
+        c.colyseus_decoder_decode(decoder, &patch, patch.len, null);
+    }
+    c.colyseus_decoder_end_batch(decoder);
+
+    try testing.expectEqual(@as(c_int, 1), batch_change_count);
+    try testing.expectEqual(@as(f64, 100), batch_previous);
+    try testing.expectEqual(@as(f64, 70), root.x);
+}
@@ -0,0 +1,177 @@
+// Shared timer wheel (src/utils/timers.c): 4 levels of 64 one-millisecond
+// slots, a wheel thread, and workers for blocking timers.
+const std = @import("std");
+const testing = std.testing;
+
+const c = @cImport({
+    @cInclude("colyseus/utils/time.h");
+});
+
+// src/utils/timers.h is internal (no include path for it here)
+const Timer = opaque {};
+const TimerFn = *const fn (?*anyopaque) callconv(.c) void;
+extern fn colyseus_timer_create(callback: TimerFn, userdata: ?*anyopaque) ?*Timer;
+extern fn colyseus_timer_create_blocking(callback: TimerFn, userdata: ?*anyopaque) ?*Timer;
+extern fn colyseus_timer_free(timer: ?*Timer) void;
+extern fn colyseus_timer_arm(timer: ?*Timer, delay_ms: u32) bool;
+extern fn colyseus_timer_cancel(timer: ?*Timer) bool;
+
+// Fired timers, in order, with the time they fired
+var fired: [16]usize = undefined;
+var fired_at: [16]u64 = undefined;
+var fired_len = std.atomic.Value(usize).init(0);
+var fired_done = std.Thread.ResetEvent{};
+var fired_expected: usize = 0;
+
+fn resetFired(expected: usize) void {
+    fired_len.store(0, .seq_cst);
+    fired_done.reset();
+    fired_expected = expected;
+}
+
+fn onFire(userdata: ?*anyopaque) callconv(.c) void {
+    const n = fired_len.fetchAdd(1, .seq_cst);
+    fired[n] = @intFromPtr(userdata);
+    fired_at[n] = c.colyseus_monotonic_ms();
+    if (n + 1 == fired_expected) fired_done.set();
+}
+
+test "timers: fire in delay order across wheel levels" {
+    // Level 0 (< 64 ms), level 1 (< 4096 ms) and level 2, with neighbours
+    // on both sides of each boundary, armed out of order
+    const delays = [_]u32{ 4200, 66, 1, 4097, 62, 130, 4094, 64 };
+    var timers: [delays.len]?*Timer = undefined;
+    resetFired(delays.len);
+
+    const start = c.colyseus_monotonic_ms();
+    for (delays, 0..) |delay, i| {
+        timers[i] = colyseus_timer_create(onFire, @ptrFromInt(i));
+        try testing.expect(colyseus_timer_arm(timers[i], delay));
+    }
+    defer for (timers) |timer| colyseus_timer_free(timer);
+
+    try fired_done.timedWait(10 * std.time.ns_per_s);
+    try testing.expectEqualSlices(usize, &[_]usize{ 2, 4, 7, 1, 5, 6, 3, 0 }, fired[0..delays.len]);
+    for (fired[0..delays.len], fired_at[0..delays.len]) |i, at| {
+        try testing.expect(at - start >= delays[i]);
+    }
+}
+
+test "timers: re-arming a pending timer moves it" {
+    resetFired(1);
+    const timer = colyseus_timer_create(onFire, null);
+    defer colyseus_timer_free(timer);
+
+    // Later: not fired at the first deadline
+    try testing.expect(colyseus_timer_arm(timer, 30));
+    try testing.expect(colyseus_timer_arm(timer, 300));
+    std.Thread.sleep(150 * std.time.ns_per_ms);
+    try testing.expectEqual(@as(usize, 0), fired_len.load(.seq_cst));
+    try fired_done.timedWait(2 * std.time.ns_per_s);
+
+    // Earlier, from a higher level: fires once, soon
+    resetFired(1);
+    const start = c.colyseus_monotonic_ms();
+    try testing.expect(colyseus_timer_arm(timer, 5000));
+    try testing.expect(colyseus_timer_arm(timer, 20));
+    try fired_done.timedWait(2 * std.time.ns_per_s);
+    try testing.expect(c.colyseus_monotonic_ms() - start < 1000);
+    std.Thread.sleep(100 * std.time.ns_per_ms);
+    try testing.expectEqual(@as(usize, 1), fired_len.load(.seq_cst));
+    try testing.expect(!colyseus_timer_cancel(timer));
+}
+
+// A callback parked until the test lets it go
+var parked_started = std.Thread.ResetEvent{};
+var parked_release = std.Thread.ResetEvent{};
+var parked_runs = std.atomic.Value(usize).init(0);
+
+fn onParked(_: ?*anyopaque) callconv(.c) void {
+    _ = parked_runs.fetchAdd(1, .seq_cst);
+    parked_started.set();
+    parked_release.wait();
+}
+
+fn resetParked() void {
+    parked_started.reset();
+    parked_release.reset();
+    parked_runs.store(0, .seq_cst);
+}
+
+var free_returned = std.atomic.Value(bool).init(false);
+
+fn freeTimer(timer: ?*Timer) void {
+    colyseus_timer_free(timer);
+    free_returned.store(true, .seq_cst);
+}
+
+test "timers: cancel doesn't wait for a running callback; free does" {
+    resetParked();
+    free_returned.store(false, .seq_cst);
+    const timer = colyseus_timer_create(onParked, null);
+    try testing.expect(colyseus_timer_arm(timer, 0));
+    try parked_started.timedWait(2 * std.time.ns_per_s);
+
+    // Running is not pending: nothing to cancel, and it returns right away
+    try testing.expect(!colyseus_timer_cancel(timer));
+
+    // Re-armed while running, then cancelled: it doesn't come back
+    try testing.expect(colyseus_timer_arm(timer, 10));
+    try testing.expect(colyseus_timer_cancel(timer));
+
+    const freer = try std.Thread.spawn(.{}, freeTimer, .{timer});
+    std.Thread.sleep(50 * std.time.ns_per_ms);
+    try testing.expect(!free_returned.load(.seq_cst));
+    parked_release.set();
+    freer.join();
+    try testing.expect(free_returned.load(.seq_cst));
+    try testing.expectEqual(@as(usize, 1), parked_runs.load(.seq_cst));
+}
+
+var self_free_timer: ?*Timer = null;
+var self_free_runs = std.atomic.Value(usize).init(0);
+
+fn onSelfFree(_: ?*anyopaque) callconv(.c) void {
+    _ = self_free_runs.fetchAdd(1, .seq_cst);
+    // Re-armed, then freed: the free wins and it never runs again
+    _ = colyseus_timer_arm(self_free_timer, 10);
+    colyseus_timer_free(self_free_timer);
+    onFire(null);
+}
+
+test "timers: a callback may free its own timer" {
+    resetFired(1);
+    self_free_runs.store(0, .seq_cst);
+    self_free_timer = colyseus_timer_create(onSelfFree, null);
+    try testing.expect(colyseus_timer_arm(self_free_timer, 5));
+    try fired_done.timedWait(2 * std.time.ns_per_s);
+
+    // The wheel keeps going
+    std.Thread.sleep(50 * std.time.ns_per_ms);
+    resetFired(1);
+    const after = colyseus_timer_create(onFire, null);
+    defer colyseus_timer_free(after);
+    try testing.expect(colyseus_timer_arm(after, 5));
+    try fired_done.timedWait(2 * std.time.ns_per_s);
+    try testing.expectEqual(@as(usize, 1), self_free_runs.load(.seq_cst));
+}
+
+test "timers: blocking timers don't hold up the others" {
+    resetParked();
+    resetFired(1);
+    const blocking = colyseus_timer_create_blocking(onParked, null);
+    defer colyseus_timer_free(blocking);
+    defer parked_release.set(); // before the free, which waits for it
+    const timer = colyseus_timer_create(onFire, null);
+    defer colyseus_timer_free(timer);
+
+    try testing.expect(colyseus_timer_arm(blocking, 0));
+    try parked_started.timedWait(2 * std.time.ns_per_s);
+
+    // Parked on a worker: the wheel thread still runs the next timer
+    const start = c.colyseus_monotonic_ms();
+    try testing.expect(colyseus_timer_arm(timer, 20));
+    try fired_done.timedWait(2 * std.time.ns_per_s);
+    try testing.expect(c.colyseus_monotonic_ms() - start < 500);
+    try testing.expect(!parked_release.isSet());
+}
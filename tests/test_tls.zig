@@ -7,6 +7,14 @@
 //     regression: the settings/override CA must actually be honored, not shadowed)
 //   - bundled roots alone, or a wrong CA -> verification fails, no open
 //   - tls_skip_verification -> opens regardless
+//   - permessage-deflate: compressed echoes are inflated, and the per-connection
+//     memory cap closes the connection with 1009
+//   - a reconnect to the same host:port resumes the cached TLS session
+//   - pings get pongs and yield an RTT
+//   - an upgrade response arriving in one TLS record with a frame opens the
+//     connection and delivers the frame without further socket activity
+//   - a host name connects through the shared resolver, falling back across
+//     addresses (localhost may resolve to ::1 first; the server is IPv4 only)
 //
 // Requires the echo server on 127.0.0.1:2569 with certs from gen-certs.sh.
 const std = @import("std");
@@ -16,29 +24,39 @@ const c = @cImport({
     @cInclude("colyseus/transport.h");
     @cInclude("colyseus/websocket_transport.h");
     @cInclude("colyseus/settings.h");
+    @cInclude("colyseus/io_runtime.h");
 });
 
 const URL = "wss://127.0.0.1:2569";
 
+// src/network/tls_config.c (its header needs the mbedtls include path)
+extern fn colyseus_tls_config_get_build_count() c_int;
+
 var g_opened = std.atomic.Value(bool).init(false);
 var g_closed = std.atomic.Value(bool).init(false);
 var g_errored = std.atomic.Value(bool).init(false);
 var g_echoed = std.atomic.Value(bool).init(false);
+var g_echo_len = std.atomic.Value(usize).init(0);
+var g_close_code = std.atomic.Value(c_int).init(0);
 
 fn reset() void {
     g_opened.store(false, .seq_cst);
     g_closed.store(false, .seq_cst);
     g_errored.store(false, .seq_cst);
     g_echoed.store(false, .seq_cst);
+    g_echo_len.store(0, .seq_cst);
+    g_close_code.store(0, .seq_cst);
 }
 
 fn onOpen(_: ?*anyopaque) callconv(.c) void {
     g_opened.store(true, .seq_cst);
 }
-fn onMessage(_: [*c]const u8, _: usize, _: ?*anyopaque) callconv(.c) void {
+fn onMessage(_: [*c]const u8, length: usize, _: ?*anyopaque) callconv(.c) void {
+    g_echo_len.store(length, .seq_cst);
     g_echoed.store(true, .seq_cst);
 }
-fn onClose(_: c_int, _: [*c]const u8, _: ?*anyopaque) callconv(.c) void {
+fn onClose(code: c_int, _: [*c]const u8, _: ?*anyopaque) callconv(.c) void {
+    g_close_code.store(code, .seq_cst);
     g_closed.store(true, .seq_cst);
 }
 fn onError(_: [*c]const u8, _: ?*anyopaque) callconv(.c) void {
@@ -97,23 +115,89 @@ fn makeSettings(ca_pem: ?[]const u8, skip_verify: bool) *c.colyseus_settings_t {
     return s;
 }
 
-test "tls: trusted CA via settings is honored -> handshake succeeds + echo" {
+// reset(), then connect `url` with `settings` and wait for on_open.
+fn connectOpened(settings: *c.colyseus_settings_t, url: [*c]const u8) ![*c]c.colyseus_transport_t {
     reset();
+    var ev = makeEvents();
+    const transport = c.colyseus_websocket_transport_create(&ev);
+    errdefer c.colyseus_transport_destroy(transport);
+
+    c.colyseus_websocket_connect_with_settings(transport, url, settings);
+    try testing.expect(pollUntil(opened, 8 * std.time.ns_per_s));
+    return transport;
+}
+
+test "tls: trusted CA via settings is honored -> handshake succeeds + echo" {
     const ca = try loadPem("tests/tls/ca.pem");
     defer testing.allocator.free(ca);
     const settings = makeSettings(ca, false);
     defer c.colyseus_settings_free(settings);
 
-    var ev = makeEvents();
-    const transport = c.colyseus_websocket_transport_create(&ev);
+    const transport = try connectOpened(settings, URL);
     defer c.colyseus_transport_destroy(transport);
 
-    c.colyseus_websocket_connect_with_settings(transport, URL, settings);
-    try testing.expect(pollUntil(opened, 8 * std.time.ns_per_s));
-
     // Data round-trips over the verified TLS connection.
     c.colyseus_transport_send(transport, "ping", 4);
     try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+
+    var stats: c.colyseus_transport_stats_t = undefined;
+    c.colyseus_transport_get_stats(transport, &stats);
+    try testing.expectEqual(@as(u64, 1), stats.frames_sent);
+    try testing.expect(stats.send_calls >= 1);
+    try testing.expect(stats.messages_received >= 1);
+}
+
+test "tls: send_parts frames the parts as one message" {
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+
+    const transport = try connectOpened(settings, URL);
+    defer c.colyseus_transport_destroy(transport);
+
+    const parts = [_]c.colyseus_transport_buf_t{
+        .{ .data = "pi", .length = 2 },
+        .{ .data = "ng", .length = 2 },
+    };
+    c.colyseus_transport_send_parts(transport, &parts, parts.len);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+    try testing.expectEqual(@as(usize, 4), g_echo_len.load(.seq_cst));
+}
+
+test "tls: permessage-deflate echoes are inflated" {
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+
+    const transport = try connectOpened(settings, URL);
+    defer c.colyseus_transport_destroy(transport);
+
+    // The echo server compresses when the extension was negotiated, so a
+    // repetitive payload comes back as a few dozen bytes on the wire.
+    var payload: [16384]u8 = undefined;
+    @memset(&payload, 'a');
+    c.colyseus_transport_send(transport, &payload, payload.len);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+    try testing.expectEqual(payload.len, g_echo_len.load(.seq_cst));
+
+    var stats: c.colyseus_transport_stats_t = undefined;
+    c.colyseus_transport_get_stats(transport, &stats);
+    try testing.expect(stats.bytes_received < payload.len / 4);
+}
+
+test "tls: message inflating past the compression memory cap closes with 1009" {
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+    // 8 KB window (server_max_window_bits=13) + 32 KB of message
+    c.colyseus_settings_set_compression(settings, true, 40 * 1024);
+
+    const transport = try connectOpened(settings, URL);
+    defer c.colyseus_transport_destroy(transport);
+
+    var payload: [64 * 1024]u8 = undefined;
+    @memset(&payload, 'a');
+    c.colyseus_transport_send(transport, &payload, payload.len);
+    try testing.expect(pollUntil(failed, 3 * std.time.ns_per_s));
+    try testing.expect(!echoed());
+    try testing.expectEqual(@as(c_int, 1009), g_close_code.load(.seq_cst));
 }
 
 test "tls: wrong CA -> verification fails, never opens" {
@@ -148,14 +232,223 @@ test "tls: bundled roots alone do not trust the self-signed server" {
 }
 
 test "tls: tls_skip_verification opens without any trusted CA" {
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+
+    const transport = try connectOpened(settings, URL);
+    defer c.colyseus_transport_destroy(transport);
+}
+
+test "tls: reconnects reuse the parsed CA chain and TLS configuration" {
+    const ca = try loadPem("tests/tls/ca.pem");
+    defer testing.allocator.free(ca);
+    const settings = makeSettings(ca, false);
+    defer c.colyseus_settings_free(settings);
+
+    var built: c_int = 0;
+    for (0..3) |i| {
+        const transport = try connectOpened(settings, URL);
+        defer c.colyseus_transport_destroy(transport);
+        if (i == 0) built = colyseus_tls_config_get_build_count();
+    }
+    try testing.expectEqual(built, colyseus_tls_config_get_build_count());
+}
+
+test "tls: reconnects resume the cached TLS session" {
+    const ca = try loadPem("tests/tls/ca.pem");
+    defer testing.allocator.free(ca);
+    const settings = makeSettings(ca, false);
+    defer c.colyseus_settings_free(settings);
+
+    var stats: c.colyseus_transport_stats_t = undefined;
+    for (0..2) |_| {
+        const transport = try connectOpened(settings, URL);
+        defer c.colyseus_transport_destroy(transport);
+        // A TLS 1.3 ticket arrives after the handshake; the echo makes sure
+        // it has been read before the connection goes away.
+        c.colyseus_transport_send(transport, "ping", 4);
+        try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+        c.colyseus_transport_get_stats(transport, &stats);
+        try testing.expectEqual(@as(u64, 1), stats.tls_full_handshakes + stats.tls_resumed_handshakes);
+    }
+    // The second connect offered the first one's session
+    try testing.expectEqual(@as(u64, 1), stats.tls_resumed_handshakes);
+    try testing.expectEqual(@as(u64, 0), stats.tls_full_handshakes);
+}
+
+test "tls: pre-warmed connection upgrades to a URL given later" {
+    reset();
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+
+    var none = std.mem.zeroes(c.colyseus_transport_events_t);
+    const transport = c.colyseus_websocket_transport_create(&none);
+    defer c.colyseus_transport_destroy(transport);
+    try testing.expect(c.colyseus_websocket_prewarm(transport, URL, settings));
+
+    // Wait for TCP + TLS; nothing is reported before the upgrade
+    var stats: c.colyseus_transport_stats_t = undefined;
+    var waited: u64 = 0;
+    while (waited < 8000) : (waited += 10) {
+        c.colyseus_transport_get_stats(transport, &stats);
+        if (stats.tls_full_handshakes + stats.tls_resumed_handshakes == 1) break;
+        std.Thread.sleep(10 * std.time.ns_per_ms);
+    }
+    try testing.expectEqual(@as(u64, 1), stats.tls_full_handshakes + stats.tls_resumed_handshakes);
+    try testing.expect(!opened() and !failed());
+
+    var ev = makeEvents();
+    try testing.expect(!c.colyseus_websocket_upgrade(transport, "wss://127.0.0.1:2570/room", &ev));
+    try testing.expect(c.colyseus_websocket_upgrade(transport, URL ++ "/process/room?sessionId=abc", &ev));
+    try testing.expect(pollUntil(opened, 3 * std.time.ns_per_s));
+    c.colyseus_transport_send(transport, "ping", 4);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+}
+
+test "tls: pings measure the round trip" {
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+    c.colyseus_settings_set_keepalive(settings, 20, 1000);
+
+    const transport = try connectOpened(settings, URL);
+    defer c.colyseus_transport_destroy(transport);
+
+    var stats: c.colyseus_transport_stats_t = undefined;
+    var waited: u64 = 0;
+    while (waited < 3000) : (waited += 10) {
+        c.colyseus_transport_get_stats(transport, &stats);
+        if (stats.pongs_received >= 3) break;
+        std.Thread.sleep(10 * std.time.ns_per_ms);
+    }
+    try testing.expect(stats.pongs_received >= 3);
+    try testing.expect(stats.pings_sent >= stats.pongs_received);
+    try testing.expect(stats.srtt_us < 1000 * std.time.us_per_ms);
+    try testing.expect(stats.last_seen_ms > 0);
+    try testing.expect(!failed());
+}
+
+test "tls: host name connects race the resolved addresses and reuse the lookup" {
+    const ca = try loadPem("tests/tls/ca.pem");
+    defer testing.allocator.free(ca);
+    const settings = makeSettings(ca, false);
+    defer c.colyseus_settings_free(settings);
+
+    var stats: c.colyseus_transport_stats_t = undefined;
+    for (0..2) |_| {
+        const transport = try connectOpened(settings, "wss://localhost:2569");
+        defer c.colyseus_transport_destroy(transport);
+        c.colyseus_transport_get_stats(transport, &stats);
+        try testing.expect(stats.connect_attempts >= 1);
+    }
+    // The second connect found localhost in the resolver cache
+    try testing.expectEqual(@as(u64, 0), stats.resolve_ms);
+}
+
+test "tls: transports on a shared io runtime handshake + echo" {
+    if (@import("builtin").os.tag != .linux) return error.SkipZigTest;
+    const runtime = c.colyseus_io_runtime_create(1);
+    try testing.expect(runtime != null);
+    defer c.colyseus_io_runtime_free(runtime);
+
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+    c.colyseus_settings_set_io_runtime(settings, runtime);
+
+    const transport = try connectOpened(settings, URL);
+    try testing.expectEqual(@as(c_int, 1), c.colyseus_io_runtime_get_connection_count(runtime));
+
+    c.colyseus_transport_send(transport, "ping", 4);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+
+    c.colyseus_transport_destroy(transport);
+    try testing.expectEqual(@as(c_int, 0), c.colyseus_io_runtime_get_connection_count(runtime));
+}
+
+test "tls: io_uring runtime handshake + echo" {
+    if (@import("builtin").os.tag != .linux) return error.SkipZigTest;
+    const runtime = c.colyseus_io_runtime_create_with_backend(1, c.COLYSEUS_IO_BACKEND_IO_URING);
+    try testing.expect(runtime != null);
+    defer c.colyseus_io_runtime_free(runtime);
+    // Kernel without io_uring (or blocked by seccomp): covered by the epoll test
+    if (c.colyseus_io_runtime_get_backend(runtime) != c.COLYSEUS_IO_BACKEND_IO_URING) return error.SkipZigTest;
+
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+    c.colyseus_settings_set_io_runtime(settings, runtime);
+
+    const transport = try connectOpened(settings, URL);
+    c.colyseus_transport_send(transport, "ping", 4);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+
+    c.colyseus_transport_destroy(transport);
+    try testing.expectEqual(@as(c_int, 0), c.colyseus_io_runtime_get_connection_count(runtime));
+}
+
+test "tls: upgrade response sharing a record with a frame opens on the io runtime" {
+    if (@import("builtin").os.tag != .linux) return error.SkipZigTest;
+    const runtime = c.colyseus_io_runtime_create(1);
+    try testing.expect(runtime != null);
+    defer c.colyseus_io_runtime_free(runtime);
+
+    const settings = makeSettings(null, true);
+    defer c.colyseus_settings_free(settings);
+    c.colyseus_settings_set_io_runtime(settings, runtime);
+
+    // The response is read 1 KB at a time; the rest of the record is
+    // already decrypted and the socket never becomes readable again
+    const transport = try connectOpened(settings, URL ++ "/?welcome=4000");
+    defer c.colyseus_transport_destroy(transport);
+    try testing.expect(pollUntil(echoed, 3 * std.time.ns_per_s));
+    try testing.expectEqual(@as(usize, 4000), g_echo_len.load(.seq_cst));
+}
+
+// Drives one transport from a hand-rolled poll() loop, as a host engine would.
+fn driveExternal(transport: *c.colyseus_transport_t, condition: anytype, deadline_ns: u64) bool {
+    var timer = std.time.Timer.start() catch return false;
+    while (timer.read() < deadline_ns) {
+        if (condition()) return true;
+
+        const fd = c.colyseus_transport_get_fd(transport);
+        const interest = c.colyseus_transport_get_interest(transport);
+        const timeout = c.colyseus_transport_get_timeout_ms(transport);
+        if (timeout == 0 or fd < 0) {
+            c.colyseus_transport_on_timeout(transport);
+            continue;
+        }
+
+        var events: i16 = 0;
+        if (interest & c.COLYSEUS_TRANSPORT_WANT_READ != 0) events |= std.posix.POLL.IN;
+        if (interest & c.COLYSEUS_TRANSPORT_WANT_WRITE != 0) events |= std.posix.POLL.OUT;
+        var fds = [_]std.posix.pollfd{.{ .fd = fd, .events = events, .revents = 0 }};
+        const n = std.posix.poll(&fds, 50) catch return false;
+        if (n == 0) continue;
+
+        if (fds[0].revents & std.posix.POLL.OUT != 0) c.colyseus_transport_on_writable(transport);
+        if (fds[0].revents & ~@as(i16, std.posix.POLL.OUT) != 0) c.colyseus_transport_on_readable(transport);
+    }
+    return condition();
+}
+
+test "tls: external event loop drives handshake + echo on the caller thread" {
+    if (@import("builtin").os.tag == .windows) return error.SkipZigTest;
     reset();
     const settings = makeSettings(null, true);
     defer c.colyseus_settings_free(settings);
+    c.colyseus_settings_set_external_event_loop(settings, true);
 
     var ev = makeEvents();
     const transport = c.colyseus_websocket_transport_create(&ev);
     defer c.colyseus_transport_destroy(transport);
 
     c.colyseus_websocket_connect_with_settings(transport, URL, settings);
-    try testing.expect(pollUntil(opened, 8 * std.time.ns_per_s));
+    try testing.expect(c.colyseus_transport_get_fd(transport) >= 0);
+
+    // Nothing happens unless the host loop runs.
+    std.Thread.sleep(100 * std.time.ns_per_ms);
+    try testing.expect(!opened());
+
+    try testing.expect(driveExternal(transport, opened, 8 * std.time.ns_per_s));
+    c.colyseus_transport_send(transport, "ping", 4);
+    try testing.expect(c.colyseus_transport_get_interest(transport) & c.COLYSEUS_TRANSPORT_WANT_WRITE != 0);
+    try testing.expect(driveExternal(transport, echoed, 3 * std.time.ns_per_s));
 }
@@ -0,0 +1,482 @@
+// WebSocket transport tests against an in-process loopback peer.
+//
+// The peer is a raw TCP listener on 127.0.0.1 that answers the upgrade and
+// then reads (or writes) frames by hand, so the tests control exactly when
+// bytes move and can look at what the transport put on the wire:
+//   - sends from several threads arrive in per-thread order
+//   - more frames than the send ring holds, queued while the socket is
+//     blocked, still go out whole and in order (ring wrap + overflow list)
+//   - close() writes every queued frame before the close frame
+//   - close() while producers are mid-send drops a clean tail, never a gap
+//   - the frame parser reassembles fragmented messages (with control frames
+//     in between), frames split across reads, rejects a 64-bit length past
+//     the message limit with 1009, and echoes the server's close status
+//
+// No external server needed.
+const std = @import("std");
+const testing = std.testing;
+
+const c = @cImport({
+    @cInclude("colyseus/transport.h");
+    @cInclude("colyseus/websocket_transport.h");
+});
+
+const ws_guid = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+const Frame = struct {
+    fin: bool,
+    opcode: u8,
+    payload: []u8, // unmasked in place; valid until the next read
+};
+
+// Loopback WebSocket peer (server side of one connection)
+const Peer = struct {
+    server: std.net.Server,
+    stream: ?std.net.Stream = null,
+    buf: [1 << 16]u8 = undefined,
+    start: usize = 0,
+    end: usize = 0,
+    url_buf: [64]u8 = undefined,
+
+    fn listen(self: *Peer) !void {
+        const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+        self.* = .{ .server = try address.listen(.{ .reuse_address = true }) };
+    }
+
+    fn url(self: *Peer) [*c]const u8 {
+        const port = self.server.listen_address.getPort();
+        return (std.fmt.bufPrintZ(&self.url_buf, "ws://127.0.0.1:{d}/", .{port}) catch unreachable).ptr;
+    }
+
+    fn deinit(self: *Peer) void {
+        if (self.stream) |stream| stream.close();
+        self.server.deinit();
+    }
+
+    // Accept the transport's connection and answer its upgrade request
+    fn accept(self: *Peer) !void {
+        const conn = try self.server.accept();
+        self.stream = conn.stream;
+
+        var eoh = std.mem.indexOf(u8, self.buf[0..self.end], "\r\n\r\n");
+        while (eoh == null) : (eoh = std.mem.indexOf(u8, self.buf[0..self.end], "\r\n\r\n")) {
+            try self.fill();
+        }
+        const request = self.buf[0..eoh.?];
+        const key_header = "Sec-WebSocket-Key: ";
+        const key_at = (std.mem.indexOf(u8, request, key_header) orelse return error.NoKey) + key_header.len;
+        const key_end = std.mem.indexOfPos(u8, request, key_at, "\r\n") orelse request.len;
+
+        var sha1 = std.crypto.hash.Sha1.init(.{});
+        sha1.update(request[key_at..key_end]);
+        sha1.update(ws_guid);
+        var digest: [std.crypto.hash.Sha1.digest_length]u8 = undefined;
+        sha1.final(&digest);
+        var accept_key: [28]u8 = undefined;
+        _ = std.base64.standard.Encoder.encode(&accept_key, &digest);
+
+        var response: [160]u8 = undefined;
+        try self.write(try std.fmt.bufPrint(&response, "HTTP/1.1 101 Switching Protocols\r\n" ++
+            "Upgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: {s}\r\n\r\n", .{accept_key}));
+        self.start = eoh.? + 4;
+    }
+
+    fn write(self: *Peer, bytes: []const u8) !void {
+        try self.stream.?.writeAll(bytes);
+    }
+
+    // One unmasked server frame; `first` is FIN/RSV/opcode
+    fn writeFrame(self: *Peer, first: u8, payload: []const u8) !void {
+        var header: [10]u8 = undefined;
+        header[0] = first;
+        var header_len: usize = 2;
+        if (payload.len > 65535) {
+            header[1] = 127;
+            std.mem.writeInt(u64, header[2..10], payload.len, .big);
+            header_len = 10;
+        } else if (payload.len > 125) {
+            header[1] = 126;
+            std.mem.writeInt(u16, header[2..4], @intCast(payload.len), .big);
+            header_len = 4;
+        } else {
+            header[1] = @intCast(payload.len);
+        }
+        try self.write(header[0..header_len]);
+        try self.write(payload);
+    }
+
+    fn fill(self: *Peer) !void {
+        if (self.start > 0) {
+            std.mem.copyForwards(u8, self.buf[0 .. self.end - self.start], self.buf[self.start..self.end]);
+            self.end -= self.start;
+            self.start = 0;
+        }
+        if (self.end == self.buf.len) return error.FrameTooLarge;
+        const n = try self.stream.?.read(self.buf[self.end..]);
+        if (n == 0) return error.EndOfStream;
+        self.end += n;
+    }
+
+    fn need(self: *Peer, n: usize) !void {
+        while (self.end - self.start < n) try self.fill();
+    }
+
+    // Next frame from the transport, unmasked
+    fn readFrame(self: *Peer) !Frame {
+        try self.need(2);
+        var length: usize = self.buf[self.start + 1] & 0x7f;
+        const header: usize = switch (length) {
+            126 => 4,
+            127 => 10,
+            else => 2,
+        };
+        try self.need(header + 4);
+        var bytes = self.buf[self.start..self.end];
+        if (length == 126) length = std.mem.readInt(u16, bytes[2..4], .big);
+        if (length == 127) length = @intCast(std.mem.readInt(u64, bytes[2..10], .big));
+
+        try self.need(header + 4 + length);
+        bytes = self.buf[self.start..self.end];
+        const mask = bytes[header..][0..4].*;
+        const payload = bytes[header + 4 ..][0..length];
+        for (payload, 0..) |*byte, i| byte.* ^= mask[i & 3];
+        self.start += header + 4 + length;
+        return .{ .fin = bytes[0] & 0x80 != 0, .opcode = bytes[0] & 0x0f, .payload = payload };
+    }
+};
+
+var g_opened = std.atomic.Value(bool).init(false);
+var g_closed = std.atomic.Value(bool).init(false);
+var g_close_code = std.atomic.Value(c_int).init(0);
+var g_messages = std.atomic.Value(usize).init(0);
+var g_message: [1024]u8 = undefined; // last message, written before g_messages
+var g_message_len: usize = 0;
+
+fn reset() void {
+    g_opened.store(false, .seq_cst);
+    g_closed.store(false, .seq_cst);
+    g_close_code.store(0, .seq_cst);
+    g_messages.store(0, .seq_cst);
+}
+
+fn onOpen(_: ?*anyopaque) callconv(.c) void {
+    g_opened.store(true, .seq_cst);
+}
+fn onMessage(data: [*c]const u8, length: usize, _: ?*anyopaque) callconv(.c) void {
+    g_message_len = @min(length, g_message.len);
+    @memcpy(g_message[0..g_message_len], data[0..g_message_len]);
+    _ = g_messages.fetchAdd(1, .seq_cst);
+}
+fn onClose(code: c_int, _: [*c]const u8, _: ?*anyopaque) callconv(.c) void {
+    g_close_code.store(code, .seq_cst);
+    g_closed.store(true, .seq_cst);
+}
+
+fn opened() bool {
+    return g_opened.load(.seq_cst);
+}
+fn closed() bool {
+    return g_closed.load(.seq_cst);
+}
+fn gotMessage() bool {
+    return g_messages.load(.seq_cst) > 0;
+}
+
+fn pollUntil(condition: anytype, deadline_ns: u64) bool {
+    const poll_interval = 10 * std.time.ns_per_ms;
+    var elapsed: u64 = 0;
+    while (elapsed < deadline_ns) : (elapsed += poll_interval) {
+        if (condition()) return true;
+        std.Thread.sleep(poll_interval);
+    }
+    return false;
+}
+
+// Connect a new transport to `peer` and wait for it to open
+fn connectOpened(peer: *Peer) !*c.colyseus_transport_t {
+    reset();
+    var events = c.colyseus_transport_events_t{
+        .on_open = onOpen,
+        .on_message = onMessage,
+        .on_close = onClose,
+        .on_error = null,
+        .userdata = null,
+    };
+    const created: ?*c.colyseus_transport_t = c.colyseus_websocket_transport_create(&events);
+    const transport = created orelse return error.CreateFailed;
+    errdefer c.colyseus_transport_destroy(transport);
+    c.colyseus_transport_connect(transport, peer.url());
+    try peer.accept();
+    try testing.expect(pollUntil(opened, 3 * std.time.ns_per_s));
+    return transport;
+}
+
+// Payload: producer id and sequence number, padded to `size`
+fn sendSeq(transport: *c.colyseus_transport_t, id: u32, seq: u32, size: usize) void {
+    var payload: [4096]u8 = undefined;
+    std.mem.writeInt(u32, payload[0..4], id, .little);
+    std.mem.writeInt(u32, payload[4..8], seq, .little);
+    @memset(payload[8..size], @truncate(seq));
+    c.colyseus_transport_send(transport, &payload, size);
+}
+
+fn frameSeq(frame: Frame) [2]u32 {
+    return .{
+        std.mem.readInt(u32, frame.payload[0..4], .little),
+        std.mem.readInt(u32, frame.payload[4..8], .little),
+    };
+}
+
+// frames_sent is counted once the socket took the bytes, which can be
+// just after the peer read them
+fn framesSentReaches(transport: *c.colyseus_transport_t, count: u64) bool {
+    var elapsed: u64 = 0;
+    while (elapsed < std.time.ns_per_s) : (elapsed += std.time.ns_per_ms) {
+        var stats: c.colyseus_transport_stats_t = undefined;
+        c.colyseus_transport_get_stats(transport, &stats);
+        if (stats.frames_sent == count) return true;
+        std.Thread.sleep(std.time.ns_per_ms);
+    }
+    return false;
+}
+
+const producer_count = 4;
+
+fn producer(transport: *c.colyseus_transport_t, id: u32, count: u32) void {
+    var seq: u32 = 0;
+    while (seq < count) : (seq += 1) sendSeq(transport, id, seq, 8);
+}
+
+test "websocket: sends from several threads keep per-thread order" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    const per_producer = 2000;
+    var threads: [producer_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, id| {
+        thread.* = try std.Thread.spawn(.{}, producer, .{ transport, @as(u32, @intCast(id)), per_producer });
+    }
+    for (threads) |thread| thread.join();
+
+    var next = [_]u32{0} ** producer_count;
+    var received: usize = 0;
+    while (received < producer_count * per_producer) : (received += 1) {
+        const frame = try peer.readFrame();
+        try testing.expect(frame.fin);
+        try testing.expectEqual(@as(u8, 2), frame.opcode);
+        try testing.expectEqual(@as(usize, 8), frame.payload.len);
+        const seq = frameSeq(frame);
+        try testing.expectEqual(next[seq[0]], seq[1]);
+        next[seq[0]] += 1;
+    }
+    try testing.expect(framesSentReaches(transport, producer_count * per_producer));
+}
+
+test "websocket: frames queued past the send ring while the socket is blocked go out in order" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    // The peer isn't reading: once the socket buffers fill, frames pile up
+    // in the 1024-slot ring, wrap it, and spill to the overflow list
+    const count = 4096;
+    const size = 4096;
+    var seq: u32 = 0;
+    while (seq < count) : (seq += 1) sendSeq(transport, 0, seq, size);
+
+    var expected: u32 = 0;
+    while (expected < count) : (expected += 1) {
+        const frame = try peer.readFrame();
+        try testing.expectEqual(@as(usize, size), frame.payload.len);
+        try testing.expectEqual(expected, frameSeq(frame)[1]);
+        try testing.expectEqual(@as(u8, @truncate(expected)), frame.payload[size - 1]);
+    }
+    try testing.expect(framesSentReaches(transport, count));
+}
+
+test "websocket: close writes the queued frames before the close frame" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    const count = 64;
+    var seq: u32 = 0;
+    while (seq < count) : (seq += 1) sendSeq(transport, 0, seq, 8);
+    c.colyseus_transport_close(transport, 1000, "bye");
+    try testing.expect(g_closed.load(.seq_cst));
+    try testing.expectEqual(@as(c_int, 1000), g_close_code.load(.seq_cst));
+
+    var expected: u32 = 0;
+    while (expected < count) : (expected += 1) {
+        const frame = try peer.readFrame();
+        try testing.expectEqual(@as(u8, 2), frame.opcode);
+        try testing.expectEqual(expected, frameSeq(frame)[1]);
+    }
+    const close = try peer.readFrame();
+    try testing.expectEqual(@as(u8, 8), close.opcode);
+    try testing.expectEqual(@as(u16, 1000), std.mem.readInt(u16, close.payload[0..2], .big));
+    try testing.expectEqualStrings("bye", close.payload[2..]);
+}
+
+test "websocket: close while producers are sending drops a tail, never a gap" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    var threads: [producer_count]std.Thread = undefined;
+    for (&threads, 0..) |*thread, id| {
+        thread.* = try std.Thread.spawn(.{}, producer, .{ transport, @as(u32, @intCast(id)), 20000 });
+    }
+    defer for (threads) |thread| thread.join();
+
+    // Close mid-stream: the queue is cleared while producers still claim
+    // ring slots (the transport only stops taking sends after the clear)
+    var next = [_]u32{0} ** producer_count;
+    var received: usize = 0;
+    while (received < 256) : (received += 1) {
+        const seq = frameSeq(try peer.readFrame());
+        try testing.expectEqual(next[seq[0]], seq[1]);
+        next[seq[0]] += 1;
+    }
+    c.colyseus_transport_close(transport, 1000, "bye");
+    try testing.expect(!c.colyseus_transport_is_open(transport));
+
+    // Whatever made it out before the socket closed is still in order
+    while (true) {
+        const frame = peer.readFrame() catch break;
+        if (frame.opcode == 8) break;
+        const seq = frameSeq(frame);
+        try testing.expectEqual(next[seq[0]], seq[1]);
+        next[seq[0]] += 1;
+    }
+}
+
+fn expectMessage(expected: []const u8) !void {
+    try testing.expect(pollUntil(gotMessage, 3 * std.time.ns_per_s));
+    try testing.expectEqual(@as(usize, 1), g_messages.load(.seq_cst));
+    try testing.expectEqualSlices(u8, expected, g_message[0..g_message_len]);
+    g_messages.store(0, .seq_cst);
+}
+
+test "websocket: fragmented messages are reassembled from continuation frames" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    // Unfragmented first: delivered in place
+    try peer.writeFrame(0x82, "whole");
+    try expectMessage("whole");
+
+    // BINARY (no FIN), CONTINUATION (no FIN), CONTINUATION + FIN
+    try peer.writeFrame(0x02, "abc");
+    try peer.writeFrame(0x00, "def");
+    try peer.writeFrame(0x80, "gh");
+    try expectMessage("abcdefgh");
+
+    // Empty fragments are fine too
+    try peer.writeFrame(0x01, "");
+    try peer.writeFrame(0x80, "text");
+    try expectMessage("text");
+}
+
+test "websocket: control frames between fragments are handled without breaking the message" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    try peer.writeFrame(0x02, "ab");
+    try peer.writeFrame(0x89, "hi"); // PING
+    try peer.writeFrame(0x00, "cd");
+    try peer.writeFrame(0x8A, "late"); // unsolicited PONG: ignored
+    try peer.writeFrame(0x80, "ef");
+    try expectMessage("abcdef");
+
+    const pong = try peer.readFrame();
+    try testing.expectEqual(@as(u8, 0xA), pong.opcode);
+    try testing.expectEqualStrings("hi", pong.payload);
+    try testing.expect(c.colyseus_transport_is_open(transport));
+}
+
+test "websocket: a frame split across reads is delivered once complete" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    // 16-bit length: split inside the header, the extended length and the payload
+    var frame: [4 + 300]u8 = undefined;
+    frame[0] = 0x82;
+    frame[1] = 126;
+    std.mem.writeInt(u16, frame[2..4], 300, .big);
+    for (frame[4..], 0..) |*byte, i| byte.* = @truncate(i);
+
+    for ([_][2]usize{ .{ 0, 1 }, .{ 1, 3 }, .{ 3, 50 }, .{ 50, frame.len } }) |cut| {
+        try testing.expectEqual(@as(usize, 0), g_messages.load(.seq_cst));
+        try peer.write(frame[cut[0]..cut[1]]);
+        std.Thread.sleep(20 * std.time.ns_per_ms);
+    }
+    try expectMessage(frame[4..]);
+}
+
+test "websocket: a 64-bit length past the message limit closes with 1009" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    // Header only: 64 MiB + 1 is refused before any payload arrives
+    var header: [10]u8 = undefined;
+    header[0] = 0x82;
+    header[1] = 127;
+    std.mem.writeInt(u64, header[2..10], 64 * 1024 * 1024 + 1, .big);
+    try peer.write(&header);
+
+    try testing.expect(pollUntil(closed, 3 * std.time.ns_per_s));
+    try testing.expectEqual(@as(c_int, 1009), g_close_code.load(.seq_cst));
+    try testing.expectEqual(@as(usize, 0), g_messages.load(.seq_cst));
+
+    const close = try peer.readFrame();
+    try testing.expectEqual(@as(u8, 8), close.opcode);
+    try testing.expectEqual(@as(u16, 1009), std.mem.readInt(u16, close.payload[0..2], .big));
+}
+
+test "websocket: a close frame from the server is echoed and reported with its status" {
+    var peer: Peer = undefined;
+    try peer.listen();
+    defer peer.deinit();
+    const transport = try connectOpened(&peer);
+    defer c.colyseus_transport_destroy(transport);
+
+    // A message in the same read as the close still arrives first
+    var bytes: [2 + 1 + 2 + 2 + 4]u8 = undefined;
+    @memcpy(bytes[0..3], &[_]u8{ 0x82, 1, 7 });
+    @memcpy(bytes[3..7], &[_]u8{ 0x88, 6, 0x0f, 0xa0 }); // 4000
+    @memcpy(bytes[7..], "done");
+    try peer.write(&bytes);
+
+    try testing.expect(pollUntil(closed, 3 * std.time.ns_per_s));
+    try testing.expectEqual(@as(c_int, 4000), g_close_code.load(.seq_cst));
+    try testing.expectEqualSlices(u8, &[_]u8{7}, g_message[0..g_message_len]);
+    try testing.expect(!c.colyseus_transport_is_open(transport));
+
+    // Echoed with the status only (RFC 6455 5.5.1)
+    const close = try peer.readFrame();
+    try testing.expectEqual(@as(u8, 8), close.opcode);
+    try testing.expectEqual(@as(usize, 2), close.payload.len);
+    try testing.expectEqual(@as(u16, 4000), std.mem.readInt(u16, close.payload[0..2], .big));
+}
@@ -5,9 +5,24 @@
 // job is to let the client complete a *verified* TLS handshake — so the tests
 // can assert that cert verification passes with a trusted CA and fails without.
 //
-// Usage: node wss-echo-server.mjs [--port N] [--cert path] [--key path]
+// With --plain it serves ws:// instead (no TLS), which the transport latency
+// benchmark (examples/ws_latency_bench.c) uses.
+//
+// Plain HTTP requests get a small JSON reply on a kept-alive connection, for
+// the HTTP client benchmark (examples/http_latency_bench.c).
+//
+// When the client offers permessage-deflate (RFC 7692) it is accepted and
+// echoes go back compressed, through one raw deflate stream per connection
+// (context takeover), honoring server_max_window_bits.
+//
+// An upgrade to a URL with ?welcome=N gets a text frame of N bytes written
+// together with the 101 response, so both arrive in one TLS record.
+//
+// Usage: node wss-echo-server.mjs [--port N] [--cert path] [--key path] [--plain]
+import http from "node:http";
 import https from "node:https";
 import crypto from "node:crypto";
+import zlib from "node:zlib";
 import fs from "node:fs";
 import path from "node:path";
 import { fileURLToPath } from "node:url";
@@ -23,11 +38,28 @@ const port = parseInt(arg("port", process.env.WSS_PORT || "2569"), 10);
 const certPath = arg("cert", path.join(here, "server.pem"));
 const keyPath = arg("key", path.join(here, "server.key"));
 
+const plain = args.includes("--plain");
+
 const WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
-const server = https.createServer({
-  cert: fs.readFileSync(certPath),
-  key: fs.readFileSync(keyPath),
+const server = plain
+  ? http.createServer()
+  : https.createServer({
+      cert: fs.readFileSync(certPath),
+      key: fs.readFileSync(keyPath),
+    });
+
+// Any non-upgrade request: drain the body and answer with a small JSON body.
+server.on("request", (req, res) => {
+  req.resume();
+  req.on("end", () => {
+    const body = JSON.stringify({ method: req.method, url: req.url });
+    res.writeHead(200, {
+      "Content-Type": "application/json",
+      "Content-Length": Buffer.byteLength(body),
+    });
+    res.end(body);
+  });
 });
 
 // Complete the RFC 6455 opening handshake.
@@ -38,17 +70,81 @@ server.on("upgrade", (req, socket) => {
     return;
   }
   const accept = crypto.createHash("sha1").update(key + WS_GUID).digest("base64");
-  socket.write(
+  const deflate = parseDeflateOffer(req.headers["sec-websocket-extensions"]);
+  let extension = "";
+  if (deflate) {
+    extension = "Sec-WebSocket-Extensions: permessage-deflate";
+    if (deflate.windowBits < 15) extension += `; server_max_window_bits=${deflate.windowBits}`;
+    extension += "\r\n";
+  }
+  const response = Buffer.from(
     "HTTP/1.1 101 Switching Protocols\r\n" +
       "Upgrade: websocket\r\n" +
       "Connection: Upgrade\r\n" +
-      `Sec-WebSocket-Accept: ${accept}\r\n\r\n`,
+      `Sec-WebSocket-Accept: ${accept}\r\n` +
+      extension +
+      "\r\n",
   );
-  pump(socket);
+  const welcome = parseInt(new URL(req.url, "http://x").searchParams.get("welcome") || "0", 10);
+  if (welcome > 0) {
+    socket.write(Buffer.concat([response, encodeFrame(0x1, Buffer.alloc(welcome, "w"))]));
+  } else {
+    socket.write(response);
+  }
+  pump(socket, deflate);
 });
 
+// First permessage-deflate offer, or null.
+function parseDeflateOffer(header) {
+  if (!header) return null;
+  for (const offer of header.split(",")) {
+    const [name, ...params] = offer.split(";").map((p) => p.trim());
+    if (name !== "permessage-deflate") continue;
+    let windowBits = 15;
+    for (const param of params) {
+      const [key, value] = param.split("=").map((p) => p.trim());
+      if (key === "server_max_window_bits" && value) windowBits = parseInt(value, 10);
+    }
+    // zlib's raw deflate has no 8-bit window
+    return { windowBits: Math.max(9, Math.min(15, windowBits)) };
+  }
+  return null;
+}
+
+// Compress one message on the connection's stream: sync flush, then drop
+// the 00 00 ff ff tail (RFC 7692 7.2.1).
+function compressor(windowBits) {
+  const stream = zlib.createDeflateRaw({ windowBits });
+  return (payload) =>
+    new Promise((resolve) => {
+      const chunks = [];
+      const onData = (chunk) => chunks.push(chunk);
+      stream.on("data", onData);
+      stream.write(payload);
+      stream.flush(zlib.constants.Z_SYNC_FLUSH, () => {
+        stream.off("data", onData);
+        const out = Buffer.concat(chunks);
+        resolve(out.subarray(0, out.length - 4));
+      });
+    });
+}
+
 // Minimal frame loop: unmask client frames, echo data frames, answer ping/close.
-function pump(socket) {
+function pump(socket, deflate) {
+  socket.setNoDelay(true);
+  // With deflate, every write goes through one chain to keep frame order.
+  const compress = deflate ? compressor(deflate.windowBits) : null;
+  let chain = Promise.resolve();
+  const send = (frame) => {
+    if (!compress) return socket.write(frame);
+    chain = chain.then(() => socket.write(frame));
+  };
+  const echo = (opcode, payload) => {
+    if (!compress) return send(encodeFrame(opcode, payload));
+    chain = chain
+      .then(() => compress(payload))
+      .then((body) => socket.write(encodeFrame(opcode, body, 0x40)));
+  };
   let buf = Buffer.alloc(0);
   socket.on("data", (chunk) => {
     buf = Buffer.concat([buf, chunk]);
@@ -58,12 +154,13 @@ function pump(socket) {
       buf = buf.subarray(frame.size);
       const op = frame.opcode;
       if (op === 0x8) {
-        socket.end(encodeFrame(0x8, frame.payload));
+        if (compress) chain = chain.then(() => socket.end(encodeFrame(0x8, frame.payload)));
+        else socket.end(encodeFrame(0x8, frame.payload));
         return;
       } else if (op === 0x9) {
-        socket.write(encodeFrame(0xa, frame.payload)); // pong
+        send(encodeFrame(0xa, frame.payload)); // pong
       } else if (op === 0x1 || op === 0x2) {
-        socket.write(encodeFrame(op, frame.payload)); // echo
+        echo(op, frame.payload);
       }
     }
   });
@@ -96,19 +193,20 @@ function readFrame(buf) {
   return { opcode, payload, size: offset + maskLen + len };
 }
 
-function encodeFrame(opcode, payload) {
+function encodeFrame(opcode, payload, rsv = 0) {
   const len = payload.length;
+  const first = 0x80 | rsv | opcode;
   let header;
   if (len < 126) {
-    header = Buffer.from([0x80 | opcode, len]);
+    header = Buffer.from([first, len]);
   } else if (len < 65536) {
     header = Buffer.alloc(4);
-    header[0] = 0x80 | opcode;
+    header[0] = first;
     header[1] = 126;
     header.writeUInt16BE(len, 2);
   } else {
     header = Buffer.alloc(10);
-    header[0] = 0x80 | opcode;
+    header[0] = first;
     header[1] = 127;
     header.writeBigUInt64BE(BigInt(len), 2);
   }
@@ -116,5 +214,5 @@ function encodeFrame(opcode, payload) {
 }
 
 server.listen(port, "127.0.0.1", () => {
-  console.log(`[wss-echo] listening on wss://127.0.0.1:${port}`);
+  console.log(`[wss-echo] listening on ${plain ? "ws" : "wss"}://127.0.0.1:${port}`);
 });